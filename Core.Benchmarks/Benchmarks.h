@@ -0,0 +1,111 @@
+#if !defined __BENCHMARKS_H__
+#define __BENCHMARKS_H__
+
+#include <benchmark/benchmark.h>
+#include "Core/Math/Random.h"
+#include "Core/Math/SIMD/Kernels.h"
+
+namespace energonsoftware {
+namespace benchmarks {
+
+// number of elements that each per-element benchmark iterates over
+// (4096 Vectors is 64KB so the inputs stay in L2)
+static const size_t ElementCount = 4096;
+
+// storage for per-element results, avoiding the packed std::vector<bool>
+template<typename T>
+using result_vector = std::vector<typename std::conditional<std::is_same<T, bool>::value, char, T>::type>;
+
+// reports elements/second (items_per_second) and the time per element (time/op)
+// for a benchmark that processes count elements per iteration
+// NOTE: time/op is in seconds in the JSON output, the console scales it (ns, ps)
+inline void set_elements_processed(benchmark::State& state, size_t count)
+{
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+    state.counters["time/op"] = benchmark::Counter(static_cast<double>(count),
+        benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+// the same pseudo-random vectors for every run, seed picks the set
+inline std::vector<math::Vector> test_vectors(size_t count, uint64_t seed)
+{
+    std::vector<math::Vector> vectors(count);
+    math::Random(seed).in_box(vectors.data(), count, math::Vector(-100.0f, -100.0f, -100.0f, 0.0f), math::Vector(100.0f, 100.0f, 100.0f, 0.0f));
+    return vectors;
+}
+
+// query radius of the spatial index benchmarks
+static const float SpatialQueryRadius = 4.0f;
+
+// pseudo-random points for the spatial index benchmarks
+// the box grows with the point count so that a sphere of
+// SpatialQueryRadius holds about 4 points at any count
+inline std::vector<math::Vector> test_points(size_t count, uint64_t seed)
+{
+    const float extent = 2.0f * std::cbrt(static_cast<float>(count));
+
+    std::vector<math::Vector> points(count);
+    math::Random(seed).in_box(points.data(), count, math::Vector(-extent, -extent, -extent), math::Vector(extent, extent, extent));
+    return points;
+}
+
+inline std::vector<float> test_floats(size_t count, uint64_t seed, float min, float max)
+{
+    std::vector<float> values(count);
+    math::Random random(seed);
+    for(float& value : values) {
+        value = random.uniform(min, max);
+    }
+    return values;
+}
+
+// selects the SIMD tier from the first benchmark argument for the lifetime of the scope
+// and skips the benchmark if this CPU doesn't support it
+class ScopedSimdLevel
+{
+public:
+    ScopedSimdLevel(benchmark::State& state, int arg = 0)
+        : _previous(math::kernels().level)
+    {
+        const math::SimdLevel level = static_cast<math::SimdLevel>(state.range(arg));
+        _supported = level <= math::max_simd_level();
+        if(_supported) {
+            math::set_simd_level(level);
+            state.SetLabel(math::simd_level_name(level));
+        } else {
+            state.SkipWithError("SIMD level not supported by this CPU");
+        }
+    }
+
+    ~ScopedSimdLevel()
+    {
+        math::set_simd_level(_previous);
+    }
+
+    bool supported() const { return _supported; }
+
+private:
+    math::SimdLevel _previous;
+    bool _supported;
+};
+
+// batch sizes from L1-resident to main memory
+// use with ->Apply(), range(0) is the batch size
+inline void batch_sizes(benchmark::internal::Benchmark* const b)
+{
+    b->ArgName("count")->Arg(1 << 10)->Arg(1 << 14)->Arg(1 << 20);
+}
+
+// every SIMD tier crossed with the batch sizes
+// use with ->Apply(), range(0) is the SimdLevel (see ScopedSimdLevel) and range(1) is the batch size
+inline void simd_batch_sizes(benchmark::internal::Benchmark* const b)
+{
+    b->ArgNames({ "simd", "count" })->ArgsProduct({
+        benchmark::CreateDenseRange(static_cast<int>(math::SimdLevel::Scalar), static_cast<int>(math::SimdLevel::AVX512), 1),
+        { 1 << 10, 1 << 14, 1 << 20 }
+    });
+}
+
+} }
+
+#endif
@@ -0,0 +1,143 @@
+#include "pch.h"
+#include <cstdio>
+#include <fstream>
+#include "Core.Benchmarks/Benchmarks.h"
+#include "Core/IO/PointCloud.h"
+
+namespace energonsoftware {
+namespace io {
+namespace benchmarks {
+
+using energonsoftware::benchmarks::set_elements_processed;
+using energonsoftware::benchmarks::test_vectors;
+using math::Vector;
+
+// loading count points from Vector::str() text (parsed with sscanf) vs a point cloud file
+// the files are written once per benchmark and are in the page cache,
+// so these measure parsing vs mapping, not the disk
+
+static void point_counts(benchmark::internal::Benchmark* b)
+{
+    b->Arg(64 * 1024)->Arg(1024 * 1024);
+}
+
+// deletes the file when the benchmark is done
+struct BenchmarkFile
+{
+    std::string path;
+
+    explicit BenchmarkFile(const char* const name)
+        : path(name)
+    {
+    }
+
+    ~BenchmarkFile()
+    {
+        std::remove(path.c_str());
+    }
+};
+
+static void PointCloud_Load_Text(benchmark::State& state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    const std::vector<Vector> points = test_vectors(count, 1);
+
+    BenchmarkFile file("pointcloud_benchmark.txt");
+    {
+        std::ofstream out(file.path);
+        for(const Vector& v : points) {
+            out << v.str() << "\n";
+        }
+    }
+
+    std::vector<Vector> r(count);
+    for(auto _ : state) {
+        std::ifstream in(file.path);
+        std::string line;
+        for(size_t i = 0; i < count && std::getline(in, line); ++i) {
+            float x, y, z, w;
+            std::sscanf(line.c_str(), "Vector(x:%f, y:%f, z:%f, w:%f)", &x, &y, &z, &w);
+            r[i] = Vector(x, y, z, w);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, count);
+}
+
+// open and copy the points out, optionally checking the checksums first
+static void PointCloud_Load_Mapped(benchmark::State& state, bool verify)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    const std::vector<Vector> points = test_vectors(count, 1);
+
+    BenchmarkFile file("pointcloud_benchmark.espc");
+    {
+        PointCloudWriter writer(file.path, { { "position", ColumnLayout::Packed } });
+        writer.write(points.data(), count);
+    }
+
+    std::vector<Vector> r(count);
+    for(auto _ : state) {
+        PointCloudFile cloud(file.path);
+        if(verify && !cloud.verify()) {
+            state.SkipWithError("checksum mismatch");
+            break;
+        }
+        cloud.read(0, r.data());
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, count);
+}
+
+// open and sum the points in place, without copying them
+static void PointCloud_Load_Span(benchmark::State& state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    const std::vector<Vector> points = test_vectors(count, 1);
+
+    BenchmarkFile file("pointcloud_benchmark.espc");
+    {
+        PointCloudWriter writer(file.path, { { "position", ColumnLayout::Packed } });
+        writer.write(points.data(), count);
+    }
+
+    for(auto _ : state) {
+        PointCloudFile cloud(file.path);
+        Vector sum;
+        for(size_t chunk = 0; chunk < cloud.chunk_count(); ++chunk) {
+            for(const Vector& v : cloud.packed(0, chunk)) {
+                sum += v;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    set_elements_processed(state, count);
+}
+
+static void PointCloud_Write(benchmark::State& state, bool checksums)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    const std::vector<Vector> points = test_vectors(count, 1);
+
+    BenchmarkFile file("pointcloud_benchmark.espc");
+    for(auto _ : state) {
+        PointCloudWriter writer(file.path, { { "position", ColumnLayout::Packed } }, PointCloudWriter::DefaultChunkSize, checksums);
+        writer.write(points.data(), count);
+        writer.close();
+    }
+
+    set_elements_processed(state, count);
+}
+
+BENCHMARK(PointCloud_Load_Text)->Apply(point_counts);
+BENCHMARK_CAPTURE(PointCloud_Load_Mapped, copy, false)->Apply(point_counts);
+BENCHMARK_CAPTURE(PointCloud_Load_Mapped, verify, true)->Apply(point_counts);
+BENCHMARK(PointCloud_Load_Span)->Apply(point_counts);
+
+BENCHMARK_CAPTURE(PointCloud_Write, checksums, true)->Apply(point_counts);
+BENCHMARK_CAPTURE(PointCloud_Write, no_checksums, false)->Apply(point_counts);
+
+} } }
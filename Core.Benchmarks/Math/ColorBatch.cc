@@ -0,0 +1,102 @@
+#include "pch.h"
+#include "Core.Benchmarks/Benchmarks.h"
+#include "Core/Math/ColorBatch.h"
+
+namespace energonsoftware {
+namespace math {
+namespace benchmarks {
+
+using energonsoftware::benchmarks::ScopedSimdLevel;
+using energonsoftware::benchmarks::batch_sizes;
+using energonsoftware::benchmarks::set_elements_processed;
+using energonsoftware::benchmarks::simd_batch_sizes;
+
+// one color at a time with the C++ standard library vs the color batch API
+// Color_Loop is the baseline for the matching Color_Kernel on each SIMD tier
+
+static std::vector<Color> test_colors(size_t count, uint64_t seed)
+{
+    std::vector<Color> colors(count);
+    Random(seed).in_box(colors.data(), count, Color(0.0f, 0.0f, 0.0f, 0.0f), Color(1.0f, 1.0f, 1.0f, 1.0f));
+    return colors;
+}
+
+static float decode_srgb(float c)
+{
+    return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+static float encode_srgb(float l)
+{
+    return l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+}
+
+static uint32_t quantize8(float c)
+{
+    return static_cast<uint32_t>(std::lrint(std::min(std::max(c, 0.0f), 1.0f) * 255.0f));
+}
+
+static uint32_t pack_srgba8(const Color& c)
+{
+    return quantize8(encode_srgb(c.x())) | (quantize8(encode_srgb(c.y())) << 8) | (quantize8(encode_srgb(c.z())) << 16) | (quantize8(c.w()) << 24);
+}
+
+static Color over(const Color& s, const Color& d)
+{
+    return s + d * (1.0f - s.w());
+}
+
+// result only carries the output element type
+template<typename R, typename Op>
+static void Color_Loop(benchmark::State& state, R, Op op)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    const std::vector<Color> a = test_colors(count, 1);
+    const std::vector<Color> b = test_colors(count, 2);
+    std::vector<R> r(count);
+
+    for(auto _ : state) {
+        for(size_t i = 0; i < count; ++i) {
+            r[i] = op(a[i], b[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, count);
+}
+
+template<typename R, typename Op>
+static void Color_Kernel(benchmark::State& state, R, Op op)
+{
+    ScopedSimdLevel simd(state);
+    const size_t count = static_cast<size_t>(state.range(1));
+    const std::vector<Color> a = test_colors(count, 1);
+    const std::vector<Color> b = test_colors(count, 2);
+    std::vector<R> r(count);
+
+    for(auto _ : state) {
+        op(a.data(), b.data(), r.data(), count);
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, count);
+}
+
+// 4 halves per color
+struct Half4
+{
+    uint16_t h[4];
+};
+
+BENCHMARK_CAPTURE(Color_Loop, srgb_to_linear, Color(), [](const Color& a, const Color&) { return Color(decode_srgb(a.x()), decode_srgb(a.y()), decode_srgb(a.z()), a.w()); })->Apply(batch_sizes);
+BENCHMARK_CAPTURE(Color_Kernel, srgb_to_linear, Color(), [](const Color* a, const Color*, Color* r, size_t n) { batch::srgb_to_linear(a, r, n); })->Apply(simd_batch_sizes);
+
+BENCHMARK_CAPTURE(Color_Loop, pack_srgba8, uint32_t(), [](const Color& a, const Color&) { return pack_srgba8(a); })->Apply(batch_sizes);
+BENCHMARK_CAPTURE(Color_Kernel, pack_srgba8, uint32_t(), [](const Color* a, const Color*, uint32_t* r, size_t n) { batch::pack_srgba8(a, r, n); })->Apply(simd_batch_sizes);
+
+BENCHMARK_CAPTURE(Color_Kernel, pack_half, Half4(), [](const Color* a, const Color*, Half4* r, size_t n) { batch::pack_half(a, reinterpret_cast<uint16_t*>(r), n); })->Apply(simd_batch_sizes);
+
+BENCHMARK_CAPTURE(Color_Loop, blend_over, Color(), [](const Color& a, const Color& b) { return over(a, b); })->Apply(batch_sizes);
+BENCHMARK_CAPTURE(Color_Kernel, blend_over, Color(), [](const Color* a, const Color* b, Color* r, size_t n) { batch::blend(a, b, r, n); })->Apply(simd_batch_sizes);
+
+} } }
@@ -0,0 +1,145 @@
+#include "pch.h"
+#include "Core.Benchmarks/Benchmarks.h"
+#include "Core/Math/Frustum.h"
+
+namespace energonsoftware {
+namespace math {
+namespace benchmarks {
+
+using energonsoftware::benchmarks::ScopedSimdLevel;
+using energonsoftware::benchmarks::batch_sizes;
+using energonsoftware::benchmarks::set_elements_processed;
+using energonsoftware::benchmarks::simd_batch_sizes;
+using energonsoftware::benchmarks::test_vectors;
+
+// one object at a time through Frustum::intersects() vs the bulk culling kernels
+// the objects are spread over a box around the camera, about 1 in 8 is visible
+
+static const Frustum TestFrustum = Frustum::from_matrix(Matrix4::perspective(1.0f, 1.5f, 1.0f, 100.0f));
+
+// (center, radius) with radii in [0, 5]
+static std::vector<Vector> test_spheres(size_t count)
+{
+    std::vector<Vector> spheres = test_vectors(count, 1);
+    const std::vector<Vector> radii = test_vectors(count, 2);
+    for(size_t i = 0; i < count; ++i) {
+        spheres[i].w(std::fabs(radii[i].x()) * 0.05f);
+    }
+    return spheres;
+}
+
+static void Cull_Loop_spheres(benchmark::State& state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    const std::vector<Vector> spheres = test_spheres(count);
+    std::vector<uint32_t> visible(count);
+
+    for(auto _ : state) {
+        size_t n = 0;
+        for(size_t i = 0; i < count; ++i) {
+            if(TestFrustum.intersects(spheres[i].xyz(), spheres[i].w())) {
+                visible[n++] = static_cast<uint32_t>(i);
+            }
+        }
+        benchmark::DoNotOptimize(n);
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, count);
+}
+
+static void Cull_Kernel_spheres(benchmark::State& state)
+{
+    ScopedSimdLevel simd(state);
+    const size_t count = static_cast<size_t>(state.range(1));
+    const std::vector<Vector> aos = test_spheres(count);
+    const VectorStream spheres(aos.data(), count);
+    std::vector<uint32_t> visible(count);
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(TestFrustum.cull_spheres(spheres, visible.data()));
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, count);
+}
+
+// the same spheres as packed Vectors, converted a chunk at a time in the scratch arena
+static void Cull_Packed_spheres(benchmark::State& state)
+{
+    ScopedSimdLevel simd(state);
+    const size_t count = static_cast<size_t>(state.range(1));
+    const std::vector<Vector> spheres = test_spheres(count);
+    std::vector<uint32_t> visible(count);
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(TestFrustum.cull_spheres(spheres.data(), count, visible.data()));
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, count);
+}
+
+// boxes around the same centers with half extents in [0, 5]
+static std::vector<AABB> test_boxes(size_t count)
+{
+    const std::vector<Vector> centers = test_vectors(count, 1);
+    const std::vector<Vector> extents = test_vectors(count, 2);
+
+    std::vector<AABB> boxes(count);
+    for(size_t i = 0; i < count; ++i) {
+        const Vector half_extents(std::fabs(extents[i].x()) * 0.05f, std::fabs(extents[i].y()) * 0.05f, std::fabs(extents[i].z()) * 0.05f);
+        boxes[i] = AABB::from_center(centers[i], half_extents);
+    }
+    return boxes;
+}
+
+static void Cull_Loop_boxes(benchmark::State& state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    const std::vector<AABB> boxes = test_boxes(count);
+    std::vector<uint32_t> visible(count);
+
+    for(auto _ : state) {
+        size_t n = 0;
+        for(size_t i = 0; i < count; ++i) {
+            if(TestFrustum.intersects(boxes[i])) {
+                visible[n++] = static_cast<uint32_t>(i);
+            }
+        }
+        benchmark::DoNotOptimize(n);
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, count);
+}
+
+static void Cull_Kernel_boxes(benchmark::State& state)
+{
+    ScopedSimdLevel simd(state);
+    const size_t count = static_cast<size_t>(state.range(1));
+    const std::vector<AABB> boxes = test_boxes(count);
+
+    VectorStream centers, half_extents;
+    for(const AABB& box : boxes) {
+        centers.push_back(box.center());
+        half_extents.push_back(box.half_extents());
+    }
+    std::vector<uint32_t> visible(count);
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(TestFrustum.cull_boxes(centers, half_extents, visible.data()));
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, count);
+}
+
+BENCHMARK(Cull_Loop_spheres)->Apply(batch_sizes);
+BENCHMARK(Cull_Kernel_spheres)->Apply(simd_batch_sizes);
+BENCHMARK(Cull_Packed_spheres)->Apply(simd_batch_sizes);
+
+BENCHMARK(Cull_Loop_boxes)->Apply(batch_sizes);
+BENCHMARK(Cull_Kernel_boxes)->Apply(simd_batch_sizes);
+
+} } }
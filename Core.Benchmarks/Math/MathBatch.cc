@@ -0,0 +1,88 @@
+#include "pch.h"
+#include "Core.Benchmarks/Benchmarks.h"
+#include "Core/Math/MathBatch.h"
+
+namespace energonsoftware {
+namespace math {
+namespace benchmarks {
+
+using energonsoftware::benchmarks::ScopedSimdLevel;
+using energonsoftware::benchmarks::batch_sizes;
+using energonsoftware::benchmarks::set_elements_processed;
+using energonsoftware::benchmarks::simd_batch_sizes;
+using energonsoftware::benchmarks::test_floats;
+
+// the C++ standard library one float at a time vs the batch elementary functions
+// Math_Loop is the baseline for the matching Math_Kernel, which runs once per SIMD tier
+// the inputs are in each function's domain: angles in [-8pi, 8pi], cosines in [-1, 1]
+// exponents in [-80, 80] and logarithms of (0, 1000]
+
+struct MathInputs
+{
+    std::vector<float> a;
+    std::vector<float> b;
+
+    MathInputs(size_t count, float min, float max)
+        : a(test_floats(count, 1, min, max)),
+          b(test_floats(count, 2, min, max))
+    {
+    }
+};
+
+template<typename Op>
+static void Math_Loop(benchmark::State& state, float min, float max, Op op)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    const MathInputs inputs(count, min, max);
+    std::vector<float> r(count);
+
+    for(auto _ : state) {
+        for(size_t i = 0; i < count; ++i) {
+            r[i] = op(inputs.a[i], inputs.b[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, count);
+}
+
+template<typename Op>
+static void Math_Kernel(benchmark::State& state, float min, float max, Op op)
+{
+    ScopedSimdLevel simd(state);
+    const size_t count = static_cast<size_t>(state.range(1));
+    const MathInputs inputs(count, min, max);
+    std::vector<float> r(count), r2(count);
+
+    for(auto _ : state) {
+        op(inputs.a.data(), inputs.b.data(), r.data(), r2.data(), count);
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, count);
+}
+
+static const float Angle = 8.0f * static_cast<float>(M_PI);
+
+BENCHMARK_CAPTURE(Math_Loop, sin, -Angle, Angle, [](float a, float) { return std::sin(a); })->Apply(batch_sizes);
+BENCHMARK_CAPTURE(Math_Kernel, sin, -Angle, Angle, [](const float* a, const float*, float* r, float*, size_t n) { batch::sin(a, r, n); })->Apply(simd_batch_sizes);
+
+BENCHMARK_CAPTURE(Math_Loop, sincos, -Angle, Angle, [](float a, float) { return std::sin(a) + std::cos(a); })->Apply(batch_sizes);
+BENCHMARK_CAPTURE(Math_Kernel, sincos, -Angle, Angle, [](const float* a, const float*, float* r, float* r2, size_t n) { batch::sincos(a, r, r2, n); })->Apply(simd_batch_sizes);
+
+BENCHMARK_CAPTURE(Math_Loop, atan, -100.0f, 100.0f, [](float a, float) { return std::atan(a); })->Apply(batch_sizes);
+BENCHMARK_CAPTURE(Math_Kernel, atan, -100.0f, 100.0f, [](const float* a, const float*, float* r, float*, size_t n) { batch::atan(a, r, n); })->Apply(simd_batch_sizes);
+
+BENCHMARK_CAPTURE(Math_Loop, atan2, -100.0f, 100.0f, [](float a, float b) { return std::atan2(a, b); })->Apply(batch_sizes);
+BENCHMARK_CAPTURE(Math_Kernel, atan2, -100.0f, 100.0f, [](const float* a, const float* b, float* r, float*, size_t n) { batch::atan2(a, b, r, n); })->Apply(simd_batch_sizes);
+
+BENCHMARK_CAPTURE(Math_Loop, acos, -1.0f, 1.0f, [](float a, float) { return std::acos(a); })->Apply(batch_sizes);
+BENCHMARK_CAPTURE(Math_Kernel, acos, -1.0f, 1.0f, [](const float* a, const float*, float* r, float*, size_t n) { batch::acos(a, r, n); })->Apply(simd_batch_sizes);
+
+BENCHMARK_CAPTURE(Math_Loop, exp, -80.0f, 80.0f, [](float a, float) { return std::exp(a); })->Apply(batch_sizes);
+BENCHMARK_CAPTURE(Math_Kernel, exp, -80.0f, 80.0f, [](const float* a, const float*, float* r, float*, size_t n) { batch::exp(a, r, n); })->Apply(simd_batch_sizes);
+
+BENCHMARK_CAPTURE(Math_Loop, log, 1.0e-6f, 1000.0f, [](float a, float) { return std::log(a); })->Apply(batch_sizes);
+BENCHMARK_CAPTURE(Math_Kernel, log, 1.0e-6f, 1000.0f, [](const float* a, const float*, float* r, float*, size_t n) { batch::log(a, r, n); })->Apply(simd_batch_sizes);
+
+} } }
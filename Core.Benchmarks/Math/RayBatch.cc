@@ -0,0 +1,141 @@
+#include "pch.h"
+#include "Core.Benchmarks/Benchmarks.h"
+#include "Core/Math/RayBatch.h"
+
+namespace energonsoftware {
+namespace math {
+namespace benchmarks {
+
+using energonsoftware::benchmarks::ScopedSimdLevel;
+using energonsoftware::benchmarks::batch_sizes;
+using energonsoftware::benchmarks::set_elements_processed;
+using energonsoftware::benchmarks::simd_batch_sizes;
+using energonsoftware::benchmarks::test_vectors;
+
+// one ray at a time with the Vector API vs the packet kernels
+// the rays start in a box around the primitives and aim
+// roughly at the middle of it so that about half of them hit
+
+static const Point3 TestCenter(1.0f, -2.0f, 3.0f);
+static const float TestRadius = 40.0f;
+static const Point3 TestV0(-60.0f, -50.0f, 5.0f), TestV1(70.0f, -40.0f, -5.0f), TestV2(0.0f, 60.0f, 0.0f);
+
+struct TestRays
+{
+    std::vector<Vector> origins;
+    std::vector<Vector> directions;
+
+    explicit TestRays(size_t count)
+        : origins(test_vectors(count, 1)), directions(test_vectors(count, 2))
+    {
+        for(size_t i = 0; i < count; ++i) {
+            directions[i] = directions[i] * 0.5f - origins[i];
+        }
+    }
+};
+
+static bool sphere_loop(const Point3& origin, const Vector& direction, float& t)
+{
+    const Vector oc = origin - TestCenter;
+    const float a = direction * direction, b = oc * direction, c = oc * oc - TestRadius * TestRadius;
+    const float discriminant = b * b - a * c;
+    if(discriminant < 0.0f) {
+        return false;
+    }
+
+    const float root = std::sqrt(discriminant);
+    float t_hit = (-b - root) / a;
+    if(t_hit < 0.0f) {
+        t_hit = (root - b) / a;
+    }
+    if(t_hit < 0.0f || t_hit > t) {
+        return false;
+    }
+
+    t = t_hit;
+    return true;
+}
+
+static bool triangle_loop(const Point3& origin, const Vector& direction, float& t)
+{
+    const Vector edge1 = TestV1 - TestV0, edge2 = TestV2 - TestV0;
+    const Vector p = direction ^ edge2;
+    const float determinant = edge1 * p;
+    if(0.0f == determinant) {
+        return false;
+    }
+
+    const float inv_determinant = 1.0f / determinant;
+    const Vector s = origin - TestV0;
+    const float u = (s * p) * inv_determinant;
+    if(u < 0.0f || u > 1.0f) {
+        return false;
+    }
+
+    const Vector q = s ^ edge1;
+    const float v = (direction * q) * inv_determinant;
+    if(v < 0.0f || u + v > 1.0f) {
+        return false;
+    }
+
+    const float t_hit = (edge2 * q) * inv_determinant;
+    if(t_hit < 0.0f || t_hit > t) {
+        return false;
+    }
+
+    t = t_hit;
+    return true;
+}
+
+template<typename Intersect>
+static void Ray_Loop(benchmark::State& state, Intersect intersect)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    const TestRays rays(count);
+    std::vector<float> t(count);
+    std::vector<uint32_t> hits((count + 31) / 32);
+
+    for(auto _ : state) {
+        std::fill(t.begin(), t.end(), std::numeric_limits<float>::infinity());
+        std::fill(hits.begin(), hits.end(), 0);
+        for(size_t i = 0; i < count; ++i) {
+            if(intersect(rays.origins[i], rays.directions[i], t[i])) {
+                hits[i / 32] |= 1u << (i % 32);
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, count);
+}
+
+template<typename Intersect>
+static void Ray_Kernel(benchmark::State& state, Intersect intersect)
+{
+    ScopedSimdLevel simd(state);
+    const size_t count = static_cast<size_t>(state.range(1));
+    const TestRays rays(count);
+    const VectorStream origins(rays.origins.data(), count), directions(rays.directions.data(), count);
+    std::vector<float> t(count);
+    std::vector<uint32_t> hits((count + 31) / 32);
+
+    for(auto _ : state) {
+        std::fill(t.begin(), t.end(), std::numeric_limits<float>::infinity());
+        benchmark::DoNotOptimize(intersect(origins, directions, t.data(), hits.data()));
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, count);
+}
+
+BENCHMARK_CAPTURE(Ray_Loop, sphere, sphere_loop)->Apply(batch_sizes);
+BENCHMARK_CAPTURE(Ray_Kernel, sphere, [](const VectorStream& o, const VectorStream& d, float* t, uint32_t* hits) {
+    return batch::intersect_sphere(o, d, TestCenter, TestRadius, t, hits);
+})->Apply(simd_batch_sizes);
+
+BENCHMARK_CAPTURE(Ray_Loop, triangle, triangle_loop)->Apply(batch_sizes);
+BENCHMARK_CAPTURE(Ray_Kernel, triangle, [](const VectorStream& o, const VectorStream& d, float* t, uint32_t* hits) {
+    return batch::intersect_triangle(o, d, TestV0, TestV1, TestV2, t, hits);
+})->Apply(simd_batch_sizes);
+
+} } }
@@ -0,0 +1,105 @@
+#include "pch.h"
+#include "Core.Benchmarks/Benchmarks.h"
+#include "Core/Math/Util.h"
+#include "Core/Math/VectorBatch.h"
+
+namespace energonsoftware {
+namespace math {
+namespace benchmarks {
+
+using energonsoftware::benchmarks::ElementCount;
+using energonsoftware::benchmarks::set_elements_processed;
+using energonsoftware::benchmarks::test_floats;
+
+static void Util_invsqrt(benchmark::State& state, Precision precision)
+{
+    const std::vector<float> a = test_floats(ElementCount, 1, 0.001f, 1000.0f);
+    std::vector<float> r(a.size());
+
+    for(auto _ : state) {
+        for(size_t i = 0; i < a.size(); ++i) {
+            r[i] = invsqrt(a[i], precision);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, a.size());
+}
+BENCHMARK_CAPTURE(Util_invsqrt, approximate, Precision::Approximate);
+BENCHMARK_CAPTURE(Util_invsqrt, refined, Precision::Refined);
+BENCHMARK_CAPTURE(Util_invsqrt, exact, Precision::Exact);
+
+// the baseline that invsqrt() is trying to beat
+static void Util_invsqrt_std(benchmark::State& state)
+{
+    const std::vector<float> a = test_floats(ElementCount, 1, 0.001f, 1000.0f);
+    std::vector<float> r(a.size());
+
+    for(auto _ : state) {
+        for(size_t i = 0; i < a.size(); ++i) {
+            r[i] = 1.0f / std::sqrt(a[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, a.size());
+}
+BENCHMARK(Util_invsqrt_std);
+
+static void Util_invsqrt_batch(benchmark::State& state, Precision precision)
+{
+    energonsoftware::benchmarks::ScopedSimdLevel simd(state);
+    const size_t count = static_cast<size_t>(state.range(1));
+    const std::vector<float> a = test_floats(count, 1, 0.001f, 1000.0f);
+    std::vector<float> r(a.size());
+
+    for(auto _ : state) {
+        batch::invsqrt(a.data(), r.data(), count, precision);
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, count);
+}
+BENCHMARK_CAPTURE(Util_invsqrt_batch, approximate, Precision::Approximate)->Apply(energonsoftware::benchmarks::simd_batch_sizes);
+BENCHMARK_CAPTURE(Util_invsqrt_batch, refined, Precision::Refined)->Apply(energonsoftware::benchmarks::simd_batch_sizes);
+BENCHMARK_CAPTURE(Util_invsqrt_batch, exact, Precision::Exact)->Apply(energonsoftware::benchmarks::simd_batch_sizes);
+
+static void Util_ilog2(benchmark::State& state)
+{
+    std::vector<unsigned int> a(ElementCount);
+    for(size_t i = 0; i < a.size(); ++i) {
+        a[i] = static_cast<unsigned int>(i * 2654435761u) | 1;
+    }
+    std::vector<unsigned int> r(a.size());
+
+    for(auto _ : state) {
+        for(size_t i = 0; i < a.size(); ++i) {
+            r[i] = ilog2(a[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, a.size());
+}
+BENCHMARK(Util_ilog2);
+
+static void Util_power_of_2(benchmark::State& state)
+{
+    std::vector<unsigned int> a(ElementCount);
+    for(size_t i = 0; i < a.size(); ++i) {
+        a[i] = static_cast<unsigned int>(i * 2654435761u) >> 2;
+    }
+    std::vector<unsigned int> r(a.size());
+
+    for(auto _ : state) {
+        for(size_t i = 0; i < a.size(); ++i) {
+            r[i] = power_of_2(a[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, a.size());
+}
+BENCHMARK(Util_power_of_2);
+
+} } }
@@ -0,0 +1,143 @@
+#include "pch.h"
+#include "Core.Benchmarks/Benchmarks.h"
+#include "Core/Math/Vector.h"
+
+namespace energonsoftware {
+namespace math {
+namespace benchmarks {
+
+using energonsoftware::benchmarks::ElementCount;
+using energonsoftware::benchmarks::set_elements_processed;
+using energonsoftware::benchmarks::test_vectors;
+
+// single-element throughput of the Vector API
+// each benchmark applies op to every element of an ElementCount array
+// so ns/op is the amortized cost of one call
+
+template<typename Op>
+static void Vector_Unary(benchmark::State& state, Op op)
+{
+    const std::vector<Vector> a = test_vectors(ElementCount, 1);
+    energonsoftware::benchmarks::result_vector<decltype(op(a[0]))> r(a.size());
+
+    for(auto _ : state) {
+        for(size_t i = 0; i < a.size(); ++i) {
+            r[i] = op(a[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, a.size());
+}
+
+template<typename Op>
+static void Vector_Binary(benchmark::State& state, Op op)
+{
+    const std::vector<Vector> a = test_vectors(ElementCount, 1);
+    const std::vector<Vector> b = test_vectors(ElementCount, 2);
+    energonsoftware::benchmarks::result_vector<decltype(op(a[0], b[0]))> r(a.size());
+
+    for(auto _ : state) {
+        for(size_t i = 0; i < a.size(); ++i) {
+            r[i] = op(a[i], b[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, a.size());
+}
+
+// op modifies a copy of each element in place
+template<typename Op>
+static void Vector_Assign(benchmark::State& state, Op op)
+{
+    const std::vector<Vector> a = test_vectors(ElementCount, 1);
+    const std::vector<Vector> b = test_vectors(ElementCount, 2);
+    std::vector<Vector> r(a.size());
+
+    for(auto _ : state) {
+        for(size_t i = 0; i < a.size(); ++i) {
+            r[i] = a[i];
+            op(r[i], b[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, a.size());
+}
+
+static void Vector_random(benchmark::State& state)
+{
+    std::vector<Vector> r(ElementCount);
+
+    for(auto _ : state) {
+        for(Vector& v : r) {
+            v = Vector::random();
+        }
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, r.size());
+}
+BENCHMARK(Vector_random);
+
+static void Vector_str(benchmark::State& state)
+{
+    const std::vector<Vector> a = test_vectors(256, 1);
+
+    for(auto _ : state) {
+        for(const Vector& v : a) {
+            benchmark::DoNotOptimize(v.str());
+        }
+    }
+
+    set_elements_processed(state, a.size());
+}
+BENCHMARK(Vector_str);
+
+BENCHMARK_CAPTURE(Vector_Unary, length_squared, [](const Vector& v) { return v.length_squared(); });
+BENCHMARK_CAPTURE(Vector_Unary, length, [](const Vector& v) { return v.length(); });
+BENCHMARK_CAPTURE(Vector_Unary, normalized_approximate, [](const Vector& v) { return v.normalized(Precision::Approximate); });
+BENCHMARK_CAPTURE(Vector_Unary, normalized_refined, [](const Vector& v) { return v.normalized(Precision::Refined); });
+BENCHMARK_CAPTURE(Vector_Unary, normalized_exact, [](const Vector& v) { return v.normalized(Precision::Exact); });
+BENCHMARK_CAPTURE(Vector_Unary, manhattan_normal, [](const Vector& v) { return v.manhattan_normal(); });
+BENCHMARK_CAPTURE(Vector_Unary, infinite_normal, [](const Vector& v) { return v.infinite_normal(); });
+BENCHMARK_CAPTURE(Vector_Unary, angle, [](const Vector& v) { return v.angle(); });
+BENCHMARK_CAPTURE(Vector_Unary, homogeneous_position, [](const Vector& v) { return v.homogeneous_position(); });
+BENCHMARK_CAPTURE(Vector_Unary, homogeneous_direction, [](const Vector& v) { return v.homogeneous_direction(); });
+BENCHMARK_CAPTURE(Vector_Unary, xyz, [](const Vector& v) { return v.xyz(); });
+BENCHMARK_CAPTURE(Vector_Unary, is_zero, [](const Vector& v) { return v.is_zero(); });
+BENCHMARK_CAPTURE(Vector_Unary, operator_negate, [](const Vector& v) { return -v; });
+BENCHMARK_CAPTURE(Vector_Unary, operator_scale, [](const Vector& v) { return v * 3.0f; });
+BENCHMARK_CAPTURE(Vector_Unary, operator_descale, [](const Vector& v) { return v / 3.0f; });
+
+BENCHMARK_CAPTURE(Vector_Binary, distance_squared, [](const Vector& a, const Vector& b) { return a.distance_squared(b); });
+BENCHMARK_CAPTURE(Vector_Binary, distance, [](const Vector& a, const Vector& b) { return a.distance(b); });
+BENCHMARK_CAPTURE(Vector_Binary, perpendicular, [](const Vector& a, const Vector& b) { return a.perpendicular(b); });
+BENCHMARK_CAPTURE(Vector_Binary, same_direction, [](const Vector& a, const Vector& b) { return a.same_direction(b); });
+BENCHMARK_CAPTURE(Vector_Binary, angle_radians, [](const Vector& a, const Vector& b) { return a.angle_radians(b); });
+BENCHMARK_CAPTURE(Vector_Binary, angle_degrees, [](const Vector& a, const Vector& b) { return a.angle_degrees(b); });
+BENCHMARK_CAPTURE(Vector_Binary, lerp, [](const Vector& a, const Vector& b) { return a.lerp(b, 0.25); });
+BENCHMARK_CAPTURE(Vector_Binary, multiply, [](const Vector& a, const Vector& b) { return a.multiply(b); });
+BENCHMARK_CAPTURE(Vector_Binary, operator_equal, [](const Vector& a, const Vector& b) { return a == b; });
+BENCHMARK_CAPTURE(Vector_Binary, operator_less, [](const Vector& a, const Vector& b) { return a < b; });
+BENCHMARK_CAPTURE(Vector_Binary, operator_plus, [](const Vector& a, const Vector& b) { return a + b; });
+BENCHMARK_CAPTURE(Vector_Binary, operator_minus, [](const Vector& a, const Vector& b) { return a - b; });
+BENCHMARK_CAPTURE(Vector_Binary, operator_dot, [](const Vector& a, const Vector& b) { return a * b; });
+BENCHMARK_CAPTURE(Vector_Binary, operator_dot_array, [](const Vector& a, const Vector& b) { return a * b.xyz().array(); });
+BENCHMARK_CAPTURE(Vector_Binary, operator_cross, [](const Vector& a, const Vector& b) { return a ^ b; });
+
+// chained arithmetic, which should stay in registers from start to finish
+BENCHMARK_CAPTURE(Vector_Binary, chain_midpoint, [](const Vector& a, const Vector& b) { return (a + b) * 0.5f; });
+BENCHMARK_CAPTURE(Vector_Binary, chain_reflect, [](const Vector& a, const Vector& b) { return a - b * (2.0f * (a * b)); });
+BENCHMARK_CAPTURE(Vector_Binary, chain_mixed, [](const Vector& a, const Vector& b) { return ((a ^ b) * 0.25f + a.multiply(b) - b) / 3.0f; });
+
+BENCHMARK_CAPTURE(Vector_Assign, set_length, [](Vector& a, const Vector&) { a.set_length(2.0f); });
+BENCHMARK_CAPTURE(Vector_Assign, normalize, [](Vector& a, const Vector&) { a.normalize(); });
+BENCHMARK_CAPTURE(Vector_Assign, operator_plus_assign, [](Vector& a, const Vector& b) { a += b; });
+BENCHMARK_CAPTURE(Vector_Assign, operator_minus_assign, [](Vector& a, const Vector& b) { a -= b; });
+BENCHMARK_CAPTURE(Vector_Assign, operator_scale_assign, [](Vector& a, const Vector&) { a *= 3.0f; });
+BENCHMARK_CAPTURE(Vector_Assign, operator_descale_assign, [](Vector& a, const Vector&) { a /= 3.0f; });
+BENCHMARK_CAPTURE(Vector_Assign, operator_cross_assign, [](Vector& a, const Vector& b) { a ^= b; });
+
+} } }
@@ -0,0 +1,151 @@
+#include "pch.h"
+#include "Core.Benchmarks/Benchmarks.h"
+#include "Core/Concurrency/TaskScheduler.h"
+#include "Core/Math/VectorBatch.h"
+#include "Core/Math/VectorStream.h"
+
+namespace energonsoftware {
+namespace math {
+namespace benchmarks {
+
+using energonsoftware::benchmarks::ScopedSimdLevel;
+using energonsoftware::benchmarks::batch_sizes;
+using energonsoftware::benchmarks::set_elements_processed;
+using energonsoftware::benchmarks::simd_batch_sizes;
+using energonsoftware::benchmarks::test_vectors;
+
+// single-element vs batch throughput
+// Batch_Loop calls the Vector API once per element (the baseline)
+// Batch_Kernel runs the batch API for the same work on each SIMD tier
+
+template<typename Op>
+static void Batch_Loop(benchmark::State& state, Op op)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    const std::vector<Vector> a = test_vectors(count, 1);
+    const std::vector<Vector> b = test_vectors(count, 2);
+    std::vector<decltype(op(a[0], b[0]))> r(count);
+
+    for(auto _ : state) {
+        for(size_t i = 0; i < count; ++i) {
+            r[i] = op(a[i], b[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, count);
+}
+
+// result only carries the output element type
+template<typename R, typename Op>
+static void Batch_Kernel(benchmark::State& state, R, Op op)
+{
+    ScopedSimdLevel simd(state);
+    const size_t count = static_cast<size_t>(state.range(1));
+    const std::vector<Vector> a = test_vectors(count, 1);
+    const std::vector<Vector> b = test_vectors(count, 2);
+    std::vector<R> r(count);
+
+    for(auto _ : state) {
+        op(a.data(), b.data(), r.data(), count);
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, count);
+}
+
+static const Matrix4 TestMatrix = Matrix4::translation(Vector(1.0f, 2.0f, 3.0f)) * Matrix4::rotation(Vector(1.0f, 1.0f, 0.0f), 0.5f);
+static const Quaternion TestQuaternion = Quaternion::axis_angle(Vector(1.0f, 1.0f, 0.0f), 0.5f);
+
+BENCHMARK_CAPTURE(Batch_Loop, multiply, [](const Vector& a, const Vector& b) { return a.multiply(b); })->Apply(batch_sizes);
+BENCHMARK_CAPTURE(Batch_Kernel, multiply, Vector(), [](const Vector* a, const Vector* b, Vector* r, size_t n) { batch::multiply(a, b, r, n); })->Apply(simd_batch_sizes);
+
+BENCHMARK_CAPTURE(Batch_Loop, dot, [](const Vector& a, const Vector& b) { return a * b; })->Apply(batch_sizes);
+BENCHMARK_CAPTURE(Batch_Kernel, dot, float(), [](const Vector* a, const Vector* b, float* r, size_t n) { batch::dot(a, b, r, n); })->Apply(simd_batch_sizes);
+
+BENCHMARK_CAPTURE(Batch_Loop, cross, [](const Vector& a, const Vector& b) { return a ^ b; })->Apply(batch_sizes);
+BENCHMARK_CAPTURE(Batch_Kernel, cross, Vector(), [](const Vector* a, const Vector* b, Vector* r, size_t n) { batch::cross(a, b, r, n); })->Apply(simd_batch_sizes);
+
+BENCHMARK_CAPTURE(Batch_Loop, length, [](const Vector& a, const Vector&) { return a.length(); })->Apply(batch_sizes);
+BENCHMARK_CAPTURE(Batch_Kernel, length, float(), [](const Vector* a, const Vector*, float* r, size_t n) { batch::length(a, r, n); })->Apply(simd_batch_sizes);
+
+BENCHMARK_CAPTURE(Batch_Loop, normalize, [](const Vector& a, const Vector&) { return a.normalized(); })->Apply(batch_sizes);
+BENCHMARK_CAPTURE(Batch_Kernel, normalize, Vector(), [](const Vector* a, const Vector*, Vector* r, size_t n) { batch::normalize(a, r, n); })->Apply(simd_batch_sizes);
+
+BENCHMARK_CAPTURE(Batch_Loop, angle, [](const Vector& a, const Vector&) { return a.angle(); })->Apply(batch_sizes);
+BENCHMARK_CAPTURE(Batch_Kernel, angle, float(), [](const Vector* a, const Vector*, float* r, size_t n) { batch::angle(a, r, n); })->Apply(simd_batch_sizes);
+
+BENCHMARK_CAPTURE(Batch_Loop, angle_radians, [](const Vector& a, const Vector& b) { return a.angle_radians(b); })->Apply(batch_sizes);
+BENCHMARK_CAPTURE(Batch_Kernel, angle_radians, float(), [](const Vector* a, const Vector* b, float* r, size_t n) { batch::angle_radians(a, b, r, n); })->Apply(simd_batch_sizes);
+
+BENCHMARK_CAPTURE(Batch_Loop, transform_points, [](const Vector& a, const Vector&) { return TestMatrix.transform_point(a); })->Apply(batch_sizes);
+BENCHMARK_CAPTURE(Batch_Kernel, transform_points, Vector(), [](const Vector* a, const Vector*, Vector* r, size_t n) { batch::transform_points(TestMatrix, a, r, n); })->Apply(simd_batch_sizes);
+
+BENCHMARK_CAPTURE(Batch_Loop, rotate, [](const Vector& a, const Vector&) { return TestQuaternion.rotate(a); })->Apply(batch_sizes);
+BENCHMARK_CAPTURE(Batch_Kernel, rotate, Vector(), [](const Vector* a, const Vector*, Vector* r, size_t n) { batch::rotate(TestQuaternion, a, r, n); })->Apply(simd_batch_sizes);
+
+// structure-of-arrays versions of the same operations
+template<typename Op>
+static void Batch_Stream(benchmark::State& state, Op op)
+{
+    ScopedSimdLevel simd(state);
+    const size_t count = static_cast<size_t>(state.range(1));
+    const std::vector<Vector> a = test_vectors(count, 1);
+    const std::vector<Vector> b = test_vectors(count, 2);
+    const VectorStream sa(a.data(), count);
+    const VectorStream sb(b.data(), count);
+    VectorStream sr(count);
+    std::vector<float> r(count);
+
+    for(auto _ : state) {
+        op(sa, sb, sr, r.data());
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, count);
+}
+
+BENCHMARK_CAPTURE(Batch_Stream, add, [](const VectorStream& a, const VectorStream& b, VectorStream& r, float*) { r = a; r += b; })->Apply(simd_batch_sizes);
+BENCHMARK_CAPTURE(Batch_Stream, multiply, [](const VectorStream& a, const VectorStream& b, VectorStream& r, float*) { a.multiply(b, r); })->Apply(simd_batch_sizes);
+BENCHMARK_CAPTURE(Batch_Stream, dot, [](const VectorStream& a, const VectorStream& b, VectorStream&, float* r) { a.dot(b, r); })->Apply(simd_batch_sizes);
+BENCHMARK_CAPTURE(Batch_Stream, cross, [](const VectorStream& a, const VectorStream& b, VectorStream& r, float*) { a.cross(b, r); })->Apply(simd_batch_sizes);
+BENCHMARK_CAPTURE(Batch_Stream, length, [](const VectorStream& a, const VectorStream&, VectorStream&, float* r) { a.length(r); })->Apply(simd_batch_sizes);
+BENCHMARK_CAPTURE(Batch_Stream, normalize, [](const VectorStream& a, const VectorStream&, VectorStream& r, float*) { a.normalized(r); })->Apply(simd_batch_sizes);
+BENCHMARK_CAPTURE(Batch_Stream, distance, [](const VectorStream& a, const VectorStream& b, VectorStream&, float* r) { a.distance(b, r); })->Apply(simd_batch_sizes);
+BENCHMARK_CAPTURE(Batch_Stream, lerp, [](const VectorStream& a, const VectorStream& b, VectorStream& r, float*) { a.lerp(b, 0.25f, r); })->Apply(simd_batch_sizes);
+
+// the TaskScheduler overloads, range(0) is the thread count (0 is every hardware thread)
+// threads = 1 runs the same chunks on the calling thread, so it measures the chunking overhead
+template<typename R, typename Op>
+static void Batch_Parallel(benchmark::State& state, R, Op op)
+{
+    concurrency::TaskScheduler scheduler(static_cast<size_t>(state.range(0)));
+    const size_t count = static_cast<size_t>(state.range(1));
+    const std::vector<Vector> a = test_vectors(count, 1);
+    const std::vector<Vector> b = test_vectors(count, 2);
+    std::vector<R> r(count);
+
+    for(auto _ : state) {
+        op(scheduler, a.data(), b.data(), r.data(), count);
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, count);
+}
+
+static void parallel_sizes(benchmark::internal::Benchmark* const b)
+{
+    // the work runs on other threads, so cpu time of the calling thread would under-report it
+    b->ArgNames({ "threads", "count" })->ArgsProduct({ { 1, 2, 4, 0 }, { 1 << 14, 1 << 20 } })->UseRealTime();
+}
+
+BENCHMARK_CAPTURE(Batch_Kernel, sum, Vector(), [](const Vector* a, const Vector*, Vector* r, size_t n) { r[0] = batch::sum(a, n); })->Apply(simd_batch_sizes);
+BENCHMARK_CAPTURE(Batch_Kernel, bounds, Vector(), [](const Vector* a, const Vector*, Vector* r, size_t n) { r[0] = batch::bounds(a, n).minimum(); })->Apply(simd_batch_sizes);
+
+BENCHMARK_CAPTURE(Batch_Parallel, transform_points, Vector(), [](concurrency::TaskScheduler& s, const Vector* a, const Vector*, Vector* r, size_t n) { batch::transform_points(s, TestMatrix, a, r, n); })->Apply(parallel_sizes);
+BENCHMARK_CAPTURE(Batch_Parallel, normalize, Vector(), [](concurrency::TaskScheduler& s, const Vector* a, const Vector*, Vector* r, size_t n) { batch::normalize(s, a, r, n); })->Apply(parallel_sizes);
+BENCHMARK_CAPTURE(Batch_Parallel, sum, Vector(), [](concurrency::TaskScheduler& s, const Vector* a, const Vector*, Vector* r, size_t n) { r[0] = batch::sum(s, a, n); })->Apply(parallel_sizes);
+BENCHMARK_CAPTURE(Batch_Parallel, dot_sum, float(), [](concurrency::TaskScheduler& s, const Vector* a, const Vector* b, float* r, size_t n) { r[0] = batch::dot_sum(s, a, b, n); })->Apply(parallel_sizes);
+BENCHMARK_CAPTURE(Batch_Parallel, bounds, Vector(), [](concurrency::TaskScheduler& s, const Vector* a, const Vector*, Vector* r, size_t n) { r[0] = batch::bounds(s, a, n).minimum(); })->Apply(parallel_sizes);
+
+} } }
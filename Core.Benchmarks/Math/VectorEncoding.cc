@@ -0,0 +1,107 @@
+#include "pch.h"
+#include "Core.Benchmarks/Benchmarks.h"
+#include "Core/Math/VectorEncoding.h"
+
+namespace energonsoftware {
+namespace math {
+namespace benchmarks {
+
+using energonsoftware::benchmarks::ScopedSimdLevel;
+using energonsoftware::benchmarks::batch_sizes;
+using energonsoftware::benchmarks::set_elements_processed;
+using energonsoftware::benchmarks::simd_batch_sizes;
+
+// one Vector at a time with the C++ standard library vs the encoding batch API
+// Encode_Loop is the baseline for the matching Encode_Kernel on each SIMD tier
+
+static void test_input(Vector* const a, size_t count)
+{
+    Random(1).unit_vectors(a, count);
+}
+
+static void test_input(OctahedralNormal* const a, size_t count)
+{
+    std::vector<Vector> normals(count);
+    test_input(normals.data(), count);
+    batch::encode_octahedral(normals.data(), a, count);
+}
+
+static float sign_not_zero(float v)
+{
+    return v < 0.0f ? -1.0f : 1.0f;
+}
+
+static uint16_t snorm16(float v)
+{
+    return static_cast<uint16_t>(std::lrint(std::min(std::max(v, -1.0f), 1.0f) * 32767.0f));
+}
+
+static OctahedralNormal octahedral(const Vector& n)
+{
+    const float l1 = std::fabs(n.x()) + std::fabs(n.y()) + std::fabs(n.z());
+    float x = n.x() / l1, y = n.y() / l1;
+    if(n.z() < 0.0f) {
+        const float fx = (1.0f - std::fabs(y)) * sign_not_zero(x);
+        y = (1.0f - std::fabs(x)) * sign_not_zero(y);
+        x = fx;
+    }
+    return { snorm16(x), snorm16(y) };
+}
+
+static Normal3 from_octahedral(const OctahedralNormal& n)
+{
+    float x = std::max(static_cast<int16_t>(n.x) / 32767.0f, -1.0f);
+    float y = std::max(static_cast<int16_t>(n.y) / 32767.0f, -1.0f);
+    const float z = 1.0f - std::fabs(x) - std::fabs(y);
+    const float t = std::max(-z, 0.0f);
+    x -= std::copysign(t, x);
+    y -= std::copysign(t, y);
+    return Vector(x, y, z).normalized();
+}
+
+// a and result only carry the input and output element types
+template<typename A, typename R, typename Op>
+static void Encode_Loop(benchmark::State& state, A, R, Op op)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    std::vector<A> a(count);
+    test_input(a.data(), count);
+    std::vector<R> r(count);
+
+    for(auto _ : state) {
+        for(size_t i = 0; i < count; ++i) {
+            r[i] = op(a[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, count);
+}
+
+template<typename A, typename R, typename Op>
+static void Encode_Kernel(benchmark::State& state, A, R, Op op)
+{
+    ScopedSimdLevel simd(state);
+    const size_t count = static_cast<size_t>(state.range(1));
+    std::vector<A> a(count);
+    test_input(a.data(), count);
+    std::vector<R> r(count);
+
+    for(auto _ : state) {
+        op(a.data(), r.data(), count);
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, count);
+}
+
+BENCHMARK_CAPTURE(Encode_Loop, encode_octahedral, Vector(), OctahedralNormal(), [](const Vector& a) { return octahedral(a); })->Apply(batch_sizes);
+BENCHMARK_CAPTURE(Encode_Kernel, encode_octahedral, Vector(), OctahedralNormal(), [](const Vector* a, OctahedralNormal* r, size_t n) { batch::encode_octahedral(a, r, n); })->Apply(simd_batch_sizes);
+
+BENCHMARK_CAPTURE(Encode_Loop, decode_octahedral, OctahedralNormal(), Normal3(), [](const OctahedralNormal& a) { return from_octahedral(a); })->Apply(batch_sizes);
+BENCHMARK_CAPTURE(Encode_Kernel, decode_octahedral, OctahedralNormal(), Normal3(), [](const OctahedralNormal* a, Normal3* r, size_t n) { batch::decode_octahedral(a, r, n); })->Apply(simd_batch_sizes);
+
+BENCHMARK_CAPTURE(Encode_Kernel, encode_half, Vector(), HalfVector(), [](const Vector* a, HalfVector* r, size_t n) { batch::encode_half(a, r, n); })->Apply(simd_batch_sizes);
+BENCHMARK_CAPTURE(Encode_Kernel, encode_bfloat16, Vector(), BFloat16Vector(), [](const Vector* a, BFloat16Vector* r, size_t n) { batch::encode_bfloat16(a, r, n); })->Apply(simd_batch_sizes);
+
+} } }
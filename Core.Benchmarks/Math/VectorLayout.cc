@@ -0,0 +1,49 @@
+#include "pch.h"
+#include <benchmark/benchmark.h>
+#include "Core/Math/PolymorphicVector.h"
+
+namespace energonsoftware {
+namespace math {
+namespace benchmarks {
+
+// compares bulk traversal of the packed 16-byte Vector
+// against the old 32-byte layout (modelled by PolymorphicVector)
+template<typename T>
+static void VectorLayout_Sum(benchmark::State& state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    std::vector<T> points(count, T(1.0f, 2.0f, 3.0f, 0.0f));
+
+    for(auto _ : state) {
+        Vector sum;
+        for(const T& point : points) {
+            sum += point;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+    state.SetBytesProcessed(state.iterations() * count * sizeof(T));
+}
+BENCHMARK_TEMPLATE(VectorLayout_Sum, Vector)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(VectorLayout_Sum, PolymorphicVector)->Range(1 << 10, 1 << 22);
+
+template<typename T>
+static void VectorLayout_Copy(benchmark::State& state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    std::vector<T> src(count, T(1.0f, 2.0f, 3.0f, 0.0f));
+    std::vector<T> dst(count);
+
+    for(auto _ : state) {
+        std::copy(src.begin(), src.end(), dst.begin());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+    state.SetBytesProcessed(state.iterations() * count * sizeof(T));
+}
+BENCHMARK_TEMPLATE(VectorLayout_Copy, Vector)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(VectorLayout_Copy, PolymorphicVector)->Range(1 << 10, 1 << 22);
+
+} } }
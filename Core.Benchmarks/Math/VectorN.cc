@@ -0,0 +1,89 @@
+#include "pch.h"
+#include "Core.Benchmarks/Benchmarks.h"
+#include "Core/Math/VectorN.h"
+
+namespace energonsoftware {
+namespace math {
+namespace benchmarks {
+
+using energonsoftware::benchmarks::ElementCount;
+using energonsoftware::benchmarks::set_elements_processed;
+using energonsoftware::benchmarks::test_vectors;
+
+// 2D and 3D work done with the always-4-wide Vector
+// against the same work done with VectorN of the real dimension
+// (the Vector benchmarks use the same zero-padded inputs)
+
+template<typename T>
+static std::vector<T> test_points(size_t dimensions, uint64_t seed)
+{
+    std::vector<T> points;
+    for(const Vector& v : test_vectors(ElementCount, seed)) {
+        points.emplace_back(2 == dimensions ? v.xy() : v.xyz());
+    }
+    return points;
+}
+
+template<typename T>
+static void VectorN_dot(benchmark::State& state)
+{
+    const std::vector<T> a = test_points<T>(state.range(0), 1);
+    const std::vector<T> b = test_points<T>(state.range(0), 2);
+    std::vector<float> r(a.size());
+
+    for(auto _ : state) {
+        for(size_t i = 0; i < a.size(); ++i) {
+            r[i] = a[i] * b[i];
+        }
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, a.size());
+}
+
+template<typename T>
+static void VectorN_length(benchmark::State& state)
+{
+    const std::vector<T> a = test_points<T>(state.range(0), 1);
+    std::vector<float> r(a.size());
+
+    for(auto _ : state) {
+        for(size_t i = 0; i < a.size(); ++i) {
+            r[i] = a[i].length();
+        }
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, a.size());
+}
+
+template<typename T>
+static void VectorN_add(benchmark::State& state)
+{
+    const std::vector<T> a = test_points<T>(state.range(0), 1);
+    const std::vector<T> b = test_points<T>(state.range(0), 2);
+    std::vector<T> r(a.size());
+
+    for(auto _ : state) {
+        for(size_t i = 0; i < a.size(); ++i) {
+            r[i] = a[i] + b[i];
+        }
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, a.size());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * a.size() * 3 * sizeof(T)));
+}
+
+// range(0) is the dimension that the points actually have
+BENCHMARK_TEMPLATE(VectorN_dot, Vector)->Arg(2)->Arg(3);
+BENCHMARK_TEMPLATE(VectorN_dot, Vector2f)->Arg(2);
+BENCHMARK_TEMPLATE(VectorN_dot, Vector3f)->Arg(3);
+BENCHMARK_TEMPLATE(VectorN_length, Vector)->Arg(2)->Arg(3);
+BENCHMARK_TEMPLATE(VectorN_length, Vector2f)->Arg(2);
+BENCHMARK_TEMPLATE(VectorN_length, Vector3f)->Arg(3);
+BENCHMARK_TEMPLATE(VectorN_add, Vector)->Arg(2)->Arg(3);
+BENCHMARK_TEMPLATE(VectorN_add, Vector2f)->Arg(2);
+BENCHMARK_TEMPLATE(VectorN_add, Vector3f)->Arg(3);
+
+} } }
@@ -0,0 +1,125 @@
+#include "pch.h"
+#include <cstdio>
+#include <cstdlib>
+#include "Core.Benchmarks/Benchmarks.h"
+#include "Core/Math/VectorText.h"
+
+namespace energonsoftware {
+namespace math {
+namespace benchmarks {
+
+using energonsoftware::benchmarks::ElementCount;
+using energonsoftware::benchmarks::set_elements_processed;
+using energonsoftware::benchmarks::test_vectors;
+
+// the C++ and C library formatting and parsing vs the allocation-free VectorText API
+// Text_Stream and Text_Printf are the baselines for the matching Text_Chars benchmarks
+
+static std::string vector_lines(const std::vector<Vector>& vectors)
+{
+    std::vector<char> text(vectors.size() * (4 * MaxFloatChars + 4));
+    const FormatVectorsResult result = format_vectors(text.data(), text.data() + text.size(), vectors.data(), vectors.size());
+    return std::string(text.data(), result.ptr);
+}
+
+// what Vector::str() used to do
+static void Text_Stream_str(benchmark::State& state)
+{
+    const std::vector<Vector> vectors = test_vectors(ElementCount, 1);
+
+    for(auto _ : state) {
+        for(const Vector& v : vectors) {
+            std::stringstream ss;
+            ss << "Vector(x:" << std::fixed << v.x() << ", y:" << v.y() << ", z:" << v.z() << ", w:" << v.w() << ")";
+            benchmark::DoNotOptimize(ss.str());
+        }
+    }
+
+    set_elements_processed(state, vectors.size());
+}
+
+static void Text_Chars_str(benchmark::State& state)
+{
+    const std::vector<Vector> vectors = test_vectors(ElementCount, 1);
+
+    for(auto _ : state) {
+        for(const Vector& v : vectors) {
+            benchmark::DoNotOptimize(v.str());
+        }
+    }
+
+    set_elements_processed(state, vectors.size());
+}
+
+// "x y z w" lines with the shortest text that round trips
+static void Text_Printf_format(benchmark::State& state)
+{
+    const std::vector<Vector> vectors = test_vectors(ElementCount, 1);
+    std::vector<char> text(vectors.size() * (4 * MaxFloatChars + 4));
+
+    for(auto _ : state) {
+        char* p = text.data();
+        for(const Vector& v : vectors) {
+            p += std::sprintf(p, "%.9g %.9g %.9g %.9g\n", v.x(), v.y(), v.z(), v.w());
+        }
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, vectors.size());
+}
+
+static void Text_Chars_format(benchmark::State& state)
+{
+    const std::vector<Vector> vectors = test_vectors(ElementCount, 1);
+    std::vector<char> text(vectors.size() * (4 * MaxFloatChars + 4));
+
+    for(auto _ : state) {
+        format_vectors(text.data(), text.data() + text.size(), vectors.data(), vectors.size());
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, vectors.size());
+}
+
+static void Text_Printf_parse(benchmark::State& state)
+{
+    const std::vector<Vector> vectors = test_vectors(ElementCount, 1);
+    const std::string text = vector_lines(vectors);
+    std::vector<Vector> r(vectors.size());
+
+    for(auto _ : state) {
+        char* p = const_cast<char*>(text.c_str());
+        for(Vector& v : r) {
+            const float x = std::strtof(p, &p);
+            const float y = std::strtof(p, &p);
+            const float z = std::strtof(p, &p);
+            v = Vector(x, y, z, std::strtof(p, &p));
+        }
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, vectors.size());
+}
+
+static void Text_Chars_parse(benchmark::State& state)
+{
+    const std::vector<Vector> vectors = test_vectors(ElementCount, 1);
+    const std::string text = vector_lines(vectors);
+    std::vector<Vector> r(vectors.size());
+
+    for(auto _ : state) {
+        parse_vectors(text.data(), text.data() + text.length(), r.data(), r.size());
+        benchmark::ClobberMemory();
+    }
+
+    set_elements_processed(state, vectors.size());
+}
+
+BENCHMARK(Text_Stream_str);
+BENCHMARK(Text_Chars_str);
+BENCHMARK(Text_Printf_format);
+BENCHMARK(Text_Chars_format);
+BENCHMARK(Text_Printf_parse);
+BENCHMARK(Text_Chars_parse);
+
+} } }
@@ -0,0 +1,101 @@
+#include "pch.h"
+#include <list>
+#include "Core.Benchmarks/Benchmarks.h"
+#include "Core/Math/Vector.h"
+#include "Core/Memory/AlignedAllocator.h"
+#include "Core/Memory/Arena.h"
+#include "Core/Memory/Pool.h"
+
+namespace energonsoftware {
+namespace memory {
+namespace benchmarks {
+
+using energonsoftware::benchmarks::set_elements_processed;
+using math::Vector;
+
+// a frame's worth of temporary arrays (range(0) of them, 16 to 4096 Vectors each)
+// from the system allocator vs from an Arena that's reset every frame
+
+static size_t temporary_size(size_t i)
+{
+    return 16 << (i % 9);
+}
+
+static void Alloc_Frame_System(benchmark::State& state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    std::vector<Vector*> arrays(count);
+
+    for(auto _ : state) {
+        for(size_t i = 0; i < count; ++i) {
+            arrays[i] = static_cast<Vector*>(aligned_allocate(temporary_size(i) * sizeof(Vector), alignof(Vector)));
+            benchmark::DoNotOptimize(arrays[i]);
+        }
+        for(Vector* array : arrays) {
+            aligned_deallocate(array);
+        }
+    }
+
+    set_elements_processed(state, count);
+}
+
+static void Alloc_Frame_Arena(benchmark::State& state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    Arena arena;
+
+    for(auto _ : state) {
+        arena.reset();
+        for(size_t i = 0; i < count; ++i) {
+            benchmark::DoNotOptimize(arena.allocate_array<Vector>(temporary_size(i)));
+        }
+    }
+
+    set_elements_processed(state, count);
+}
+
+// building and tearing down a std::list of range(0) Vectors
+// with the standard allocator vs a PoolAllocator
+
+template<typename List>
+static void build_list(List& list, size_t count)
+{
+    for(size_t i = 0; i < count; ++i) {
+        list.emplace_back(static_cast<float>(i), 0.0f, 0.0f);
+    }
+    benchmark::DoNotOptimize(list.back());
+}
+
+static void Alloc_List_System(benchmark::State& state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+
+    for(auto _ : state) {
+        std::list<Vector, AlignedAllocator<Vector>> list;
+        build_list(list, count);
+    }
+
+    set_elements_processed(state, count);
+}
+
+static void Alloc_List_Pool(benchmark::State& state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    // a list node is the Vector and two links
+    Pool pool(sizeof(Vector) + 2 * sizeof(void*), alignof(Vector));
+
+    for(auto _ : state) {
+        std::list<Vector, PoolAllocator<Vector>> list((PoolAllocator<Vector>(pool)));
+        build_list(list, count);
+    }
+
+    set_elements_processed(state, count);
+}
+
+BENCHMARK(Alloc_Frame_System)->ArgName("count")->Arg(64)->Arg(1024);
+BENCHMARK(Alloc_Frame_Arena)->ArgName("count")->Arg(64)->Arg(1024);
+
+BENCHMARK(Alloc_List_System)->ArgName("count")->Arg(64)->Arg(4096);
+BENCHMARK(Alloc_List_Pool)->ArgName("count")->Arg(64)->Arg(4096);
+
+} } }
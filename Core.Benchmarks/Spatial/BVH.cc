@@ -0,0 +1,151 @@
+#include "pch.h"
+#include "Core.Benchmarks/Benchmarks.h"
+#include "Core/Spatial/BVH.h"
+
+namespace energonsoftware {
+namespace spatial {
+namespace benchmarks {
+
+using energonsoftware::benchmarks::ElementCount;
+using energonsoftware::benchmarks::SpatialQueryRadius;
+using energonsoftware::benchmarks::set_elements_processed;
+using energonsoftware::benchmarks::test_points;
+
+// unit boxes around the spatial index test points
+static std::vector<AABB> test_boxes(size_t count)
+{
+    const std::vector<Vector> points = test_points(count, 1);
+
+    std::vector<AABB> boxes;
+    boxes.reserve(count);
+    for(const Vector& point : points) {
+        boxes.push_back(AABB::from_center(point, Vector(0.5f, 0.5f, 0.5f)));
+    }
+    return boxes;
+}
+
+// ElementCount rays from random points in random directions
+struct TestRays
+{
+    std::vector<Vector> origins;
+    std::vector<Vector> directions;
+
+    explicit TestRays(const AABB& bounds)
+        : origins(ElementCount), directions(ElementCount)
+    {
+        math::Random random(2);
+        random.in_box(origins.data(), ElementCount, bounds.minimum(), bounds.maximum());
+        random.unit_vectors(directions.data(), ElementCount);
+    }
+};
+
+// range(1) is the number of threads
+static void BVH_Build(benchmark::State& state)
+{
+    const std::vector<AABB> boxes = test_boxes(state.range(0));
+    BVH bvh;
+
+    for(auto _ : state) {
+        bvh.build(boxes.data(), boxes.size(), state.range(1));
+        benchmark::DoNotOptimize(bvh.node_count());
+    }
+
+    set_elements_processed(state, boxes.size());
+}
+
+// the O(n) per ray baseline
+static void BVH_BruteForceRay(benchmark::State& state)
+{
+    const std::vector<AABB> boxes = test_boxes(state.range(0));
+    const TestRays rays(AABB::from_points(test_points(state.range(0), 1).data(), state.range(0)));
+
+    for(auto _ : state) {
+        for(size_t r = 0; r < ElementCount; ++r) {
+            const Vector& d = rays.directions[r];
+            const Vector inv_direction(1.0f / d.x(), 1.0f / d.y(), 1.0f / d.z());
+
+            BVH::Index hit = BVH::InvalidIndex;
+            float nearest = std::numeric_limits<float>::infinity();
+            for(size_t i = 0; i < boxes.size(); ++i) {
+                float t;
+                if(boxes[i].intersect_ray(rays.origins[r], inv_direction, 0.0f, nearest, t)) {
+                    hit = static_cast<BVH::Index>(i);
+                    nearest = t;
+                }
+            }
+            benchmark::DoNotOptimize(hit);
+        }
+    }
+
+    set_elements_processed(state, ElementCount);
+}
+
+// closest hit
+static void BVH_Ray(benchmark::State& state)
+{
+    const std::vector<AABB> boxes = test_boxes(state.range(0));
+    const BVH bvh(boxes.data(), boxes.size());
+    const TestRays rays(bvh.bounds());
+
+    for(auto _ : state) {
+        for(size_t r = 0; r < ElementCount; ++r) {
+            float t = std::numeric_limits<float>::infinity();
+            benchmark::DoNotOptimize(bvh.cast_ray(rays.origins[r], rays.directions[r], t));
+        }
+    }
+
+    set_elements_processed(state, ElementCount);
+}
+
+// every box within SpatialQueryRadius (per axis) of a box center
+static void BVH_Overlap(benchmark::State& state)
+{
+    const std::vector<AABB> boxes = test_boxes(state.range(0));
+    const BVH bvh(boxes.data(), boxes.size());
+    std::vector<BVH::Index> found;
+
+    for(auto _ : state) {
+        for(size_t i = 0; i < ElementCount; ++i) {
+            found.clear();
+            bvh.query_overlap(AABB::from_center(boxes[i].center(), Vector(SpatialQueryRadius, SpatialQueryRadius, SpatialQueryRadius)), found);
+            benchmark::DoNotOptimize(found.data());
+        }
+    }
+
+    set_elements_processed(state, ElementCount);
+}
+
+// a 90 degree frustum from the center of the boxes looking down -z
+// out to the edge, about a 12th of them
+static void BVH_Frustum(benchmark::State& state)
+{
+    const std::vector<AABB> boxes = test_boxes(state.range(0));
+    const BVH bvh(boxes.data(), boxes.size());
+
+    const float s = std::sqrt(0.5f);
+    const Vector planes[] = {
+        Vector(0.0f, 0.0f, -1.0f, -1.0f),
+        Vector(0.0f, 0.0f, 1.0f, -bvh.bounds().minimum().z()),
+        Vector(s, 0.0f, -s, 0.0f),
+        Vector(-s, 0.0f, -s, 0.0f),
+        Vector(0.0f, s, -s, 0.0f),
+        Vector(0.0f, -s, -s, 0.0f),
+    };
+    std::vector<BVH::Index> found;
+
+    for(auto _ : state) {
+        found.clear();
+        bvh.query_frustum(planes, 6, found);
+        benchmark::DoNotOptimize(found.data());
+    }
+
+    set_elements_processed(state, boxes.size());
+}
+
+BENCHMARK(BVH_Build)->ArgNames({ "count", "threads" })->ArgsProduct({ { 1 << 16, 1 << 20 }, { 1, 0 } })->Unit(benchmark::kMillisecond);
+BENCHMARK(BVH_BruteForceRay)->ArgName("count")->Arg(1 << 12)->Arg(1 << 16)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BVH_Ray)->ArgName("count")->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BVH_Overlap)->ArgName("count")->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BVH_Frustum)->ArgName("count")->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMicrosecond);
+
+} } }
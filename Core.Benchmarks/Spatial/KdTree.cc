@@ -0,0 +1,61 @@
+#include "pch.h"
+#include "Core.Benchmarks/Benchmarks.h"
+#include "Core/Spatial/KdTree.h"
+
+namespace energonsoftware {
+namespace spatial {
+namespace benchmarks {
+
+using energonsoftware::benchmarks::SpatialQueryRadius;
+using energonsoftware::benchmarks::set_elements_processed;
+using energonsoftware::benchmarks::test_points;
+
+// the same points and queries as the SpatialHashGrid benchmarks
+
+// range(1) is the number of threads
+static void KdTree_Build(benchmark::State& state)
+{
+    const std::vector<Vector> points = test_points(state.range(0), 1);
+    KdTree tree;
+
+    for(auto _ : state) {
+        tree.build(points.data(), points.size(), state.range(1));
+        benchmark::DoNotOptimize(tree.node_count());
+    }
+
+    set_elements_processed(state, points.size());
+}
+
+static void KdTree_Radius(benchmark::State& state)
+{
+    const std::vector<Vector> points = test_points(state.range(0), 1);
+    const KdTree tree(points.data(), points.size());
+    QueryResults results;
+
+    for(auto _ : state) {
+        tree.query_radius(points.data(), points.size(), SpatialQueryRadius, results);
+        benchmark::DoNotOptimize(results.ids.data());
+    }
+
+    set_elements_processed(state, points.size());
+}
+
+static void KdTree_Nearest(benchmark::State& state)
+{
+    const std::vector<Vector> points = test_points(state.range(0), 1);
+    const KdTree tree(points.data(), points.size());
+    QueryResults results;
+
+    for(auto _ : state) {
+        tree.query_nearest(points.data(), points.size(), 8, results);
+        benchmark::DoNotOptimize(results.ids.data());
+    }
+
+    set_elements_processed(state, points.size());
+}
+
+BENCHMARK(KdTree_Build)->ArgNames({ "count", "threads" })->ArgsProduct({ { 1 << 14, 1 << 20 }, { 1, 0 } })->Unit(benchmark::kMicrosecond);
+BENCHMARK(KdTree_Radius)->ArgName("count")->Arg(1 << 12)->Arg(1 << 14)->Arg(1 << 17)->Unit(benchmark::kMicrosecond);
+BENCHMARK(KdTree_Nearest)->ArgName("count")->Arg(1 << 12)->Arg(1 << 14)->Arg(1 << 17)->Unit(benchmark::kMicrosecond);
+
+} } }
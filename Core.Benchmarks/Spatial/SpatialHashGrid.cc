@@ -0,0 +1,100 @@
+#include "pch.h"
+#include "Core.Benchmarks/Benchmarks.h"
+#include "Core/Spatial/SpatialHashGrid.h"
+
+namespace energonsoftware {
+namespace spatial {
+namespace benchmarks {
+
+using energonsoftware::benchmarks::SpatialQueryRadius;
+using energonsoftware::benchmarks::set_elements_processed;
+using energonsoftware::benchmarks::test_points;
+
+// every point queries its own neighborhood, as in a per-tick proximity pass
+
+static SpatialHashGrid test_grid(const std::vector<Vector>& points)
+{
+    SpatialHashGrid grid(SpatialQueryRadius);
+    grid.reserve(points.size());
+    for(const Vector& point : points) {
+        grid.insert(point);
+    }
+    return grid;
+}
+
+// the O(n^2) baseline
+static void SpatialHashGrid_BruteForceRadius(benchmark::State& state)
+{
+    const std::vector<Vector> points = test_points(state.range(0), 1);
+    QueryResults results;
+
+    for(auto _ : state) {
+        results.clear();
+        results.offsets.push_back(0);
+        for(const Vector& center : points) {
+            for(size_t i = 0; i < points.size(); ++i) {
+                if(center.distance_squared(points[i]) <= SpatialQueryRadius * SpatialQueryRadius) {
+                    results.ids.push_back(static_cast<SpatialHashGrid::Id>(i));
+                }
+            }
+            results.offsets.push_back(results.ids.size());
+        }
+        benchmark::DoNotOptimize(results.ids.data());
+    }
+
+    set_elements_processed(state, points.size());
+}
+
+static void SpatialHashGrid_Radius(benchmark::State& state)
+{
+    const std::vector<Vector> points = test_points(state.range(0), 1);
+    const SpatialHashGrid grid = test_grid(points);
+    QueryResults results;
+
+    for(auto _ : state) {
+        grid.query_radius(points.data(), points.size(), SpatialQueryRadius, results);
+        benchmark::DoNotOptimize(results.ids.data());
+    }
+
+    set_elements_processed(state, points.size());
+}
+
+static void SpatialHashGrid_Nearest(benchmark::State& state)
+{
+    const std::vector<Vector> points = test_points(state.range(0), 1);
+    const SpatialHashGrid grid = test_grid(points);
+    QueryResults results;
+
+    for(auto _ : state) {
+        grid.query_nearest(points.data(), points.size(), 8, results);
+        benchmark::DoNotOptimize(results.ids.data());
+    }
+
+    set_elements_processed(state, points.size());
+}
+
+// every point moves a little (some change cells) each iteration
+static void SpatialHashGrid_Move(benchmark::State& state)
+{
+    std::vector<Vector> points = test_points(state.range(0), 1);
+    const std::vector<Vector> velocities = energonsoftware::benchmarks::test_vectors(points.size(), 2);
+    SpatialHashGrid grid = test_grid(points);
+
+    float direction = 0.001f;
+    for(auto _ : state) {
+        for(size_t i = 0; i < points.size(); ++i) {
+            points[i] += velocities[i] * direction;
+            grid.move(static_cast<SpatialHashGrid::Id>(i), points[i]);
+        }
+        direction = -direction;
+    }
+
+    set_elements_processed(state, points.size());
+}
+
+BENCHMARK(SpatialHashGrid_BruteForceRadius)->ArgName("count")->Arg(1 << 12)->Arg(1 << 14)->Unit(benchmark::kMicrosecond);
+BENCHMARK(SpatialHashGrid_Radius)->ArgName("count")->Arg(1 << 12)->Arg(1 << 14)->Arg(1 << 17)->Unit(benchmark::kMicrosecond);
+BENCHMARK(SpatialHashGrid_Nearest)->ArgName("count")->Arg(1 << 12)->Arg(1 << 14)->Arg(1 << 17)->Unit(benchmark::kMicrosecond);
+BENCHMARK(SpatialHashGrid_Move)->ArgName("count")->Arg(1 << 12)->Arg(1 << 14)->Arg(1 << 17)->Unit(benchmark::kMicrosecond);
+
+} } }
@@ -0,0 +1,28 @@
+#include "pch.h"
+#include <benchmark/benchmark.h>
+#include "Core/Math/SIMD/Kernels.h"
+
+// same as BENCHMARK_MAIN() but records how the library was built
+// in the context so that results from different builds can be told apart
+// (use --benchmark_out=<file> --benchmark_out_format=json to save them)
+int main(int argc, char** argv)
+{
+    using namespace energonsoftware::math;
+
+#if defined USE_SSE
+    benchmark::AddCustomContext("vector_build", "sse");
+#else
+    benchmark::AddCustomContext("vector_build", "scalar");
+#endif
+    benchmark::AddCustomContext("max_simd_level", simd_level_name(max_simd_level()));
+    benchmark::AddCustomContext("simd_level", simd_level_name(kernels().level));
+
+    benchmark::Initialize(&argc, argv);
+    if(benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
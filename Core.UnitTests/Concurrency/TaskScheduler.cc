@@ -0,0 +1,161 @@
+#include "pch.h"
+#include <stdexcept>
+#include "CppUnitTest.h"
+#include "Core/Concurrency/TaskScheduler.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace concurrency {
+namespace unittests {
+
+TEST_CLASS(TaskSchedulerTests)
+{
+public:
+    TEST_METHOD(thread_count)
+    {
+        // Arrange
+        TaskScheduler one(1);
+        TaskScheduler four(4);
+
+        // Act
+
+        // Assert
+        Assert::AreEqual(static_cast<size_t>(1), one.thread_count());
+        Assert::AreEqual(static_cast<size_t>(4), four.thread_count());
+        Assert::IsTrue(TaskScheduler::global().thread_count() >= 1);
+    }
+
+    TEST_METHOD(submit)
+    {
+        // Arrange
+        TaskScheduler scheduler(4);
+        std::atomic<int> sum(0);
+
+        // Act
+        for(int i = 1; i <= 100; ++i) {
+            scheduler.submit([&sum, i]() { sum += i; });
+        }
+        scheduler.wait([&sum]() { return 5050 == sum; });
+
+        // Assert
+        Assert::AreEqual(5050, sum.load());
+    }
+
+    TEST_METHOD(parallel_for)
+    {
+        for(size_t threads : { 1, 2, 3, 8 }) {
+            // Arrange
+            TaskScheduler scheduler(threads);
+            std::vector<int> visits(10007, 0);
+            std::atomic<size_t> chunks(0);
+
+            // Act
+            scheduler.parallel_for(visits.size(), 64, [&](size_t begin, size_t end) {
+                Assert::IsTrue(0 == begin % 64);
+                Assert::IsTrue(end - begin <= 64);
+                for(size_t i = begin; i < end; ++i) {
+                    ++visits[i];
+                }
+                ++chunks;
+            });
+
+            // Assert
+            Assert::AreEqual(static_cast<size_t>(157), chunks.load());
+            for(int v : visits) {
+                Assert::AreEqual(1, v);
+            }
+        }
+    }
+
+    TEST_METHOD(parallel_for_empty)
+    {
+        // Arrange
+        TaskScheduler scheduler(2);
+        bool called = false;
+
+        // Act
+        scheduler.parallel_for(0, 16, [&called](size_t, size_t) { called = true; });
+
+        // Assert
+        Assert::IsFalse(called);
+    }
+
+    TEST_METHOD(parallel_for_nested)
+    {
+        // Arrange
+        TaskScheduler scheduler(4);
+        std::atomic<size_t> total(0);
+
+        // Act
+        // the outer bodies wait on the inner loops, which only finishes
+        // if the waiting threads run the queued tasks themselves
+        scheduler.parallel_for(64, 1, [&](size_t, size_t) {
+            scheduler.parallel_for(1000, 10, [&](size_t begin, size_t end) {
+                total += end - begin;
+            });
+        });
+
+        // Assert
+        Assert::AreEqual(static_cast<size_t>(64000), total.load());
+    }
+
+    TEST_METHOD(parallel_for_exception)
+    {
+        // Arrange
+        TaskScheduler scheduler(4);
+        std::atomic<size_t> chunks(0);
+
+        // Act
+        bool thrown = false;
+        try {
+            scheduler.parallel_for(100, 1, [&chunks](size_t begin, size_t) {
+                ++chunks;
+                if(37 == begin) {
+                    throw std::runtime_error("chunk 37");
+                }
+            });
+        } catch(const std::runtime_error&) {
+            thrown = true;
+        }
+
+        // Assert
+        Assert::IsTrue(thrown);
+        Assert::AreEqual(static_cast<size_t>(100), chunks.load());
+    }
+
+    TEST_METHOD(parallel_reduce)
+    {
+        // Arrange
+        // float addition isn't associative, so a sum that depended on
+        // the order that the threads finished in would differ between runs
+        std::vector<float> values(100000);
+        for(size_t i = 0; i < values.size(); ++i) {
+            values[i] = 1.0f / static_cast<float>(i + 1);
+        }
+
+        const auto map = [&values](size_t begin, size_t end) {
+            float sum = 0.0f;
+            for(size_t i = begin; i < end; ++i) {
+                sum += values[i];
+            }
+            return sum;
+        };
+        const auto combine = [](float a, float b) { return a + b; };
+
+        // Act
+        TaskScheduler one(1);
+        const float expected = one.parallel_reduce(values.size(), 1000, 0.0f, map, combine);
+
+        // Assert
+        for(size_t threads : { 2, 3, 8 }) {
+            TaskScheduler scheduler(threads);
+            for(int run = 0; run < 10; ++run) {
+                Assert::AreEqual(expected, scheduler.parallel_reduce(values.size(), 1000, 0.0f, map, combine));
+            }
+        }
+        Assert::AreEqual(12.09f, expected, 0.01f);
+    }
+};
+
+} } }
@@ -0,0 +1,222 @@
+#include "pch.h"
+#include <cstdio>
+#include <fstream>
+#include "CppUnitTest.h"
+#include "Core/Math/Random.h"
+#include "Core/IO/PointCloud.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace io {
+namespace unittests {
+
+using math::Vector;
+
+TEST_CLASS(PointCloudTests)
+{
+private:
+    // deletes the file when the test is done
+    struct TempFile
+    {
+        std::string path;
+
+        TempFile()
+            : path("pointcloud_test_" + std::to_string(std::random_device()()) + ".espc")
+        {
+        }
+
+        ~TempFile()
+        {
+            std::remove(path.c_str());
+        }
+    };
+
+    static std::vector<Vector> test_points(size_t count, uint64_t seed)
+    {
+        std::vector<Vector> points(count);
+        math::Random(seed).in_box(points.data(), count, Vector(-100.0f, -100.0f, -100.0f, -1.0f), Vector(100.0f, 100.0f, 100.0f, 1.0f));
+        return points;
+    }
+
+    static void corrupt(const std::string& path, size_t offset)
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(static_cast<std::streamoff>(offset));
+        file.put('\x7f');
+    }
+
+    static void patch(const std::string& path, size_t offset, uint64_t value)
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(static_cast<std::streamoff>(offset));
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    static uint64_t peek(const std::string& path, size_t offset)
+    {
+        uint64_t value = 0;
+        std::ifstream file(path, std::ios::binary);
+        file.seekg(static_cast<std::streamoff>(offset));
+        file.read(reinterpret_cast<char*>(&value), sizeof(value));
+        return value;
+    }
+
+    // the start of the mapping, the header is the first thing in the file
+    static const char* file_start(const PointCloudFile& file)
+    {
+        return reinterpret_cast<const char*>(file.packed(0, 0).begin()) - 128;
+    }
+
+    static void assert_throws(const std::string& path)
+    {
+        Assert::ExpectException<std::runtime_error>([&path]() { PointCloudFile file(path); });
+    }
+
+public:
+    TEST_METHOD(round_trip)
+    {
+        // Arrange
+        TempFile temp;
+        const std::vector<Vector> positions = test_points(1000, 1);
+        const std::vector<Vector> colors = test_points(1000, 2);
+
+        // Act
+        {
+            // an odd chunk size and writes that cross chunks
+            PointCloudWriter writer(temp.path, { { "position", ColumnLayout::Packed }, { "color", ColumnLayout::Stream } }, 77);
+            writer.write({ positions.data(), colors.data() }, 100);
+            writer.write({ positions.data() + 100, colors.data() + 100 }, 900);
+            Assert::AreEqual(static_cast<size_t>(1000), writer.size());
+            writer.close();
+        }
+        PointCloudFile file(temp.path);
+
+        // Assert
+        Assert::AreEqual(static_cast<size_t>(1000), file.size());
+        Assert::AreEqual(static_cast<size_t>(2), file.column_count());
+        Assert::AreEqual(std::string("color"), file.column(1).name);
+        Assert::IsTrue(ColumnLayout::Stream == file.column(1).layout);
+        Assert::AreEqual(static_cast<size_t>(1), file.find_column("color"));
+        Assert::AreEqual(PointCloudFile::npos, file.find_column("normal"));
+        Assert::AreEqual(static_cast<size_t>(77), file.chunk_size());
+        Assert::AreEqual(static_cast<size_t>(13), file.chunk_count());
+        Assert::AreEqual(static_cast<size_t>(1000 - 12 * 77), file.chunk_points(12));
+        Assert::IsTrue(file.has_checksums());
+        Assert::IsTrue(file.verify());
+
+        for(size_t chunk = 0; chunk < file.chunk_count(); ++chunk) {
+            const memory::Span<const Vector> p = file.packed(0, chunk);
+            const math::ConstStreamRef c = file.stream(1, chunk);
+            Assert::AreEqual(file.chunk_points(chunk), p.size());
+            Assert::AreEqual(static_cast<size_t>(0), reinterpret_cast<size_t>(p.data()) % 64);
+            Assert::AreEqual(static_cast<size_t>(0), reinterpret_cast<size_t>(c.w) % 64);
+
+            for(size_t i = 0; i < p.size(); ++i) {
+                const size_t index = file.chunk_start(chunk) + i;
+                Assert::IsTrue(positions[index] == p[i]);
+                Assert::IsTrue(colors[index] == Vector(c.x[i], c.y[i], c.z[i], c.w[i]));
+            }
+        }
+
+        std::vector<Vector> read(file.size());
+        file.read(1, read.data());
+        Assert::IsTrue(colors == read);
+        file.read(0, read.data());
+        Assert::IsTrue(positions == read);
+    }
+
+    TEST_METHOD(empty)
+    {
+        // Arrange
+        TempFile temp;
+
+        // Act
+        {
+            PointCloudWriter writer(temp.path, { { "position", ColumnLayout::Packed } }, 16, false);
+        }
+        PointCloudFile file(temp.path);
+
+        // Assert
+        Assert::AreEqual(static_cast<size_t>(0), file.size());
+        Assert::AreEqual(static_cast<size_t>(0), file.chunk_count());
+        Assert::IsFalse(file.has_checksums());
+        Assert::IsTrue(file.verify());
+    }
+
+    TEST_METHOD(verify)
+    {
+        // Arrange
+        TempFile temp;
+        const std::vector<Vector> points = test_points(100, 3);
+        {
+            PointCloudWriter writer(temp.path, { { "position", ColumnLayout::Packed } }, 64);
+            writer.write(points.data(), points.size());
+        }
+
+        // Act
+        // flip a byte in the second chunk
+        size_t offset = 0;
+        {
+            PointCloudFile file(temp.path);
+            offset = static_cast<size_t>(reinterpret_cast<const char*>(file.packed(0, 1).begin() + 5) - file_start(file));
+        }
+        corrupt(temp.path, offset);
+        PointCloudFile file(temp.path);
+
+        // Assert
+        Assert::IsTrue(file.verify(0));
+        Assert::IsFalse(file.verify(1));
+        Assert::IsFalse(file.verify());
+    }
+
+    TEST_METHOD(invalid)
+    {
+        // Arrange
+        TempFile temp;
+        const std::vector<Vector> points = test_points(10, 4);
+
+        // Act
+        PointCloudWriter writer(temp.path, { { "position", ColumnLayout::Packed } });
+        writer.write(points.data(), points.size());
+
+        // Assert
+        // the header isn't written until the writer is closed
+        assert_throws(temp.path);
+        assert_throws("does_not_exist.espc");
+
+        writer.close();
+        {
+            PointCloudFile file(temp.path);
+            Assert::AreEqual(static_cast<size_t>(10), file.size());
+        }
+
+        // a huge point count and chunk size, with a chunk table that agrees
+        const uint64_t chunk_size = peek(temp.path, 32);
+        const uint64_t chunk_points = peek(temp.path, 48) + 8;
+        patch(temp.path, 24, 1ULL << 60);
+        patch(temp.path, 32, 1ULL << 60);
+        patch(temp.path, chunk_points, 1ULL << 60);
+        assert_throws(temp.path);
+
+        // a chunk size that wraps the chunk count around to 0
+        patch(temp.path, 24, 10);
+        patch(temp.path, 32, ~0ULL);
+        patch(temp.path, 40, 0);
+        patch(temp.path, chunk_points, 10);
+        assert_throws(temp.path);
+
+        patch(temp.path, 32, chunk_size);
+        patch(temp.path, 40, 1);
+        {
+            PointCloudFile file(temp.path);
+            Assert::AreEqual(static_cast<size_t>(10), file.size());
+        }
+
+        // newer version
+        corrupt(temp.path, 8);
+        assert_throws(temp.path);
+    }
+};
+
+} } }
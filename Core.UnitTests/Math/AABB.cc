@@ -0,0 +1,158 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Core/Math/AABB.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace math {
+namespace unittests {
+
+TEST_CLASS(AABBTests)
+{
+public:
+    TEST_METHOD(constructor)
+    {
+        // Arrange
+        AABB b1;
+        AABB b2(Point3(-1.0f, -2.0f, -3.0f, 1.0f), Point3(1.0f, 2.0f, 3.0f, 1.0f));
+        AABB b3 = AABB::from_center(Point3(1.0f, 1.0f, 1.0f), Vector(1.0f, 2.0f, 3.0f));
+
+        // Act
+
+        // Assert
+        Assert::IsTrue(b1.is_empty());
+        Assert::IsTrue(AABB::Empty == b1);
+        Assert::IsFalse(b2.is_empty());
+        Assert::AreEqual(0.0f, b2.minimum().w());
+        Assert::AreEqual(0.0f, b2.maximum().w());
+        Assert::IsTrue(Point3(0.0f, -1.0f, -2.0f) == b3.minimum());
+        Assert::IsTrue(Point3(2.0f, 3.0f, 4.0f) == b3.maximum());
+    }
+
+    TEST_METHOD(from_points)
+    {
+        // Arrange
+        const Point3 points[] = { Point3(1.0f, 5.0f, -1.0f), Point3(-2.0f, 0.0f, 3.0f, 1.0f), Point3(0.0f, 1.0f, 2.0f) };
+
+        // Act
+        AABB b1 = AABB::from_points(points, 3);
+        AABB b2 = AABB::from_points(points, 1);
+        AABB b3 = AABB::from_points(points, 0);
+
+        // Assert
+        Assert::IsTrue(AABB(Point3(-2.0f, 0.0f, -1.0f), Point3(1.0f, 5.0f, 3.0f)) == b1);
+        Assert::IsFalse(b2.is_empty());
+        Assert::IsTrue(b2.contains(points[0]));
+        Assert::AreEqual(0.0f, b2.volume());
+        Assert::IsTrue(b3.is_empty());
+    }
+
+    TEST_METHOD(measurements)
+    {
+        // Arrange
+        AABB b1(Point3(-1.0f, -2.0f, -3.0f), Point3(1.0f, 2.0f, 3.0f));
+
+        // Act
+
+        // Assert
+        Assert::IsTrue(Point3(0.0f, 0.0f, 0.0f) == b1.center());
+        Assert::IsTrue(Vector(2.0f, 4.0f, 6.0f) == b1.extents());
+        Assert::IsTrue(Vector(1.0f, 2.0f, 3.0f) == b1.half_extents());
+        Assert::AreEqual(2.0f * (8.0f + 24.0f + 12.0f), b1.surface_area());
+        Assert::AreEqual(48.0f, b1.volume());
+        Assert::AreEqual(2, b1.longest_axis());
+        Assert::AreEqual(0.0f, AABB::Empty.surface_area());
+        Assert::AreEqual(0.0f, AABB::Empty.volume());
+    }
+
+    TEST_METHOD(merge)
+    {
+        // Arrange
+        AABB b1(Point3(0.0f, 0.0f, 0.0f), Point3(1.0f, 1.0f, 1.0f));
+        AABB b2(Point3(-1.0f, 0.5f, 0.5f), Point3(0.5f, 2.0f, 0.5f));
+
+        // Act
+        AABB b3 = b1.merged(b2);
+        AABB b4 = AABB().merge(Point3(1.0f, 2.0f, 3.0f, 1.0f));
+        AABB b5 = b1.merged(AABB::Empty);
+
+        // Assert
+        Assert::IsTrue(AABB(Point3(-1.0f, 0.0f, 0.0f), Point3(1.0f, 2.0f, 1.0f)) == b3);
+        Assert::IsTrue(AABB(Point3(1.0f, 2.0f, 3.0f), Point3(1.0f, 2.0f, 3.0f)) == b4);
+        Assert::IsTrue(b1 == b5);
+    }
+
+    TEST_METHOD(contains_overlaps)
+    {
+        // Arrange
+        AABB b1(Point3(0.0f, 0.0f, 0.0f), Point3(2.0f, 2.0f, 2.0f));
+        AABB b2(Point3(1.0f, 1.0f, 1.0f), Point3(3.0f, 3.0f, 3.0f));
+        AABB b3(Point3(2.0f, 0.0f, 0.0f), Point3(3.0f, 1.0f, 1.0f));
+        AABB b4(Point3(2.5f, 0.0f, 0.0f), Point3(3.0f, 1.0f, 1.0f));
+
+        // Act
+
+        // Assert
+        Assert::IsTrue(b1.contains(Point3(1.0f, 1.0f, 1.0f, 100.0f)));
+        Assert::IsTrue(b1.contains(Point3(2.0f, 0.0f, 2.0f)));
+        Assert::IsFalse(b1.contains(Point3(1.0f, 2.5f, 1.0f)));
+        Assert::IsTrue(b1.contains(AABB(Point3(0.5f, 0.5f, 0.5f), Point3(1.0f, 1.0f, 1.0f))));
+        Assert::IsFalse(b1.contains(b2));
+        Assert::IsTrue(b1.contains(AABB::Empty));
+
+        Assert::IsTrue(b1.overlaps(b2));
+        Assert::IsTrue(b2.overlaps(b1));
+        Assert::IsTrue(b1.overlaps(b3));
+        Assert::IsFalse(b1.overlaps(b4));
+        Assert::IsFalse(b1.overlaps(AABB::Empty));
+        Assert::IsFalse(AABB::Empty.overlaps(AABB::Empty));
+
+        Assert::IsTrue(AABB(Point3(1.0f, 1.0f, 1.0f), Point3(2.0f, 2.0f, 2.0f)) == b1.intersection(b2));
+        Assert::IsTrue(b1.intersection(b4).is_empty());
+    }
+
+    TEST_METHOD(distance_squared)
+    {
+        // Arrange
+        AABB b1(Point3(0.0f, 0.0f, 0.0f), Point3(2.0f, 2.0f, 2.0f));
+
+        // Act
+
+        // Assert
+        Assert::AreEqual(0.0f, b1.distance_squared(Point3(1.0f, 1.0f, 1.0f, 1.0f)));
+        Assert::AreEqual(4.0f, b1.distance_squared(Point3(1.0f, 4.0f, 1.0f)));
+        Assert::AreEqual(3.0f, b1.distance_squared(Point3(-1.0f, 3.0f, 3.0f)));
+    }
+
+    TEST_METHOD(intersect_ray)
+    {
+        // Arrange
+        AABB b1(Point3(1.0f, -1.0f, -1.0f), Point3(3.0f, 1.0f, 1.0f));
+        const float inf = std::numeric_limits<float>::infinity();
+        float t = -1.0f;
+
+        // Act
+
+        // Assert
+        // along x, the zero components have infinite inverses
+        Assert::IsTrue(b1.intersect_ray(Point3(0.0f, 0.0f, 0.0f, 1.0f), Vector(1.0f, inf, inf), 0.0f, 100.0f, t));
+        Assert::AreEqual(1.0f, t);
+
+        // starting inside
+        Assert::IsTrue(b1.intersect_ray(Point3(2.0f, 0.0f, 0.0f), Vector(-1.0f, inf, inf), 0.0f, 100.0f, t));
+        Assert::AreEqual(0.0f, t);
+
+        // diagonal, direction (2, 1, 0)
+        Assert::IsTrue(b1.intersect_ray(Point3(-1.0f, -1.0f, 0.0f), Vector(0.5f, 1.0f, inf), 0.0f, 100.0f, t));
+        Assert::AreEqual(1.0f, t);
+
+        // too short, pointing away and missing
+        Assert::IsFalse(b1.intersect_ray(Point3(0.0f, 0.0f, 0.0f), Vector(1.0f, inf, inf), 0.0f, 0.5f, t));
+        Assert::IsFalse(b1.intersect_ray(Point3(0.0f, 0.0f, 0.0f), Vector(-1.0f, inf, inf), 0.0f, 100.0f, t));
+        Assert::IsFalse(b1.intersect_ray(Point3(0.0f, 2.0f, 0.0f), Vector(1.0f, inf, inf), 0.0f, 100.0f, t));
+        Assert::IsFalse(AABB::Empty.intersect_ray(Point3(0.0f, 0.0f, 0.0f), Vector(1.0f, 1.0f, 1.0f), 0.0f, 100.0f, t));
+    }
+};
+
+} } }
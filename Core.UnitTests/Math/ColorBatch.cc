@@ -0,0 +1,248 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Core/Math/SIMD/Kernels.h"
+#include "Core/Math/ColorBatch.h"
+#include "Core.UnitTests/UnitTests.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace math {
+namespace unittests {
+
+TEST_CLASS(ColorBatchTests)
+{
+private:
+    // the IEC 61966-2-1 curves in double precision
+    static double reference_decode(double c)
+    {
+        return c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+    }
+
+    static double reference_encode(double l)
+    {
+        return l <= 0.0031308 ? l * 12.92 : 1.055 * std::pow(l, 1.0 / 2.4) - 0.055;
+    }
+
+    static void assert_relative(double expected, float actual, double tolerance)
+    {
+        Assert::AreEqual(expected, static_cast<double>(actual), std::max(std::fabs(expected) * tolerance, 1e-9));
+    }
+
+    void assert_equal(const Color& expected, const Color& actual)
+    {
+        Assert::AreEqual(expected.x(), actual.x(), 0.0001f);
+        Assert::AreEqual(expected.y(), actual.y(), 0.0001f);
+        Assert::AreEqual(expected.z(), actual.z(), 0.0001f);
+        Assert::AreEqual(expected.w(), actual.w(), 0.0001f);
+    }
+
+    // every channel value from 0 to 1 in steps of 1 / 1024, as grey with those alphas
+    static std::vector<Color> create_ramp()
+    {
+        std::vector<Color> colors;
+        for(int i = 0; i <= 1024; ++i) {
+            const float f = static_cast<float>(i) / 1024.0f;
+            colors.emplace_back(f, f, f, f);
+        }
+        return colors;
+    }
+
+public:
+    TEST_METHOD(srgb)
+    {
+        for_each_simd_level([this]() {
+            // Arrange
+            const std::vector<Color> colors = create_ramp();
+            std::vector<Color> linear(colors.size()), encoded(colors.size());
+
+            // Act
+            batch::srgb_to_linear(colors.data(), linear.data(), colors.size());
+            batch::linear_to_srgb(colors.data(), encoded.data(), colors.size());
+
+            // Assert
+            for(size_t i = 0; i < colors.size(); ++i) {
+                assert_relative(reference_decode(colors[i].x()), linear[i].x(), 2e-6);
+                assert_relative(reference_encode(colors[i].y()), encoded[i].y(), 2e-6);
+
+                // alpha is left alone
+                Assert::AreEqual(colors[i].w(), linear[i].w());
+                Assert::AreEqual(colors[i].w(), encoded[i].w());
+            }
+        });
+    }
+
+    TEST_METHOD(rgba8)
+    {
+        for_each_simd_level([this]() {
+            // Arrange
+            const Color colors[] = {
+                Color(1.0f, 0.0f, 0.5f, 1.0f),
+                Color(-1.0f, 2.0f, NAN, 0.2f),
+            };
+            uint32_t packed[2];
+
+            // Act
+            batch::pack_rgba8(colors, packed, 2);
+
+            // Assert
+            // 127.5 rounds to even, out of range clamps and NaN is 0
+            Assert::AreEqual(0xff8000ffu, packed[0]);
+            Assert::AreEqual(0x3300ff00u, packed[1]);
+
+            // every 8-bit value survives a round trip
+            std::vector<uint32_t> all(256);
+            for(uint32_t i = 0; i < 256; ++i) {
+                all[i] = i | ((255 - i) << 8) | (((i * 7) & 0xff) << 16) | (i << 24);
+            }
+            std::vector<Color> unpacked(all.size());
+            std::vector<uint32_t> repacked(all.size());
+            batch::unpack_rgba8(all.data(), unpacked.data(), all.size());
+            batch::pack_rgba8(unpacked.data(), repacked.data(), all.size());
+            for(uint32_t i = 0; i < 256; ++i) {
+                Assert::AreEqual(static_cast<float>(i) / 255.0f, unpacked[i].x(), 1e-7f);
+                Assert::AreEqual(all[i], repacked[i]);
+            }
+        });
+    }
+
+    TEST_METHOD(srgba8)
+    {
+        for_each_simd_level([this]() {
+            // Arrange
+            std::vector<uint32_t> all(256);
+            for(uint32_t i = 0; i < 256; ++i) {
+                all[i] = i | ((255 - i) << 8) | (((i * 7) & 0xff) << 16) | (i << 24);
+            }
+            std::vector<Color> unpacked(all.size());
+            std::vector<uint32_t> repacked(all.size());
+
+            // Act
+            batch::unpack_srgba8(all.data(), unpacked.data(), all.size());
+            batch::pack_srgba8(unpacked.data(), repacked.data(), all.size());
+
+            // Assert
+            for(uint32_t i = 0; i < 256; ++i) {
+                assert_relative(reference_decode(i / 255.0), unpacked[i].x(), 2e-6);
+                Assert::AreEqual(static_cast<float>(i) / 255.0f, unpacked[i].w(), 1e-7f);
+                Assert::AreEqual(all[i], repacked[i]);
+            }
+        });
+    }
+
+    TEST_METHOD(rgb10a2)
+    {
+        for_each_simd_level([this]() {
+            // Arrange
+            const Color colors[] = {
+                Color(1.0f, 0.0f, 0.5f, 1.0f),
+                Color(0.25f, 2.0f, -1.0f, 0.5f),
+            };
+            uint32_t packed[2];
+            Color unpacked[2];
+
+            // Act
+            batch::pack_rgb10a2(colors, packed, 2);
+            batch::unpack_rgb10a2(packed, unpacked, 2);
+
+            // Assert
+            // 511.5 and 1.5 round to even
+            Assert::AreEqual(0xe00003ffu, packed[0]);
+            Assert::AreEqual(0x800ffd00u, packed[1]);
+            assert_equal(Color(1.0f, 0.0f, 512.0f / 1023.0f, 1.0f), unpacked[0]);
+            assert_equal(Color(256.0f / 1023.0f, 1.0f, 0.0f, 2.0f / 3.0f), unpacked[1]);
+        });
+    }
+
+    TEST_METHOD(half)
+    {
+        for_each_simd_level([this]() {
+            // Arrange
+            const Color colors[] = {
+                Color(1.0f, -0.0f, 65504.0f, 65520.0f),
+                Color(5.9604645e-08f, 2.9802322e-08f, 2.9802326e-08f, 6.1035156e-05f),
+                Color(1.00048828125f, 1.00146484375f, -HUGE_VALF, NAN),
+            };
+            uint16_t packed[12];
+
+            // Act
+            batch::pack_half(colors, packed, 3);
+
+            // Assert
+            // halfway cases round to even and 65520 is the first value to overflow
+            const uint16_t expected[12] = {
+                0x3c00, 0x8000, 0x7bff, 0x7c00,
+                0x0001, 0x0000, 0x0001, 0x0400,
+                0x3c00, 0x3c02, 0xfc00, 0x7e00,
+            };
+            for(size_t i = 0; i < 12; ++i) {
+                Assert::AreEqual(expected[i], packed[i]);
+            }
+
+            // every float16 survives a round trip, NaNs come back quiet
+            std::vector<uint16_t> all(65536);
+            for(size_t i = 0; i < all.size(); ++i) {
+                all[i] = static_cast<uint16_t>(i);
+            }
+            std::vector<Color> unpacked(all.size() / 4);
+            std::vector<uint16_t> repacked(all.size());
+            batch::unpack_half(all.data(), unpacked.data(), unpacked.size());
+            batch::pack_half(unpacked.data(), repacked.data(), unpacked.size());
+            for(size_t i = 0; i < all.size(); ++i) {
+                const bool nan = (all[i] & 0x7c00) == 0x7c00 && (all[i] & 0x03ff) != 0;
+                Assert::AreEqual(static_cast<uint16_t>(nan ? all[i] | 0x0200 : all[i]), repacked[i]);
+            }
+            Assert::AreEqual(1.0f, unpacked[0x3c00 / 4].x());
+            Assert::AreEqual(5.9604645e-08f, unpacked[0].y());
+            Assert::AreEqual(-65504.0f, unpacked[0xfbff / 4].w());
+        });
+    }
+
+    TEST_METHOD(premultiply)
+    {
+        for_each_simd_level([this]() {
+            // Arrange
+            const Color colors[] = {
+                Color(1.0f, 0.5f, 0.25f, 0.5f),
+                Color(1.0f, 1.0f, 1.0f, 0.0f),
+            };
+            Color premultiplied[2], unpremultiplied[2];
+
+            // Act
+            batch::premultiply(colors, premultiplied, 2);
+            batch::unpremultiply(premultiplied, unpremultiplied, 2);
+
+            // Assert
+            assert_equal(Color(0.5f, 0.25f, 0.125f, 0.5f), premultiplied[0]);
+            assert_equal(colors[0], unpremultiplied[0]);
+            assert_equal(Color(0.0f, 0.0f, 0.0f, 0.0f), unpremultiplied[1]);
+        });
+    }
+
+    TEST_METHOD(blend)
+    {
+        for_each_simd_level([this]() {
+            // Arrange
+            // premultiplied, src is 50% red and dst is 50% blue-ish grey
+            const std::vector<Color> src(5, Color(0.5f, 0.0f, 0.0f, 0.5f));
+            const std::vector<Color> dst(5, Color(0.1f, 0.2f, 0.4f, 0.5f));
+            std::vector<Color> over(5), add(5), multiply(5), screen(5);
+
+            // Act
+            batch::blend(src.data(), dst.data(), over.data(), src.size());
+            batch::blend(src.data(), dst.data(), add.data(), src.size(), BlendMode::Add);
+            batch::blend(src.data(), dst.data(), multiply.data(), src.size(), BlendMode::Multiply);
+            batch::blend(src.data(), dst.data(), screen.data(), src.size(), BlendMode::Screen);
+
+            // Assert
+            for(size_t i = 0; i < src.size(); ++i) {
+                assert_equal(Color(0.55f, 0.1f, 0.2f, 0.75f), over[i]);
+                assert_equal(Color(0.6f, 0.2f, 0.4f, 1.0f), add[i]);
+                assert_equal(Color(0.35f, 0.1f, 0.2f, 0.75f), multiply[i]);
+                assert_equal(Color(0.55f, 0.2f, 0.4f, 0.75f), screen[i]);
+            }
+        });
+    }
+};
+
+} } }
@@ -0,0 +1,153 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Core/Math/Fixed.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace math {
+namespace unittests {
+
+TEST_CLASS(FixedTests)
+{
+public:
+    TEST_METHOD(constructor)
+    {
+        // Arrange
+        Fixed f1;
+        Fixed f2(3);
+        Fixed f3(-2.25);
+
+        // Act
+
+        // Assert
+        Assert::AreEqual(static_cast<int64_t>(0), f1.raw());
+        Assert::AreEqual(static_cast<int64_t>(3) << 32, f2.raw());
+        Assert::AreEqual(-2.25, f3.to_double());
+        Assert::AreEqual(static_cast<int64_t>(1), Fixed::Epsilon.raw());
+    }
+
+    TEST_METHOD(floor_fraction)
+    {
+        // Arrange
+        Fixed f1(2.75);
+        Fixed f2(-2.75);
+
+        // Act
+
+        // Assert
+        Assert::AreEqual(2, f1.floor());
+        Assert::AreEqual(0.75, f1.fraction().to_double());
+        Assert::AreEqual(-3, f2.floor());
+        Assert::AreEqual(0.25, f2.fraction().to_double());
+    }
+
+    TEST_METHOD(add_subtract)
+    {
+        // Arrange
+        Fixed f1(1.5);
+        Fixed f2(-4.25);
+
+        // Act
+        Fixed f3 = f1 + f2;
+        Fixed f4 = f1 - f2;
+        Fixed f5 = -f1;
+
+        // Assert
+        Assert::AreEqual(-2.75, f3.to_double());
+        Assert::AreEqual(5.75, f4.to_double());
+        Assert::AreEqual(-1.5, f5.to_double());
+    }
+
+    TEST_METHOD(multiply)
+    {
+        // Arrange
+        Fixed f1(1.5);
+        Fixed f2(-4.25);
+        Fixed f3(1000000);
+
+        // Act
+        Fixed f4 = f1 * f2;
+        Fixed f5 = f3 * Fixed(0.001);
+        Fixed f6 = Fixed::Epsilon * Fixed(0.5);
+
+        // Assert
+        Assert::AreEqual(-6.375, f4.to_double());
+        // 0.001 itself is only accurate to 2^-33
+        Assert::AreEqual(1000.0, f5.to_double(), 1e6 / 8589934592.0);
+        Assert::IsTrue(Fixed::Zero == f6);
+    }
+
+    TEST_METHOD(divide)
+    {
+        // Arrange
+        Fixed f1(1);
+        Fixed f2(-3);
+        Fixed f3(1000000);
+
+        // Act
+        Fixed f4 = f1 / f2;
+        Fixed f5 = f3 / Fixed(0.5);
+        Fixed f6 = Fixed(-6.375) / Fixed(1.5);
+
+        // Assert
+        // 1/3 rounds towards zero
+        Assert::AreEqual(-static_cast<int64_t>(0x55555555), f4.raw());
+        Assert::AreEqual(2000000.0, f5.to_double());
+        Assert::AreEqual(-4.25, f6.to_double());
+    }
+
+    TEST_METHOD(fixed_sqrt)
+    {
+        // Arrange
+        Fixed f1(16);
+        Fixed f2(2);
+        Fixed f3(1000000000);
+
+        // Act
+        Fixed r1 = sqrt(f1);
+        Fixed r2 = sqrt(f2);
+        Fixed r3 = sqrt(f3);
+
+        // Assert
+        Assert::AreEqual(4.0, r1.to_double());
+        Assert::AreEqual(std::sqrt(2.0), r2.to_double(), 1e-9);
+        Assert::AreEqual(std::sqrt(1e9), r3.to_double(), 1e-6);
+        Assert::IsTrue(Fixed::Zero == sqrt(Fixed::Zero));
+    }
+
+    TEST_METHOD(fixed_hypot)
+    {
+        // Arrange
+        Fixed a(300000000);
+        Fixed b(-400000000);
+
+        // Act
+        // the squares are far outside of the Fixed range
+        Fixed r1 = hypot(a, b);
+        Fixed r2 = hypot(Fixed(2), Fixed(3), Fixed(6));
+
+        // Assert
+        Assert::AreEqual(500000000.0, r1.to_double());
+        Assert::AreEqual(7.0, r2.to_double());
+    }
+
+    TEST_METHOD(compare)
+    {
+        // Arrange
+        Fixed f1(-1);
+        Fixed f2(0.5);
+
+        // Act
+
+        // Assert
+        Assert::IsTrue(f1 < f2);
+        Assert::IsTrue(f1 <= f2);
+        Assert::IsTrue(f2 > f1);
+        Assert::IsTrue(f2 >= f2);
+        Assert::IsTrue(f1 != f2);
+        Assert::IsTrue(Fixed(1) == abs(f1));
+    }
+};
+
+} } }
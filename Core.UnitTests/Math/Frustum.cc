@@ -0,0 +1,224 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Core/Math/SIMD/Kernels.h"
+#include "Core/Math/Frustum.h"
+#include "Core/Math/Random.h"
+#include "Core.UnitTests/UnitTests.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace math {
+namespace unittests {
+
+// odd-sized so that every kernel has to handle a remainder
+static const size_t CullCount = 1001;
+
+TEST_CLASS(FrustumTests)
+{
+private:
+    // looking down -z from the origin
+    static Frustum create_test_frustum()
+    {
+        return Frustum::from_matrix(Matrix4::perspective(static_cast<float>(DEG_RAD(90.0)), 2.0f, 1.0f, 100.0f));
+    }
+
+public:
+    TEST_METHOD(from_matrix)
+    {
+        // Arrange
+        const Frustum frustum = create_test_frustum();
+
+        // Act
+
+        // Assert
+        for(int i = 0; i < Frustum::PlaneCount; ++i) {
+            Assert::AreEqual(1.0f, frustum.planes()[i].normal().length(), 0.0001f);
+        }
+
+        // the near and far planes are z = -1 and z = -100 facing each other
+        Assert::AreEqual(0.0f, frustum.plane(Frustum::NearPlane).distance(Point3(3.0f, 4.0f, -1.0f)), 0.0001f);
+        Assert::AreEqual(0.0f, frustum.plane(Frustum::FarPlane).distance(Point3(3.0f, 4.0f, -100.0f)), 0.001f);
+        Assert::AreEqual(-1.0f, frustum.plane(Frustum::NearPlane).normal().z(), 0.0001f);
+        Assert::AreEqual(1.0f, frustum.plane(Frustum::FarPlane).normal().z(), 0.0001f);
+
+        // 90 degrees vertically is 45 degrees from the axis, the aspect ratio doubles that horizontally
+        Assert::AreEqual(0.0f, frustum.plane(Frustum::TopPlane).distance(Point3(0.0f, 10.0f, -10.0f)), 0.0001f);
+        Assert::AreEqual(0.0f, frustum.plane(Frustum::BottomPlane).distance(Point3(0.0f, -10.0f, -10.0f)), 0.0001f);
+        Assert::AreEqual(0.0f, frustum.plane(Frustum::RightPlane).distance(Point3(20.0f, 0.0f, -10.0f)), 0.0001f);
+        Assert::AreEqual(0.0f, frustum.plane(Frustum::LeftPlane).distance(Point3(-20.0f, 0.0f, -10.0f)), 0.0001f);
+    }
+
+    TEST_METHOD(from_matrix_view)
+    {
+        // Arrange
+        const Vector eye(10.0f, 5.0f, -3.0f);
+        const Matrix4 view = Matrix4::look_at(eye, Vector(10.0f, 5.0f, 10.0f), Vector(0.0f, 1.0f, 0.0f));
+
+        // Act
+        const Frustum frustum = Frustum::from_matrix(Matrix4::orthographic(-1.0f, 1.0f, -2.0f, 2.0f, 0.5f, 10.0f) * view);
+
+        // Assert
+        // looking down +z from eye
+        Assert::IsTrue(frustum.contains(eye + Vector(0.9f, 1.9f, 0.6f)));
+        Assert::IsTrue(frustum.contains(eye + Vector(-0.9f, -1.9f, 9.9f)));
+        Assert::IsFalse(frustum.contains(eye + Vector(0.0f, 0.0f, 0.4f)));
+        Assert::IsFalse(frustum.contains(eye + Vector(0.0f, 0.0f, 10.1f)));
+        Assert::IsFalse(frustum.contains(eye + Vector(0.0f, 2.1f, 5.0f)));
+        Assert::IsFalse(frustum.contains(eye + Vector(0.0f, 0.0f, -5.0f)));
+    }
+
+    TEST_METHOD(intersects)
+    {
+        // Arrange
+        const Frustum frustum = create_test_frustum();
+
+        // Act
+
+        // Assert
+        Assert::IsTrue(frustum.contains(Point3(0.0f, 0.0f, -50.0f)));
+        Assert::IsFalse(frustum.contains(Point3(0.0f, 0.0f, 1.0f)));
+
+        Assert::IsTrue(frustum.intersects(Point3(0.0f, 0.0f, 0.0f), 1.5f));
+        Assert::IsFalse(frustum.intersects(Point3(0.0f, 0.0f, 0.0f), 0.5f));
+        Assert::IsTrue(frustum.intersects(Point3(0.0f, 0.0f, -101.0f), 2.0f));
+        Assert::IsFalse(frustum.intersects(Point3(0.0f, 20.0f, -10.0f), 1.0f));
+
+        Assert::IsTrue(frustum.intersects(AABB(Point3(-1.0f, -1.0f, -1.0f), Point3(1.0f, 1.0f, 1.0f))));
+        Assert::IsTrue(frustum.intersects(AABB(Point3(-100.0f, -100.0f, -60.0f), Point3(100.0f, 100.0f, -50.0f))));
+        Assert::IsFalse(frustum.intersects(AABB(Point3(-1.0f, -1.0f, 0.0f), Point3(1.0f, 1.0f, 1.0f))));
+        Assert::IsFalse(frustum.intersects(AABB(Point3(-1.0f, 11.0f, -10.0f), Point3(1.0f, 12.0f, -9.0f))));
+        Assert::IsFalse(frustum.intersects(AABB::Empty));
+    }
+
+    TEST_METHOD(cull_spheres)
+    {
+        // Arrange
+        const Frustum frustum = create_test_frustum();
+
+        Random random(1);
+        VectorStream spheres;
+        for(size_t i = 0; i < CullCount; ++i) {
+            const Vector center = random.in_box(Vector(-120.0f, -120.0f, -120.0f), Vector(120.0f, 120.0f, 20.0f));
+            spheres.push_back(Vector(center.x(), center.y(), center.z(), random.uniform(0.0f, 10.0f)));
+        }
+
+        std::vector<uint32_t> expected;
+        for(size_t i = 0; i < CullCount; ++i) {
+            if(frustum.intersects(spheres[i].xyz(), spheres[i].w())) {
+                expected.push_back(static_cast<uint32_t>(i));
+            }
+        }
+
+        for_each_simd_level([&]() {
+            // Act
+            std::vector<uint32_t> visible(CullCount);
+            const size_t count = frustum.cull_spheres(spheres, visible.data());
+
+            // Assert
+            Assert::IsTrue(expected.size() > 50 && expected.size() < CullCount / 2);
+            Assert::AreEqual(expected.size(), count);
+            visible.resize(count);
+            Assert::IsTrue(expected == visible);
+        });
+    }
+
+    TEST_METHOD(cull_boxes)
+    {
+        // Arrange
+        const Frustum frustum = create_test_frustum();
+
+        Random random(2);
+        std::vector<AABB> boxes;
+        VectorStream centers, half_extents;
+        for(size_t i = 0; i < CullCount; ++i) {
+            const Vector center = random.in_box(Vector(-120.0f, -120.0f, -120.0f), Vector(120.0f, 120.0f, 20.0f));
+            const Vector half_extent = random.in_box(Vector::Zero, Vector(10.0f, 5.0f, 1.0f));
+            boxes.push_back(AABB::from_center(center, half_extent));
+            centers.push_back(boxes.back().center());
+            half_extents.push_back(boxes.back().half_extents());
+        }
+
+        std::vector<uint32_t> expected;
+        for(size_t i = 0; i < CullCount; ++i) {
+            if(frustum.intersects(boxes[i])) {
+                expected.push_back(static_cast<uint32_t>(i));
+            }
+        }
+
+        for_each_simd_level([&]() {
+            // Act
+            std::vector<uint32_t> visible(CullCount);
+            const size_t count = frustum.cull_boxes(centers, half_extents, visible.data());
+
+            // Assert
+            Assert::IsTrue(expected.size() > 50 && expected.size() < CullCount / 2);
+            Assert::AreEqual(expected.size(), count);
+            visible.resize(count);
+            Assert::IsTrue(expected == visible);
+        });
+    }
+
+    TEST_METHOD(cull_everything)
+    {
+        // Arrange
+        const Frustum frustum = create_test_frustum();
+        VectorStream spheres;
+        for(size_t i = 0; i < CullCount; ++i) {
+            spheres.push_back(Vector(0.0f, 0.0f, -10.0f, 1.0f));
+        }
+
+        // Act
+        std::vector<uint32_t> visible(CullCount);
+        const size_t all = frustum.cull_spheres(spheres, visible.data());
+
+        spheres.set(CullCount - 1, Vector(0.0f, 0.0f, 10.0f, 1.0f));
+        const size_t last = frustum.cull_spheres(spheres, visible.data());
+
+        // Assert
+        Assert::AreEqual(CullCount, all);
+        Assert::AreEqual(CullCount - 1, last);
+        for(size_t i = 0; i < last; ++i) {
+            Assert::AreEqual(static_cast<uint32_t>(i), visible[i]);
+        }
+    }
+
+    TEST_METHOD(cull_packed)
+    {
+        // Arrange
+        // enough for a few scratch chunks and a partial one
+        const size_t count = ScratchChunkSize * 2 + 101;
+        const Frustum frustum = create_test_frustum();
+
+        Random random(3);
+        std::vector<Vector> spheres;
+        std::vector<AABB> boxes;
+        for(size_t i = 0; i < count; ++i) {
+            const Vector center = random.in_box(Vector(-120.0f, -120.0f, -120.0f), Vector(120.0f, 120.0f, 20.0f));
+            spheres.push_back(Vector(center.x(), center.y(), center.z(), random.uniform(0.0f, 10.0f)));
+            boxes.push_back(0 == i % 7 ? AABB::Empty : AABB::from_center(center, random.in_box(Vector::Zero, Vector(10.0f, 5.0f, 1.0f))));
+        }
+
+        std::vector<uint32_t> expected_spheres, expected_boxes;
+        for(size_t i = 0; i < count; ++i) {
+            if(frustum.intersects(spheres[i].xyz(), spheres[i].w())) {
+                expected_spheres.push_back(static_cast<uint32_t>(i));
+            }
+            if(frustum.intersects(boxes[i])) {
+                expected_boxes.push_back(static_cast<uint32_t>(i));
+            }
+        }
+
+        // Act
+        std::vector<uint32_t> visible_spheres(count), visible_boxes(count);
+        visible_spheres.resize(frustum.cull_spheres(spheres.data(), count, visible_spheres.data()));
+        visible_boxes.resize(frustum.cull_boxes(boxes.data(), count, visible_boxes.data()));
+
+        // Assert
+        Assert::IsTrue(expected_spheres.size() > 100 && expected_boxes.size() > 100);
+        Assert::IsTrue(expected_spheres == visible_spheres);
+        Assert::IsTrue(expected_boxes == visible_boxes);
+    }
+};
+
+} } }
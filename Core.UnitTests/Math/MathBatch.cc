@@ -0,0 +1,237 @@
+#include "pch.h"
+#include <cfloat>
+#include "CppUnitTest.h"
+#include "Core/Math/SIMD/Kernels.h"
+#include "Core/Math/MathBatch.h"
+#include "Core.UnitTests/UnitTests.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace math {
+namespace unittests {
+
+// the ulp bounds from MathBatch.h
+static const double TrigUlps = 4.0;
+static const double AtanUlps = 2.5;
+static const double Atan2Ulps = 3.0;
+static const double AcosUlps = 1.5;
+static const double ExpUlps = 1.5;
+static const double LogUlps = 1.0;
+
+TEST_CLASS(MathBatchTests)
+{
+private:
+    // the error of actual in ulps of the correctly rounded float of expected
+    static double ulps(double expected, float actual)
+    {
+        // anything past FLT_MAX rounds to infinity
+        if(std::isinf(actual) && std::fabs(expected) >= FLT_MAX) {
+            return std::signbit(expected) == std::signbit(actual) ? 0.0 : HUGE_VAL;
+        }
+
+        const double magnitude = std::max(std::fabs(expected), static_cast<double>(FLT_MIN));
+        int exponent;
+        std::frexp(magnitude, &exponent);
+        return std::fabs(static_cast<double>(actual) - expected) / std::ldexp(1.0, exponent - 24);
+    }
+
+    // checks f over every input against the double precision reference
+    template<typename Reference>
+    static void assert_ulps(const std::vector<float>& x, const std::vector<float>& actual, double max_ulps, Reference reference)
+    {
+        for(size_t i = 0; i < x.size(); ++i) {
+            const double expected = reference(static_cast<double>(x[i]));
+            if(ulps(expected, actual[i]) > max_ulps) {
+                std::wstringstream message;
+                message << simd_level_name(kernels().level) << L" f(" << x[i] << L") = " << actual[i] << L": " << ulps(expected, actual[i]) << L" ulps";
+                Assert::Fail(message.str().c_str());
+            }
+        }
+    }
+
+    // count evenly spaced floats over [first, last]
+    static std::vector<float> create_range(float first, float last, size_t count)
+    {
+        std::vector<float> x(count);
+        for(size_t i = 0; i < count; ++i) {
+            x[i] = static_cast<float>(first + (static_cast<double>(last) - first) * i / (count - 1));
+        }
+        return x;
+    }
+
+    // count floats spread over every binade of positive floats
+    static std::vector<float> create_binades(size_t count)
+    {
+        std::vector<float> x(count);
+        for(size_t i = 0; i < count; ++i) {
+            x[i] = std::ldexp(1.0f + static_cast<float>(i % 997) / 997.0f, static_cast<int>(i % 277) - 149);
+        }
+        return x;
+    }
+
+public:
+    TEST_METHOD(sincos)
+    {
+        for_each_simd_level([]() {
+            // Arrange
+            std::vector<float> x = create_range(-51471.0f, 51471.0f, 100003);
+            const std::vector<float> small = create_range(-10.0f, 10.0f, 10007);
+            x.insert(x.end(), small.begin(), small.end());
+            std::vector<float> s(x.size()), c(x.size()), s2(x.size()), c2(x.size());
+
+            // Act
+            batch::sin(x.data(), s.data(), x.size());
+            batch::cos(x.data(), c.data(), x.size());
+            batch::sincos(x.data(), s2.data(), c2.data(), x.size());
+
+            // Assert
+            assert_ulps(x, s, TrigUlps, [](double d) { return std::sin(d); });
+            assert_ulps(x, c, TrigUlps, [](double d) { return std::cos(d); });
+            for(size_t i = 0; i < x.size(); ++i) {
+                Assert::AreEqual(s[i], s2[i]);
+                Assert::AreEqual(c[i], c2[i]);
+            }
+        });
+    }
+
+    TEST_METHOD(trig_special)
+    {
+        for_each_simd_level([]() {
+            // Arrange
+            const float x[] = { 0.0f, HUGE_VALF, -HUGE_VALF, NAN, 1.0e30f };
+            float s[5], c[5];
+
+            // Act
+            batch::sincos(x, s, c, 5);
+
+            // Assert
+            Assert::AreEqual(0.0f, s[0]);
+            Assert::AreEqual(1.0f, c[0]);
+            for(size_t i = 1; i < 4; ++i) {
+                Assert::IsTrue(std::isnan(s[i]) && std::isnan(c[i]));
+            }
+
+            // meaningless but in range
+            Assert::IsTrue(std::fabs(s[4]) <= 1.0f && std::fabs(c[4]) <= 1.0f);
+        });
+    }
+
+    TEST_METHOD(atan)
+    {
+        for_each_simd_level([]() {
+            // Arrange
+            std::vector<float> x = create_binades(100003);
+            const std::vector<float> small = create_range(-4.0f, 4.0f, 10007);
+            x.insert(x.end(), small.begin(), small.end());
+            x.push_back(HUGE_VALF);
+            x.push_back(-HUGE_VALF);
+            std::vector<float> r(x.size());
+
+            // Act
+            batch::atan(x.data(), r.data(), x.size());
+
+            // Assert
+            assert_ulps(x, r, AtanUlps, [](double d) { return std::atan(d); });
+        });
+    }
+
+    TEST_METHOD(atan2)
+    {
+        for_each_simd_level([]() {
+            // Arrange
+            const std::vector<float> angles = create_range(-3.14159f, 3.14159f, 10007);
+            std::vector<float> y, x;
+            for(size_t i = 0; i < angles.size(); ++i) {
+                const float length = std::ldexp(1.0f, static_cast<int>(i % 41) - 20);
+                y.push_back(length * std::sin(angles[i]));
+                x.push_back(length * std::cos(angles[i]));
+            }
+
+            // the axes and signed zeros
+            const float ey[] = { 0.0f, -0.0f, 0.0f, -0.0f, 1.0f, -1.0f, 0.0f, 0.0f, HUGE_VALF, 1.0f };
+            const float ex[] = { 0.0f, 0.0f, -0.0f, -0.0f, 0.0f, 0.0f, 1.0f, -1.0f, 1.0f, HUGE_VALF };
+            y.insert(y.end(), std::begin(ey), std::end(ey));
+            x.insert(x.end(), std::begin(ex), std::end(ex));
+            std::vector<float> r(x.size());
+
+            // Act
+            batch::atan2(y.data(), x.data(), r.data(), x.size());
+
+            // Assert
+            for(size_t i = 0; i < x.size(); ++i) {
+                const double expected = std::atan2(static_cast<double>(y[i]), static_cast<double>(x[i]));
+                Assert::IsTrue(ulps(expected, r[i]) <= Atan2Ulps);
+                Assert::AreEqual(std::signbit(expected), std::signbit(r[i]));
+            }
+        });
+    }
+
+    TEST_METHOD(acos)
+    {
+        for_each_simd_level([]() {
+            // Arrange
+            std::vector<float> x = create_range(-1.0f, 1.0f, 100003);
+            const float near_one[] = { 1.0f - FLT_EPSILON / 2.0f, -1.0f + FLT_EPSILON / 2.0f, 0.5f, -0.5f, 0.0f, -0.0f };
+            x.insert(x.end(), std::begin(near_one), std::end(near_one));
+            std::vector<float> r(x.size());
+            const float outside[] = { 1.0f + FLT_EPSILON, -2.0f, NAN };
+            float ro[3];
+
+            // Act
+            batch::acos(x.data(), r.data(), x.size());
+            batch::acos(outside, ro, 3);
+
+            // Assert
+            assert_ulps(x, r, AcosUlps, [](double d) { return std::acos(d); });
+            for(float f : ro) {
+                Assert::IsTrue(std::isnan(f));
+            }
+        });
+    }
+
+    TEST_METHOD(exp)
+    {
+        for_each_simd_level([]() {
+            // Arrange
+            std::vector<float> x = create_range(-103.0f, 88.7f, 100003);
+            const float edges[] = { 0.0f, -0.0f, 88.72f, 88.73f, -87.33f, -87.34f, -103.97f, -104.0f, -1000.0f, 1000.0f, HUGE_VALF, -HUGE_VALF };
+            x.insert(x.end(), std::begin(edges), std::end(edges));
+            std::vector<float> r(x.size());
+
+            // Act
+            batch::exp(x.data(), r.data(), x.size());
+
+            // Assert
+            assert_ulps(x, r, ExpUlps, [](double d) { return std::exp(d); });
+        });
+    }
+
+    TEST_METHOD(log)
+    {
+        for_each_simd_level([]() {
+            // Arrange
+            std::vector<float> x = create_binades(100003);
+            x.push_back(FLT_MAX);
+            x.push_back(FLT_MIN);
+            x.push_back(1.0f);
+            std::vector<float> r(x.size());
+            const float special[] = { 0.0f, -0.0f, -1.0f, HUGE_VALF, NAN };
+            float rs[5];
+
+            // Act
+            batch::log(x.data(), r.data(), x.size());
+            batch::log(special, rs, 5);
+
+            // Assert
+            assert_ulps(x, r, LogUlps, [](double d) { return std::log(d); });
+            Assert::AreEqual(-HUGE_VALF, rs[0]);
+            Assert::AreEqual(-HUGE_VALF, rs[1]);
+            Assert::IsTrue(std::isnan(rs[2]));
+            Assert::AreEqual(HUGE_VALF, rs[3]);
+            Assert::IsTrue(std::isnan(rs[4]));
+        });
+    }
+};
+
+} } }
@@ -0,0 +1,236 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Core/Math/Matrix4.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace math {
+namespace unittests {
+
+TEST_CLASS(Matrix4Tests)
+{
+private:
+    Matrix4 create_test_matrix()
+    {
+        return Matrix4(
+            Vector(2.0f, 0.5f, -1.0f, 0.25f),
+            Vector(1.0f, 3.0f, 0.0f, -0.5f),
+            Vector(0.0f, -2.0f, 4.0f, 1.0f),
+            Vector(1.5f, 1.0f, 2.0f, 1.0f)
+        );
+    }
+
+    Matrix4 create_test_affine()
+    {
+        return Matrix4::translation(Vector(1.0f, -2.0f, 3.0f))
+            * Matrix4::rotation(Vector(1.0f, 1.0f, 0.0f), 0.75f)
+            * Matrix4::scale(Vector(2.0f, 0.5f, 3.0f));
+    }
+
+    void assert_equal(const Vector& expected, const Vector& actual)
+    {
+        Assert::AreEqual(expected.x(), actual.x(), 0.0001f);
+        Assert::AreEqual(expected.y(), actual.y(), 0.0001f);
+        Assert::AreEqual(expected.z(), actual.z(), 0.0001f);
+        Assert::AreEqual(expected.w(), actual.w(), 0.0001f);
+    }
+
+    void assert_equal(const Matrix4& expected, const Matrix4& actual)
+    {
+        for(int i = 0; i < 4; ++i) {
+            assert_equal(expected.column(i), actual.column(i));
+        }
+    }
+
+public:
+    TEST_METHOD(layout)
+    {
+        // Arrange
+        Matrix4 m1 = create_test_matrix();
+
+        // Act
+
+        // Assert
+        Assert::AreEqual(static_cast<size_t>(64), sizeof(Matrix4));
+        Assert::AreEqual(static_cast<size_t>(0), reinterpret_cast<size_t>(m1.array()) % 16);
+        Assert::AreEqual(0.5f, m1(1, 0));
+        Assert::AreEqual(1.0f, m1(0, 1));
+        Assert::AreEqual(0.5f, m1.array()[1]);
+        Assert::IsTrue(Vector(1.5f, 1.0f, 2.0f, 1.0f) == m1.column(3));
+        Assert::IsTrue(Vector(2.0f, 1.0f, 0.0f, 1.5f) == m1.row(0));
+    }
+
+    TEST_METHOD(identity)
+    {
+        // Arrange
+        Matrix4 m1;
+        Matrix4 m2 = create_test_matrix();
+
+        // Act
+
+        // Assert
+        Assert::IsTrue(Matrix4::Identity == m1);
+        Assert::IsTrue(m2 == m1 * m2);
+        Assert::IsTrue(m2 == m2 * m1);
+    }
+
+    TEST_METHOD(transposed)
+    {
+        // Arrange
+        Matrix4 m1 = create_test_matrix();
+
+        // Act
+        Matrix4 m2 = m1.transposed();
+
+        // Assert
+        for(int i = 0; i < 4; ++i) {
+            Assert::IsTrue(m1.row(i) == m2.column(i));
+        }
+    }
+
+    TEST_METHOD(operator_multiply)
+    {
+        // Arrange
+        Matrix4 m1 = create_test_matrix();
+        Matrix4 m2 = m1.transposed();
+        Matrix4 expected = Matrix4::Zero;
+        for(int row = 0; row < 4; ++row) {
+            for(int col = 0; col < 4; ++col) {
+                expected(row, col) = m1.row(row) * m2.column(col);
+            }
+        }
+
+        // Act
+        Matrix4 m3 = m1 * m2;
+        m1 *= m2;
+
+        // Assert
+        assert_equal(expected, m3);
+        assert_equal(expected, m1);
+    }
+
+    TEST_METHOD(operator_multiply_vector)
+    {
+        // Arrange
+        Matrix4 m1 = create_test_matrix();
+        Vector v1(1.0f, 2.0f, 3.0f, 4.0f);
+        Vector expected(m1.row(0) * v1, m1.row(1) * v1, m1.row(2) * v1, m1.row(3) * v1);
+
+        // Act
+        Vector v2 = m1 * v1;
+
+        // Assert
+        assert_equal(expected, v2);
+    }
+
+    TEST_METHOD(transform_point_direction)
+    {
+        // Arrange
+        Matrix4 m1 = Matrix4::translation(Vector(1.0f, 2.0f, 3.0f)) * Matrix4::scale(2.0f);
+        Vector v1(1.0f, 1.0f, 1.0f);
+
+        // Act
+        Vector point = m1.transform_point(v1);
+        Vector direction = m1.transform_direction(v1);
+
+        // Assert
+        assert_equal(Vector(3.0f, 4.0f, 5.0f, 1.0f), point);
+        assert_equal(Vector(2.0f, 2.0f, 2.0f, 0.0f), direction);
+    }
+
+    TEST_METHOD(rotation)
+    {
+        // Arrange
+        Matrix4 m1 = Matrix4::rotation(Vector::ZAxis, static_cast<float>(M_PI_2));
+
+        // Act
+        Vector v1 = m1.transform_direction(Vector::XAxis);
+
+        // Assert
+        assert_equal(Vector::YAxis, v1);
+        Assert::AreEqual(1.0f, m1.determinant(), 0.0001f);
+    }
+
+    TEST_METHOD(determinant)
+    {
+        // Arrange
+        Matrix4 m1 = Matrix4::scale(Vector(2.0f, 3.0f, 4.0f));
+        Matrix4 m2 = create_test_matrix();
+
+        // Act
+
+        // Assert
+        Assert::AreEqual(24.0f, m1.determinant(), 0.0001f);
+        Assert::AreEqual(m2.determinant(), m2.transposed().determinant(), 0.0001f);
+        Assert::AreEqual(0.0f, Matrix4::Zero.determinant());
+    }
+
+    TEST_METHOD(inverse)
+    {
+        // Arrange
+        Matrix4 m1 = create_test_matrix();
+
+        // Act
+        Matrix4 m2 = m1.inverse();
+
+        // Assert
+        assert_equal(Matrix4::Identity, m1 * m2);
+        assert_equal(Matrix4::Identity, m2 * m1);
+    }
+
+    TEST_METHOD(affine_inverse)
+    {
+        // Arrange
+        Matrix4 m1 = create_test_affine();
+
+        // Act
+        Matrix4 m2 = m1.affine_inverse();
+
+        // Assert
+        Assert::IsTrue(m1.is_affine());
+        assert_equal(m1.inverse(), m2);
+        assert_equal(Matrix4::Identity, m1 * m2);
+    }
+
+    TEST_METHOD(look_at)
+    {
+        // Arrange
+        Vector eye(1.0f, 2.0f, 3.0f);
+
+        // Act
+        Matrix4 m1 = Matrix4::look_at(eye, Vector(1.0f, 2.0f, -10.0f), Vector::Up);
+
+        // Assert
+        assert_equal(Vector(0.0f, 0.0f, 0.0f, 1.0f), m1.transform_point(eye));
+        assert_equal(Vector(0.0f, 0.0f, -5.0f, 1.0f), m1.transform_point(eye + Vector::Forward * 5.0f));
+    }
+
+    TEST_METHOD(perspective)
+    {
+        // Arrange
+        Matrix4 m1 = Matrix4::perspective(static_cast<float>(M_PI_2), 1.0f, 1.0f, 100.0f);
+
+        // Act
+        Vector near_plane = m1.transform_point(Vector(0.0f, 0.0f, -1.0f));
+        Vector far_plane = m1.transform_point(Vector(0.0f, 0.0f, -100.0f));
+
+        // Assert
+        Assert::AreEqual(-1.0f, near_plane.z() / near_plane.w(), 0.0001f);
+        Assert::AreEqual(1.0f, far_plane.z() / far_plane.w(), 0.0001f);
+    }
+
+    TEST_METHOD(orthographic)
+    {
+        // Arrange
+        Matrix4 m1 = Matrix4::orthographic(-2.0f, 2.0f, -1.0f, 1.0f, 1.0f, 10.0f);
+
+        // Act
+        Vector v1 = m1.transform_point(Vector(2.0f, -1.0f, -10.0f));
+
+        // Assert
+        assert_equal(Vector(1.0f, -1.0f, 1.0f, 1.0f), v1);
+    }
+};
+
+} } }
@@ -0,0 +1,68 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Core/Math/Plane.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace math {
+namespace unittests {
+
+TEST_CLASS(PlaneTests)
+{
+public:
+    TEST_METHOD(constructor)
+    {
+        // Arrange
+        Plane p1;
+        Plane p2(Vector(0.0f, 0.0f, 1.0f), -2.0f);
+        Plane p3 = Plane::from_point_normal(Point3(1.0f, 2.0f, 3.0f), Vector(1.0f, 0.0f, 0.0f));
+        Plane p4 = Plane::from_points(Point3(0.0f, 0.0f, 5.0f), Point3(1.0f, 0.0f, 5.0f), Point3(0.0f, 1.0f, 5.0f));
+
+        // Act
+
+        // Assert
+        Assert::IsTrue(Vector(0.0f, 1.0f, 0.0f) == p1.normal());
+        Assert::AreEqual(0.0f, p1.d());
+        Assert::IsTrue(Vector(0.0f, 0.0f, 1.0f, -2.0f) == p2.vector());
+        Assert::IsTrue(Vector(1.0f, 0.0f, 0.0f, -1.0f) == p3.vector());
+        Assert::AreEqual(0.0f, p4.normal().x());
+        Assert::AreEqual(0.0f, p4.normal().y());
+        Assert::AreEqual(1.0f, p4.normal().z(), 0.0001f);
+        Assert::AreEqual(-5.0f, p4.d(), 0.0001f);
+    }
+
+    TEST_METHOD(distance)
+    {
+        // Arrange
+        Plane p(Vector(0.0f, 0.0f, 1.0f), -2.0f);
+
+        // Act
+
+        // Assert
+        // w of the point doesn't matter
+        Assert::AreEqual(3.0f, p.distance(Point3(7.0f, -4.0f, 5.0f, 9.0f)));
+        Assert::AreEqual(-2.0f, p.distance(Point3::Zero));
+        Assert::IsTrue(p.in_front(Point3(0.0f, 0.0f, 2.0f)));
+        Assert::IsFalse(p.in_front(Point3(0.0f, 0.0f, 1.9f)));
+        Assert::IsTrue(Point3(7.0f, -4.0f, 2.0f) == p.project(Point3(7.0f, -4.0f, 5.0f)));
+    }
+
+    TEST_METHOD(normalize)
+    {
+        // Arrange
+        Plane p(Vector(0.0f, 3.0f, 4.0f), 10.0f);
+
+        // Act
+        Plane n = p.normalized();
+        Plane f = n.flipped();
+
+        // Assert
+        Assert::AreEqual(1.0f, n.normal().length(), 0.0001f);
+        Assert::AreEqual(2.0f, n.d(), 0.0001f);
+        Assert::AreEqual(p.distance(Point3(1.0f, 2.0f, 3.0f)) / 5.0f, n.distance(Point3(1.0f, 2.0f, 3.0f)), 0.0001f);
+        Assert::AreEqual(-n.distance(Point3(1.0f, 2.0f, 3.0f)), f.distance(Point3(1.0f, 2.0f, 3.0f)));
+    }
+};
+
+} } }
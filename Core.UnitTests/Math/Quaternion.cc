@@ -0,0 +1,144 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Core/Math/Quaternion.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace math {
+namespace unittests {
+
+TEST_CLASS(QuaternionTests)
+{
+private:
+    void assert_equal(const Vector& expected, const Vector& actual)
+    {
+        Assert::AreEqual(expected.x(), actual.x(), 0.0001f);
+        Assert::AreEqual(expected.y(), actual.y(), 0.0001f);
+        Assert::AreEqual(expected.z(), actual.z(), 0.0001f);
+        Assert::AreEqual(expected.w(), actual.w(), 0.0001f);
+    }
+
+    // q and -q are the same rotation
+    void assert_equal(const Quaternion& expected, const Quaternion& actual)
+    {
+        const float sign = expected.dot(actual) < 0.0f ? -1.0f : 1.0f;
+        Assert::AreEqual(expected.x(), sign * actual.x(), 0.0001f);
+        Assert::AreEqual(expected.y(), sign * actual.y(), 0.0001f);
+        Assert::AreEqual(expected.z(), sign * actual.z(), 0.0001f);
+        Assert::AreEqual(expected.w(), sign * actual.w(), 0.0001f);
+    }
+
+public:
+    TEST_METHOD(layout)
+    {
+        // Arrange
+        Quaternion q1(1.0f, 2.0f, 3.0f, 4.0f);
+
+        // Act
+        VectorStorage s = q1.storage();
+
+        // Assert
+        Assert::AreEqual(sizeof(Vector), sizeof(Quaternion));
+        Assert::AreEqual(4.0f, s.w);
+        Assert::IsTrue(q1 == Quaternion(s));
+        Assert::IsTrue(Quaternion::Identity == Quaternion());
+    }
+
+    TEST_METHOD(axis_angle)
+    {
+        // Arrange
+        Quaternion q1 = Quaternion::axis_angle(Vector::ZAxis, static_cast<float>(M_PI_2));
+
+        // Act
+        Vector v1 = q1.rotate(Vector::XAxis);
+        Vector v2 = q1 * Vector(1.0f, 0.0f, 0.0f, 1.0f);
+
+        // Assert
+        Assert::AreEqual(1.0f, q1.length(), 0.0001f);
+        assert_equal(Vector::YAxis, v1);
+        assert_equal(Vector(0.0f, 1.0f, 0.0f, 1.0f), v2);
+    }
+
+    TEST_METHOD(operator_multiply)
+    {
+        // Arrange
+        Quaternion q1 = Quaternion::axis_angle(Vector(1.0f, 2.0f, 3.0f), 0.5f);
+        Quaternion q2 = Quaternion::axis_angle(Vector(-1.0f, 0.5f, 2.0f), 1.25f);
+        Vector v1(0.5f, -1.0f, 2.0f);
+
+        // Act
+        Quaternion q3 = q1 * q2;
+
+        // Assert
+        assert_equal(q1.rotate(q2.rotate(v1)), q3.rotate(v1));
+        Assert::IsTrue(Quaternion(24.0f, 48.0f, 48.0f, -6.0f) == Quaternion(1.0f, 2.0f, 3.0f, 4.0f) * Quaternion(5.0f, 6.0f, 7.0f, 8.0f));
+        Assert::IsTrue(Quaternion(0.0f, 0.0f, 1.0f, 0.0f) == Quaternion(1.0f, 0.0f, 0.0f, 0.0f) * Quaternion(0.0f, 1.0f, 0.0f, 0.0f));
+    }
+
+    TEST_METHOD(inverse)
+    {
+        // Arrange
+        Quaternion q1 = Quaternion::axis_angle(Vector(1.0f, 2.0f, 3.0f), 0.5f);
+
+        // Act
+        Quaternion q2 = q1 * q1.conjugate();
+        Quaternion q3 = q1 * q1.inverse();
+
+        // Assert
+        assert_equal(Quaternion::Identity, q2);
+        assert_equal(Quaternion::Identity, q3);
+    }
+
+    TEST_METHOD(matrix)
+    {
+        // Arrange
+        Quaternion q1 = Quaternion::axis_angle(Vector(1.0f, -2.0f, 0.5f), 2.0f);
+        Vector v1(0.5f, -1.0f, 2.0f);
+
+        // Act
+        Matrix4 m1 = q1.matrix();
+        Quaternion q2 = Quaternion::from_matrix(m1);
+
+        // Assert
+        assert_equal(q1.rotate(v1), m1.transform_direction(v1));
+        assert_equal(Matrix4::rotation(Vector(1.0f, -2.0f, 0.5f), 2.0f).transform_direction(v1), m1.transform_direction(v1));
+        assert_equal(q1, q2);
+    }
+
+    TEST_METHOD(from_matrix_branches)
+    {
+        // Arrange
+        // the near-180 degree rotations around each axis take the other branches
+        const Vector axes[] = { Vector::XAxis, Vector::YAxis, Vector::ZAxis, Vector(1.0f, 1.0f, 1.0f) };
+
+        // Act
+
+        // Assert
+        for(const Vector& axis : axes) {
+            Quaternion q1 = Quaternion::axis_angle(axis, 3.0f);
+            assert_equal(q1, Quaternion::from_matrix(q1.matrix()));
+        }
+    }
+
+    TEST_METHOD(nlerp_slerp)
+    {
+        // Arrange
+        Quaternion q1 = Quaternion::axis_angle(Vector::YAxis, 0.0f);
+        Quaternion q2 = Quaternion::axis_angle(Vector::YAxis, 2.0f);
+
+        // Act
+        Quaternion slerp = q1.slerp(q2, 0.25f);
+        Quaternion nlerp = q1.nlerp(q2, 0.5f);
+
+        // Assert
+        assert_equal(Quaternion::axis_angle(Vector::YAxis, 0.5f), slerp);
+        assert_equal(Quaternion::axis_angle(Vector::YAxis, 1.0f), nlerp);
+        assert_equal(q1, q1.slerp(q2, 0.0f));
+        assert_equal(q2, q1.slerp(q2, 1.0f));
+        assert_equal(q2, q1.slerp(-q2, 1.0f));
+        assert_equal(q2, q2.slerp(q2, 0.5f));
+    }
+};
+
+} } }
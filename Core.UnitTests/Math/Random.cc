@@ -0,0 +1,220 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Core/Math/SIMD/Kernels.h"
+#include "Core/Math/Random.h"
+#include "Core.UnitTests/UnitTests.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace math {
+namespace unittests {
+
+// not a multiple of RandomLanes::Lanes so that the kernels have to handle a partial block
+static const size_t RandomSize = 1001;
+
+TEST_CLASS(RandomTests)
+{
+public:
+    TEST_METHOD(xoshiro256_reference)
+    {
+        // Arrange
+        Xoshiro256 engine(1, 2, 3, 4);
+
+        // Act
+        uint64_t first = engine();
+
+        // Assert
+        Assert::AreEqual(static_cast<uint64_t>(11520), first);
+    }
+
+    TEST_METHOD(xoshiro256_seed)
+    {
+        // Arrange
+        Xoshiro256 e1(1234), e2(1234), e3(1234);
+
+        // Act
+        e3.jump();
+
+        // Assert
+        for(int i = 0; i < 100; ++i) {
+            const uint64_t v = e1();
+            Assert::AreEqual(v, e2());
+            Assert::AreNotEqual(v, e3());
+        }
+    }
+
+    TEST_METHOD(pcg32_reference)
+    {
+        // Arrange
+        static const uint32_t Expected[] = { 0xa15c02b7, 0x7b47f409, 0xba1d3330, 0x83d2f293, 0xbfa4784b, 0xcbed606e };
+        PCG32 engine(42, 54);
+
+        // Act
+
+        // Assert
+        for(uint32_t expected : Expected) {
+            Assert::AreEqual(expected, engine());
+        }
+    }
+
+    TEST_METHOD(standard_distribution)
+    {
+        // Arrange
+        Xoshiro256 engine(5);
+        std::uniform_int_distribution<int> distribution(1, 6);
+
+        // Act
+
+        // Assert
+        for(int i = 0; i < 100; ++i) {
+            const int v = distribution(engine);
+            Assert::IsTrue(v >= 1 && v <= 6);
+        }
+    }
+
+    TEST_METHOD(thread_random_reproducible)
+    {
+        // Arrange
+        seed_thread_random(99);
+        const Vector v1 = Vector::random();
+        const float f1 = thread_random().uniform();
+
+        // Act
+        seed_thread_random(99);
+        const Vector v2 = Vector::random();
+        const float f2 = thread_random().uniform();
+
+        // Assert
+        Assert::IsTrue(v1 == v2);
+        Assert::AreEqual(f1, f2);
+    }
+
+    TEST_METHOD(uniform)
+    {
+        for_each_simd_level([]() {
+            // Arrange
+            Random random(7);
+            std::vector<float> values(RandomSize);
+
+            // Act
+            random.uniform(values.data(), values.size());
+
+            // Assert
+            double sum = 0.0;
+            for(float v : values) {
+                Assert::IsTrue(v >= 0.0f && v < 1.0f);
+                sum += v;
+            }
+            Assert::AreEqual(0.5, sum / values.size(), 0.05);
+        });
+    }
+
+    TEST_METHOD(uniform_simd_levels)
+    {
+        // Arrange
+        std::vector<float> expected(RandomSize);
+        std::vector<float> actual(RandomSize);
+
+        {
+            const ScopedSimdLevel scalar(SimdLevel::Scalar);
+            Random(11).uniform(expected.data(), expected.size());
+        }
+
+        // Act
+        {
+            const ScopedSimdLevel best(max_simd_level());
+            Random(11).uniform(actual.data(), actual.size());
+        }
+
+        // Assert
+        for(size_t i = 0; i < RandomSize; ++i) {
+            Assert::AreEqual(expected[i], actual[i]);
+        }
+    }
+
+    TEST_METHOD(unit_vectors)
+    {
+        for_each_simd_level([]() {
+            // Arrange
+            Random random(13);
+            std::vector<Vector> vectors(RandomSize);
+
+            // Act
+            random.unit_vectors(vectors.data(), vectors.size());
+
+            // Assert
+            Vector sum;
+            for(const Vector& v : vectors) {
+                Assert::AreEqual(1.0f, v.length(), 0.0001f);
+                Assert::AreEqual(0.0f, v.w());
+                sum += v;
+            }
+            Assert::IsTrue((sum / static_cast<float>(RandomSize)).length() < 0.1f);
+        });
+    }
+
+    TEST_METHOD(in_sphere)
+    {
+        for_each_simd_level([]() {
+            // Arrange
+            Random random(17);
+            std::vector<Vector> vectors(RandomSize);
+
+            // Act
+            random.in_sphere(vectors.data(), vectors.size(), 3.0f);
+
+            // Assert
+            for(const Vector& v : vectors) {
+                Assert::IsTrue(v.length() <= 3.0001f);
+                Assert::AreEqual(0.0f, v.w());
+            }
+            Assert::IsTrue(random.in_sphere(3.0f).length() <= 3.0001f);
+        });
+    }
+
+    TEST_METHOD(in_box)
+    {
+        for_each_simd_level([]() {
+            // Arrange
+            Random random(19);
+            const Vector min(-1.0f, 2.0f, -10.0f);
+            const Vector max(1.0f, 3.0f, 10.0f);
+            std::vector<Vector> vectors(RandomSize);
+
+            // Act
+            random.in_box(vectors.data(), vectors.size(), min, max);
+            vectors.push_back(random.in_box(min, max));
+
+            // Assert
+            for(const Vector& v : vectors) {
+                Assert::IsTrue(v.x() >= min.x() && v.x() <= max.x());
+                Assert::IsTrue(v.y() >= min.y() && v.y() <= max.y());
+                Assert::IsTrue(v.z() >= min.z() && v.z() <= max.z());
+                Assert::AreEqual(0.0f, v.w());
+            }
+        });
+    }
+
+    TEST_METHOD(colors)
+    {
+        for_each_simd_level([]() {
+            // Arrange
+            Random random(23);
+            std::vector<Vector> colors(RandomSize);
+
+            // Act
+            random.colors(colors.data(), colors.size());
+
+            // Assert
+            for(const Vector& c : colors) {
+                Assert::IsTrue(c.x() >= 0.0f && c.x() < 1.0f);
+                Assert::IsTrue(c.y() >= 0.0f && c.y() < 1.0f);
+                Assert::IsTrue(c.z() >= 0.0f && c.z() < 1.0f);
+                Assert::AreEqual(1.0f, c.w());
+            }
+        });
+    }
+};
+
+} } }
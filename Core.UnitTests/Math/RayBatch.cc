@@ -0,0 +1,288 @@
+#include "pch.h"
+#include <limits>
+#include "CppUnitTest.h"
+#include "Core/Math/SIMD/Kernels.h"
+#include "Core/Math/Random.h"
+#include "Core/Math/RayBatch.h"
+#include "Core.UnitTests/UnitTests.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace math {
+namespace unittests {
+
+// odd-sized so that every kernel has to handle a remainder
+// and more than 32 so the hits span two words
+static const size_t RayCount = 37;
+
+static const float Infinity = std::numeric_limits<float>::infinity();
+
+TEST_CLASS(RayBatchTests)
+{
+private:
+    static bool is_hit(const std::vector<uint32_t>& hits, size_t i)
+    {
+        return 0 != (hits[i / 32] & (1u << (i % 32)));
+    }
+
+    // rays along +x at increasing heights, from x = -10
+    static void create_parallel_rays(VectorStream& origins, VectorStream& directions)
+    {
+        for(size_t i = 0; i < RayCount; ++i) {
+            origins.push_back(Point3(-10.0f, static_cast<float>(i) * 0.25f - 4.5f, 0.0f));
+            directions.push_back(Vector(1.0f, 0.0f, 0.0f));
+        }
+    }
+
+public:
+    TEST_METHOD(intersect_sphere)
+    {
+        for_each_simd_level([]() {
+            // Arrange
+            VectorStream origins, directions;
+            create_parallel_rays(origins, directions);
+
+            // the last ray starts inside of the sphere and leaves it at x = 3
+            origins.set(RayCount - 1, Point3(1.0f, 0.0f, 0.0f));
+
+            std::vector<float> t(RayCount, Infinity);
+            std::vector<uint32_t> hits((RayCount + 31) / 32, 0xffffffff);
+
+            // Act
+            size_t count = batch::intersect_sphere(origins, directions, Point3(1.0f, 0.0f, 0.0f), 2.0f, t.data(), hits.data());
+
+            // Assert
+            size_t expected = 0;
+            for(size_t i = 0; i < RayCount - 1; ++i) {
+                const float y = origins[i].y();
+                const bool hit = std::fabs(y) <= 2.0f;
+                Assert::AreEqual(hit, is_hit(hits, i));
+                if(hit) {
+                    Assert::AreEqual(11.0f - std::sqrt(4.0f - y * y), t[i], 0.0001f);
+                    ++expected;
+                } else {
+                    Assert::AreEqual(Infinity, t[i]);
+                }
+            }
+            Assert::IsTrue(is_hit(hits, RayCount - 1));
+            Assert::AreEqual(2.0f, t[RayCount - 1], 0.0001f);
+            Assert::AreEqual(expected + 1, count);
+        });
+    }
+
+    TEST_METHOD(intersect_plane)
+    {
+        for_each_simd_level([]() {
+            // Arrange
+            VectorStream origins, directions;
+            for(size_t i = 0; i < RayCount; ++i) {
+                // every third ray goes away from the plane, parallel to it or towards it
+                const float dz = static_cast<float>(i % 3) - 1.0f;
+                origins.push_back(Point3(static_cast<float>(i), 0.0f, 4.0f));
+                directions.push_back(Vector(0.0f, 1.0f, dz));
+            }
+
+            // z = 2 from both sides
+            const Vector plane(0.0f, 0.0f, -1.0f, 2.0f);
+
+            std::vector<float> t(RayCount, Infinity);
+            std::vector<uint32_t> hits((RayCount + 31) / 32, 0xffffffff);
+
+            // Act
+            size_t count = batch::intersect_plane(origins, directions, plane, t.data(), hits.data());
+
+            // Assert
+            size_t expected = 0;
+            for(size_t i = 0; i < RayCount; ++i) {
+                const bool hit = 0 == i % 3;
+                Assert::AreEqual(hit, is_hit(hits, i));
+                Assert::AreEqual(hit ? 2.0f : Infinity, t[i]);
+                expected += hit ? 1 : 0;
+            }
+            Assert::AreEqual(expected, count);
+        });
+    }
+
+    TEST_METHOD(intersect_aabb)
+    {
+        for_each_simd_level([]() {
+            // Arrange
+            const AABB box(Point3(-1.0f, -2.0f, -3.0f), Point3(2.0f, 1.0f, 0.5f));
+
+            // rays fanned out from a few origins, some of them inside of the box
+            VectorStream origins, directions;
+            for(size_t i = 0; i < RayCount; ++i) {
+                const float f = static_cast<float>(i);
+                origins.push_back(Point3(-4.0f + 0.25f * f, 3.0f - 0.125f * f, -2.0f));
+                directions.push_back(Vector(std::cos(f), std::sin(f), 0.5f - 0.03f * f));
+            }
+
+            // a short limit on some rays
+            std::vector<float> t(RayCount);
+            for(size_t i = 0; i < RayCount; ++i) {
+                t[i] = 0 == i % 4 ? 1.0f : Infinity;
+            }
+            const std::vector<float> t_max(t);
+            std::vector<uint32_t> hits((RayCount + 31) / 32, 0);
+
+            // Act
+            size_t count = batch::intersect_aabb(origins, directions, box, t.data(), hits.data());
+
+            // Assert
+            size_t expected = 0;
+            for(size_t i = 0; i < RayCount; ++i) {
+                const Vector d = directions[i];
+                const Vector inv_direction(1.0f / d.x(), 1.0f / d.y(), 1.0f / d.z());
+
+                float t_hit = t_max[i];
+                const bool hit = box.intersect_ray(origins[i], inv_direction, 0.0f, t_max[i], t_hit);
+                Assert::AreEqual(hit, is_hit(hits, i));
+                if(hit) {
+                    Assert::AreEqual(t_hit, t[i], 0.0001f);
+                } else {
+                    Assert::AreEqual(t_max[i], t[i]);
+                }
+                expected += hit ? 1 : 0;
+            }
+            Assert::AreEqual(expected, count);
+            Assert::IsTrue(count > 0 && count < RayCount);
+        });
+    }
+
+    TEST_METHOD(intersect_aabb_empty)
+    {
+        // Arrange
+        VectorStream origins, directions;
+        create_parallel_rays(origins, directions);
+
+        std::vector<float> t(RayCount, Infinity);
+        std::vector<uint32_t> hits((RayCount + 31) / 32, 0xffffffff);
+
+        // Act
+        size_t count = batch::intersect_aabb(origins, directions, AABB::Empty, t.data(), hits.data());
+
+        // Assert
+        Assert::AreEqual(static_cast<size_t>(0), count);
+        Assert::AreEqual(0u, hits[0]);
+        Assert::AreEqual(0u, hits[1]);
+        Assert::AreEqual(Infinity, t[0]);
+    }
+
+    TEST_METHOD(intersect_triangle)
+    {
+        for_each_simd_level([]() {
+            // Arrange
+            VectorStream origins, directions;
+            for(size_t i = 0; i < RayCount; ++i) {
+                // a grid of rays down -z, the last one in the plane of the triangle
+                const float x = static_cast<float>(i % 6) * 0.5f - 0.7f;
+                const float y = static_cast<float>(i / 6) * 0.5f - 0.7f;
+                origins.push_back(Point3(x, y, 5.0f));
+                directions.push_back(Vector(0.0f, 0.0f, -2.0f));
+            }
+            origins.set(RayCount - 1, Point3(-1.0f, 0.5f, 1.0f));
+            directions.set(RayCount - 1, Vector(1.0f, 0.0f, 0.0f));
+
+            // at z = 1, facing away from the rays
+            const Point3 v0(0.0f, 0.0f, 1.0f), v1(0.0f, 2.0f, 1.0f), v2(2.0f, 0.0f, 1.0f);
+
+            std::vector<float> t(RayCount, Infinity);
+            std::vector<uint32_t> hits((RayCount + 31) / 32, 0xffffffff);
+
+            // Act
+            size_t count = batch::intersect_triangle(origins, directions, v0, v1, v2, t.data(), hits.data());
+
+            // Assert
+            size_t expected = 0;
+            for(size_t i = 0; i < RayCount - 1; ++i) {
+                const float x = origins[i].x(), y = origins[i].y();
+                const bool hit = x >= 0.0f && y >= 0.0f && x + y <= 2.0f;
+                Assert::AreEqual(hit, is_hit(hits, i));
+                if(hit) {
+                    Assert::AreEqual(2.0f, t[i], 0.0001f);
+                } else {
+                    Assert::AreEqual(Infinity, t[i]);
+                }
+                expected += hit ? 1 : 0;
+            }
+            Assert::IsFalse(is_hit(hits, RayCount - 1));
+            Assert::AreEqual(expected, count);
+        });
+    }
+
+    TEST_METHOD(closest_hit)
+    {
+        for_each_simd_level([]() {
+            // Arrange
+            VectorStream origins, directions;
+            create_parallel_rays(origins, directions);
+
+            std::vector<float> t(RayCount, Infinity);
+            std::vector<uint32_t> hits((RayCount + 31) / 32);
+
+            // Act
+            // a wall at x = 5 and then a sphere in front of it
+            size_t wall = batch::intersect_plane(origins, directions, Vector(-1.0f, 0.0f, 0.0f, 5.0f), t.data(), hits.data());
+            size_t sphere = batch::intersect_sphere(origins, directions, Point3::Zero, 1.0f, t.data(), hits.data());
+
+            // and another sphere behind the wall
+            size_t hidden = batch::intersect_sphere(origins, directions, Point3(8.0f, 0.0f, 0.0f), 2.0f, t.data(), hits.data());
+
+            // Assert
+            Assert::AreEqual(RayCount, wall);
+            Assert::AreEqual(static_cast<size_t>(9), sphere);
+            Assert::AreEqual(static_cast<size_t>(0), hidden);
+            for(size_t i = 0; i < RayCount; ++i) {
+                const float y = origins[i].y();
+                const float expected = std::fabs(y) <= 1.0f ? 10.0f - std::sqrt(1.0f - y * y) : 15.0f;
+                Assert::AreEqual(expected, t[i], 0.0001f);
+            }
+        });
+    }
+
+    TEST_METHOD(packed_arrays)
+    {
+        // Arrange
+        // enough rays for a few scratch chunks and a partial one
+        const size_t count = ScratchChunkSize * 2 + 101;
+
+        Random random(7);
+        std::vector<Vector> origins(count), directions(count);
+        for(size_t i = 0; i < count; ++i) {
+            origins[i] = random.in_box(Vector(-10.0f, -10.0f, -10.0f), Vector(10.0f, 10.0f, 10.0f));
+            directions[i] = random.in_box(Vector(-1.0f, -1.0f, -1.0f), Vector(1.0f, 1.0f, 1.0f));
+        }
+        const VectorStream origin_stream(origins.data(), count), direction_stream(directions.data(), count);
+
+        std::vector<float> expected_t(count, Infinity), t(count, Infinity);
+        std::vector<uint32_t> expected_hits((count + 31) / 32), hits((count + 31) / 32);
+
+        // Act
+        size_t expected = 0, actual = 0;
+        expected += batch::intersect_sphere(origin_stream, direction_stream, Point3(1.0f, 2.0f, 3.0f), 4.0f, expected_t.data(), expected_hits.data());
+        actual += batch::intersect_sphere(origins.data(), directions.data(), count, Point3(1.0f, 2.0f, 3.0f), 4.0f, t.data(), hits.data());
+        Assert::IsTrue(expected_hits == hits);
+
+        expected += batch::intersect_plane(origin_stream, direction_stream, Vector(0.0f, 1.0f, 0.0f, 2.0f), expected_t.data(), expected_hits.data());
+        actual += batch::intersect_plane(origins.data(), directions.data(), count, Vector(0.0f, 1.0f, 0.0f, 2.0f), t.data(), hits.data());
+        Assert::IsTrue(expected_hits == hits);
+
+        const AABB box(Point3(-3.0f, -3.0f, -3.0f), Point3(0.0f, 1.0f, 2.0f));
+        expected += batch::intersect_aabb(origin_stream, direction_stream, box, expected_t.data(), expected_hits.data());
+        actual += batch::intersect_aabb(origins.data(), directions.data(), count, box, t.data(), hits.data());
+        Assert::IsTrue(expected_hits == hits);
+
+        const Point3 v0(-5.0f, 0.0f, -5.0f), v1(5.0f, 0.0f, -5.0f), v2(0.0f, 5.0f, 5.0f);
+        expected += batch::intersect_triangle(origin_stream, direction_stream, v0, v1, v2, expected_t.data(), expected_hits.data());
+        actual += batch::intersect_triangle(origins.data(), directions.data(), count, v0, v1, v2, t.data(), hits.data());
+        Assert::IsTrue(expected_hits == hits);
+
+        // Assert
+        Assert::IsTrue(expected > count / 2);
+        Assert::AreEqual(expected, actual);
+        Assert::IsTrue(expected_t == t);
+    }
+};
+
+} } }
@@ -0,0 +1,682 @@
+#include "pch.h"
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+#include "CppUnitTest.h"
+#include "Core/Math/SIMD/Kernels.h"
+#include "Core/Math/Random.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace math {
+namespace unittests {
+
+// differential tests that run every kernel of every supported tier
+// over the same random inputs as the scalar tier and compare the results
+//
+// results are compared in units in the last place (ulps) because the tiers
+// are allowed to differ in operation order (horizontal sums, fused multiply-add)
+// and in the hardware approximations they use for Precision::Approximate/Refined
+
+// not a multiple of any tier's width so that every kernel has to handle a remainder
+static const size_t DifferentialSize = 1021;
+
+// extra floats after every output that no kernel may write
+static const size_t Guard = 17;
+static const float Sentinel = -12345.5f;
+
+// the ray kernels start with t at this so that the far hits don't count
+static const float RayDistance = 64.0f;
+
+// ulp tolerances for each Precision relative to the scalar tier
+// Approximate covers the 12-bit rsqrt estimate of SSE/AVX (1.5 * 2^-12 relative),
+// Exact still differs by the rounding of the length_squared that feeds it
+static const int64_t ApproximateUlps = 1 << 13;
+static const int64_t RefinedUlps = 16;
+static const int64_t ExactUlps = 4;
+
+TEST_CLASS(KernelTests)
+{
+private:
+    // orders the floats on an integer line so that
+    // adjacent representable floats are 1 apart
+    static int64_t ordered(float f)
+    {
+        int32_t i;
+        std::memcpy(&i, &f, sizeof(i));
+        return i < 0 ? static_cast<int64_t>(INT32_MIN) - i : i;
+    }
+
+    static int64_t ulp_distance(float a, float b)
+    {
+        if(std::isnan(a) || std::isnan(b)) {
+            return std::isnan(a) && std::isnan(b) ? 0 : INT64_MAX;
+        }
+        return std::abs(ordered(a) - ordered(b));
+    }
+
+    static int64_t precision_ulps(Precision precision)
+    {
+        switch(precision)
+        {
+        case Precision::Approximate:
+            return ApproximateUlps;
+        case Precision::Refined:
+            return RefinedUlps;
+        case Precision::Exact:
+        default:
+            return ExactUlps;
+        }
+    }
+
+    // random inputs spread over a few orders of magnitude
+    static std::vector<float> create_test_floats(uint64_t seed, size_t count)
+    {
+        Random random(seed);
+        std::vector<float> floats(count);
+        for(float& f : floats) {
+            f = std::ldexp(random.uniform(-1.0f, 1.0f), static_cast<int>(random.uniform(-4.0f, 4.0f)));
+        }
+        return floats;
+    }
+
+    static float magnitude(const float* v)
+    {
+        return std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + v[3] * v[3]);
+    }
+
+    /*
+    Runs kernel against the scalar tier and every other supported tier
+    and checks that every output float of the other tiers is within max_ulps
+    of the scalar result.
+
+    kernel(table, r) writes its results to r, which has size floats
+    all initialized to Sentinel. Anything that the kernel is not supposed to
+    write must be left alone, so out-of-bounds writes are caught as well.
+
+    scale(i) is the magnitude of the terms that output i was computed from,
+    results that cancel to (nearly) 0 are compared against max_ulps of that instead
+    */
+    void assert_matches_scalar(size_t size, int64_t max_ulps, const std::function<float(size_t)>& scale,
+        const std::function<void(const KernelTable&, float*)>& kernel)
+    {
+        std::vector<float> expected(size, Sentinel);
+        kernel(kernels(SimdLevel::Scalar), expected.data());
+
+        for(int level = static_cast<int>(SimdLevel::Scalar) + 1; level <= static_cast<int>(max_simd_level()); ++level) {
+            const KernelTable& table = kernels(static_cast<SimdLevel>(level));
+
+            std::vector<float> actual(size, Sentinel);
+            kernel(table, actual.data());
+
+            for(size_t i = 0; i < size; ++i) {
+                const int64_t ulps = ulp_distance(expected[i], actual[i]);
+                const float tolerance = nullptr == scale ? 0.0f : static_cast<float>(max_ulps) * FLT_EPSILON * scale(i);
+                if(ulps > max_ulps && !(std::fabs(expected[i] - actual[i]) <= tolerance)) {
+                    std::wstringstream message;
+                    message << simd_level_name(table.level) << L" output " << i << L": " << ulps << L" ulps";
+                    Assert::AreEqual(expected[i], actual[i], tolerance, message.str().c_str());
+                }
+            }
+        }
+    }
+
+    void assert_matches_scalar(size_t size, int64_t max_ulps, const std::function<void(const KernelTable&, float*)>& kernel)
+    {
+        assert_matches_scalar(size, max_ulps, nullptr, kernel);
+    }
+
+private:
+    // packed Vectors (array-of-structures)
+    std::vector<float> _a = create_test_floats(1, DifferentialSize * 4);
+    std::vector<float> _b = create_test_floats(2, DifferentialSize * 4);
+
+    // the same Vectors as structure-of-arrays
+    std::vector<float> _as = transpose(_a);
+    std::vector<float> _bs = transpose(_b);
+
+    std::vector<float> _matrix = create_test_floats(3, 16);
+
+    static std::vector<float> transpose(const std::vector<float>& aos)
+    {
+        std::vector<float> soa(aos.size());
+        for(size_t i = 0; i < DifferentialSize; ++i) {
+            for(size_t c = 0; c < 4; ++c) {
+                soa[c * DifferentialSize + i] = aos[i * 4 + c];
+            }
+        }
+        return soa;
+    }
+
+    ConstStreamRef stream_a() const { return stream(_as.data()); }
+    ConstStreamRef stream_b() const { return stream(_bs.data()); }
+
+    static ConstStreamRef stream(const float* soa)
+    {
+        return ConstStreamRef(soa, soa + DifferentialSize, soa + 2 * DifferentialSize, soa + 3 * DifferentialSize);
+    }
+
+    // output streams are spaced out so that each component has its own guard
+    static const size_t StreamOutputSize = 4 * (DifferentialSize + Guard);
+
+    static StreamRef output_stream(float* r)
+    {
+        const size_t stride = DifferentialSize + Guard;
+        return { r, r + stride, r + 2 * stride, r + 3 * stride };
+    }
+
+    // the element that output i of an output_stream() belongs to
+    static size_t stream_element(size_t i)
+    {
+        return MIN(i % (DifferentialSize + Guard), DifferentialSize - 1);
+    }
+
+    // the element that output i of a packed Vector output belongs to
+    static size_t array_element(size_t i)
+    {
+        return MIN(i / 4, DifferentialSize - 1);
+    }
+
+    // |a| * |b|, the largest that any term of a dot or cross product can be
+    float product_scale(size_t element) const
+    {
+        return magnitude(_a.data() + element * 4) * magnitude(_b.data() + element * 4);
+    }
+
+    // rays from _a in the directions of _b against one primitive,
+    // the hit bits are written to the first DifferentialSize outputs
+    // as 0 or 1 and the distances to the next DifferentialSize
+    static const size_t RayOutputSize = 2 * DifferentialSize + Guard;
+
+    template<typename Kernel>
+    void run_ray_kernel(float* r, Kernel kernel) const
+    {
+        float* const t = r + DifferentialSize;
+        std::fill(t, t + DifferentialSize, RayDistance);
+
+        std::vector<uint32_t> hits((DifferentialSize + 31) / 32, 0xffffffff);
+        const size_t count = kernel(stream_a(), stream_b(), t, hits.data());
+
+        size_t expected = 0;
+        for(size_t i = 0; i < DifferentialSize; ++i) {
+            const bool hit = 0 != (hits[i / 32] & (1u << (i % 32)));
+            r[i] = hit ? 1.0f : 0.0f;
+            expected += hit ? 1 : 0;
+        }
+        Assert::AreEqual(expected, count);
+    }
+
+public:
+    TEST_METHOD(floats_invsqrt)
+    {
+        const std::vector<float> a = create_test_floats(4, DifferentialSize);
+        std::vector<float> positive(a.size());
+        std::transform(a.begin(), a.end(), positive.begin(), [](float f) { return std::fabs(f) + FLT_MIN; });
+
+        for(Precision precision : { Precision::Approximate, Precision::Refined, Precision::Exact }) {
+            assert_matches_scalar(DifferentialSize + Guard, precision_ulps(precision), [&](const KernelTable& k, float* r) {
+                k.floats.invsqrt(positive.data(), r, DifferentialSize, precision);
+            });
+        }
+    }
+
+    TEST_METHOD(floats_elementary)
+    {
+        // each tier is within a few ulps of the correctly rounded result (see MathBatch.h)
+        // so two tiers can be twice that apart
+        const int64_t max_ulps = 6;
+
+        // the random inputs scaled over each function's domain, sin, cos and log
+        // cross 0 where the tiers are compared against the ulps of 1 instead
+        std::vector<float> angles(_a.size()), cosines(_a.size()), exponents(_a.size()), positive(_a.size());
+        for(size_t i = 0; i < _a.size(); ++i) {
+            angles[i] = std::ldexp(_a[i], static_cast<int>(i % 16) - 4);
+            cosines[i] = std::max(-1.0f, std::min(_a[i] * 1.05f, 1.0f));
+            exponents[i] = _a[i] * 12.0f;
+            positive[i] = std::ldexp(std::fabs(_a[i]), static_cast<int>(i % 250) - 125);
+        }
+
+        const auto unit = [](size_t) { return 1.0f; };
+        assert_matches_scalar(angles.size() + Guard, max_ulps, unit, [&](const KernelTable& k, float* r) {
+            k.floats.sin(angles.data(), r, angles.size());
+        });
+        assert_matches_scalar(angles.size() + Guard, max_ulps, unit, [&](const KernelTable& k, float* r) {
+            k.floats.cos(angles.data(), r, angles.size());
+        });
+        assert_matches_scalar(angles.size() * 2 + Guard, max_ulps, unit, [&](const KernelTable& k, float* r) {
+            k.floats.sincos(angles.data(), r, r + angles.size(), angles.size());
+        });
+        assert_matches_scalar(angles.size() + Guard, max_ulps, [&](const KernelTable& k, float* r) {
+            k.floats.atan(angles.data(), r, angles.size());
+        });
+        assert_matches_scalar(DifferentialSize * 4 + Guard, max_ulps, [&](const KernelTable& k, float* r) {
+            k.floats.atan2(_a.data(), _b.data(), r, DifferentialSize * 4);
+        });
+        assert_matches_scalar(cosines.size() + Guard, max_ulps, [&](const KernelTable& k, float* r) {
+            k.floats.acos(cosines.data(), r, cosines.size());
+        });
+        assert_matches_scalar(exponents.size() + Guard, max_ulps, [&](const KernelTable& k, float* r) {
+            k.floats.exp(exponents.data(), r, exponents.size());
+        });
+        assert_matches_scalar(positive.size() + Guard, max_ulps, unit, [&](const KernelTable& k, float* r) {
+            k.floats.log(positive.data(), r, positive.size());
+        });
+    }
+
+    TEST_METHOD(stream_arithmetic)
+    {
+        // single IEEE operations have to be bit-exact
+        assert_matches_scalar(StreamOutputSize, 0, [this](const KernelTable& k, float* r) {
+            k.stream.add(stream_a(), stream_b(), output_stream(r), DifferentialSize);
+        });
+        assert_matches_scalar(StreamOutputSize, 0, [this](const KernelTable& k, float* r) {
+            k.stream.sub(stream_a(), stream_b(), output_stream(r), DifferentialSize);
+        });
+        assert_matches_scalar(StreamOutputSize, 0, [this](const KernelTable& k, float* r) {
+            k.stream.multiply(stream_a(), stream_b(), output_stream(r), DifferentialSize);
+        });
+        assert_matches_scalar(StreamOutputSize, 0, [this](const KernelTable& k, float* r) {
+            k.stream.scale(stream_a(), -3.25f, output_stream(r), DifferentialSize);
+        });
+    }
+
+    TEST_METHOD(stream_products)
+    {
+        assert_matches_scalar(DifferentialSize + Guard, 2, [this](size_t i) { return product_scale(MIN(i, DifferentialSize - 1)); },
+            [this](const KernelTable& k, float* r) {
+                k.stream.dot(stream_a(), stream_b(), r, DifferentialSize);
+            });
+        assert_matches_scalar(StreamOutputSize, 2, [this](size_t i) { return product_scale(stream_element(i)); },
+            [this](const KernelTable& k, float* r) {
+                k.stream.cross(stream_a(), stream_b(), output_stream(r), DifferentialSize);
+            });
+    }
+
+    TEST_METHOD(stream_lengths)
+    {
+        assert_matches_scalar(DifferentialSize + Guard, 2, [this](const KernelTable& k, float* r) {
+            k.stream.length_squared(stream_a(), r, DifferentialSize);
+        });
+        assert_matches_scalar(DifferentialSize + Guard, 2, [this](const KernelTable& k, float* r) {
+            k.stream.length(stream_a(), r, DifferentialSize);
+        });
+        assert_matches_scalar(DifferentialSize + Guard, 2, [this](const KernelTable& k, float* r) {
+            k.stream.distance_squared(stream_a(), stream_b(), r, DifferentialSize);
+        });
+        assert_matches_scalar(DifferentialSize + Guard, 2, [this](const KernelTable& k, float* r) {
+            k.stream.distance(stream_a(), stream_b(), r, DifferentialSize);
+        });
+    }
+
+    TEST_METHOD(stream_normalize)
+    {
+        for(Precision precision : { Precision::Approximate, Precision::Refined, Precision::Exact }) {
+            // components are at most 1, small ones are compared absolutely
+            assert_matches_scalar(StreamOutputSize, precision_ulps(precision), [](size_t) { return 1.0f; },
+                [this, precision](const KernelTable& k, float* r) {
+                    k.stream.normalize(stream_a(), output_stream(r), DifferentialSize, precision);
+                });
+        }
+    }
+
+    TEST_METHOD(stream_lerp)
+    {
+        assert_matches_scalar(StreamOutputSize, 2,
+            [this](size_t i) { return magnitude(_a.data() + stream_element(i) * 4) + magnitude(_b.data() + stream_element(i) * 4); },
+            [this](const KernelTable& k, float* r) {
+                k.stream.lerp(stream_a(), stream_b(), 0.375f, output_stream(r), DifferentialSize);
+            });
+    }
+
+    TEST_METHOD(array_arithmetic)
+    {
+        assert_matches_scalar(DifferentialSize * 4 + Guard, 0, [this](const KernelTable& k, float* r) {
+            k.array.multiply(_a.data(), _b.data(), r, DifferentialSize);
+        });
+    }
+
+    TEST_METHOD(array_products)
+    {
+        assert_matches_scalar(DifferentialSize + Guard, 2, [this](size_t i) { return product_scale(MIN(i, DifferentialSize - 1)); },
+            [this](const KernelTable& k, float* r) {
+                k.array.dot(_a.data(), _b.data(), r, DifferentialSize);
+            });
+        assert_matches_scalar(DifferentialSize * 4 + Guard, 2, [this](size_t i) { return product_scale(array_element(i)); },
+            [this](const KernelTable& k, float* r) {
+                k.array.cross(_a.data(), _b.data(), r, DifferentialSize);
+            });
+    }
+
+    TEST_METHOD(array_lengths)
+    {
+        assert_matches_scalar(DifferentialSize + Guard, 2, [this](const KernelTable& k, float* r) {
+            k.array.length_squared(_a.data(), r, DifferentialSize);
+        });
+        assert_matches_scalar(DifferentialSize + Guard, 2, [this](const KernelTable& k, float* r) {
+            k.array.length(_a.data(), r, DifferentialSize);
+        });
+    }
+
+    TEST_METHOD(array_normalize)
+    {
+        for(Precision precision : { Precision::Approximate, Precision::Refined, Precision::Exact }) {
+            assert_matches_scalar(DifferentialSize * 4 + Guard, precision_ulps(precision), [](size_t) { return 1.0f; },
+                [this, precision](const KernelTable& k, float* r) {
+                    k.array.normalize(_a.data(), r, DifferentialSize, precision);
+                });
+        }
+    }
+
+    TEST_METHOD(array_angles)
+    {
+        // atan of a quotient that the tiers round the same and atan2 of a sine and
+        // cosine that they don't, near 0 the angles are compared against the ulps of 1
+        assert_matches_scalar(DifferentialSize + Guard, 6, [this](const KernelTable& k, float* r) {
+            k.array.angle(_a.data(), r, DifferentialSize);
+        });
+        assert_matches_scalar(DifferentialSize + Guard, 8, [](size_t) { return 1.0f; }, [this](const KernelTable& k, float* r) {
+            k.array.angle_between(_a.data(), _b.data(), 1.0f, r, DifferentialSize);
+        });
+    }
+
+    TEST_METHOD(array_transform)
+    {
+        float max_element = 0.0f;
+        for(float m : _matrix) {
+            max_element = MAX(max_element, std::fabs(m));
+        }
+
+        // every output is a sum of 4 terms of at most max_element * |v|
+        const auto scale = [this, max_element](size_t i) { return 4.0f * max_element * magnitude(_a.data() + array_element(i) * 4); };
+
+        assert_matches_scalar(DifferentialSize * 4 + Guard, 2, scale, [this](const KernelTable& k, float* r) {
+            k.array.transform(_matrix.data(), _a.data(), r, DifferentialSize);
+        });
+        assert_matches_scalar(DifferentialSize * 4 + Guard, 2, scale, [this](const KernelTable& k, float* r) {
+            k.array.transform_points(_matrix.data(), _a.data(), r, DifferentialSize);
+        });
+        assert_matches_scalar(DifferentialSize * 4 + Guard, 2, scale, [this](const KernelTable& k, float* r) {
+            k.array.transform_directions(_matrix.data(), _a.data(), r, DifferentialSize);
+        });
+    }
+
+    TEST_METHOD(array_rotate)
+    {
+        // unit quaternions
+        std::vector<float> q(_b);
+        for(size_t i = 0; i < DifferentialSize; ++i) {
+            const float invlength = 1.0f / magnitude(q.data() + i * 4);
+            for(size_t c = 0; c < 4; ++c) {
+                q[i * 4 + c] *= invlength;
+            }
+        }
+
+        const auto scale = [this](size_t i) { return 4.0f * magnitude(_a.data() + array_element(i) * 4); };
+
+        assert_matches_scalar(DifferentialSize * 4 + Guard, 4, scale, [this, &q](const KernelTable& k, float* r) {
+            k.array.rotate(q.data(), _a.data(), r, DifferentialSize);
+        });
+        assert_matches_scalar(DifferentialSize * 4 + Guard, 4, scale, [this, &q](const KernelTable& k, float* r) {
+            k.array.rotate_each(q.data(), _a.data(), r, DifferentialSize);
+        });
+    }
+
+    TEST_METHOD(array_transpose)
+    {
+        assert_matches_scalar(StreamOutputSize, 0, [this](const KernelTable& k, float* r) {
+            k.array.to_stream(_a.data(), output_stream(r), DifferentialSize);
+        });
+        assert_matches_scalar(DifferentialSize * 4 + Guard, 0, [this](const KernelTable& k, float* r) {
+            k.array.from_stream(stream_a(), r, DifferentialSize);
+        });
+    }
+
+    TEST_METHOD(array_in_place)
+    {
+        // outputs may alias inputs
+        assert_matches_scalar(DifferentialSize * 4, ExactUlps, [](size_t) { return 1.0f; }, [this](const KernelTable& k, float* r) {
+            std::copy(_a.begin(), _a.end(), r);
+            k.array.normalize(r, r, DifferentialSize, Precision::Exact);
+        });
+    }
+
+    TEST_METHOD(random_sequences)
+    {
+        // every tier has to produce the same sequence from the same state
+        RandomLanes lanes;
+        Xoshiro256 seeder(5);
+        for(size_t k = 0; k < 4; ++k) {
+            for(size_t i = 0; i < RandomLanes::Lanes; ++i) {
+                lanes.s[k][i] = static_cast<uint32_t>(seeder() >> 32);
+            }
+        }
+
+        assert_matches_scalar(DifferentialSize + Guard, 0, [lanes](const KernelTable& k, float* r) {
+            RandomLanes l(lanes);
+            k.random.uniform(l, r, DifferentialSize);
+        });
+
+        const float min[4] = { -2.0f, 0.0f, 1.0f, 3.0f };
+        const float max[4] = { 2.0f, 0.5f, 8.0f, 3.5f };
+        assert_matches_scalar(DifferentialSize * 4 + Guard, 1, [](size_t) { return 8.0f; }, [lanes, &min, &max](const KernelTable& k, float* r) {
+            RandomLanes l(lanes);
+            k.random.in_box(l, min, max, r, DifferentialSize);
+        });
+
+        // 2 * sqrt(1 - s) amplifies any rounding difference in s as s approaches 1
+        assert_matches_scalar(DifferentialSize * 4 + Guard, 64, [](size_t) { return 1.0f; }, [lanes](const KernelTable& k, float* r) {
+            RandomLanes l(lanes);
+            k.random.unit_vectors(l, r, DifferentialSize);
+        });
+
+        assert_matches_scalar(DifferentialSize * 4 + Guard, 1, [](size_t) { return 2.0f; }, [lanes](const KernelTable& k, float* r) {
+            RandomLanes l(lanes);
+            k.random.in_sphere(l, 2.0f, r, DifferentialSize);
+        });
+    }
+
+    TEST_METHOD(ray_intersections)
+    {
+        // the hits have to agree exactly, the distances up to the rounding
+        // of the dot and cross products (a few ulps of the ray's scale)
+        const auto scale = [](size_t) { return RayDistance; };
+
+        const float sphere[4] = { 0.5f, -0.25f, 1.0f, 6.0f };
+        assert_matches_scalar(RayOutputSize, 4, scale, [this, &sphere](const KernelTable& k, float* r) {
+            run_ray_kernel(r, [&](ConstStreamRef o, ConstStreamRef d, float* t, uint32_t* hits) {
+                return k.ray.sphere(o, d, sphere, t, hits, DifferentialSize);
+            });
+        });
+
+        const float plane[4] = { 0.6f, 0.0f, -0.8f, 1.5f };
+        assert_matches_scalar(RayOutputSize, 4, scale, [this, &plane](const KernelTable& k, float* r) {
+            run_ray_kernel(r, [&](ConstStreamRef o, ConstStreamRef d, float* t, uint32_t* hits) {
+                return k.ray.plane(o, d, plane, t, hits, DifferentialSize);
+            });
+        });
+
+        const float minimum[4] = { -4.0f, -2.0f, -6.0f, 0.0f };
+        const float maximum[4] = { 4.0f, 5.0f, 3.0f, 0.0f };
+        assert_matches_scalar(RayOutputSize, 4, scale, [this, &minimum, &maximum](const KernelTable& k, float* r) {
+            run_ray_kernel(r, [&](ConstStreamRef o, ConstStreamRef d, float* t, uint32_t* hits) {
+                return k.ray.aabb(o, d, minimum, maximum, t, hits, DifferentialSize);
+            });
+        });
+
+        const float v0[4] = { -8.0f, -8.0f, 0.0f, 0.0f };
+        const float v1[4] = { 8.0f, -8.0f, 1.0f, 0.0f };
+        const float v2[4] = { 0.0f, 8.0f, -1.0f, 0.0f };
+        assert_matches_scalar(RayOutputSize, 4, scale, [this, &v0, &v1, &v2](const KernelTable& k, float* r) {
+            run_ray_kernel(r, [&](ConstStreamRef o, ConstStreamRef d, float* t, uint32_t* hits) {
+                return k.ray.triangle(o, d, v0, v1, v2, t, hits, DifferentialSize);
+            });
+        });
+    }
+
+    TEST_METHOD(cull)
+    {
+        // the same elements have to pass on every tier, written
+        // as their indices followed by the count
+        const float planes[] = {
+            0.6f, 0.0f, 0.8f, 2.0f,
+            0.0f, -1.0f, 0.0f, 3.0f,
+            -0.48f, 0.6f, -0.64f, 4.0f,
+        };
+        const size_t plane_count = sizeof(planes) / sizeof(planes[0]) / 4;
+
+        const auto run_cull_kernel = [](float* r, const std::function<size_t(uint32_t*)>& kernel) {
+            std::vector<uint32_t> visible(DifferentialSize);
+            const size_t count = kernel(visible.data());
+            for(size_t i = 0; i < count; ++i) {
+                r[i] = static_cast<float>(visible[i]);
+            }
+            r[DifferentialSize] = static_cast<float>(count);
+        };
+
+        assert_matches_scalar(DifferentialSize + 1 + Guard, 0, [&](const KernelTable& k, float* r) {
+            run_cull_kernel(r, [&](uint32_t* visible) {
+                return k.cull.spheres(stream_a(), planes, plane_count, visible, DifferentialSize);
+            });
+        });
+
+        assert_matches_scalar(DifferentialSize + 1 + Guard, 0, [&](const KernelTable& k, float* r) {
+            run_cull_kernel(r, [&](uint32_t* visible) {
+                return k.cull.boxes(stream_a(), stream_b(), planes, plane_count, visible, DifferentialSize);
+            });
+        });
+    }
+
+    TEST_METHOD(color)
+    {
+        const auto unit = [](size_t) { return 1.0f; };
+
+        // the sRGB curves go through the pow() polynomial, which
+        // rounds differently with fused multiply-add
+        assert_matches_scalar(DifferentialSize * 4 + Guard, 8, unit, [this](const KernelTable& k, float* r) {
+            k.color.srgb_to_linear(_a.data(), r, DifferentialSize);
+        });
+        assert_matches_scalar(DifferentialSize * 4 + Guard, 8, unit, [this](const KernelTable& k, float* r) {
+            k.color.linear_to_srgb(_a.data(), r, DifferentialSize);
+        });
+
+        assert_matches_scalar(DifferentialSize * 4 + Guard, 0, [this](const KernelTable& k, float* r) {
+            k.color.premultiply(_a.data(), r, DifferentialSize);
+        });
+        assert_matches_scalar(DifferentialSize * 4 + Guard, 0, [this](const KernelTable& k, float* r) {
+            k.color.unpremultiply(_a.data(), r, DifferentialSize);
+        });
+
+        // the compiler is free to fuse the blend multiply-adds
+        const auto blend_scale = [](size_t) { return 16.0f * 16.0f; };
+        for(auto blend : { &ColorKernels::blend_over, &ColorKernels::blend_add, &ColorKernels::blend_multiply, &ColorKernels::blend_screen }) {
+            assert_matches_scalar(DifferentialSize * 4 + Guard, 2, blend_scale, [this, blend](const KernelTable& k, float* r) {
+                (k.color.*blend)(_a.data(), _b.data(), r, DifferentialSize);
+            });
+        }
+    }
+
+    TEST_METHOD(color_packing)
+    {
+        // packed values are compared as 16-bit halves, which are exact as floats
+        const auto split = [](const std::vector<uint32_t>& packed, float* r) {
+            for(size_t i = 0; i < packed.size(); ++i) {
+                r[i * 2] = static_cast<float>(packed[i] & 0xffff);
+                r[i * 2 + 1] = static_cast<float>(packed[i] >> 16);
+            }
+        };
+
+        // inputs in [0, 1] so that the rounding of every channel is exercised
+        std::vector<float> colors(_a.size());
+        std::transform(_a.begin(), _a.end(), colors.begin(), [](float f) { return std::fabs(f) / 16.0f; });
+        colors[0] = -1.0f;
+        colors[1] = 2.0f;
+        colors[2] = NAN;
+
+        for(auto pack : { &ColorKernels::pack_rgba8, &ColorKernels::pack_srgba8, &ColorKernels::pack_rgb10a2 }) {
+            assert_matches_scalar(DifferentialSize * 2 + Guard, 0, [&](const KernelTable& k, float* r) {
+                std::vector<uint32_t> packed(DifferentialSize);
+                (k.color.*pack)(colors.data(), packed.data(), DifferentialSize);
+                split(packed, r);
+            });
+        }
+
+        std::vector<uint32_t> packed(DifferentialSize);
+        for(size_t i = 0; i < packed.size(); ++i) {
+            packed[i] = static_cast<uint32_t>(i * 2654435761u);
+        }
+
+        assert_matches_scalar(DifferentialSize * 4 + Guard, 0, [&](const KernelTable& k, float* r) {
+            k.color.unpack_rgba8(packed.data(), r, DifferentialSize);
+        });
+        assert_matches_scalar(DifferentialSize * 4 + Guard, 8, [](size_t) { return 1.0f; }, [&](const KernelTable& k, float* r) {
+            k.color.unpack_srgba8(packed.data(), r, DifferentialSize);
+        });
+        assert_matches_scalar(DifferentialSize * 4 + Guard, 0, [&](const KernelTable& k, float* r) {
+            k.color.unpack_rgb10a2(packed.data(), r, DifferentialSize);
+        });
+    }
+
+    TEST_METHOD(encode_half)
+    {
+        // every float16 and bfloat16, which have to decode the same with F16C and without
+        std::vector<uint16_t> halves(65536);
+        for(size_t i = 0; i < halves.size(); ++i) {
+            halves[i] = static_cast<uint16_t>(i);
+        }
+        assert_matches_scalar(halves.size() + Guard, 0, [&](const KernelTable& k, float* r) {
+            k.encode.from_half(halves.data(), r, halves.size());
+        });
+        assert_matches_scalar(halves.size() + Guard, 0, [&](const KernelTable& k, float* r) {
+            k.encode.from_bfloat16(halves.data(), r, halves.size());
+        });
+
+        // the random inputs scaled across the whole float16 range and the edges of it
+        std::vector<float> floats(_a.size());
+        for(size_t i = 0; i < floats.size(); ++i) {
+            floats[i] = std::ldexp(_a[i], static_cast<int>(i % 48) - 28);
+        }
+        const float edges[] = { 65504.0f, 65519.99f, 65520.0f, HUGE_VALF, -HUGE_VALF, NAN, -0.0f, 5.9604645e-08f, 2.9802322e-08f, 2.9802326e-08f, 6.1035156e-05f, 6.1035152e-05f, FLT_MAX, FLT_MIN };
+        std::copy(std::begin(edges), std::end(edges), floats.begin());
+
+        for(auto encode : { &EncodeKernels::to_half, &EncodeKernels::to_bfloat16 }) {
+            assert_matches_scalar(floats.size() + Guard, 0, [&](const KernelTable& k, float* r) {
+                std::vector<uint16_t> packed(floats.size());
+                (k.encode.*encode)(floats.data(), packed.data(), floats.size());
+                std::transform(packed.begin(), packed.end(), r, [](uint16_t h) { return static_cast<float>(h); });
+            });
+        }
+    }
+
+    TEST_METHOD(encode_vectors)
+    {
+        // the encoded values are compared as 16-bit integers, which are exact as floats
+        // and the decoded values up to the rounding of the normalize and the fused multiply-add
+        std::vector<uint32_t> octahedral(DifferentialSize);
+        assert_matches_scalar(DifferentialSize * 2 + Guard, 0, [&](const KernelTable& k, float* r) {
+            k.encode.to_octahedral(_a.data(), octahedral.data(), DifferentialSize);
+            for(size_t i = 0; i < octahedral.size(); ++i) {
+                r[i * 2] = static_cast<float>(octahedral[i] & 0xffff);
+                r[i * 2 + 1] = static_cast<float>(octahedral[i] >> 16);
+            }
+        });
+        assert_matches_scalar(DifferentialSize * 4 + Guard, 2, [](size_t) { return 1.0f; }, [&](const KernelTable& k, float* r) {
+            k.encode.from_octahedral(octahedral.data(), r, DifferentialSize);
+        });
+
+        const float offset[4] = { -10.0f, -5.0f, -20.0f, 0.0f };
+        const float scale[4] = { 65535.0f / 20.0f, 65535.0f / 10.0f, 65535.0f / 40.0f, 0.0f };
+        std::vector<uint16_t> quantized(DifferentialSize * 4);
+        assert_matches_scalar(DifferentialSize * 4 + Guard, 0, [&](const KernelTable& k, float* r) {
+            k.encode.quantize(_a.data(), offset, scale, quantized.data(), DifferentialSize);
+            std::transform(quantized.begin(), quantized.end(), r, [](uint16_t q) { return static_cast<float>(q); });
+        });
+
+        const float step[4] = { 20.0f / 65535.0f, 10.0f / 65535.0f, 40.0f / 65535.0f, 0.0f };
+        assert_matches_scalar(DifferentialSize * 4 + Guard, 1, [](size_t) { return 20.0f; }, [&](const KernelTable& k, float* r) {
+            k.encode.dequantize(quantized.data(), offset, step, r, DifferentialSize);
+        });
+    }
+};
+
+} } }
@@ -143,6 +143,26 @@ public:
         Assert::AreEqual(e2, a2, 0.001f);
         Assert::AreEqual(e3, a3, 0.001f);
     }
+
+    TEST_METHOD(util_invsqrt_precision)
+    {
+        // Arrange
+        static const float values[] = { 0.0001f, 0.5f, 1.0f, 2.0f, 10.0f, 1234.0f, 5000.0f, 1.0e10f };
+
+        for(float v : values) {
+            float expected = 1.0f / std::sqrt(v);
+
+            // Act
+            float approximate = invsqrt(v, Precision::Approximate);
+            float refined = invsqrt(v, Precision::Refined);
+            float exact = invsqrt(v, Precision::Exact);
+
+            // Assert
+            Assert::AreEqual(expected, approximate, expected * 2.0e-3f);
+            Assert::AreEqual(expected, refined, expected * 5.0e-6f);
+            Assert::AreEqual(expected, exact);
+        }
+    }
 };
 
 } } }
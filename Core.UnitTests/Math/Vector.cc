@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "CppUnitTest.h"
-#include "Core/Math/Vector.h"
+#include <cstring>
+#include "Core/Math/PolymorphicVector.h"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -238,6 +239,71 @@ public:
         Assert::AreEqual(4.0f, v1.w());
     }
 
+    TEST_METHOD(memcpy_array)
+    {
+        // Arrange
+        Vector v1[] = { Vector(1.0f, 2.0f, 3.0f, 4.0f), Vector(5.0f, 6.0f, 7.0f, 8.0f) };
+        Vector v2[2];
+
+        // Act
+        std::memcpy(v2, v1, sizeof(v1));
+
+        // Assert
+        Assert::AreEqual(static_cast<size_t>(32), sizeof(v1));
+        Assert::IsTrue(v1[0] == v2[0]);
+        Assert::IsTrue(v1[1] == v2[1]);
+    }
+
+    TEST_METHOD(storage)
+    {
+        // Arrange
+        Vector v1(1.0f, 2.0f, 3.0f, 4.0f);
+
+        // Act
+        VectorStorage s = v1.storage();
+        Vector v2(s);
+
+        // Assert
+        Assert::AreEqual(1.0f, s.x);
+        Assert::AreEqual(2.0f, s.y);
+        Assert::AreEqual(3.0f, s.z);
+        Assert::AreEqual(4.0f, s.w);
+        Assert::IsTrue(v1 == v2);
+        Assert::AreEqual(0, std::memcmp(&s, &v1, sizeof(s)));
+    }
+
+#if defined USE_SSE
+    TEST_METHOD(simd)
+    {
+        // Arrange
+        Vector v1(1.0f, -2.0f, 3.0f, 4.0f);
+
+        // Act
+        Vector v2(v1.simd());
+        Vector v3(_mm_add_ps(v1.simd(), Vector::WAxis.simd()));
+
+        // Assert
+        Assert::IsTrue(v1 == v2);
+        Assert::IsTrue(Vector(1.0f, -2.0f, 3.0f, 5.0f) == v3);
+    }
+#endif
+
+    TEST_METHOD(polymorphic_vector)
+    {
+        // Arrange
+        std::unique_ptr<PolymorphicVector> v1(new PolymorphicVector(1.0f, 2.0f, 3.0f, 4.0f));
+        PolymorphicVector v2(Vector::XAxis);
+
+        // Act
+        Vector v3 = v2 + *v1;
+
+        // Assert
+        Assert::IsTrue(Vector(2.0f, 2.0f, 3.0f, 4.0f) == v3);
+        Assert::IsTrue(Vector::XAxis == v2.vector());
+        Assert::IsTrue(std::has_virtual_destructor<PolymorphicVector>::value);
+        Assert::IsFalse(std::has_virtual_destructor<Vector>::value);
+    }
+
     TEST_METHOD(property_x)
     {
         // Arrange
@@ -403,6 +469,36 @@ public:
         Assert::AreEqual(v1_copy.length(), v1.length(), 0.001f);
     }
 
+    TEST_METHOD(normalize_precision)
+    {
+        // Arrange
+        Vector v1(1.0f, 2.0f, 3.0f);
+
+        // Act
+        Vector approximate = v1.normalized(Precision::Approximate);
+        Vector refined = v1.normalized(Precision::Refined);
+        Vector exact = v1.normalized(Precision::Exact);
+
+        // Assert
+        Assert::AreEqual(1.0f, approximate.length(), 0.002f);
+        Assert::AreEqual(1.0f, refined.length(), 0.00001f);
+        Assert::AreEqual(1.0f, exact.length(), 0.000001f);
+    }
+
+    TEST_METHOD(normalize_repeated)
+    {
+        // Arrange
+        Vector v1(1.0f, 2.0f, 3.0f);
+
+        // Act
+        for(int i = 0; i < 10000; ++i) {
+            v1 = (v1 + Vector(0.001f, 0.0f, 0.0f)).normalize();
+        }
+
+        // Assert
+        Assert::AreEqual(1.0f, v1.length(), 0.00001f);
+    }
+
     TEST_METHOD(perpendicular)
     {
         // Arrange
@@ -504,6 +600,29 @@ public:
         Assert::AreEqual(6.0f, v2.distance(v1));
     }
 
+    TEST_METHOD(lerp)
+    {
+        // Arrange
+        Vector v1(0.0f, 10.0f, -4.0f, 1.0f);
+        Vector v2(10.0f, 20.0f, 4.0f, 1.0f);
+        Vector v3(0.1f, 0.7f, -0.3f, 3.0f);
+
+        // Act
+        Vector v4 = v1.lerp(v2, 0.25);
+        Vector v5 = v1.lerp(v3, 0.3);
+
+        // Assert
+        Assert::IsTrue(Vector(2.5f, 12.5f, -2.0f, 1.0f) == v4);
+        Assert::IsTrue(v1.lerp(v2, 0.0) == v1);
+        Assert::IsTrue(v1.lerp(v2, 1.0) == v2);
+
+        // the SIMD and scalar versions have to round the same way
+        Assert::AreEqual(0.7f * v1.x() + 0.3f * v3.x(), v5.x());
+        Assert::AreEqual(0.7f * v1.y() + 0.3f * v3.y(), v5.y());
+        Assert::AreEqual(0.7f * v1.z() + 0.3f * v3.z(), v5.z());
+        Assert::AreEqual(0.7f * v1.w() + 0.3f * v3.w(), v5.w());
+    }
+
     TEST_METHOD(multiply)
     {
         // Arrange
@@ -520,6 +639,21 @@ public:
         Assert::AreEqual(-32.0f, v3.w());
     }
 
+    TEST_METHOD(minimum_maximum)
+    {
+        // Arrange
+        Vector v1(1.0f, -2.0f, 3.0f, 4.0f);
+        Vector v2(4.0f, 12.0f, -15.0f, 4.0f);
+
+        // Act
+        Vector v3 = v1.minimum(v2);
+        Vector v4 = v1.maximum(v2);
+
+        // Assert
+        Assert::IsTrue(Vector(1.0f, -2.0f, -15.0f, 4.0f) == v3);
+        Assert::IsTrue(Vector(4.0f, 12.0f, 3.0f, 4.0f) == v4);
+    }
+
     TEST_METHOD(homogeneous_position)
     {
         // Arrange
@@ -0,0 +1,376 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Core/Concurrency/TaskScheduler.h"
+#include "Core/Math/SIMD/Kernels.h"
+#include "Core/Math/VectorBatch.h"
+#include "Core.UnitTests/UnitTests.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace math {
+namespace unittests {
+
+// odd-sized so that every kernel has to handle a remainder
+static const size_t BatchSize = 37;
+
+TEST_CLASS(VectorBatchTests)
+{
+private:
+    std::vector<Vector> create_test_vectors(float offset)
+    {
+        std::vector<Vector> vectors;
+        for(size_t i = 0; i < BatchSize; ++i) {
+            const float f = static_cast<float>(i) + offset;
+            vectors.emplace_back(f, 2.0f * f - 3.0f, 1.0f - f, 0.5f * f);
+        }
+        return vectors;
+    }
+
+    void assert_equal(const Vector& expected, const Vector& actual)
+    {
+        Assert::AreEqual(expected.x(), actual.x(), 0.001f);
+        Assert::AreEqual(expected.y(), actual.y(), 0.001f);
+        Assert::AreEqual(expected.z(), actual.z(), 0.001f);
+        Assert::AreEqual(expected.w(), actual.w(), 0.001f);
+    }
+
+public:
+    TEST_METHOD(simd_level)
+    {
+        // Arrange
+        const SimdLevel level = kernels().level;
+
+        // Act
+        SimdLevel scalar = set_simd_level(SimdLevel::Scalar);
+        SimdLevel best = set_simd_level(SimdLevel::AVX512);
+        set_simd_level(level);
+
+        // Assert
+        Assert::IsTrue(SimdLevel::Scalar == scalar);
+        Assert::IsTrue(max_simd_level() == best);
+        Assert::IsTrue(kernels(best).level == best);
+        Assert::AreEqual(std::string("scalar"), std::string(simd_level_name(SimdLevel::Scalar)));
+    }
+
+    TEST_METHOD(multiply)
+    {
+        for_each_simd_level([this]() {
+            // Arrange
+            std::vector<Vector> v1 = create_test_vectors(1.0f);
+            std::vector<Vector> v2 = create_test_vectors(-5.0f);
+            std::vector<Vector> v3(BatchSize);
+
+            // Act
+            batch::multiply(v1.data(), v2.data(), v3.data(), BatchSize);
+
+            // Assert
+            for(size_t i = 0; i < BatchSize; ++i) {
+                assert_equal(v1[i].multiply(v2[i]), v3[i]);
+            }
+        });
+    }
+
+    TEST_METHOD(dot)
+    {
+        for_each_simd_level([this]() {
+            // Arrange
+            std::vector<Vector> v1 = create_test_vectors(1.0f);
+            std::vector<Vector> v2 = create_test_vectors(-5.0f);
+            std::vector<float> dots(BatchSize);
+
+            // Act
+            batch::dot(v1.data(), v2.data(), dots.data(), BatchSize);
+
+            // Assert
+            for(size_t i = 0; i < BatchSize; ++i) {
+                Assert::AreEqual(v1[i] * v2[i], dots[i], 0.01f);
+            }
+        });
+    }
+
+    TEST_METHOD(cross)
+    {
+        for_each_simd_level([this]() {
+            // Arrange
+            std::vector<Vector> v1 = create_test_vectors(1.0f);
+            std::vector<Vector> v2 = create_test_vectors(-5.0f);
+            std::vector<Vector> v3(BatchSize);
+
+            // Act
+            batch::cross(v1.data(), v2.data(), v3.data(), BatchSize);
+
+            // Assert
+            for(size_t i = 0; i < BatchSize; ++i) {
+                assert_equal(v1[i] ^ v2[i], v3[i]);
+            }
+        });
+    }
+
+    TEST_METHOD(length)
+    {
+        for_each_simd_level([this]() {
+            // Arrange
+            std::vector<Vector> v1 = create_test_vectors(1.0f);
+            std::vector<float> lengths(BatchSize);
+            std::vector<float> lengths_squared(BatchSize);
+
+            // Act
+            batch::length(v1.data(), lengths.data(), BatchSize);
+            batch::length_squared(v1.data(), lengths_squared.data(), BatchSize);
+
+            // Assert
+            for(size_t i = 0; i < BatchSize; ++i) {
+                Assert::AreEqual(v1[i].length(), lengths[i], 0.001f);
+                Assert::AreEqual(v1[i].length_squared(), lengths_squared[i], 0.01f);
+            }
+        });
+    }
+
+    TEST_METHOD(normalize)
+    {
+        for_each_simd_level([this]() {
+            // Arrange
+            std::vector<Vector> v1 = create_test_vectors(1.0f);
+            std::vector<Vector> v2(v1);
+
+            // Act
+            batch::normalize(v2.data(), v2.data(), BatchSize);
+
+            // Assert
+            for(size_t i = 0; i < BatchSize; ++i) {
+                assert_equal(v1[i] / v1[i].length(), v2[i]);
+            }
+        });
+    }
+
+    TEST_METHOD(angles)
+    {
+        for_each_simd_level([this]() {
+            // Arrange
+            std::vector<Vector> v1 = create_test_vectors(1.0f);
+            std::vector<Vector> v2 = create_test_vectors(-5.0f);
+
+            // parallel and opposite vectors whose cosines can round past 1
+            v1.push_back(Vector(0.1f, 0.2f, 0.3f, 0.0f));
+            v2.push_back(Vector(0.3f, 0.6f, 0.9f, 0.0f));
+            v1.push_back(Vector(0.1f, 0.2f, 0.3f, 0.0f));
+            v2.push_back(Vector(-0.3f, -0.6f, -0.9f, 0.0f));
+
+            const size_t count = v1.size();
+            std::vector<float> angle(count), radians(count), degrees(count);
+
+            // Act
+            batch::angle(v1.data(), angle.data(), count);
+            batch::angle_radians(v1.data(), v2.data(), radians.data(), count);
+            batch::angle_degrees(v1.data(), v2.data(), degrees.data(), count);
+
+            // Assert
+            for(size_t i = 0; i < count; ++i) {
+                Assert::AreEqual(v1[i].angle(), angle[i], 1.0e-6f);
+
+                // Vector::angle_radians() isn't accurate enough near 0 and pi to compare against
+                const Vector& a = v1[i];
+                const Vector& b = v2[i];
+                const double dot = static_cast<double>(a.x()) * b.x() + static_cast<double>(a.y()) * b.y()
+                    + static_cast<double>(a.z()) * b.z() + static_cast<double>(a.w()) * b.w();
+                const double lengths = std::sqrt((static_cast<double>(a.x()) * a.x() + static_cast<double>(a.y()) * a.y()
+                    + static_cast<double>(a.z()) * a.z() + static_cast<double>(a.w()) * a.w())
+                    * (static_cast<double>(b.x()) * b.x() + static_cast<double>(b.y()) * b.y()
+                    + static_cast<double>(b.z()) * b.z() + static_cast<double>(b.w()) * b.w()));
+                const double expected = std::acos(std::max(-1.0, std::min(dot / lengths, 1.0)));
+                Assert::AreEqual(expected, static_cast<double>(radians[i]), 1.0e-6);
+                Assert::AreEqual(RAD_DEG(expected), static_cast<double>(degrees[i]), 1.0e-4);
+            }
+        });
+    }
+
+    TEST_METHOD(transform)
+    {
+        for_each_simd_level([this]() {
+            // Arrange
+            std::vector<Vector> v1 = create_test_vectors(1.0f);
+            std::vector<Vector> v2(BatchSize), points(BatchSize), directions(v1);
+            const Matrix4 m = Matrix4::translation(Vector(1.0f, -2.0f, 3.0f)) * Matrix4::rotation(Vector::YAxis, 0.5f) * Matrix4::scale(2.0f);
+
+            // Act
+            batch::transform(m, v1.data(), v2.data(), BatchSize);
+            batch::transform_points(m, v1.data(), points.data(), BatchSize);
+            batch::transform_directions(m, directions.data(), directions.data(), BatchSize);
+
+            // Assert
+            for(size_t i = 0; i < BatchSize; ++i) {
+                assert_equal(m * v1[i], v2[i]);
+                assert_equal(m.transform_point(v1[i]), points[i]);
+                assert_equal(m.transform_direction(v1[i]), directions[i]);
+            }
+        });
+    }
+
+    TEST_METHOD(rotate)
+    {
+        for_each_simd_level([this]() {
+            // Arrange
+            std::vector<Vector> v1 = create_test_vectors(1.0f);
+            std::vector<Vector> v2(BatchSize), v3(v1);
+            std::vector<Quaternion> q;
+            for(size_t i = 0; i < BatchSize; ++i) {
+                q.push_back(Quaternion::axis_angle(Vector(1.0f, static_cast<float>(i), 2.0f), 0.1f * i));
+            }
+
+            // Act
+            batch::rotate(q[5], v1.data(), v2.data(), BatchSize);
+            batch::rotate(q.data(), v3.data(), v3.data(), BatchSize);
+
+            // Assert
+            for(size_t i = 0; i < BatchSize; ++i) {
+                assert_equal(q[5].rotate(v1[i]), v2[i]);
+                assert_equal(q[i].rotate(v1[i]), v3[i]);
+            }
+        });
+    }
+
+    TEST_METHOD(normalize_precision)
+    {
+        for_each_simd_level([this]() {
+            // Arrange
+            std::vector<Vector> v1 = create_test_vectors(1.0f);
+            std::vector<Vector> approximate(BatchSize), refined(BatchSize), exact(BatchSize);
+
+            // Act
+            batch::normalize(v1.data(), approximate.data(), BatchSize, Precision::Approximate);
+            batch::normalize(v1.data(), refined.data(), BatchSize, Precision::Refined);
+            batch::normalize(v1.data(), exact.data(), BatchSize, Precision::Exact);
+
+            // Assert
+            for(size_t i = 0; i < BatchSize; ++i) {
+                Assert::AreEqual(1.0f, approximate[i].length(), 1.0e-3f);
+                Assert::AreEqual(1.0f, refined[i].length(), 1.0e-6f);
+                Assert::AreEqual(1.0f, exact[i].length(), 1.0e-6f);
+            }
+        });
+    }
+
+    TEST_METHOD(invsqrt)
+    {
+        for_each_simd_level([]() {
+            // Arrange
+            std::vector<float> x;
+            for(size_t i = 0; i < BatchSize; ++i) {
+                x.push_back(0.25f + static_cast<float>(i) * 17.0f);
+            }
+            std::vector<float> approximate(BatchSize), refined(BatchSize), exact(BatchSize);
+
+            // Act
+            batch::invsqrt(x.data(), approximate.data(), BatchSize, Precision::Approximate);
+            batch::invsqrt(x.data(), refined.data(), BatchSize, Precision::Refined);
+            batch::invsqrt(x.data(), exact.data(), BatchSize, Precision::Exact);
+
+            // Assert
+            for(size_t i = 0; i < BatchSize; ++i) {
+                const float expected = 1.0f / std::sqrt(x[i]);
+                Assert::AreEqual(expected, approximate[i], expected * 4.0e-4f);
+                Assert::AreEqual(expected, refined[i], expected * 1.0e-6f);
+                Assert::AreEqual(expected, exact[i]);
+            }
+        });
+    }
+
+    TEST_METHOD(reductions)
+    {
+        for_each_simd_level([this]() {
+            // Arrange
+            std::vector<Vector> v1 = create_test_vectors(1.0f);
+            std::vector<Vector> v2 = create_test_vectors(-5.0f);
+
+            Vector expected_sum;
+            float expected_dot_sum = 0.0f;
+            AABB expected_bounds;
+            for(size_t i = 0; i < BatchSize; ++i) {
+                expected_sum += v1[i];
+                expected_dot_sum += v1[i] * v2[i];
+                expected_bounds.merge(v1[i]);
+            }
+
+            // Act
+            const Vector sum = batch::sum(v1.data(), BatchSize);
+            const float dot_sum = batch::dot_sum(v1.data(), v2.data(), BatchSize);
+            const AABB bounds = batch::bounds(v1.data(), BatchSize);
+
+            // Assert
+            assert_equal(expected_sum, sum);
+            Assert::AreEqual(expected_dot_sum, dot_sum, 0.1f);
+            Assert::IsTrue(expected_bounds == bounds);
+            Assert::IsTrue(batch::sum(v1.data(), 0).is_zero());
+            Assert::AreEqual(0.0f, batch::dot_sum(v1.data(), v2.data(), 0));
+            Assert::IsTrue(batch::bounds(v1.data(), 0).is_empty());
+        });
+    }
+
+    TEST_METHOD(parallel)
+    {
+        // Arrange
+        // several chunks with a partial one at the end
+        const size_t count = batch::ParallelChunkSize * 5 + 3;
+        std::vector<Vector> v1, v2;
+        for(size_t i = 0; i < count; ++i) {
+            const float f = static_cast<float>(i % 1000) * 0.01f;
+            v1.emplace_back(f, 1.0f - f, 2.0f * f + 1.0f, 0.5f);
+            v2.emplace_back(1.0f / (f + 1.0f), f, -f, 1.0f);
+        }
+        const Matrix4 m = Matrix4::translation(Vector(1.0f, -2.0f, 3.0f)) * Matrix4::rotation(Vector::YAxis, 0.5f);
+
+        std::vector<Vector> expected_points(count), expected_normalized(count);
+        batch::transform_points(m, v1.data(), expected_points.data(), count);
+        batch::normalize(v1.data(), expected_normalized.data(), count);
+        const Vector expected_sum = batch::sum(v1.data(), count);
+        const float expected_dot_sum = batch::dot_sum(v1.data(), v2.data(), count);
+        const AABB expected_bounds = batch::bounds(v1.data(), count);
+
+        for(size_t threads : { 1, 2, 4 }) {
+            concurrency::TaskScheduler scheduler(threads);
+            std::vector<Vector> points(count), normalized(count);
+
+            // Act
+            batch::transform_points(scheduler, m, v1.data(), points.data(), count);
+            batch::normalize(scheduler, v1.data(), normalized.data(), count);
+            const Vector sum = batch::sum(scheduler, v1.data(), count);
+            const float dot_sum = batch::dot_sum(scheduler, v1.data(), v2.data(), count);
+            const AABB bounds = batch::bounds(scheduler, v1.data(), count);
+
+            // Assert
+            // the same kernels over the same ranges, so exactly the same results
+            Assert::IsTrue(expected_points == points);
+            Assert::IsTrue(expected_normalized == normalized);
+            Assert::IsTrue(expected_sum == sum);
+            Assert::AreEqual(expected_dot_sum, dot_sum);
+            Assert::IsTrue(expected_bounds == bounds);
+        }
+    }
+
+    TEST_METHOD(relative_to)
+    {
+        // Arrange
+        const VectorD camera(1.0e9, -2.0e9, 5.0e8, 1.0);
+        std::vector<VectorD> positions;
+        std::vector<VectorFixed> fixed_positions;
+        for(const Vector& v : create_test_vectors(0.25f)) {
+            positions.push_back(camera + VectorD(v));
+            fixed_positions.emplace_back(positions.back());
+        }
+        std::vector<Vector> relative(BatchSize), fixed_relative(BatchSize);
+
+        // Act
+        batch::relative_to(positions.data(), camera, relative.data(), BatchSize);
+        batch::relative_to(fixed_positions.data(), VectorFixed(camera), fixed_relative.data(), BatchSize);
+
+        // Assert
+        for(size_t i = 0; i < BatchSize; ++i) {
+            Assert::IsTrue(positions[i].relative_to(camera) == relative[i]);
+            Assert::IsTrue(fixed_positions[i].relative_to(VectorFixed(camera)) == fixed_relative[i]);
+            assert_equal(create_test_vectors(0.25f)[i], relative[i]);
+        }
+    }
+};
+
+} } }
@@ -0,0 +1,112 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Core/Math/VectorD.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace math {
+namespace unittests {
+
+TEST_CLASS(VectorDTests)
+{
+public:
+    TEST_METHOD(constructor)
+    {
+        // Arrange
+        VectorD v1;
+        VectorD v2(1.0, 2.0, 3.0);
+        VectorD v3(Vector(1.0f, 2.0f, 3.0f, 4.0f));
+
+        // Act
+
+        // Assert
+        Assert::IsTrue(v1.is_zero());
+        Assert::AreEqual(0.0, v2.w());
+        Assert::IsTrue(VectorD(1.0, 2.0, 3.0, 4.0) == v3);
+    }
+
+    TEST_METHOD(arithmetic)
+    {
+        // Arrange
+        VectorD v1(1.0, 2.0, 3.0, 4.0);
+        VectorD v2(5.0, 6.0, 7.0, 8.0);
+
+        // Act
+        VectorD v3 = v1 + v2;
+        VectorD v4 = v2 - v1;
+        VectorD v5 = v1 * 2.0;
+        VectorD v6 = v2 / 2.0;
+        VectorD v7 = v1.multiply(v2);
+        VectorD v8 = -v1;
+
+        // Assert
+        Assert::IsTrue(VectorD(6.0, 8.0, 10.0, 12.0) == v3);
+        Assert::IsTrue(VectorD(4.0, 4.0, 4.0, 4.0) == v4);
+        Assert::IsTrue(VectorD(2.0, 4.0, 6.0, 8.0) == v5);
+        Assert::IsTrue(VectorD(2.5, 3.0, 3.5, 4.0) == v6);
+        Assert::IsTrue(VectorD(5.0, 12.0, 21.0, 32.0) == v7);
+        Assert::IsTrue(VectorD(-1.0, -2.0, -3.0, -4.0) == v8);
+    }
+
+    TEST_METHOD(dot_cross)
+    {
+        // Arrange
+        VectorD v1(1.0, 2.0, 3.0);
+        VectorD v2(4.0, 5.0, 6.0);
+
+        // Act
+        double d = v1 * v2;
+        VectorD c = v1 ^ v2;
+
+        // Assert
+        Assert::AreEqual(32.0, d);
+        Assert::IsTrue(VectorD(-3.0, 6.0, -3.0) == c);
+    }
+
+    TEST_METHOD(length)
+    {
+        // Arrange
+        VectorD v1(2.0, 3.0, 6.0);
+
+        // Act
+        VectorD v2 = v1.normalized();
+
+        // Assert
+        Assert::AreEqual(49.0, v1.length_squared());
+        Assert::AreEqual(7.0, v1.length());
+        Assert::AreEqual(1.0, v2.length(), 1e-15);
+        Assert::AreEqual(7.0, VectorD().distance(v1));
+    }
+
+    TEST_METHOD(lerp)
+    {
+        // Arrange
+        VectorD v1(0.0, 10.0, -4.0);
+        VectorD v2(10.0, 20.0, 4.0);
+
+        // Act
+        VectorD v3 = v1.lerp(v2, 0.25);
+
+        // Assert
+        Assert::IsTrue(VectorD(2.5, 12.5, -2.0) == v3);
+    }
+
+    TEST_METHOD(relative_to)
+    {
+        // Arrange
+        // 1e9 units out, where float only has a precision of 64
+        VectorD camera(1.0e9, -2.0e9, 5.0e8);
+        VectorD position = camera + VectorD(1.25, -0.5, 0.125);
+
+        // Act
+        Vector v1 = position.relative_to(camera);
+        Vector v2 = VectorD(1.5, -2.5, 3.0, 1.0).vector();
+
+        // Assert
+        Assert::IsTrue(Vector(1.25f, -0.5f, 0.125f) == v1);
+        Assert::IsTrue(Vector(1.5f, -2.5f, 3.0f, 1.0f) == v2);
+    }
+};
+
+} } }
@@ -0,0 +1,161 @@
+#include "pch.h"
+#include <cfloat>
+#include "CppUnitTest.h"
+#include "Core/Math/SIMD/Kernels.h"
+#include "Core/Math/Random.h"
+#include "Core/Math/VectorEncoding.h"
+#include "Core.UnitTests/UnitTests.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace math {
+namespace unittests {
+
+// odd-sized so that every kernel has to handle a remainder
+static const size_t EncodingSize = 1001;
+
+TEST_CLASS(VectorEncodingTests)
+{
+private:
+    static void assert_relative(float expected, float actual, float tolerance, float minimum=0.0f)
+    {
+        Assert::AreEqual(expected, actual, std::max(std::fabs(expected) * tolerance, minimum));
+    }
+
+public:
+    TEST_METHOD(half)
+    {
+        for_each_simd_level([this]() {
+            // Arrange
+            std::vector<Vector> vectors(EncodingSize);
+            Random(1).in_box(vectors.data(), vectors.size(), Vector(-1000.0f, -1.0f, -0.0001f, -60000.0f), Vector(1000.0f, 1.0f, 0.0001f, 60000.0f));
+            std::vector<HalfVector> encoded(vectors.size());
+            std::vector<Vector> decoded(vectors.size());
+
+            // Act
+            batch::encode_half(vectors.data(), encoded.data(), vectors.size());
+            batch::decode_half(encoded.data(), decoded.data(), vectors.size());
+            const HalfVector h = encode_half(Vector(1.0f, -2.0f, 0.5f, 65520.0f));
+
+            // Assert
+            for(size_t i = 0; i < vectors.size(); ++i) {
+                assert_relative(vectors[i].x(), decoded[i].x(), 1.0f / 2048.0f);
+                assert_relative(vectors[i].y(), decoded[i].y(), 1.0f / 2048.0f);
+                // z crosses into the subnormal halves
+                assert_relative(vectors[i].z(), decoded[i].z(), 1.0f / 2048.0f, 1.0f / 33554432.0f);
+                assert_relative(vectors[i].w(), decoded[i].w(), 1.0f / 2048.0f);
+            }
+
+            Assert::AreEqual(static_cast<uint16_t>(0x3c00), h.x);
+            Assert::AreEqual(static_cast<uint16_t>(0xc000), h.y);
+            Assert::AreEqual(static_cast<uint16_t>(0x3800), h.z);
+            Assert::AreEqual(static_cast<uint16_t>(0x7c00), h.w);
+            Assert::IsTrue(Vector(1.0f, -2.0f, 0.5f, HUGE_VALF) == decode(h));
+        });
+    }
+
+    TEST_METHOD(bfloat16)
+    {
+        for_each_simd_level([this]() {
+            // Arrange
+            std::vector<Vector> vectors(EncodingSize);
+            Random(2).in_box(vectors.data(), vectors.size(), Vector(-1e30f, -1.0f, -1e-30f, -100.0f), Vector(1e30f, 1.0f, 1e-30f, 100.0f));
+            std::vector<BFloat16Vector> encoded(vectors.size());
+            std::vector<Vector> decoded(vectors.size());
+
+            // Act
+            batch::encode_bfloat16(vectors.data(), encoded.data(), vectors.size());
+            batch::decode_bfloat16(encoded.data(), decoded.data(), vectors.size());
+
+            // 1 + 2^-8 is halfway and rounds to even, 1 + 3 * 2^-8 rounds up
+            const BFloat16Vector b = encode_bfloat16(Vector(1.00390625f, 1.01171875f, FLT_MAX, NAN));
+
+            // Assert
+            for(size_t i = 0; i < vectors.size(); ++i) {
+                assert_relative(vectors[i].x(), decoded[i].x(), 1.0f / 256.0f);
+                assert_relative(vectors[i].y(), decoded[i].y(), 1.0f / 256.0f);
+                assert_relative(vectors[i].z(), decoded[i].z(), 1.0f / 256.0f);
+                assert_relative(vectors[i].w(), decoded[i].w(), 1.0f / 256.0f);
+            }
+
+            Assert::AreEqual(static_cast<uint16_t>(0x3f80), b.x);
+            Assert::AreEqual(static_cast<uint16_t>(0x3f82), b.y);
+            Assert::AreEqual(static_cast<uint16_t>(0x7f80), b.z);
+            Assert::AreEqual(static_cast<uint16_t>(0x7fc0), b.w);
+            Assert::IsTrue(std::isnan(decode(b).w()));
+        });
+    }
+
+    TEST_METHOD(octahedral)
+    {
+        for_each_simd_level([this]() {
+            // Arrange
+            std::vector<Vector> normals(EncodingSize * 10);
+            Random(3).unit_vectors(normals.data(), normals.size());
+            normals[0] = Vector(0.0f, 0.0f, 1.0f);
+            normals[1] = Vector(0.0f, 0.0f, -1.0f);
+            normals[2] = Vector(-1.0f, 0.0f, 0.0f);
+            normals[3] = Vector(0.0f, 3.0f, 0.0f);
+            std::vector<OctahedralNormal> encoded(normals.size());
+            std::vector<Normal3> decoded(normals.size());
+
+            // Act
+            batch::encode_octahedral(normals.data(), encoded.data(), normals.size());
+            batch::decode_octahedral(encoded.data(), decoded.data(), normals.size());
+
+            // Assert
+            for(size_t i = 0; i < normals.size(); ++i) {
+                // the sine of the angle, acos() isn't accurate enough this close to 1
+                const Vector n = normals[i].normalized();
+                Assert::IsTrue((n ^ decoded[i]).length() <= 0.0001f);
+                Assert::AreEqual(1.0f, decoded[i].length(), 1e-6f);
+                Assert::AreEqual(0.0f, decoded[i].w());
+            }
+
+            // the axes are exact
+            Assert::IsTrue(Vector(0.0f, 0.0f, 1.0f) == decoded[0]);
+            Assert::IsTrue(Vector(0.0f, 0.0f, -1.0f) == decoded[1]);
+            Assert::IsTrue(Vector(-1.0f, 0.0f, 0.0f) == decoded[2]);
+            Assert::IsTrue(Vector(0.0f, 1.0f, 0.0f) == decoded[3]);
+            Assert::IsTrue(Vector(0.0f, 0.0f, 1.0f) == decode(encode_octahedral(Vector())));
+        });
+    }
+
+    TEST_METHOD(quantize)
+    {
+        for_each_simd_level([this]() {
+            // Arrange
+            const AABB bounds(Point3(-100.0f, 0.0f, 5.0f), Point3(100.0f, 1.0f, 5.0f));
+            std::vector<Point3> points(EncodingSize);
+            Random(4).in_box(points.data(), points.size(), bounds.minimum(), bounds.maximum());
+            points[0] = bounds.maximum();
+            std::vector<QuantizedPosition> encoded(points.size());
+            std::vector<Point3> decoded(points.size());
+
+            // Act
+            batch::quantize(bounds, points.data(), encoded.data(), points.size());
+            batch::dequantize(bounds, encoded.data(), decoded.data(), points.size());
+            const QuantizedPosition outside = math::quantize(bounds, Point3(-200.0f, 2.0f, 6.0f));
+
+            // Assert
+            // half a step plus a little for the rounding of the decoded floats
+            const float tolerance_x = 200.0f / 131070.0f * 1.001f;
+            const float tolerance_y = 1.0f / 131070.0f * 1.001f;
+            for(size_t i = 0; i < points.size(); ++i) {
+                Assert::AreEqual(points[i].x(), decoded[i].x(), tolerance_x);
+                Assert::AreEqual(points[i].y(), decoded[i].y(), tolerance_y);
+
+                // the z axis is flat
+                Assert::AreEqual(5.0f, decoded[i].z());
+                Assert::AreEqual(static_cast<uint16_t>(0), encoded[i].w);
+            }
+
+            Assert::AreEqual(static_cast<uint16_t>(65535), encoded[0].x);
+            Assert::AreEqual(static_cast<uint16_t>(65535), encoded[0].y);
+            Assert::IsTrue(Point3(-100.0f, 1.0f, 5.0f) == dequantize(bounds, outside));
+        });
+    }
+};
+
+} } }
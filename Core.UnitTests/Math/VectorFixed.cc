@@ -0,0 +1,111 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Core/Math/VectorFixed.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace math {
+namespace unittests {
+
+TEST_CLASS(VectorFixedTests)
+{
+public:
+    TEST_METHOD(constructor)
+    {
+        // Arrange
+        VectorFixed v1;
+        VectorFixed v2(1, 2, 3);
+        VectorFixed v3(VectorD(1.5, -2.0, 0.25, 1.0));
+
+        // Act
+
+        // Assert
+        Assert::IsTrue(v1.is_zero());
+        Assert::IsTrue(Fixed::Zero == v2.w());
+        Assert::IsTrue(VectorD(1.5, -2.0, 0.25, 1.0) == v3.vector_d());
+    }
+
+    TEST_METHOD(arithmetic)
+    {
+        // Arrange
+        VectorFixed v1(1, 2, 3, 4);
+        VectorFixed v2(5, 6, 7, 8);
+
+        // Act
+        VectorFixed v3 = v1 + v2;
+        VectorFixed v4 = v2 - v1;
+        VectorFixed v5 = v1 * Fixed(2);
+        VectorFixed v6 = v2 / Fixed(2);
+        VectorFixed v7 = v1.multiply(v2);
+
+        // Assert
+        Assert::IsTrue(VectorFixed(6, 8, 10, 12) == v3);
+        Assert::IsTrue(VectorFixed(4, 4, 4, 4) == v4);
+        Assert::IsTrue(VectorFixed(2, 4, 6, 8) == v5);
+        Assert::IsTrue(VectorFixed(Fixed(2.5), 3, Fixed(3.5), 4) == v6);
+        Assert::IsTrue(VectorFixed(5, 12, 21, 32) == v7);
+    }
+
+    TEST_METHOD(dot_cross)
+    {
+        // Arrange
+        VectorFixed v1(1, 2, 3);
+        VectorFixed v2(4, 5, 6);
+
+        // Act
+        Fixed d = v1 * v2;
+        VectorFixed c = v1 ^ v2;
+
+        // Assert
+        Assert::IsTrue(Fixed(32) == d);
+        Assert::IsTrue(VectorFixed(-3, 6, -3) == c);
+    }
+
+    TEST_METHOD(length)
+    {
+        // Arrange
+        VectorFixed v1(2, 3, 6);
+        VectorFixed v2(300000000, -400000000, 0);
+
+        // Act
+        VectorFixed v3 = v1.normalized();
+
+        // Assert
+        Assert::IsTrue(Fixed(49) == v1.length_squared());
+        Assert::IsTrue(Fixed(7) == v1.length());
+        Assert::IsTrue(Fixed(500000000) == v2.length());
+        Assert::AreEqual(1.0, v3.length().to_double(), 1e-9);
+    }
+
+    TEST_METHOD(deterministic)
+    {
+        // Arrange
+        VectorFixed v1(Fixed(0.1), Fixed(-0.2), Fixed(0.3));
+        VectorFixed v2(Fixed(12345.678), Fixed(-0.001), Fixed(99.5));
+
+        // Act
+        VectorFixed v3 = (v1 ^ v2).normalized() * Fixed(3.5) + v1.lerp(v2, Fixed(0.75));
+
+        // Assert
+        // the exact raw bits have to be the same everywhere
+        Assert::AreEqual(static_cast<int64_t>(39768252489531), v3.x().raw());
+        Assert::AreEqual(static_cast<int64_t>(12279238063), v3.y().raw());
+        Assert::AreEqual(static_cast<int64_t>(329187971230), v3.z().raw());
+    }
+
+    TEST_METHOD(relative_to)
+    {
+        // Arrange
+        VectorFixed camera(2000000000, -2000000000, 1000000000);
+        VectorFixed position = camera + VectorFixed(Fixed(1.25), Fixed(-0.5), Fixed(0.125));
+
+        // Act
+        Vector v = position.relative_to(camera);
+
+        // Assert
+        Assert::IsTrue(Vector(1.25f, -0.5f, 0.125f) == v);
+    }
+};
+
+} } }
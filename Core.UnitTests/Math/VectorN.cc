@@ -0,0 +1,316 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Core/Math/VectorN.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace math {
+namespace unittests {
+
+// everything that doesn't need a square root has to work at compile-time
+static_assert(Vector2i(1, 2) + Vector2i(3, 4) == Vector2i(4, 6), "constexpr operator+");
+static_assert(Vector3f(1.0f, 2.0f, 3.0f) * Vector3f(4.0f, 5.0f, 6.0f) == 32.0f, "constexpr dot");
+static_assert((Vector3i::unit(0) ^ Vector3i::unit(1)) == Vector3i::unit(2), "constexpr cross");
+static_assert(Vector2i(-3, 4).manhattan_normal() == 7, "constexpr manhattan_normal");
+static_assert(Vector4d::fill(2.0).sum() == 8.0, "constexpr fill");
+static_assert(Vector3i(1, 2, 3) < Vector3i(1, 2, 4) && !(Vector3i(1, 3, 0) < Vector3i(1, 2, 9)), "constexpr operator<");
+
+TEST_CLASS(VectorNTests)
+{
+public:
+    TEST_METHOD(constructor_default)
+    {
+        // Arrange
+        Vector3f v1;
+        Vector2i v2;
+
+        // Act
+
+        // Assert
+        Assert::IsTrue(v1.is_zero());
+        Assert::IsTrue(v2.is_zero());
+    }
+
+    TEST_METHOD(constructor_components)
+    {
+        // Arrange
+        Vector4d v1(1.0, 2.0, 3.0, 4.0);
+        Vector2f v2(1, 2);
+
+        // Act
+
+        // Assert
+        Assert::AreEqual(1.0, v1.x());
+        Assert::AreEqual(2.0, v1.y());
+        Assert::AreEqual(3.0, v1.z());
+        Assert::AreEqual(4.0, v1.w());
+        Assert::AreEqual(1.0f, v2.x());
+        Assert::AreEqual(2.0f, v2.y());
+    }
+
+    TEST_METHOD(constructor_convert)
+    {
+        // Arrange
+        Vector3f v1(1.75f, -2.5f, 3.0f);
+        Vector v2(1.0f, 2.0f, 3.0f, 4.0f);
+
+        // Act
+        Vector3i v3(v1);
+        Vector2f v4(v2);
+
+        // Assert
+        Assert::IsTrue(Vector3i(1, -2, 3) == v3);
+        Assert::IsTrue(Vector2f(1.0f, 2.0f) == v4);
+        Assert::IsTrue(Vector(1.0f, -2.5f, 3.0f, 0.0f) == Vector3f(v3).vector() + Vector(0.0f, -0.5f, 0.0f));
+        Assert::IsTrue(Vector(1.75f, -2.5f, 3.0f, 0.0f) == v1.vector());
+    }
+
+    TEST_METHOD(size)
+    {
+        // Assert
+        Assert::AreEqual(static_cast<size_t>(8), sizeof(Vector2f));
+        Assert::AreEqual(static_cast<size_t>(12), sizeof(Vector3f));
+        Assert::AreEqual(static_cast<size_t>(16), sizeof(Vector4f));
+        Assert::AreEqual(static_cast<size_t>(16), sizeof(Vector2d));
+        Assert::AreEqual(static_cast<size_t>(12), sizeof(Vector3i));
+    }
+
+    TEST_METHOD(swizzle)
+    {
+        // Arrange
+        Vector4i v1(1, 2, 3, 4);
+
+        // Act
+        Vector2i v2 = v1.xy();
+        Vector3i v3 = v1.xyz();
+
+        // Assert
+        Assert::IsTrue(Vector2i(1, 2) == v2);
+        Assert::IsTrue(Vector3i(1, 2, 3) == v3);
+    }
+
+    TEST_METHOD(length)
+    {
+        // Arrange
+        Vector2f v1(3.0f, 4.0f);
+        Vector3d v2(2.0, 3.0, 6.0);
+        Vector2i v3(-3, 4);
+
+        // Act
+
+        // Assert
+        Assert::AreEqual(25.0f, v1.length_squared());
+        Assert::AreEqual(5.0f, v1.length());
+        Assert::AreEqual(7.0, v2.length());
+        Assert::AreEqual(25, v3.length_squared());
+        Assert::AreEqual(5.0f, v3.length());
+    }
+
+    TEST_METHOD(normalize)
+    {
+        // Arrange
+        Vector2f v1(3.0f, 4.0f);
+        Vector3d v2(2.0, 3.0, 6.0);
+
+        // Act
+        v1.normalize(Precision::Exact);
+        Vector3d v3 = v2.normalized();
+
+        // Assert
+        Assert::AreEqual(0.6f, v1.x(), 0.00001f);
+        Assert::AreEqual(0.8f, v1.y(), 0.00001f);
+        Assert::AreEqual(1.0, v3.length(), 1e-15);
+        Assert::AreEqual(6.0 / 7.0, v3.z(), 1e-15);
+    }
+
+    TEST_METHOD(distance)
+    {
+        // Arrange
+        Vector2i v1(1, 1);
+        Vector2i v2(4, 5);
+
+        // Act
+
+        // Assert
+        Assert::AreEqual(25, v1.distance_squared(v2));
+        Assert::AreEqual(5.0f, v1.distance(v2));
+        Assert::AreEqual(7, v1.manhattan_distance(v2));
+    }
+
+    TEST_METHOD(normals)
+    {
+        // Arrange
+        Vector3i v1(-7, 2, 5);
+
+        // Act
+
+        // Assert
+        Assert::AreEqual(14, v1.manhattan_normal());
+        Assert::AreEqual(7, v1.infinite_normal());
+        Assert::AreEqual(-7, v1.min_component());
+        Assert::AreEqual(5, v1.max_component());
+        Assert::AreEqual(0, v1.sum());
+    }
+
+    TEST_METHOD(minimum_maximum)
+    {
+        // Arrange
+        Vector3f v1(1.0f, 5.0f, -2.0f);
+        Vector3f v2(3.0f, -1.0f, -2.0f);
+
+        // Act
+        Vector3f v3 = v1.minimum(v2);
+        Vector3f v4 = v1.maximum(v2);
+
+        // Assert
+        Assert::IsTrue(Vector3f(1.0f, -1.0f, -2.0f) == v3);
+        Assert::IsTrue(Vector3f(3.0f, 5.0f, -2.0f) == v4);
+    }
+
+    TEST_METHOD(dot)
+    {
+        // Arrange
+        Vector2f v1(1.0f, 2.0f);
+        Vector2f v2(3.0f, -4.0f);
+
+        // Act
+        float d1 = v1 * v2;
+        float d2 = v1.dot(v2);
+
+        // Assert
+        Assert::AreEqual(-5.0f, d1);
+        Assert::AreEqual(-5.0f, d2);
+    }
+
+    TEST_METHOD(cross)
+    {
+        // Arrange
+        Vector3f v1(1.0f, 2.0f, 3.0f);
+        Vector3f v2(4.0f, 5.0f, 6.0f);
+
+        // Act
+        Vector3f v3 = v1 ^ v2;
+        Vector3f v4(v1);
+        v4 ^= v2;
+
+        // Assert
+        Assert::IsTrue((Vector(1.0f, 2.0f, 3.0f) ^ Vector(4.0f, 5.0f, 6.0f)) == v3.vector());
+        Assert::IsTrue(v3 == v4);
+    }
+
+    TEST_METHOD(perp_dot)
+    {
+        // Arrange
+        Vector2i v1(1, 0);
+        Vector2i v2(0, 1);
+
+        // Act
+        int d1 = v1.perp_dot(v2);
+        int d2 = v2.perp_dot(v1);
+        Vector2i v3 = v1.perpendicular();
+
+        // Assert
+        Assert::AreEqual(1, d1);
+        Assert::AreEqual(-1, d2);
+        Assert::IsTrue(v2 == v3);
+    }
+
+    TEST_METHOD(lerp)
+    {
+        // Arrange
+        Vector3f v1(0.0f, 10.0f, -4.0f);
+        Vector3f v2(10.0f, 20.0f, 4.0f);
+
+        // Act
+        Vector3f v3 = v1.lerp(v2, 0.25f);
+
+        // Assert
+        Assert::IsTrue(Vector3f(2.5f, 12.5f, -2.0f) == v3);
+        Assert::IsTrue(v1 == v1.lerp(v2, 0.0f));
+        Assert::IsTrue(v2 == v1.lerp(v2, 1.0f));
+    }
+
+    TEST_METHOD(arithmetic)
+    {
+        // Arrange
+        Vector3i v1(1, 2, 3);
+        Vector3i v2(4, 5, 6);
+
+        // Act
+        Vector3i v3 = v1 + v2;
+        Vector3i v4 = v2 - v1;
+        Vector3i v5 = v1 * 2;
+        Vector3i v6 = 2 * v1;
+        Vector3i v7 = v2 / 2;
+        Vector3i v8 = -v1;
+        Vector3i v9 = v1.multiply(v2);
+
+        // Assert
+        Assert::IsTrue(Vector3i(5, 7, 9) == v3);
+        Assert::IsTrue(Vector3i(3, 3, 3) == v4);
+        Assert::IsTrue(Vector3i(2, 4, 6) == v5);
+        Assert::IsTrue(v5 == v6);
+        Assert::IsTrue(Vector3i(2, 2, 3) == v7);
+        Assert::IsTrue(Vector3i(-1, -2, -3) == v8);
+        Assert::IsTrue(Vector3i(4, 10, 18) == v9);
+    }
+
+    TEST_METHOD(arithmetic_assign)
+    {
+        // Arrange
+        Vector2f v1(1.0f, 2.0f);
+
+        // Act
+        v1 += Vector2f(1.0f, 1.0f);
+        v1 *= 3.0f;
+        v1 -= Vector2f(2.0f, 1.0f);
+        v1 /= 2.0f;
+
+        // Assert
+        Assert::IsTrue(Vector2f(2.0f, 4.0f) == v1);
+    }
+
+    TEST_METHOD(operator_less)
+    {
+        // Arrange
+        Vector2i v1(1, 5);
+        Vector2i v2(2, 0);
+        Vector2i v3(1, 6);
+
+        // Act
+
+        // Assert
+        Assert::IsTrue(v1 < v2);
+        Assert::IsTrue(v1 < v3);
+        Assert::IsFalse(v2 < v1);
+        Assert::IsFalse(v1 < v1);
+    }
+
+    TEST_METHOD(unit_fill)
+    {
+        // Arrange
+        Vector4f v1 = Vector4f::unit(2);
+        Vector2d v2 = Vector2d::fill(1.5);
+
+        // Act
+
+        // Assert
+        Assert::IsTrue(Vector4f(0.0f, 0.0f, 1.0f, 0.0f) == v1);
+        Assert::IsTrue(Vector2d(1.5, 1.5) == v2);
+    }
+
+    TEST_METHOD(str)
+    {
+        // Arrange
+        Vector2i v1(1, -2);
+
+        // Act
+        std::string s = v1.str();
+
+        // Assert
+        Assert::AreEqual(std::string("VectorN(x:1, y:-2)"), s);
+    }
+};
+
+} } }
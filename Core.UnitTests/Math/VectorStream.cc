@@ -0,0 +1,372 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Core/Memory/Arena.h"
+#include "Core/Math/VectorStream.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace math {
+namespace unittests {
+
+// odd-sized so that every kernel has to handle a remainder
+static const size_t TestSize = 37;
+
+TEST_CLASS(VectorStreamTests)
+{
+private:
+    std::vector<Vector> create_test_vectors(float offset)
+    {
+        std::vector<Vector> vectors;
+        for(size_t i = 0; i < TestSize; ++i) {
+            const float f = static_cast<float>(i) + offset;
+            vectors.emplace_back(f, 2.0f * f - 3.0f, 1.0f - f, 0.5f * f);
+        }
+        return vectors;
+    }
+
+    void assert_equal(const Vector& expected, const Vector& actual)
+    {
+        Assert::AreEqual(expected.x(), actual.x(), 0.001f);
+        Assert::AreEqual(expected.y(), actual.y(), 0.001f);
+        Assert::AreEqual(expected.z(), actual.z(), 0.001f);
+        Assert::AreEqual(expected.w(), actual.w(), 0.001f);
+    }
+
+public:
+    TEST_METHOD(constructor_default)
+    {
+        // Arrange
+        VectorStream s1;
+
+        // Act
+
+        // Assert
+        Assert::IsTrue(s1.empty());
+        Assert::AreEqual(static_cast<size_t>(0), s1.size());
+    }
+
+    TEST_METHOD(constructor_size)
+    {
+        // Arrange
+        VectorStream s1(TestSize);
+
+        // Act
+
+        // Assert
+        Assert::AreEqual(TestSize, s1.size());
+        Assert::IsTrue(s1.capacity() >= TestSize);
+        for(size_t i = 0; i < s1.size(); ++i) {
+            Assert::IsTrue(s1[i].is_zero());
+        }
+    }
+
+    TEST_METHOD(alignment)
+    {
+        // Arrange
+        VectorStream s1(TestSize);
+
+        // Act
+
+        // Assert
+        Assert::AreEqual(static_cast<size_t>(0), reinterpret_cast<size_t>(s1.x()) % VectorStream::Alignment);
+        Assert::AreEqual(static_cast<size_t>(0), reinterpret_cast<size_t>(s1.y()) % VectorStream::Alignment);
+        Assert::AreEqual(static_cast<size_t>(0), reinterpret_cast<size_t>(s1.z()) % VectorStream::Alignment);
+        Assert::AreEqual(static_cast<size_t>(0), reinterpret_cast<size_t>(s1.w()) % VectorStream::Alignment);
+    }
+
+    TEST_METHOD(load_store)
+    {
+        // Arrange
+        std::vector<Vector> v1 = create_test_vectors(1.0f);
+        std::vector<Vector> v2(TestSize);
+
+        // Act
+        VectorStream s1(v1.data(), v1.size());
+        s1.store(v2.data());
+
+        // Assert
+        Assert::AreEqual(TestSize, s1.size());
+        for(size_t i = 0; i < TestSize; ++i) {
+            Assert::IsTrue(v1[i] == s1[i]);
+            Assert::IsTrue(v1[i] == v2[i]);
+        }
+    }
+
+    TEST_METHOD(load_stream)
+    {
+        // Arrange
+        std::vector<Vector> v1 = create_test_vectors(1.0f);
+        memory::Arena arena;
+
+        // Act
+        arena.allocate(4, 4);
+        const StreamRef s1 = math::load_stream(v1.data(), v1.size(), arena);
+
+        // Assert
+        for(const float* component : { s1.x, s1.y, s1.z, s1.w }) {
+            Assert::AreEqual(static_cast<size_t>(0), reinterpret_cast<size_t>(component) % VectorStream::Alignment);
+        }
+        for(size_t i = 0; i < TestSize; ++i) {
+            Assert::IsTrue(v1[i] == Vector(s1.x[i], s1.y[i], s1.z[i], s1.w[i]));
+        }
+    }
+
+    TEST_METHOD(push_back)
+    {
+        // Arrange
+        std::vector<Vector> v1 = create_test_vectors(1.0f);
+        VectorStream s1;
+
+        // Act
+        for(const Vector& v : v1) {
+            s1.push_back(v);
+        }
+
+        // Assert
+        Assert::AreEqual(TestSize, s1.size());
+        for(size_t i = 0; i < TestSize; ++i) {
+            Assert::IsTrue(v1[i] == s1[i]);
+        }
+    }
+
+    TEST_METHOD(copy_move)
+    {
+        // Arrange
+        std::vector<Vector> v1 = create_test_vectors(1.0f);
+        VectorStream s1(v1.data(), v1.size());
+
+        // Act
+        VectorStream s2(s1);
+        VectorStream s3(std::move(s1));
+
+        // Assert
+        Assert::IsTrue(s1.empty());
+        for(size_t i = 0; i < TestSize; ++i) {
+            Assert::IsTrue(v1[i] == s2[i]);
+            Assert::IsTrue(v1[i] == s3[i]);
+        }
+    }
+
+    TEST_METHOD(copy_empty)
+    {
+        // Arrange
+        std::vector<Vector> v1 = create_test_vectors(1.0f);
+        VectorStream s1;
+        VectorStream s2(v1.data(), v1.size());
+
+        // Act
+        VectorStream s3(s1);
+        VectorStream s4;
+        s4 = s1;
+        s2 = s1;
+
+        // Assert
+        Assert::IsTrue(s3.empty());
+        Assert::IsTrue(s4.empty());
+        Assert::IsTrue(s2.empty());
+    }
+
+    TEST_METHOD(operator_plus_assign)
+    {
+        // Arrange
+        std::vector<Vector> v1 = create_test_vectors(1.0f);
+        std::vector<Vector> v2 = create_test_vectors(-5.0f);
+        VectorStream s1(v1.data(), v1.size());
+        VectorStream s2(v2.data(), v2.size());
+
+        // Act
+        s1 += s2;
+
+        // Assert
+        for(size_t i = 0; i < TestSize; ++i) {
+            assert_equal(v1[i] + v2[i], s1[i]);
+        }
+    }
+
+    TEST_METHOD(operator_minus_assign)
+    {
+        // Arrange
+        std::vector<Vector> v1 = create_test_vectors(1.0f);
+        std::vector<Vector> v2 = create_test_vectors(-5.0f);
+        VectorStream s1(v1.data(), v1.size());
+        VectorStream s2(v2.data(), v2.size());
+
+        // Act
+        s1 -= s2;
+
+        // Assert
+        for(size_t i = 0; i < TestSize; ++i) {
+            assert_equal(v1[i] - v2[i], s1[i]);
+        }
+    }
+
+    TEST_METHOD(operator_scale_assign)
+    {
+        // Arrange
+        std::vector<Vector> v1 = create_test_vectors(1.0f);
+        VectorStream s1(v1.data(), v1.size());
+
+        // Act
+        s1 *= 3.0f;
+
+        // Assert
+        for(size_t i = 0; i < TestSize; ++i) {
+            assert_equal(v1[i] * 3.0f, s1[i]);
+        }
+    }
+
+    TEST_METHOD(operator_descale_assign)
+    {
+        // Arrange
+        std::vector<Vector> v1 = create_test_vectors(1.0f);
+        VectorStream s1(v1.data(), v1.size());
+
+        // Act
+        s1 /= 4.0f;
+
+        // Assert
+        for(size_t i = 0; i < TestSize; ++i) {
+            assert_equal(v1[i] / 4.0f, s1[i]);
+        }
+    }
+
+    TEST_METHOD(dot)
+    {
+        // Arrange
+        std::vector<Vector> v1 = create_test_vectors(1.0f);
+        std::vector<Vector> v2 = create_test_vectors(-5.0f);
+        VectorStream s1(v1.data(), v1.size());
+        VectorStream s2(v2.data(), v2.size());
+        std::vector<float> dots(TestSize);
+
+        // Act
+        s1.dot(s2, dots.data());
+
+        // Assert
+        for(size_t i = 0; i < TestSize; ++i) {
+            Assert::AreEqual(v1[i] * v2[i], dots[i], 0.01f);
+        }
+    }
+
+    TEST_METHOD(cross)
+    {
+        // Arrange
+        std::vector<Vector> v1 = create_test_vectors(1.0f);
+        std::vector<Vector> v2 = create_test_vectors(-5.0f);
+        VectorStream s1(v1.data(), v1.size());
+        VectorStream s2(v2.data(), v2.size());
+        VectorStream s3;
+
+        // Act
+        s1.cross(s2, s3);
+        s1 ^= s2;
+
+        // Assert
+        for(size_t i = 0; i < TestSize; ++i) {
+            assert_equal(v1[i] ^ v2[i], s3[i]);
+            assert_equal(v1[i] ^ v2[i], s1[i]);
+        }
+    }
+
+    TEST_METHOD(multiply)
+    {
+        // Arrange
+        std::vector<Vector> v1 = create_test_vectors(1.0f);
+        std::vector<Vector> v2 = create_test_vectors(-5.0f);
+        VectorStream s1(v1.data(), v1.size());
+        VectorStream s2(v2.data(), v2.size());
+        VectorStream s3;
+
+        // Act
+        s1.multiply(s2, s3);
+
+        // Assert
+        for(size_t i = 0; i < TestSize; ++i) {
+            assert_equal(v1[i].multiply(v2[i]), s3[i]);
+        }
+    }
+
+    TEST_METHOD(length)
+    {
+        // Arrange
+        std::vector<Vector> v1 = create_test_vectors(1.0f);
+        VectorStream s1(v1.data(), v1.size());
+        std::vector<float> lengths(TestSize);
+        std::vector<float> lengths_squared(TestSize);
+
+        // Act
+        s1.length(lengths.data());
+        s1.length_squared(lengths_squared.data());
+
+        // Assert
+        for(size_t i = 0; i < TestSize; ++i) {
+            Assert::AreEqual(v1[i].length(), lengths[i], 0.001f);
+            Assert::AreEqual(v1[i].length_squared(), lengths_squared[i], 0.01f);
+        }
+    }
+
+    TEST_METHOD(normalize)
+    {
+        // Arrange
+        std::vector<Vector> v1 = create_test_vectors(1.0f);
+        VectorStream s1(v1.data(), v1.size());
+        VectorStream s2;
+
+        // Act
+        s1.normalized(s2);
+        s1.normalize();
+
+        // Assert
+        for(size_t i = 0; i < TestSize; ++i) {
+            const Vector expected = v1[i] / v1[i].length();
+            assert_equal(expected, s1[i]);
+            assert_equal(expected, s2[i]);
+        }
+    }
+
+    TEST_METHOD(distance)
+    {
+        // Arrange
+        std::vector<Vector> v1 = create_test_vectors(1.0f);
+        std::vector<Vector> v2 = create_test_vectors(-5.0f);
+        VectorStream s1(v1.data(), v1.size());
+        VectorStream s2(v2.data(), v2.size());
+        std::vector<float> distances(TestSize);
+        std::vector<float> distances_squared(TestSize);
+
+        // Act
+        s1.distance(s2, distances.data());
+        s1.distance_squared(s2, distances_squared.data());
+
+        // Assert
+        for(size_t i = 0; i < TestSize; ++i) {
+            Assert::AreEqual(v1[i].distance(v2[i]), distances[i], 0.001f);
+            Assert::AreEqual(v1[i].distance_squared(v2[i]), distances_squared[i], 0.01f);
+        }
+    }
+
+    TEST_METHOD(lerp)
+    {
+        // Arrange
+        std::vector<Vector> v1 = create_test_vectors(1.0f);
+        std::vector<Vector> v2 = create_test_vectors(-5.0f);
+        VectorStream s1(v1.data(), v1.size());
+        VectorStream s2(v2.data(), v2.size());
+        VectorStream s3, s4, s5;
+
+        // Act
+        s1.lerp(s2, 0.0f, s3);
+        s1.lerp(s2, 1.0f, s4);
+        s1.lerp(s2, 0.25f, s5);
+
+        // Assert
+        for(size_t i = 0; i < TestSize; ++i) {
+            Assert::IsTrue(v1[i] == s3[i]);
+            Assert::IsTrue(v2[i] == s4[i]);
+            assert_equal(v1[i].lerp(v2[i], 0.25), s5[i]);
+        }
+    }
+};
+
+} } }
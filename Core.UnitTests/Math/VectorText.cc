@@ -0,0 +1,330 @@
+#include "pch.h"
+#include <cfloat>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include "CppUnitTest.h"
+#include "Core/Math/Random.h"
+#include "Core/Math/VectorText.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace math {
+namespace unittests {
+
+TEST_CLASS(VectorTextTests)
+{
+private:
+    static std::string format(float v, FloatFormat format = FloatFormat::Shortest, int precision = 6)
+    {
+        char buffer[MaxFloatChars];
+        char* const end = to_chars(buffer, buffer + sizeof(buffer), v, format, precision);
+        Assert::IsNotNull(end);
+        return std::string(buffer, end);
+    }
+
+    static float parse(const std::string& text, size_t expected_length)
+    {
+        float value = -1.0f;
+        const char* const end = math::from_chars(text.data(), text.data() + text.length(), value);
+        Assert::IsNotNull(end);
+        Assert::AreEqual(expected_length, static_cast<size_t>(end - text.data()));
+        return value;
+    }
+
+    static float parse(const std::string& text)
+    {
+        return parse(text, text.length());
+    }
+
+    // finite floats with uniformly random bits, so every exponent is covered
+    static std::vector<float> random_floats(size_t count, uint64_t seed)
+    {
+        std::mt19937_64 random(seed);
+        std::vector<float> values;
+        while(values.size() < count) {
+            const uint32_t bits = static_cast<uint32_t>(random());
+            float v;
+            std::memcpy(&v, &bits, sizeof(v));
+            if(std::isfinite(v)) {
+                values.push_back(v);
+            }
+        }
+        return values;
+    }
+
+    // ignoring the sign, the decimal point, the exponent and leading and trailing zeros
+    static size_t significant_digits(const std::string& text)
+    {
+        std::string digits;
+        for(char c : text.substr(0, text.find('e'))) {
+            if(c >= '0' && c <= '9') {
+                digits += c;
+            }
+        }
+        const size_t first = digits.find_first_not_of('0');
+        return digits.find_last_not_of('0') - first + 1;
+    }
+
+    static bool same_bits(float expected, float actual)
+    {
+        return 0 == std::memcmp(&expected, &actual, sizeof(float));
+    }
+
+public:
+    TEST_METHOD(shortest)
+    {
+        // Arrange
+
+        // Act
+
+        // Assert
+        Assert::AreEqual(std::string("0"), format(0.0f));
+        Assert::AreEqual(std::string("-0"), format(-0.0f));
+        Assert::AreEqual(std::string("1"), format(1.0f));
+        Assert::AreEqual(std::string("-2.5"), format(-2.5f));
+        Assert::AreEqual(std::string("0.1"), format(0.1f));
+        Assert::AreEqual(std::string("100"), format(100.0f));
+        Assert::AreEqual(std::string("0.0001"), format(0.0001f));
+        Assert::AreEqual(std::string("1.5e-5"), format(1.5e-5f));
+        Assert::AreEqual(std::string("123456790"), format(123456789.0f));
+        Assert::AreEqual(std::string("1e9"), format(1e9f));
+        Assert::AreEqual(std::string("3.4028235e38"), format(FLT_MAX));
+        Assert::AreEqual(std::string("1.1754944e-38"), format(FLT_MIN));
+        Assert::AreEqual(std::string("1e-45"), format(std::numeric_limits<float>::denorm_min()));
+        Assert::AreEqual(std::string("inf"), format(HUGE_VALF));
+        Assert::AreEqual(std::string("-inf"), format(-HUGE_VALF));
+        Assert::AreEqual(std::string("nan"), format(NAN));
+    }
+
+    TEST_METHOD(shortest_round_trip)
+    {
+        // Arrange
+        const std::vector<float> values = random_floats(200000, 1);
+
+        // Act
+
+        // Assert
+        for(size_t i = 0; i < values.size(); ++i) {
+            const std::string text = format(values[i]);
+            Assert::IsTrue(same_bits(values[i], std::strtof(text.c_str(), nullptr)));
+
+            // no shorter printf() precision round trips
+            if(0 == i % 16) {
+                const size_t digits = significant_digits(text);
+                if(digits > 1) {
+                    char shorter[32];
+                    std::snprintf(shorter, sizeof(shorter), "%.*g", static_cast<int>(digits - 1), values[i]);
+                    Assert::IsFalse(same_bits(values[i], std::strtof(shorter, nullptr)));
+                }
+            }
+        }
+    }
+
+    TEST_METHOD(fixed)
+    {
+        // Arrange
+        std::vector<float> values = random_floats(20000, 2);
+        values.push_back(0.5f);
+        values.push_back(-0.0f);
+        values.push_back(-1e-9f);
+        values.push_back(FLT_MAX);
+
+        // Act
+
+        // Assert
+        for(float v : values) {
+            for(int precision = 0; precision <= 9; ++precision) {
+                char expected[64];
+                std::snprintf(expected, sizeof(expected), "%.*f", precision, v);
+                Assert::AreEqual(std::string(expected), format(v, FloatFormat::Fixed, precision));
+            }
+        }
+
+        // ties go to even like printf()
+        Assert::AreEqual(std::string("2"), format(2.5f, FloatFormat::Fixed, 0));
+        Assert::AreEqual(std::string("0.125"), format(0.125f, FloatFormat::Fixed, 3));
+        Assert::AreEqual(std::string("0.12"), format(0.125f, FloatFormat::Fixed, 2));
+    }
+
+    TEST_METHOD(buffer_too_small)
+    {
+        // Arrange
+        char buffer[8] = "xxxxxxx";
+
+        // Act
+        char* const fits = to_chars(buffer, buffer + 4, -2.5f);
+        char* const doesnt = to_chars(buffer + 4, buffer + 7, 1.2345f);
+
+        // Assert
+        Assert::IsTrue(buffer + 4 == fits);
+        Assert::IsTrue(nullptr == doesnt);
+        Assert::AreEqual(std::string("-2.5xxx"), std::string(buffer));
+    }
+
+    TEST_METHOD(parse_floats)
+    {
+        // Arrange
+
+        // Act
+
+        // Assert
+        Assert::AreEqual(1.0f, parse("1"));
+        Assert::AreEqual(-0.5f, parse("-.5"));
+        Assert::AreEqual(0.5f, parse("+0.5"));
+        Assert::AreEqual(1.5e-5f, parse("1.5e-5"));
+        Assert::AreEqual(1.5e-5f, parse("0.000015"));
+        Assert::AreEqual(250.0f, parse("2.5E+2"));
+        Assert::AreEqual(FLT_MAX, parse("3.4028235e38"));
+        Assert::AreEqual(std::numeric_limits<float>::denorm_min(), parse("1e-45"));
+        Assert::AreEqual(HUGE_VALF, parse("1e39"));
+        Assert::AreEqual(0.0f, parse("1e-50"));
+        Assert::AreEqual(-HUGE_VALF, parse("-inf"));
+        Assert::IsTrue(std::isnan(parse("nan")));
+        Assert::AreEqual(0.1f, parse("0.1000000000000000000000000000001"));
+        Assert::AreEqual(1.0f, parse(std::string(70, '0') + "1"));
+        Assert::AreEqual(std::strtof(std::string(70, '1').c_str(), nullptr), parse(std::string(70, '1')));
+
+        // stops at anything that isn't part of the float
+        Assert::AreEqual(1.0f, parse("1e", 1));
+        Assert::AreEqual(2.0f, parse("2 3", 1));
+        Assert::AreEqual(3.0f, parse("3,4", 1));
+
+        float value;
+        const char* const text = "x";
+        Assert::IsNull(from_chars(text, text + 1, value));
+        Assert::IsNull(from_chars(text, text, value));
+    }
+
+    TEST_METHOD(parse_rounding)
+    {
+        // Arrange
+        const std::vector<float> values = random_floats(100000, 3);
+        std::mt19937_64 random(4);
+
+        // Act
+
+        // Assert
+        for(float v : values) {
+            // exact round trips, plus arbitrary decimals that have to be rounded
+            char text[64];
+            const int length = std::snprintf(text, sizeof(text), "%.9g", v);
+            Assert::IsTrue(same_bits(v, parse(std::string(text, length))));
+
+            const int digits = 1 + static_cast<int>(random() % 12);
+            const int decimal_length = std::snprintf(text, sizeof(text), "%.*e", digits, static_cast<double>(v) * 1.000001);
+            Assert::IsTrue(same_bits(std::strtof(text, nullptr), parse(std::string(text, decimal_length))));
+        }
+    }
+
+    TEST_METHOD(str)
+    {
+        // Arrange
+        const Vector v(1.5f, -0.0000004f, 123456.789f, -1e20f);
+
+        // Act
+        std::stringstream expected;
+        expected << "Vector(x:" << std::fixed << v.x() << ", y:" << v.y() << ", z:" << v.z() << ", w:" << v.w() << ")";
+
+        // Assert
+        Assert::AreEqual(expected.str(), v.str());
+    }
+
+    TEST_METHOD(format_and_parse_vectors)
+    {
+        // Arrange
+        std::vector<Vector> vectors(1000);
+        Random(5).in_box(vectors.data(), vectors.size(), Vector(-1000.0f, -1.0f, -1e-6f, -1e20f), Vector(1000.0f, 1.0f, 1e-6f, 1e20f));
+        std::vector<char> text(vectors.size() * (4 * MaxFloatChars + 4));
+        std::vector<Vector> parsed(vectors.size());
+
+        // Act
+        const FormatVectorsResult formatted = format_vectors(text.data(), text.data() + text.size(), vectors.data(), vectors.size());
+        const ParseVectorsResult result = parse_vectors(text.data(), formatted.ptr, parsed.data(), parsed.size());
+
+        // Assert
+        Assert::AreEqual(vectors.size(), formatted.count);
+        Assert::AreEqual(vectors.size(), result.count);
+        Assert::IsTrue(result.ok);
+        Assert::IsTrue(formatted.ptr == result.ptr);
+        Assert::IsTrue(vectors == parsed);
+    }
+
+    TEST_METHOD(format_vectors_partial)
+    {
+        // Arrange
+        const Vector vectors[] = { Vector(1.0f, 2.0f, 3.0f), Vector(4.0f, 5.0f, 6.0f) };
+        // one byte short of both lines
+        char text[15];
+        VectorTextFormat format;
+        format.components = 3;
+        format.prefix = "v";
+
+        // Act
+        const FormatVectorsResult result = format_vectors(text, text + sizeof(text), vectors, 2, format);
+
+        // Assert
+        Assert::AreEqual(static_cast<size_t>(1), result.count);
+        Assert::AreEqual(std::string("v 1 2 3\n"), std::string(text, result.ptr));
+    }
+
+    TEST_METHOD(parse_vectors_formats)
+    {
+        // Arrange
+        const std::string obj = "# a cube\nmtllib cube.mtl\nv 1.0 2.0 3.0\nvn 0 0 1\n\nv  -1 -2 -3 0.5 0.5 0.5\r\nf 1 2 3\nv 4 5 6";
+        const std::string csv = "1,2,3,4\r\n5, 6, 7, 8\n\t9\t10\t11\t12";
+        Vector out[4];
+
+        VectorTextFormat format;
+        format.components = 3;
+        format.defaults = Vector(0.0f, 0.0f, 0.0f, 1.0f);
+        format.prefix = "v";
+
+        // Act
+        const ParseVectorsResult vertices = parse_vectors(obj.data(), obj.data() + obj.length(), out, 4, format);
+        const Vector first = out[0];
+        const Vector second = out[1];
+        const Vector third = out[2];
+        const ParseVectorsResult rows = parse_vectors(csv.data(), csv.data() + csv.length(), out, 4);
+
+        // Assert
+        Assert::AreEqual(static_cast<size_t>(3), vertices.count);
+        Assert::IsTrue(vertices.ok);
+        Assert::IsTrue(Vector(1.0f, 2.0f, 3.0f, 1.0f) == first);
+        Assert::IsTrue(Vector(-1.0f, -2.0f, -3.0f, 1.0f) == second);
+        Assert::IsTrue(Vector(4.0f, 5.0f, 6.0f, 1.0f) == third);
+
+        Assert::AreEqual(static_cast<size_t>(3), rows.count);
+        Assert::IsTrue(Vector(5.0f, 6.0f, 7.0f, 8.0f) == out[1]);
+        Assert::IsTrue(Vector(9.0f, 10.0f, 11.0f, 12.0f) == out[2]);
+    }
+
+    TEST_METHOD(parse_vectors_stops)
+    {
+        // Arrange
+        const std::string text = "1 2 3 4\n5 6 7 8\n9 10 11\n";
+        Vector out[4];
+
+        // Act
+        const ParseVectorsResult full = parse_vectors(text.data(), text.data() + text.length(), out, 1);
+        const ParseVectorsResult next = parse_vectors(full.ptr, text.data() + text.length(), out + 1, 3);
+
+        // Assert
+        // out of room
+        Assert::AreEqual(static_cast<size_t>(1), full.count);
+        Assert::IsTrue(full.ok);
+        Assert::AreEqual(static_cast<size_t>(8), static_cast<size_t>(full.ptr - text.data()));
+
+        // the last line is missing a component
+        Assert::AreEqual(static_cast<size_t>(1), next.count);
+        Assert::IsFalse(next.ok);
+        Assert::AreEqual(static_cast<size_t>(16), static_cast<size_t>(next.ptr - text.data()));
+        Assert::IsTrue(Vector(5.0f, 6.0f, 7.0f, 8.0f) == out[1]);
+
+        const std::string garbage = "1 2 3 4x\n";
+        Assert::IsFalse(parse_vectors(garbage.data(), garbage.data() + garbage.length(), out, 4).ok);
+    }
+};
+
+} } }
@@ -0,0 +1,77 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Core/Math/Matrix4.h"
+#include "Core/Math/Vector.h"
+#include "Core/Memory/AlignedAllocator.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace memory {
+namespace unittests {
+
+using math::Matrix4;
+using math::Vector;
+
+TEST_CLASS(AlignedAllocatorTests)
+{
+public:
+    TEST_METHOD(aligned_allocate)
+    {
+        for(size_t alignment : { 1, 4, 8, 16, 64, 256, 4096 }) {
+            // Arrange
+
+            // Act
+            void* p = memory::aligned_allocate(100, alignment);
+
+            // Assert
+            Assert::IsNotNull(p);
+            Assert::AreEqual(static_cast<size_t>(0), reinterpret_cast<size_t>(p) % alignment);
+
+            memory::aligned_deallocate(p);
+        }
+
+        Assert::IsNull(memory::aligned_allocate(0, 16));
+        memory::aligned_deallocate(nullptr);
+    }
+
+    TEST_METHOD(vector)
+    {
+        // Arrange
+        AlignedVector<Vector> vectors;
+        AlignedVector<float, 64> floats(3);
+
+        // Act
+        for(size_t i = 0; i < 100; ++i) {
+            vectors.emplace_back(static_cast<float>(i), 1.0f, 2.0f, 3.0f);
+
+            // Assert
+            Assert::AreEqual(static_cast<size_t>(0), reinterpret_cast<size_t>(vectors.data()) % alignof(Vector));
+        }
+
+        Assert::AreEqual(static_cast<size_t>(0), reinterpret_cast<size_t>(floats.data()) % 64);
+        Assert::IsTrue(Vector(99.0f, 1.0f, 2.0f, 3.0f) == vectors.back());
+    }
+
+    TEST_METHOD(rebind)
+    {
+        // Arrange
+        AlignedAllocator<Matrix4> matrices;
+        AlignedAllocator<char, 16> chars;
+
+        // Act
+        AlignedAllocator<Matrix4>::rebind<char>::other rebound(matrices);
+        Matrix4* m = matrices.allocate(2);
+        char* c = chars.allocate(3);
+
+        // Assert
+        Assert::IsTrue(matrices == AlignedAllocator<Matrix4>(rebound));
+        Assert::AreEqual(static_cast<size_t>(0), reinterpret_cast<size_t>(m) % alignof(Matrix4));
+        Assert::AreEqual(static_cast<size_t>(0), reinterpret_cast<size_t>(c) % 16);
+
+        matrices.deallocate(m, 2);
+        chars.deallocate(c, 3);
+    }
+};
+
+} } }
@@ -0,0 +1,197 @@
+#include "pch.h"
+#include <thread>
+#include "CppUnitTest.h"
+#include "Core/Math/Vector.h"
+#include "Core/Memory/Arena.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace memory {
+namespace unittests {
+
+using math::Vector;
+
+TEST_CLASS(ArenaTests)
+{
+private:
+    static size_t misalignment(const void* p, size_t alignment)
+    {
+        return reinterpret_cast<size_t>(p) % alignment;
+    }
+
+public:
+    TEST_METHOD(allocate)
+    {
+        // Arrange
+        Arena arena(1024);
+
+        // Act
+        char* a = static_cast<char*>(arena.allocate(3, 1));
+        void* b = arena.allocate(16);
+        void* c = arena.allocate(1, 64);
+        Vector* v = arena.allocate_array<Vector>(10);
+
+        // Assert
+        Assert::AreEqual(static_cast<size_t>(0), misalignment(a, Arena::BlockAlignment));
+        Assert::IsTrue(a + 16 == b);
+        Assert::AreEqual(static_cast<size_t>(0), misalignment(c, 64));
+        Assert::AreEqual(static_cast<size_t>(0), misalignment(v, alignof(Vector)));
+
+        const Arena::Stats stats = arena.stats();
+        Assert::AreEqual(static_cast<size_t>(64 + 16 + 160), stats.used);
+        Assert::AreEqual(static_cast<size_t>(1024), stats.capacity);
+        Assert::AreEqual(static_cast<size_t>(1), stats.block_count);
+        Assert::AreEqual(static_cast<size_t>(4), stats.allocations);
+    }
+
+    TEST_METHOD(grow)
+    {
+        // Arrange
+        Arena arena(1024);
+
+        // Act
+        arena.allocate(1000);
+        void* p = arena.allocate(100);
+        void* large = arena.allocate(5000);
+
+        // Assert
+        Assert::AreEqual(static_cast<size_t>(0), misalignment(p, Arena::BlockAlignment));
+        Assert::AreEqual(static_cast<size_t>(0), misalignment(large, Arena::BlockAlignment));
+
+        const Arena::Stats stats = arena.stats();
+        Assert::AreEqual(static_cast<size_t>(3), stats.block_count);
+        Assert::AreEqual(static_cast<size_t>(1024 + 1024 + 5000), stats.capacity);
+        Assert::AreEqual(static_cast<size_t>(1024 + 1024 + 5000), stats.used);
+        Assert::AreEqual(static_cast<size_t>(3), stats.system_allocations);
+    }
+
+    TEST_METHOD(rewind)
+    {
+        // Arrange
+        Arena arena(1024);
+        arena.allocate(100);
+
+        // Act
+        const Arena::Marker marker = arena.mark();
+        void* p = arena.allocate(500);
+        arena.allocate(1000);
+        const size_t used = arena.stats().used;
+        arena.rewind(marker);
+
+        // Assert
+        Assert::AreEqual(static_cast<size_t>(1024 + 1000), used);
+        Assert::AreEqual(static_cast<size_t>(100), arena.stats().used);
+
+        // the same memory again, and the second block is reused
+        Assert::IsTrue(p == arena.allocate(500));
+        arena.allocate(1000);
+        Assert::AreEqual(used, arena.stats().used);
+        Assert::AreEqual(static_cast<size_t>(2), arena.stats().block_count);
+        Assert::AreEqual(static_cast<size_t>(2), arena.stats().system_allocations);
+    }
+
+    TEST_METHOD(scope)
+    {
+        // Arrange
+        Arena arena(1024);
+        arena.allocate(100);
+        const size_t used = arena.stats().used;
+
+        // Act
+        size_t outer_used = 0, inner_used = 0;
+        {
+            ArenaScope outer(arena);
+            arena.allocate(2000);
+            outer_used = arena.stats().used;
+            {
+                ArenaScope inner(arena);
+                arena.allocate(200);
+                inner_used = arena.stats().used;
+            }
+            Assert::AreEqual(outer_used, arena.stats().used);
+        }
+
+        // Assert
+        Assert::AreEqual(used, arena.stats().used);
+        Assert::IsTrue(inner_used > outer_used && outer_used > used);
+    }
+
+    TEST_METHOD(reset_per_frame)
+    {
+        // Arrange
+        Arena arena(1024);
+
+        // Act
+        // the first frame outgrows the first block and the rest fit in one
+        for(size_t frame = 0; frame < 10; ++frame) {
+            arena.reset();
+            for(size_t i = 0; i < 10; ++i) {
+                arena.allocate(300);
+            }
+        }
+
+        // Assert
+        const Arena::Stats stats = arena.stats();
+        Assert::AreEqual(static_cast<size_t>(1), stats.block_count);
+        Assert::AreEqual(static_cast<size_t>(4096), stats.capacity);
+        Assert::AreEqual(static_cast<size_t>(10), stats.allocations);
+        Assert::AreEqual(static_cast<size_t>(9 * 304 + 300), stats.used);
+        Assert::AreEqual(static_cast<size_t>(4 + 1), stats.system_allocations);
+        Assert::IsTrue(stats.peak >= stats.used);
+    }
+
+    TEST_METHOD(release)
+    {
+        // Arrange
+        Arena arena(1024);
+        arena.allocate(5000);
+
+        // Act
+        arena.release();
+
+        // Assert
+        Assert::AreEqual(static_cast<size_t>(0), arena.stats().block_count);
+        Assert::AreEqual(static_cast<size_t>(0), arena.stats().used);
+        Assert::IsNotNull(arena.allocate(10));
+    }
+
+    TEST_METHOD(allocator)
+    {
+        // Arrange
+        Arena arena;
+        ArenaAllocator<Vector> allocator(arena);
+
+        // Act
+        std::vector<Vector, ArenaAllocator<Vector>> vectors(allocator);
+        for(size_t i = 0; i < 100; ++i) {
+            vectors.emplace_back(static_cast<float>(i), 0.0f, 0.0f);
+        }
+
+        // Assert
+        Assert::AreEqual(static_cast<size_t>(0), misalignment(vectors.data(), alignof(Vector)));
+        Assert::IsTrue(vectors.get_allocator() == ArenaAllocator<int>(arena));
+        Assert::AreEqual(99.0f, vectors.back().x());
+
+        // growing by doubling leaves the old arrays behind
+        Assert::IsTrue(arena.stats().used >= 100 * sizeof(Vector));
+        Assert::IsTrue(arena.stats().allocations > 1);
+    }
+
+    TEST_METHOD(scratch)
+    {
+        // Arrange
+        Arena& scratch = scratch_arena();
+        Arena* other = nullptr;
+
+        // Act
+        std::thread thread([&other]() { other = &scratch_arena(); });
+        thread.join();
+
+        // Assert
+        Assert::IsTrue(&scratch == &scratch_arena());
+        Assert::IsTrue(&scratch != other);
+    }
+};
+
+} } }
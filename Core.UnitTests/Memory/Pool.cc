@@ -0,0 +1,155 @@
+#include "pch.h"
+#include <list>
+#include <map>
+#include "CppUnitTest.h"
+#include "Core/Math/Matrix4.h"
+#include "Core/Memory/Pool.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace memory {
+namespace unittests {
+
+using math::Matrix4;
+using math::Vector;
+
+TEST_CLASS(PoolTests)
+{
+public:
+    TEST_METHOD(block_size)
+    {
+        // Arrange
+        Pool small(1);
+        Pool vectors(sizeof(Vector));
+        Pool odd(20, 64);
+
+        // Act
+
+        // Assert
+        Assert::AreEqual(static_cast<size_t>(16), small.block_size());
+        Assert::AreEqual(static_cast<size_t>(16), vectors.block_size());
+        Assert::AreEqual(static_cast<size_t>(64), odd.block_size());
+        Assert::AreEqual(static_cast<size_t>(64), odd.alignment());
+    }
+
+    TEST_METHOD(allocate)
+    {
+        // Arrange
+        Pool pool(sizeof(Matrix4), alignof(Matrix4), 4);
+        std::vector<void*> blocks;
+
+        // Act
+        for(size_t i = 0; i < 10; ++i) {
+            blocks.push_back(pool.allocate());
+        }
+
+        // Assert
+        for(size_t i = 0; i < blocks.size(); ++i) {
+            Assert::AreEqual(static_cast<size_t>(0), reinterpret_cast<size_t>(blocks[i]) % alignof(Matrix4));
+            for(size_t j = 0; j < i; ++j) {
+                Assert::IsTrue(blocks[i] != blocks[j]);
+            }
+        }
+
+        const Pool::Stats stats = pool.stats();
+        Assert::AreEqual(static_cast<size_t>(10), stats.live);
+        Assert::AreEqual(static_cast<size_t>(12), stats.capacity);
+        Assert::AreEqual(static_cast<size_t>(3), stats.page_count);
+    }
+
+    TEST_METHOD(reuse)
+    {
+        // Arrange
+        Pool pool(32, 16, 4);
+        void* a = pool.allocate();
+        void* b = pool.allocate();
+
+        // Act
+        pool.deallocate(a);
+        pool.deallocate(b);
+
+        // Assert
+        // newest first
+        Assert::IsTrue(b == pool.allocate());
+        Assert::IsTrue(a == pool.allocate());
+
+        const Pool::Stats stats = pool.stats();
+        Assert::AreEqual(static_cast<size_t>(2), stats.live);
+        Assert::AreEqual(static_cast<size_t>(2), stats.peak);
+        Assert::AreEqual(static_cast<size_t>(1), stats.page_count);
+    }
+
+    TEST_METHOD(reset)
+    {
+        // Arrange
+        Pool pool(32, 16, 4);
+        void* first = pool.allocate();
+        for(size_t i = 0; i < 9; ++i) {
+            pool.allocate();
+        }
+
+        // Act
+        pool.reset();
+
+        // Assert
+        // the same pages are handed out again from the start
+        Assert::AreEqual(static_cast<size_t>(0), pool.stats().live);
+        Assert::IsTrue(first == pool.allocate());
+        for(size_t i = 0; i < 9; ++i) {
+            pool.allocate();
+        }
+        Assert::AreEqual(static_cast<size_t>(3), pool.stats().page_count);
+        Assert::AreEqual(static_cast<size_t>(10), pool.stats().peak);
+    }
+
+    TEST_METHOD(create_destroy)
+    {
+        // Arrange
+        Pool pool(sizeof(Matrix4), alignof(Matrix4));
+
+        // Act
+        Matrix4* m = pool.create<Matrix4>(Matrix4::translation(Vector(1.0f, 2.0f, 3.0f)));
+
+        // Assert
+        Assert::IsTrue(Matrix4::translation(Vector(1.0f, 2.0f, 3.0f)) == *m);
+        Assert::AreEqual(static_cast<size_t>(1), pool.stats().live);
+
+        pool.destroy(m);
+        Assert::AreEqual(static_cast<size_t>(0), pool.stats().live);
+    }
+
+    TEST_METHOD(allocator)
+    {
+        // Arrange
+        // big enough for a map node of a Vector
+        Pool pool(128);
+        PoolAllocator<std::pair<const int, Vector>> allocator(pool);
+
+        // Act
+        {
+            std::map<int, Vector, std::less<int>, PoolAllocator<std::pair<const int, Vector>>> map(allocator);
+            for(int i = 0; i < 100; ++i) {
+                map[i] = Vector(static_cast<float>(i), 0.0f, 0.0f);
+            }
+
+            std::list<Vector, PoolAllocator<Vector>> list(allocator);
+            list.push_back(Vector(1.0f, 2.0f, 3.0f));
+
+            // Assert
+            Assert::AreEqual(static_cast<size_t>(101), pool.stats().live);
+            Assert::AreEqual(99.0f, map[99].x());
+            Assert::IsTrue(Vector(1.0f, 2.0f, 3.0f) == list.front());
+        }
+        Assert::AreEqual(static_cast<size_t>(0), pool.stats().live);
+
+        // arrays don't fit in a block and bypass the pool
+        PoolAllocator<Vector> vectors(pool);
+        Vector* v = vectors.allocate(100);
+        Assert::AreEqual(static_cast<size_t>(0), pool.stats().live);
+        Assert::AreEqual(static_cast<size_t>(0), reinterpret_cast<size_t>(v) % alignof(Vector));
+        vectors.deallocate(v, 100);
+    }
+};
+
+} } }
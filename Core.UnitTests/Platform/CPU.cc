@@ -0,0 +1,44 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Core/Platform/CPU.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace platform {
+namespace unittests {
+
+TEST_CLASS(CPUTests)
+{
+public:
+    TEST_METHOD(features_are_consistent)
+    {
+        // Arrange
+        const CPUFeatures& features = cpu_features();
+
+        // Act
+
+        // Assert
+        Assert::IsTrue(&features == &cpu_features());
+        Assert::IsTrue(!features.sse41 || features.sse2);
+        Assert::IsTrue(!features.avx2 || features.avx);
+        Assert::IsTrue(!features.fma || features.avx);
+        Assert::IsTrue(!features.avx512dq || features.avx512f);
+        Assert::IsTrue(!features.avx512vl || features.avx512f);
+    }
+
+    TEST_METHOD(str)
+    {
+        // Arrange
+        const CPUFeatures& features = cpu_features();
+
+        // Act
+        std::string str = features.str();
+
+        // Assert
+        Assert::IsTrue(0 == str.find("CPU(vendor:"));
+        Assert::IsTrue(!features.avx2 || std::string::npos != str.find("avx2"));
+    }
+};
+
+} } }
@@ -0,0 +1,75 @@
+#include "pch.h"
+#include <cstdio>
+#include <fstream>
+#include "CppUnitTest.h"
+#include "Core/Platform/MappedFile.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace platform {
+namespace unittests {
+
+TEST_CLASS(MappedFileTests)
+{
+private:
+    static std::string write_file(const std::string& contents)
+    {
+        const std::string path = "mappedfile_test_" + std::to_string(std::random_device()()) + ".bin";
+        std::ofstream(path, std::ios::binary) << contents;
+        return path;
+    }
+
+public:
+    TEST_METHOD(map)
+    {
+        // Arrange
+        const std::string path = write_file("hello, mapped world");
+
+        // Act
+        MappedFile file(path);
+        file.prefetch(0, 1024);
+
+        // Assert
+        Assert::IsTrue(file.is_open());
+        Assert::AreEqual(path, file.path());
+        Assert::AreEqual(static_cast<size_t>(19), file.size());
+        Assert::AreEqual(std::string("hello, mapped world"), std::string(file.data(), file.size()));
+
+        file.close();
+        Assert::IsFalse(file.is_open());
+        Assert::IsNull(file.data());
+        std::remove(path.c_str());
+    }
+
+    TEST_METHOD(empty)
+    {
+        // Arrange
+        const std::string path = write_file("");
+
+        // Act
+        MappedFile file(path);
+
+        // Assert
+        Assert::IsTrue(file.is_open());
+        Assert::AreEqual(static_cast<size_t>(0), file.size());
+        Assert::IsNull(file.data());
+
+        file.close();
+        std::remove(path.c_str());
+    }
+
+    TEST_METHOD(missing)
+    {
+        // Arrange
+        MappedFile file;
+
+        // Act
+
+        // Assert
+        Assert::ExpectException<std::runtime_error>([&file]() { file.open("does_not_exist.bin"); });
+        Assert::IsFalse(file.is_open());
+    }
+};
+
+} } }
@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cwctype>
+#include <memory>
+#include "CppUnitTest.h"
+
+/*
+Test runner for the portable CppUnitTest.h
+
+Usage: core_unittests [--list] [--verbose] [filter...]
+
+Each filter is a substring matched against "ClassName::method_name",
+a test runs if it matches any of them (or there are none).
+The exit code is the number of failed tests (capped at 255).
+*/
+
+namespace Microsoft {
+namespace VisualStudio {
+namespace CppUnitTestFramework {
+
+namespace detail {
+
+std::string narrow(const wchar_t* message)
+{
+    std::string s;
+    for(const wchar_t* c = message; 0 != *c; ++c) {
+        s += *c >= 0 && *c < 0x80 ? static_cast<char>(*c) : '?';
+    }
+    return s;
+}
+
+void fail(const std::string& what, const wchar_t* message, const __LineInfo* lineInfo)
+{
+    std::stringstream ss;
+    ss << "Assert failed. " << what;
+    if(nullptr != message && 0 != *message) {
+        ss << " - " << narrow(message);
+    }
+    if(nullptr != lineInfo) {
+        ss << " (" << lineInfo->file << ":" << lineInfo->line << " in " << lineInfo->function << ")";
+    }
+    throw AssertFailedException(ss.str());
+}
+
+}
+
+void Assert::AreEqual(const char* expected, const char* actual, bool ignoreCase, const wchar_t* message, const __LineInfo* lineInfo)
+{
+    bool equal = expected == actual;
+    if(!equal && nullptr != expected && nullptr != actual) {
+        std::string e(expected), a(actual);
+        if(ignoreCase) {
+            std::transform(e.begin(), e.end(), e.begin(), ::tolower);
+            std::transform(a.begin(), a.end(), a.begin(), ::tolower);
+        }
+        equal = e == a;
+    }
+
+    if(!equal) {
+        detail::fail("Expected:<" + ToString(expected) + "> Actual:<" + ToString(actual) + ">", message, lineInfo);
+    }
+}
+
+void Assert::AreEqual(const wchar_t* expected, const wchar_t* actual, bool ignoreCase, const wchar_t* message, const __LineInfo* lineInfo)
+{
+    bool equal = expected == actual;
+    if(!equal && nullptr != expected && nullptr != actual) {
+        std::wstring e(expected), a(actual);
+        if(ignoreCase) {
+            std::transform(e.begin(), e.end(), e.begin(), ::towlower);
+            std::transform(a.begin(), a.end(), a.begin(), ::towlower);
+        }
+        equal = e == a;
+    }
+
+    if(!equal) {
+        detail::fail("Expected:<" + ToString(expected) + "> Actual:<" + ToString(actual) + ">", message, lineInfo);
+    }
+}
+
+std::vector<TestClassInfo>& test_classes()
+{
+    // function-local so that it exists before the first static registrar runs
+    static std::vector<TestClassInfo> classes;
+    return classes;
+}
+
+} } }
+
+namespace {
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+bool matches(const std::string& name, const std::vector<std::string>& filters)
+{
+    if(filters.empty()) {
+        return true;
+    }
+
+    for(const std::string& filter : filters) {
+        if(std::string::npos != name.find(filter)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// returns an empty string on success or the reason for the failure
+std::string run(const TestClassInfo& info, size_t method)
+{
+    try {
+        std::unique_ptr<TestClassBase> instance(info.create());
+        instance->initialize();
+
+        std::string error;
+        try {
+            instance->methods()[method].method(*instance);
+        } catch(const std::exception& e) {
+            error = e.what();
+        } catch(...) {
+            error = "Unknown exception";
+        }
+
+        // cleanup runs even if the test failed, like MSTest
+        instance->cleanup();
+        return error;
+    } catch(const std::exception& e) {
+        return e.what();
+    } catch(...) {
+        return "Unknown exception";
+    }
+}
+
+void usage(const char* program)
+{
+    std::printf("Usage: %s [--list] [--verbose] [filter...]\n", program);
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    bool list = false, verbose = false;
+    std::vector<std::string> filters;
+    for(int i = 1; i < argc; ++i) {
+        const std::string arg(argv[i]);
+        if("--list" == arg) {
+            list = true;
+        } else if("--verbose" == arg || "-v" == arg) {
+            verbose = true;
+        } else if("--help" == arg || "-h" == arg) {
+            usage(argv[0]);
+            return 0;
+        } else if(0 == arg.compare(0, 1, "-")) {
+            usage(argv[0]);
+            return 1;
+        } else {
+            filters.push_back(arg);
+        }
+    }
+
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point start = Clock::now();
+
+    size_t total = 0, failed = 0;
+    for(const TestClassInfo& info : test_classes()) {
+        // one instance to list the methods, each method then gets its own
+        const std::unique_ptr<TestClassBase> prototype(info.create());
+        for(size_t i = 0; i < prototype->methods().size(); ++i) {
+            const std::string name = std::string(info.name) + "::" + prototype->methods()[i].name;
+            if(!matches(name, filters)) {
+                continue;
+            }
+
+            if(list) {
+                std::printf("%s\n", name.c_str());
+                continue;
+            }
+
+            ++total;
+            const Clock::time_point test_start = Clock::now();
+            const std::string error = run(info, i);
+            const double ms = std::chrono::duration<double, std::milli>(Clock::now() - test_start).count();
+
+            if(!error.empty()) {
+                ++failed;
+                std::printf("FAILED  %s (%.1f ms)\n        %s\n", name.c_str(), ms, error.c_str());
+            } else if(verbose) {
+                std::printf("passed  %s (%.1f ms)\n", name.c_str(), ms);
+            }
+            std::fflush(stdout);
+        }
+    }
+
+    if(list) {
+        return 0;
+    }
+
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::printf("%zu tests, %zu passed, %zu failed (%.2f s)\n", total, total - failed, failed, seconds);
+    if(0 == total && !filters.empty()) {
+        std::printf("no tests matched the filters\n");
+        return 1;
+    }
+    return static_cast<int>(std::min<size_t>(failed, 255));
+}
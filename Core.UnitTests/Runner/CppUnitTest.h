@@ -0,0 +1,354 @@
+#if !defined __CPPUNITTEST_H__
+#define __CPPUNITTEST_H__
+
+/*
+Portable implementation of the parts of the MSTest C++ framework (CppUnitTest.h)
+that Core.UnitTests uses, so that the same test sources build and run
+outside of Visual Studio. Windows builds use the real framework instead.
+
+Supported:
+    TEST_CLASS, TEST_METHOD, TEST_METHOD_INITIALIZE, TEST_METHOD_CLEANUP
+    Assert (AreEqual, AreNotEqual, AreSame, AreNotSame, IsTrue, IsFalse,
+            IsNull, IsNotNull, Fail, ExpectException)
+    LINE_INFO()
+
+Like MSTest every test method runs on a fresh instance of its class.
+Values in failure messages are formatted with ToString(), which uses
+operator<< or a str() method when the type has one.
+
+The test runner itself (main) is in CppUnitTest.cc.
+*/
+
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Microsoft {
+namespace VisualStudio {
+namespace CppUnitTestFramework {
+
+// source location of an assertion, see LINE_INFO()
+struct __LineInfo
+{
+    const char* file;
+    const char* function;
+    int line;
+
+    __LineInfo(const char* file, const char* function, int line)
+        : file(file), function(function), line(line)
+    {
+    }
+
+    // LINE_INFO() passes a temporary, which lives until the end of the assertion
+    const __LineInfo* self() const { return this; }
+};
+
+// thrown by every failed assertion
+class AssertFailedException : public std::exception
+{
+public:
+    explicit AssertFailedException(const std::string& message)
+        : _message(message)
+    {
+    }
+
+    const char* what() const noexcept override { return _message.c_str(); }
+
+private:
+    std::string _message;
+};
+
+namespace detail {
+
+template<typename T>
+class has_stream_operator
+{
+private:
+    template<typename U> static auto test(int) -> decltype(std::declval<std::ostream&>() << std::declval<const U&>(), std::true_type());
+    template<typename> static std::false_type test(...);
+
+public:
+    static const bool value = decltype(test<T>(0))::value;
+};
+
+template<typename T>
+class has_str
+{
+private:
+    template<typename U> static auto test(int) -> decltype(std::declval<const U&>().str(), std::true_type());
+    template<typename> static std::false_type test(...);
+
+public:
+    static const bool value = decltype(test<T>(0))::value;
+};
+
+template<typename T>
+typename std::enable_if<has_stream_operator<T>::value, std::string>::type to_string(const T& value)
+{
+    std::stringstream ss;
+    ss.precision(9);
+    ss << value;
+    return ss.str();
+}
+
+template<typename T>
+typename std::enable_if<!has_stream_operator<T>::value && has_str<T>::value, std::string>::type to_string(const T& value)
+{
+    return value.str();
+}
+
+template<typename T>
+typename std::enable_if<!has_stream_operator<T>::value && !has_str<T>::value, std::string>::type to_string(const T&)
+{
+    return "<object>";
+}
+
+// messages are wide strings in MSTest but only ever ASCII in practice
+std::string narrow(const wchar_t* message);
+
+[[noreturn]] void fail(const std::string& what, const wchar_t* message, const __LineInfo* lineInfo);
+
+}
+
+template<typename T>
+std::string ToString(const T& value)
+{
+    return detail::to_string(value);
+}
+
+inline std::string ToString(bool value) { return value ? "true" : "false"; }
+inline std::string ToString(char value) { return std::string(1, value); }
+inline std::string ToString(signed char value) { return std::to_string(value); }
+inline std::string ToString(unsigned char value) { return std::to_string(value); }
+inline std::string ToString(const char* value) { return nullptr == value ? "(null)" : value; }
+inline std::string ToString(const wchar_t* value) { return nullptr == value ? "(null)" : detail::narrow(value); }
+
+class Assert
+{
+public:
+    template<typename T>
+    static void AreEqual(const T& expected, const T& actual, const wchar_t* message = nullptr, const __LineInfo* lineInfo = nullptr)
+    {
+        if(!(expected == actual)) {
+            detail::fail("Expected:<" + ToString(expected) + "> Actual:<" + ToString(actual) + ">", message, lineInfo);
+        }
+    }
+
+    static void AreEqual(float expected, float actual, float tolerance, const wchar_t* message = nullptr, const __LineInfo* lineInfo = nullptr)
+    {
+        if(!(std::fabs(expected - actual) <= tolerance)) {
+            detail::fail("Expected:<" + ToString(expected) + "> Actual:<" + ToString(actual) + "> Tolerance:<" + ToString(tolerance) + ">", message, lineInfo);
+        }
+    }
+
+    static void AreEqual(double expected, double actual, double tolerance, const wchar_t* message = nullptr, const __LineInfo* lineInfo = nullptr)
+    {
+        if(!(std::fabs(expected - actual) <= tolerance)) {
+            detail::fail("Expected:<" + ToString(expected) + "> Actual:<" + ToString(actual) + "> Tolerance:<" + ToString(tolerance) + ">", message, lineInfo);
+        }
+    }
+
+    // C strings compare by contents
+    static void AreEqual(const char* expected, const char* actual, bool ignoreCase = false, const wchar_t* message = nullptr, const __LineInfo* lineInfo = nullptr);
+    static void AreEqual(const wchar_t* expected, const wchar_t* actual, bool ignoreCase = false, const wchar_t* message = nullptr, const __LineInfo* lineInfo = nullptr);
+
+    template<typename T>
+    static void AreNotEqual(const T& notExpected, const T& actual, const wchar_t* message = nullptr, const __LineInfo* lineInfo = nullptr)
+    {
+        if(notExpected == actual) {
+            detail::fail("Not expected:<" + ToString(notExpected) + "> Actual:<" + ToString(actual) + ">", message, lineInfo);
+        }
+    }
+
+    static void AreNotEqual(float notExpected, float actual, float tolerance, const wchar_t* message = nullptr, const __LineInfo* lineInfo = nullptr)
+    {
+        if(std::fabs(notExpected - actual) <= tolerance) {
+            detail::fail("Not expected:<" + ToString(notExpected) + "> Actual:<" + ToString(actual) + "> Tolerance:<" + ToString(tolerance) + ">", message, lineInfo);
+        }
+    }
+
+    static void AreNotEqual(double notExpected, double actual, double tolerance, const wchar_t* message = nullptr, const __LineInfo* lineInfo = nullptr)
+    {
+        if(std::fabs(notExpected - actual) <= tolerance) {
+            detail::fail("Not expected:<" + ToString(notExpected) + "> Actual:<" + ToString(actual) + "> Tolerance:<" + ToString(tolerance) + ">", message, lineInfo);
+        }
+    }
+
+    template<typename T>
+    static void AreSame(const T& expected, const T& actual, const wchar_t* message = nullptr, const __LineInfo* lineInfo = nullptr)
+    {
+        if(&expected != &actual) {
+            detail::fail("Expected the same object", message, lineInfo);
+        }
+    }
+
+    template<typename T>
+    static void AreNotSame(const T& notExpected, const T& actual, const wchar_t* message = nullptr, const __LineInfo* lineInfo = nullptr)
+    {
+        if(&notExpected == &actual) {
+            detail::fail("Expected different objects", message, lineInfo);
+        }
+    }
+
+    static void IsTrue(bool condition, const wchar_t* message = nullptr, const __LineInfo* lineInfo = nullptr)
+    {
+        if(!condition) {
+            detail::fail("Expected true", message, lineInfo);
+        }
+    }
+
+    static void IsFalse(bool condition, const wchar_t* message = nullptr, const __LineInfo* lineInfo = nullptr)
+    {
+        if(condition) {
+            detail::fail("Expected false", message, lineInfo);
+        }
+    }
+
+    template<typename T>
+    static void IsNull(const T* pointer, const wchar_t* message = nullptr, const __LineInfo* lineInfo = nullptr)
+    {
+        if(nullptr != pointer) {
+            detail::fail("Expected null", message, lineInfo);
+        }
+    }
+
+    template<typename T>
+    static void IsNotNull(const T* pointer, const wchar_t* message = nullptr, const __LineInfo* lineInfo = nullptr)
+    {
+        if(nullptr == pointer) {
+            detail::fail("Expected not null", message, lineInfo);
+        }
+    }
+
+    [[noreturn]] static void Fail(const wchar_t* message = nullptr, const __LineInfo* lineInfo = nullptr)
+    {
+        detail::fail("Fail", message, lineInfo);
+    }
+
+    // fails unless functor throws an E
+    template<typename E, typename F>
+    static void ExpectException(F functor, const wchar_t* message = nullptr, const __LineInfo* lineInfo = nullptr)
+    {
+        try {
+            functor();
+        } catch(const E&) {
+            return;
+        } catch(...) {
+            detail::fail("Unexpected exception type", message, lineInfo);
+        }
+        detail::fail("Expected an exception", message, lineInfo);
+    }
+};
+
+// everything the runner needs to know about a test class
+class TestClassBase
+{
+public:
+    typedef std::function<void(TestClassBase&)> Method;
+
+    struct MethodInfo
+    {
+        const char* name;
+        Method method;
+    };
+
+public:
+    virtual ~TestClassBase() = default;
+
+    const std::vector<MethodInfo>& methods() const { return _methods; }
+
+    void initialize() { if(_initialize) _initialize(*this); }
+    void cleanup() { if(_cleanup) _cleanup(*this); }
+
+protected:
+    void add_method(const char* name, Method method) { _methods.push_back({ name, method }); }
+    void set_initialize(Method method) { _initialize = method; }
+    void set_cleanup(Method method) { _cleanup = method; }
+
+private:
+    std::vector<MethodInfo> _methods;
+    Method _initialize;
+    Method _cleanup;
+};
+
+// every registered test class, in registration order
+struct TestClassInfo
+{
+    const char* name;
+    TestClassBase* (*create)();
+};
+
+std::vector<TestClassInfo>& test_classes();
+
+template<typename C>
+class TestClass : public TestClassBase
+{
+protected:
+    typedef C this_class;
+
+    // registers a method when the instance is constructed
+    // so that methods are listed in declaration order
+    struct MethodEntry
+    {
+        MethodEntry(TestClass* c, const char* name, void (C::*method)())
+        {
+            c->add_method(name, [method](TestClassBase& instance) { (static_cast<C&>(instance).*method)(); });
+        }
+    };
+
+    struct InitializeEntry
+    {
+        InitializeEntry(TestClass* c, void (C::*method)())
+        {
+            c->set_initialize([method](TestClassBase& instance) { (static_cast<C&>(instance).*method)(); });
+        }
+    };
+
+    struct CleanupEntry
+    {
+        CleanupEntry(TestClass* c, void (C::*method)())
+        {
+            c->set_cleanup([method](TestClassBase& instance) { (static_cast<C&>(instance).*method)(); });
+        }
+    };
+};
+
+template<typename C>
+struct TestClassRegistrar
+{
+    static TestClassBase* create() { return new C(); }
+
+    explicit TestClassRegistrar(const char* name)
+    {
+        test_classes().push_back({ name, &TestClassRegistrar::create });
+    }
+};
+
+} } }
+
+#define LINE_INFO() ::Microsoft::VisualStudio::CppUnitTestFramework::__LineInfo(__FILE__, __func__, __LINE__).self()
+
+#define TEST_CLASS(className) \
+    class className; \
+    static const ::Microsoft::VisualStudio::CppUnitTestFramework::TestClassRegistrar<className> className##_registrar(#className); \
+    class className : public ::Microsoft::VisualStudio::CppUnitTestFramework::TestClass<className>
+
+#define TEST_METHOD(methodName) \
+    MethodEntry methodName##_entry { this, #methodName, &this_class::methodName }; \
+    public: void methodName()
+
+#define TEST_METHOD_INITIALIZE(methodName) \
+    InitializeEntry methodName##_entry { this, &this_class::methodName }; \
+    public: void methodName()
+
+#define TEST_METHOD_CLEANUP(methodName) \
+    CleanupEntry methodName##_entry { this, &this_class::methodName }; \
+    public: void methodName()
+
+#endif
@@ -0,0 +1,311 @@
+#include "pch.h"
+#include <algorithm>
+#include "CppUnitTest.h"
+#include "Core/Math/Random.h"
+#include "Core/Spatial/BVH.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace spatial {
+namespace unittests {
+
+using math::Matrix4;
+using math::Random;
+
+TEST_CLASS(BVHTests)
+{
+private:
+    // boxes up to 2 units across scattered over [-extent, extent)
+    static std::vector<AABB> create_test_boxes(size_t count, float extent, uint64_t seed)
+    {
+        Random random(seed);
+
+        std::vector<AABB> boxes(count);
+        for(AABB& box : boxes) {
+            const Point3 center = random.in_box(Vector(-extent, -extent, -extent), Vector(extent, extent, extent));
+            const Vector half_extents(random.uniform(0.0f, 1.0f), random.uniform(0.0f, 1.0f), random.uniform(0.0f, 1.0f));
+            box = AABB::from_center(center, half_extents);
+        }
+        return boxes;
+    }
+
+    // the frustum of a 90 degree perspective camera at the origin looking down -z
+    // from 1 to 100, normals pointing inwards
+    static std::vector<Vector> create_test_frustum()
+    {
+        const float s = std::sqrt(0.5f);
+        return {
+            Vector(0.0f, 0.0f, -1.0f, -1.0f),
+            Vector(0.0f, 0.0f, 1.0f, 100.0f),
+            Vector(s, 0.0f, -s, 0.0f),
+            Vector(-s, 0.0f, -s, 0.0f),
+            Vector(0.0f, s, -s, 0.0f),
+            Vector(0.0f, -s, -s, 0.0f),
+        };
+    }
+
+    static bool outside(const AABB& box, const Vector& plane)
+    {
+        const Vector corner(plane.x() >= 0.0f ? box.maximum().x() : box.minimum().x(),
+            plane.y() >= 0.0f ? box.maximum().y() : box.minimum().y(),
+            plane.z() >= 0.0f ? box.maximum().z() : box.minimum().z());
+        return plane.x() * corner.x() + plane.y() * corner.y() + plane.z() * corner.z() + plane.w() < 0.0f;
+    }
+
+    static std::vector<BVH::Index> sorted(std::vector<BVH::Index> indices)
+    {
+        std::sort(indices.begin(), indices.end());
+        return indices;
+    }
+
+public:
+    TEST_METHOD(build)
+    {
+        // Arrange
+        const std::vector<AABB> boxes = create_test_boxes(1000, 50.0f, 1);
+
+        // Act
+        BVH bvh(boxes.data(), boxes.size());
+
+        // Assert
+        Assert::AreEqual(size_t(1000), bvh.size());
+        Assert::IsFalse(bvh.empty());
+        Assert::IsTrue(bvh.node_count() >= 333 && bvh.node_count() < 1000);
+        AABB bounds;
+        for(const AABB& box : boxes) {
+            bounds.merge(box);
+        }
+        Assert::IsTrue(bounds == bvh.bounds());
+
+        // every primitive exactly once
+        std::vector<BVH::Index> all;
+        Assert::AreEqual(size_t(1000), bvh.query_overlap(bvh.bounds(), all));
+        all = sorted(all);
+        for(size_t i = 0; i < all.size(); ++i) {
+            Assert::AreEqual(static_cast<BVH::Index>(i), all[i]);
+        }
+
+        bvh.clear();
+        Assert::IsTrue(bvh.empty());
+        Assert::AreEqual(size_t(0), bvh.query_overlap(AABB(Point3(-1.0f, -1.0f, -1.0f), Point3(1.0f, 1.0f, 1.0f)), all));
+    }
+
+    TEST_METHOD(build_small)
+    {
+        // Arrange
+        const std::vector<AABB> boxes = create_test_boxes(3, 10.0f, 2);
+        std::vector<BVH::Index> found;
+
+        // Act
+        BVH bvh1(boxes.data(), 1);
+        BVH bvh3(boxes.data(), 3);
+
+        // Assert
+        Assert::AreEqual(size_t(1), bvh1.node_count());
+        Assert::AreEqual(size_t(1), bvh1.query_overlap(boxes[0], found));
+        Assert::AreEqual(BVH::Index(0), found[0]);
+
+        found.clear();
+        Assert::AreEqual(size_t(1), bvh3.node_count());
+        Assert::AreEqual(size_t(3), bvh3.query_overlap(bvh3.bounds(), found));
+    }
+
+    TEST_METHOD(build_parallel)
+    {
+        // Arrange
+        const std::vector<AABB> boxes = create_test_boxes(200000, 500.0f, 3);
+        const AABB query(Point3(-20.0f, -20.0f, -20.0f), Point3(20.0f, 20.0f, 20.0f));
+
+        // Act
+        BVH bvh1(boxes.data(), boxes.size(), 1);
+        BVH bvh8(boxes.data(), boxes.size(), 8);
+
+        // Assert
+        // exactly the same tree, so exactly the same order
+        std::vector<BVH::Index> found1, found8;
+        Assert::AreEqual(bvh1.node_count(), bvh8.node_count());
+        bvh1.query_overlap(query, found1);
+        bvh8.query_overlap(query, found8);
+        Assert::IsFalse(found1.empty());
+        Assert::IsTrue(found1 == found8);
+    }
+
+    TEST_METHOD(query_overlap)
+    {
+        // Arrange
+        const std::vector<AABB> boxes = create_test_boxes(5000, 50.0f, 4);
+        const BVH bvh(boxes.data(), boxes.size());
+        Random random(5);
+
+        for(int q = 0; q < 100; ++q) {
+            const AABB query = AABB::from_center(random.in_box(Vector(-60.0f, -60.0f, -60.0f), Vector(60.0f, 60.0f, 60.0f)), Vector(5.0f, 5.0f, 5.0f));
+
+            std::vector<BVH::Index> expected;
+            for(size_t i = 0; i < boxes.size(); ++i) {
+                if(boxes[i].overlaps(query)) {
+                    expected.push_back(static_cast<BVH::Index>(i));
+                }
+            }
+
+            // Act
+            std::vector<BVH::Index> found;
+            const size_t count = bvh.query_overlap(query, found);
+
+            // Assert
+            Assert::AreEqual(expected.size(), count);
+            Assert::IsTrue(expected == sorted(found));
+        }
+    }
+
+    TEST_METHOD(query_ray)
+    {
+        // Arrange
+        const std::vector<AABB> boxes = create_test_boxes(5000, 50.0f, 6);
+        const BVH bvh(boxes.data(), boxes.size());
+        Random random(7);
+
+        for(int q = 0; q < 100; ++q) {
+            const Point3 origin = random.in_box(Vector(-60.0f, -60.0f, -60.0f), Vector(60.0f, 60.0f, 60.0f));
+            const Vector direction = random.unit_vector() * 2.0f;
+            const Vector inv_direction(1.0f / direction.x(), 1.0f / direction.y(), 1.0f / direction.z());
+            const float t_max = 40.0f;
+
+            std::vector<BVH::Index> expected;
+            BVH::Index nearest = BVH::InvalidIndex;
+            float nearest_t = t_max;
+            for(size_t i = 0; i < boxes.size(); ++i) {
+                float t;
+                if(boxes[i].intersect_ray(origin, inv_direction, 0.0f, t_max, t)) {
+                    expected.push_back(static_cast<BVH::Index>(i));
+                    if(t < nearest_t) {
+                        nearest_t = t;
+                        nearest = static_cast<BVH::Index>(i);
+                    }
+                }
+            }
+
+            // Act
+            std::vector<BVH::Index> found;
+            const size_t count = bvh.query_ray(origin, direction, t_max, found);
+
+            float t = t_max;
+            const BVH::Index hit = bvh.cast_ray(origin, direction, t);
+
+            // Assert
+            Assert::AreEqual(expected.size(), count);
+            Assert::IsTrue(expected == sorted(found));
+            if(BVH::InvalidIndex == nearest) {
+                Assert::AreEqual(BVH::InvalidIndex, hit);
+                Assert::AreEqual(t_max, t);
+            } else {
+                // ties may hit a different box at the same distance
+                float hit_t;
+                Assert::IsTrue(boxes[hit].intersect_ray(origin, inv_direction, 0.0f, t_max, hit_t));
+                Assert::AreEqual(nearest_t, hit_t);
+                Assert::AreEqual(nearest_t, t);
+            }
+        }
+    }
+
+    TEST_METHOD(cast_ray_intersect)
+    {
+        // Arrange
+        // a row of unit boxes along x, the intersector only accepts odd ones
+        std::vector<AABB> boxes;
+        for(int i = 0; i < 100; ++i) {
+            boxes.push_back(AABB(Point3(i * 2.0f, 0.0f, 0.0f), Point3(i * 2.0f + 1.0f, 1.0f, 1.0f)));
+        }
+        const BVH bvh(boxes.data(), boxes.size());
+        size_t tested = 0;
+
+        // Act
+        float t = 1000.0f;
+        const BVH::Index hit = bvh.cast_ray(Point3(-10.0f, 0.5f, 0.5f), Vector(1.0f, 0.0f, 0.0f), t, [&tested](BVH::Index index, float t_box, float& t_hit) {
+            ++tested;
+            if(IS_EVEN(index)) {
+                return false;
+            }
+            t_hit = t_box + 0.5f;
+            return true;
+        });
+
+        // Assert
+        Assert::AreEqual(BVH::Index(1), hit);
+        Assert::AreEqual(12.5f, t);
+
+        // nothing past the hit
+        Assert::IsTrue(tested <= 3);
+    }
+
+    TEST_METHOD(query_frustum)
+    {
+        // Arrange
+        const std::vector<AABB> boxes = create_test_boxes(5000, 150.0f, 8);
+        const BVH bvh(boxes.data(), boxes.size());
+        const std::vector<Vector> planes = create_test_frustum();
+
+        std::vector<BVH::Index> expected;
+        for(size_t i = 0; i < boxes.size(); ++i) {
+            bool visible = true;
+            for(const Vector& plane : planes) {
+                visible = visible && !outside(boxes[i], plane);
+            }
+            if(visible) {
+                expected.push_back(static_cast<BVH::Index>(i));
+            }
+        }
+
+        // Act
+        std::vector<BVH::Index> found;
+        const size_t count = bvh.query_frustum(planes.data(), planes.size(), found);
+
+        // Assert
+        Assert::IsTrue(expected.size() > 50 && expected.size() < boxes.size() / 2);
+        Assert::AreEqual(expected.size(), count);
+        Assert::IsTrue(expected == sorted(found));
+    }
+
+    TEST_METHOD(query_frustum_matrix)
+    {
+        // Arrange
+        const std::vector<AABB> boxes = create_test_boxes(5000, 150.0f, 9);
+        const BVH bvh(boxes.data(), boxes.size());
+        const Frustum frustum = Frustum::from_matrix(Matrix4::perspective(1.0f, 1.5f, 1.0f, 100.0f)
+            * Matrix4::look_at(Vector(10.0f, 20.0f, 30.0f), Vector::Zero, Vector(0.0f, 1.0f, 0.0f)));
+
+        std::vector<BVH::Index> expected;
+        for(size_t i = 0; i < boxes.size(); ++i) {
+            if(frustum.intersects(boxes[i])) {
+                expected.push_back(static_cast<BVH::Index>(i));
+            }
+        }
+
+        // Act
+        std::vector<BVH::Index> found;
+        const size_t count = bvh.query_frustum(frustum, found);
+
+        // Assert
+        Assert::IsTrue(expected.size() > 50 && expected.size() < boxes.size() / 2);
+        Assert::AreEqual(expected.size(), count);
+        Assert::IsTrue(expected == sorted(found));
+    }
+
+    TEST_METHOD(duplicates)
+    {
+        // Arrange
+        // SAH can't separate identical boxes, they're split at the median
+        const std::vector<AABB> boxes(1000, AABB(Point3(1.0f, 1.0f, 1.0f), Point3(2.0f, 2.0f, 2.0f)));
+
+        // Act
+        BVH bvh(boxes.data(), boxes.size());
+
+        // Assert
+        std::vector<BVH::Index> found;
+        Assert::AreEqual(size_t(1000), bvh.query_overlap(AABB(Point3(0.0f, 0.0f, 0.0f), Point3(1.0f, 1.0f, 1.0f)), found));
+        found.clear();
+        Assert::AreEqual(size_t(1000), bvh.query_ray(Point3(0.0f, 1.5f, 1.5f), Vector(1.0f, 0.0f, 0.0f), 10.0f, found));
+    }
+};
+
+} } }
@@ -0,0 +1,209 @@
+#include "pch.h"
+#include <algorithm>
+#include "CppUnitTest.h"
+#include "Core/Math/Random.h"
+#include "Core/Spatial/KdTree.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace spatial {
+namespace unittests {
+
+using math::Random;
+
+TEST_CLASS(KdTreeTests)
+{
+private:
+    static std::vector<Vector> create_test_points(size_t count, float extent, uint64_t seed)
+    {
+        std::vector<Vector> points(count);
+        Random(seed).in_box(points.data(), count, Vector(-extent, -extent, -extent), Vector(extent, extent, extent));
+        return points;
+    }
+
+    // brute-force reference, sorted by index
+    static std::vector<KdTree::Index> brute_force_radius(const std::vector<Vector>& points, const Vector& center, float radius)
+    {
+        std::vector<KdTree::Index> indices;
+        for(size_t i = 0; i < points.size(); ++i) {
+            if(center.distance_squared(points[i]) <= radius * radius) {
+                indices.push_back(static_cast<KdTree::Index>(i));
+            }
+        }
+        return indices;
+    }
+
+    // brute-force reference, nearest first with ties broken by index
+    static std::vector<KdTree::Index> brute_force_nearest(const std::vector<Vector>& points, const Vector& center, size_t k)
+    {
+        std::vector<std::pair<float, KdTree::Index>> candidates;
+        for(size_t i = 0; i < points.size(); ++i) {
+            candidates.emplace_back(center.distance_squared(points[i]), static_cast<KdTree::Index>(i));
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        std::vector<KdTree::Index> indices;
+        for(size_t i = 0; i < MIN(k, candidates.size()); ++i) {
+            indices.push_back(candidates[i].second);
+        }
+        return indices;
+    }
+
+public:
+    TEST_METHOD(build)
+    {
+        // Arrange
+        const std::vector<Vector> points = create_test_points(1000, 10.0f, 1);
+
+        // Act
+        KdTree tree(points.data(), points.size());
+
+        // Assert
+        Assert::AreEqual(points.size(), tree.size());
+        Assert::IsTrue(tree.node_count() > points.size() / KdTree::LeafSize);
+        for(size_t i = 0; i < points.size(); ++i) {
+            Assert::IsTrue(points[i] == tree.point(static_cast<KdTree::Index>(i)));
+        }
+    }
+
+    TEST_METHOD(build_parallel)
+    {
+        // Arrange
+        const std::vector<Vector> points = create_test_points(200000, 100.0f, 2);
+        const std::vector<Vector> centers = create_test_points(100, 100.0f, 3);
+
+        // Act
+        KdTree tree1(points.data(), points.size(), 1);
+        KdTree tree8(points.data(), points.size(), 8);
+
+        // Assert
+        // the tree doesn't depend on the number of threads
+        Assert::AreEqual(tree1.node_count(), tree8.node_count());
+        for(const Vector& center : centers) {
+            std::vector<KdTree::Index> found1, found8;
+            tree1.query_radius(center, 2.0f, found1);
+            tree8.query_radius(center, 2.0f, found8);
+            Assert::IsTrue(found1 == found8);
+            Assert::AreEqual(tree1.nearest(center), tree8.nearest(center));
+        }
+    }
+
+    TEST_METHOD(nearest)
+    {
+        // Arrange
+        const std::vector<Vector> points = create_test_points(2000, 50.0f, 4);
+        const std::vector<Vector> centers = create_test_points(100, 100.0f, 5);
+        KdTree tree(points.data(), points.size());
+
+        for(const Vector& center : centers) {
+            // Act
+            KdTree::Index index = tree.nearest(center);
+
+            // Assert
+            Assert::AreEqual(brute_force_nearest(points, center, 1)[0], index);
+        }
+        Assert::AreEqual(KdTree::InvalidIndex, KdTree().nearest(Vector()));
+    }
+
+    TEST_METHOD(query_radius)
+    {
+        // Arrange
+        const std::vector<Vector> points = create_test_points(2000, 50.0f, 6);
+        const std::vector<Vector> centers = create_test_points(50, 60.0f, 7);
+        KdTree tree(points.data(), points.size());
+
+        for(float radius : { 0.0f, 3.0f, 12.5f, 500.0f }) {
+            for(const Vector& center : centers) {
+                // Act
+                std::vector<KdTree::Index> found;
+                size_t count = tree.query_radius(center, radius, found);
+                std::sort(found.begin(), found.end());
+
+                // Assert
+                Assert::AreEqual(found.size(), count);
+                Assert::IsTrue(brute_force_radius(points, center, radius) == found);
+            }
+        }
+    }
+
+    TEST_METHOD(query_nearest)
+    {
+        // Arrange
+        const std::vector<Vector> points = create_test_points(2000, 50.0f, 8);
+        const std::vector<Vector> centers = create_test_points(50, 200.0f, 9);
+        KdTree tree(points.data(), points.size());
+
+        for(size_t k : { 1, 8, 64, 5000 }) {
+            for(const Vector& center : centers) {
+                // Act
+                std::vector<KdTree::Index> found;
+                size_t count = tree.query_nearest(center, k, found);
+
+                // Assert
+                Assert::AreEqual(found.size(), count);
+                Assert::IsTrue(brute_force_nearest(points, center, k) == found);
+            }
+        }
+    }
+
+    TEST_METHOD(query_nearest_max_distance)
+    {
+        // Arrange
+        const std::vector<Vector> points = { Vector(0.0f, 0.0f, 0.0f), Vector(0.0f, 2.0f, 0.0f), Vector(0.0f, 7.0f, 0.0f) };
+        KdTree tree(points.data(), points.size());
+        std::vector<KdTree::Index> found;
+
+        // Act
+        size_t count = tree.query_nearest(Vector(0.0f, 3.0f, 0.0f), 3, found, 3.5f);
+
+        // Assert
+        Assert::AreEqual(static_cast<size_t>(2), count);
+        Assert::AreEqual(static_cast<KdTree::Index>(1), found[0]);
+        Assert::AreEqual(static_cast<KdTree::Index>(0), found[1]);
+    }
+
+    TEST_METHOD(duplicates)
+    {
+        // Arrange
+        std::vector<Vector> points(100, Vector(1.0f, 2.0f, 3.0f));
+        points.emplace_back(1.0f, 2.0f, 4.0f);
+        KdTree tree(points.data(), points.size());
+        std::vector<KdTree::Index> found1, found2;
+
+        // Act
+        size_t count1 = tree.query_radius(Vector(1.0f, 2.0f, 3.0f), 0.0f, found1);
+        size_t count2 = tree.query_nearest(Vector(1.0f, 2.0f, 5.0f), 2, found2);
+
+        // Assert
+        Assert::AreEqual(static_cast<size_t>(100), count1);
+        Assert::AreEqual(static_cast<size_t>(2), count2);
+        Assert::AreEqual(static_cast<KdTree::Index>(100), found2[0]);
+        Assert::AreEqual(static_cast<KdTree::Index>(0), found2[1]);
+    }
+
+    TEST_METHOD(batched_queries)
+    {
+        // Arrange
+        const std::vector<Vector> points = create_test_points(1000, 30.0f, 10);
+        const std::vector<Vector> centers = create_test_points(25, 30.0f, 11);
+        KdTree tree(points.data(), points.size());
+        QueryResults radius_results, nearest_results;
+
+        // Act
+        tree.query_radius(centers.data(), centers.size(), 5.0f, radius_results);
+        tree.query_nearest(centers.data(), centers.size(), 6, nearest_results);
+
+        // Assert
+        Assert::AreEqual(centers.size(), radius_results.size());
+        Assert::AreEqual(centers.size(), nearest_results.size());
+        for(size_t i = 0; i < centers.size(); ++i) {
+            std::vector<KdTree::Index> found(radius_results.begin(i), radius_results.end(i));
+            std::sort(found.begin(), found.end());
+            Assert::IsTrue(brute_force_radius(points, centers[i], 5.0f) == found);
+            Assert::IsTrue(brute_force_nearest(points, centers[i], 6) == std::vector<KdTree::Index>(nearest_results.begin(i), nearest_results.end(i)));
+        }
+    }
+};
+
+} } }
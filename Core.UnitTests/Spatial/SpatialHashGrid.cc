@@ -0,0 +1,287 @@
+#include "pch.h"
+#include <algorithm>
+#include <set>
+#include <tuple>
+#include "CppUnitTest.h"
+#include "Core/Math/Random.h"
+#include "Core/Spatial/SpatialHashGrid.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace energonsoftware {
+namespace spatial {
+namespace unittests {
+
+using math::Random;
+
+TEST_CLASS(SpatialHashGridTests)
+{
+private:
+    static std::vector<Vector> create_test_points(size_t count, float extent, uint64_t seed)
+    {
+        std::vector<Vector> points(count);
+        Random(seed).in_box(points.data(), count, Vector(-extent, -extent, -extent), Vector(extent, extent, extent));
+        return points;
+    }
+
+    // brute-force reference, sorted by id
+    static std::vector<SpatialHashGrid::Id> brute_force_radius(const std::vector<Vector>& points, const Vector& center, float radius)
+    {
+        std::vector<SpatialHashGrid::Id> ids;
+        for(size_t i = 0; i < points.size(); ++i) {
+            if(center.distance_squared(points[i]) <= radius * radius) {
+                ids.push_back(static_cast<SpatialHashGrid::Id>(i));
+            }
+        }
+        return ids;
+    }
+
+    // brute-force reference, nearest first with ties broken by id
+    static std::vector<SpatialHashGrid::Id> brute_force_nearest(const std::vector<Vector>& points, const Vector& center, size_t k)
+    {
+        std::vector<std::pair<float, SpatialHashGrid::Id>> candidates;
+        for(size_t i = 0; i < points.size(); ++i) {
+            candidates.emplace_back(center.distance_squared(points[i]), static_cast<SpatialHashGrid::Id>(i));
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        std::vector<SpatialHashGrid::Id> ids;
+        for(size_t i = 0; i < MIN(k, candidates.size()); ++i) {
+            ids.push_back(candidates[i].second);
+        }
+        return ids;
+    }
+
+public:
+    TEST_METHOD(insert)
+    {
+        // Arrange
+        SpatialHashGrid grid(2.0f);
+
+        // Act
+        SpatialHashGrid::Id id1 = grid.insert(Vector(1.0f, 1.0f, 1.0f));
+        SpatialHashGrid::Id id2 = grid.insert(Vector(1.5f, 0.5f, 1.0f));
+        SpatialHashGrid::Id id3 = grid.insert(Vector(-10.0f, 3.0f, 7.0f, 1.0f));
+
+        // Assert
+        Assert::AreEqual(static_cast<size_t>(3), grid.size());
+        Assert::AreEqual(static_cast<size_t>(2), grid.cell_count());
+        Assert::IsTrue(grid.contains(id1));
+        Assert::IsTrue(Vector(1.5f, 0.5f, 1.0f) == grid.position(id2));
+        Assert::IsTrue(Vector(-10.0f, 3.0f, 7.0f) == grid.position(id3));
+    }
+
+    TEST_METHOD(move)
+    {
+        // Arrange
+        SpatialHashGrid grid(2.0f);
+        SpatialHashGrid::Id id1 = grid.insert(Vector(1.0f, 1.0f, 1.0f));
+        SpatialHashGrid::Id id2 = grid.insert(Vector(1.5f, 0.5f, 1.0f));
+        std::vector<SpatialHashGrid::Id> found;
+
+        // Act
+        grid.move(id1, Vector(1.25f, 1.0f, 1.0f));
+        grid.move(id2, Vector(100.0f, 0.0f, 0.0f));
+        grid.query_radius(Vector(100.0f, 0.0f, 0.0f), 1.0f, found);
+
+        // Assert
+        Assert::IsTrue(Vector(1.25f, 1.0f, 1.0f) == grid.position(id1));
+        Assert::IsTrue(Vector(100.0f, 0.0f, 0.0f) == grid.position(id2));
+        Assert::AreEqual(static_cast<size_t>(2), grid.cell_count());
+        Assert::AreEqual(static_cast<size_t>(1), found.size());
+        Assert::AreEqual(id2, found[0]);
+    }
+
+    TEST_METHOD(remove)
+    {
+        // Arrange
+        SpatialHashGrid grid(2.0f);
+        SpatialHashGrid::Id id1 = grid.insert(Vector(1.0f, 1.0f, 1.0f));
+        SpatialHashGrid::Id id2 = grid.insert(Vector(1.5f, 0.5f, 1.0f));
+        SpatialHashGrid::Id id3 = grid.insert(Vector(9.0f, 0.0f, 0.0f));
+
+        // Act
+        grid.remove(id1);
+        grid.remove(id3);
+        SpatialHashGrid::Id id4 = grid.insert(Vector(-5.0f, 0.0f, 0.0f));
+
+        // Assert
+        Assert::AreEqual(static_cast<size_t>(2), grid.size());
+        Assert::AreEqual(static_cast<size_t>(2), grid.cell_count());
+        Assert::IsFalse(grid.contains(id1));
+        Assert::IsTrue(grid.contains(id2));
+        Assert::IsTrue(Vector(1.5f, 0.5f, 1.0f) == grid.position(id2));
+
+        // removed ids are reused
+        Assert::AreEqual(id3, id4);
+        Assert::IsTrue(Vector(-5.0f, 0.0f, 0.0f) == grid.position(id4));
+    }
+
+    TEST_METHOD(query_radius)
+    {
+        // Arrange
+        const std::vector<Vector> points = create_test_points(2000, 50.0f, 1);
+        const std::vector<Vector> centers = create_test_points(50, 60.0f, 2);
+        SpatialHashGrid grid(5.0f);
+        for(const Vector& point : points) {
+            grid.insert(point);
+        }
+
+        for(float radius : { 0.0f, 3.0f, 5.0f, 12.5f, 500.0f }) {
+            for(const Vector& center : centers) {
+                // Act
+                std::vector<SpatialHashGrid::Id> found;
+                size_t count = grid.query_radius(center, radius, found);
+                std::sort(found.begin(), found.end());
+
+                // Assert
+                Assert::AreEqual(found.size(), count);
+                Assert::IsTrue(brute_force_radius(points, center, radius) == found);
+            }
+        }
+    }
+
+    TEST_METHOD(query_nearest)
+    {
+        // Arrange
+        const std::vector<Vector> points = create_test_points(2000, 50.0f, 3);
+        const std::vector<Vector> centers = create_test_points(50, 200.0f, 4);
+        SpatialHashGrid grid(4.0f);
+        for(const Vector& point : points) {
+            grid.insert(point);
+        }
+
+        for(size_t k : { 1, 8, 64, 5000 }) {
+            for(const Vector& center : centers) {
+                // Act
+                std::vector<SpatialHashGrid::Id> found;
+                size_t count = grid.query_nearest(center, k, found);
+
+                // Assert
+                Assert::AreEqual(found.size(), count);
+                Assert::IsTrue(brute_force_nearest(points, center, k) == found);
+            }
+        }
+    }
+
+    TEST_METHOD(query_nearest_max_distance)
+    {
+        // Arrange
+        SpatialHashGrid grid(1.0f);
+        grid.insert(Vector(0.0f, 0.0f, 0.0f));
+        SpatialHashGrid::Id id = grid.insert(Vector(0.0f, 2.0f, 0.0f));
+        grid.insert(Vector(0.0f, 7.0f, 0.0f));
+        std::vector<SpatialHashGrid::Id> found;
+
+        // Act
+        size_t count = grid.query_nearest(Vector(0.0f, 3.0f, 0.0f), 3, found, 3.5f);
+
+        // Assert
+        Assert::AreEqual(static_cast<size_t>(2), count);
+        Assert::AreEqual(id, found[0]);
+    }
+
+    TEST_METHOD(query_after_updates)
+    {
+        // Arrange
+        std::vector<Vector> points = create_test_points(1000, 20.0f, 5);
+        const std::vector<Vector> moves = create_test_points(1000, 20.0f, 6);
+        SpatialHashGrid grid(3.0f);
+        for(const Vector& point : points) {
+            grid.insert(point);
+        }
+
+        // Act
+        for(size_t i = 0; i < points.size(); i += 2) {
+            points[i] = moves[i];
+            grid.move(static_cast<SpatialHashGrid::Id>(i), points[i]);
+        }
+        std::vector<SpatialHashGrid::Id> found;
+        grid.query_radius(Vector(1.0f, 2.0f, 3.0f), 6.0f, found);
+        std::sort(found.begin(), found.end());
+
+        // Assert
+        Assert::IsTrue(brute_force_radius(points, Vector(1.0f, 2.0f, 3.0f), 6.0f) == found);
+    }
+
+    TEST_METHOD(remove_many)
+    {
+        // Arrange
+        const std::vector<Vector> points = create_test_points(3000, 40.0f, 9);
+        SpatialHashGrid grid(1.0f);
+        for(const Vector& point : points) {
+            grid.insert(point);
+        }
+
+        // Act
+        // removing most of the points empties (and removes) most of the cells
+        std::vector<Vector> remaining;
+        for(size_t i = 0; i < points.size(); ++i) {
+            if(0 == i % 5) {
+                remaining.push_back(points[i]);
+            } else {
+                grid.remove(static_cast<SpatialHashGrid::Id>(i));
+            }
+        }
+
+        // Assert
+        Assert::AreEqual(remaining.size(), grid.size());
+        std::set<std::tuple<float, float, float>> cells;
+        for(const Vector& point : remaining) {
+            cells.emplace(std::floor(point.x()), std::floor(point.y()), std::floor(point.z()));
+        }
+        Assert::AreEqual(cells.size(), grid.cell_count());
+        for(size_t i = 0; i < remaining.size(); ++i) {
+            std::vector<SpatialHashGrid::Id> found;
+            grid.query_nearest(remaining[i], 1, found);
+            Assert::AreEqual(static_cast<SpatialHashGrid::Id>(i * 5), found[0]);
+        }
+    }
+
+    TEST_METHOD(batched_queries)
+    {
+        // Arrange
+        const std::vector<Vector> points = create_test_points(1000, 30.0f, 7);
+        const std::vector<Vector> centers = create_test_points(25, 30.0f, 8);
+        SpatialHashGrid grid(4.0f);
+        for(const Vector& point : points) {
+            grid.insert(point);
+        }
+        QueryResults radius_results, nearest_results;
+
+        // Act
+        grid.query_radius(centers.data(), centers.size(), 5.0f, radius_results);
+        grid.query_nearest(centers.data(), centers.size(), 6, nearest_results);
+
+        // Assert
+        Assert::AreEqual(centers.size(), radius_results.size());
+        Assert::AreEqual(centers.size(), nearest_results.size());
+        for(size_t i = 0; i < centers.size(); ++i) {
+            std::vector<SpatialHashGrid::Id> found(radius_results.begin(i), radius_results.end(i));
+            std::sort(found.begin(), found.end());
+            Assert::IsTrue(brute_force_radius(points, centers[i], 5.0f) == found);
+
+            Assert::AreEqual(static_cast<size_t>(6), nearest_results.count(i));
+            Assert::IsTrue(brute_force_nearest(points, centers[i], 6) == std::vector<SpatialHashGrid::Id>(nearest_results.begin(i), nearest_results.end(i)));
+        }
+    }
+
+    TEST_METHOD(empty)
+    {
+        // Arrange
+        SpatialHashGrid grid(1.0f);
+        grid.remove(grid.insert(Vector(1.0f, 2.0f, 3.0f)));
+        std::vector<SpatialHashGrid::Id> found;
+
+        // Act
+        size_t count1 = grid.query_radius(Vector(), 10.0f, found);
+        size_t count2 = grid.query_nearest(Vector(), 4, found);
+
+        // Assert
+        Assert::IsTrue(grid.empty());
+        Assert::AreEqual(static_cast<size_t>(0), grid.cell_count());
+        Assert::AreEqual(static_cast<size_t>(0), count1 + count2);
+    }
+};
+
+} } }
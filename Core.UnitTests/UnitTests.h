@@ -0,0 +1,48 @@
+#if !defined __UNITTESTS_H__
+#define __UNITTESTS_H__
+
+#include "CppUnitTest.h"
+#include "Core/Math/SIMD/Kernels.h"
+
+namespace energonsoftware {
+namespace math {
+namespace unittests {
+
+// forces a SIMD tier for its lifetime and restores the previous one
+// even when a failed Assert throws out of the test
+class ScopedSimdLevel
+{
+public:
+    explicit ScopedSimdLevel(SimdLevel level)
+        : _previous(kernels().level), _level(set_simd_level(level))
+    {
+    }
+
+    ~ScopedSimdLevel()
+    {
+        set_simd_level(_previous);
+    }
+
+    DISALLOW_COPY_AND_ASSIGN(ScopedSimdLevel);
+
+    // the tier actually in use, lower than requested if the CPU doesn't support it
+    SimdLevel level() const { return _level; }
+
+private:
+    SimdLevel _previous;
+    SimdLevel _level;
+};
+
+// runs the test against every supported tier
+inline void for_each_simd_level(const std::function<void()>& test)
+{
+    for(int i = 0; i <= static_cast<int>(max_simd_level()); ++i) {
+        const ScopedSimdLevel level(static_cast<SimdLevel>(i));
+        Microsoft::VisualStudio::CppUnitTestFramework::Assert::AreEqual(i, static_cast<int>(level.level()));
+        test();
+    }
+}
+
+} } }
+
+#endif
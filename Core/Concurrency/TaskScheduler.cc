@@ -0,0 +1,201 @@
+#include "pch.h"
+#include <algorithm>
+#include "TaskScheduler.h"
+
+namespace energonsoftware {
+namespace concurrency {
+
+namespace {
+
+// the scheduler and queue of the current worker thread
+thread_local const TaskScheduler* current_scheduler = nullptr;
+thread_local size_t current_queue = 0;
+
+// the chunks of one parallel_for()
+// shared with the helper tasks, which can outlive the call
+// if they start after every chunk has been taken
+struct ParallelFor
+{
+    const std::function<void(size_t, size_t)>* body;
+    size_t count;
+    size_t chunk_size;
+    size_t chunks;
+
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> finished{0};
+
+    std::mutex error_mutex;
+    std::exception_ptr error;
+
+    // takes chunks until there are none left
+    // body is only touched while a chunk is unfinished,
+    // which the calling thread waits for
+    void run()
+    {
+        for(size_t chunk = next++; chunk < chunks; chunk = next++) {
+            const size_t begin = chunk * chunk_size;
+            try {
+                (*body)(begin, std::min(begin + chunk_size, count));
+            } catch(...) {
+                std::lock_guard<std::mutex> guard(error_mutex);
+                if(nullptr == error) {
+                    error = std::current_exception();
+                }
+            }
+            ++finished;
+        }
+    }
+};
+
+}
+
+TaskScheduler& TaskScheduler::global()
+{
+    static TaskScheduler scheduler;
+    return scheduler;
+}
+
+TaskScheduler::TaskScheduler(size_t thread_count)
+{
+    if(0 == thread_count) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for(size_t i = 0; i < thread_count; ++i) {
+        _queues.emplace_back(new Queue());
+    }
+
+    for(size_t i = 0; i + 1 < thread_count; ++i) {
+        _threads.emplace_back([this, i]() { run_worker(i); });
+    }
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    {
+        std::lock_guard<std::mutex> guard(_sleep_mutex);
+        _stopping = true;
+    }
+    _wake.notify_all();
+
+    for(std::thread& thread : _threads) {
+        thread.join();
+    }
+}
+
+void TaskScheduler::submit(Task task)
+{
+    Queue& queue = *_queues[queue_index()];
+    {
+        std::lock_guard<std::mutex> guard(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    ++_queued;
+
+    // taking the lock orders this with a worker that's about to sleep
+    {
+        std::lock_guard<std::mutex> guard(_sleep_mutex);
+    }
+    _wake.notify_one();
+}
+
+void TaskScheduler::wait(const std::function<bool()>& done)
+{
+    const size_t queue = queue_index();
+    while(!done()) {
+        if(!run_one(queue)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void TaskScheduler::parallel_for(size_t count, size_t chunk_size, const std::function<void(size_t, size_t)>& body)
+{
+    assert(chunk_size > 0);
+
+    const size_t chunks = (count + chunk_size - 1) / chunk_size;
+    if(chunks <= 1 || _threads.empty()) {
+        for(size_t begin = 0; begin < count; begin += chunk_size) {
+            body(begin, std::min(begin + chunk_size, count));
+        }
+        return;
+    }
+
+    std::shared_ptr<ParallelFor> state(new ParallelFor());
+    state->body = &body;
+    state->count = count;
+    state->chunk_size = chunk_size;
+    state->chunks = chunks;
+
+    // the helpers share out the chunks with this thread
+    // rather than a task per chunk, so idle threads steal whole helpers
+    const size_t helpers = std::min(chunks, thread_count()) - 1;
+    for(size_t i = 0; i < helpers; ++i) {
+        submit([state]() { state->run(); });
+    }
+
+    state->run();
+    wait([&state]() { return state->finished == state->chunks; });
+
+    if(nullptr != state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+size_t TaskScheduler::queue_index() const
+{
+    return this == current_scheduler ? current_queue : _queues.size() - 1;
+}
+
+bool TaskScheduler::run_one(size_t queue)
+{
+    Task task;
+
+    // newest first from our own queue
+    {
+        Queue& own = *_queues[queue];
+        std::lock_guard<std::mutex> guard(own.mutex);
+        if(!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+        }
+    }
+
+    // then oldest first from everyone else, starting with our neighbor
+    for(size_t i = 1; !task && i < _queues.size(); ++i) {
+        Queue& other = *_queues[(queue + i) % _queues.size()];
+        std::lock_guard<std::mutex> guard(other.mutex);
+        if(!other.tasks.empty()) {
+            task = std::move(other.tasks.front());
+            other.tasks.pop_front();
+        }
+    }
+
+    if(!task) {
+        return false;
+    }
+
+    --_queued;
+    task();
+    return true;
+}
+
+void TaskScheduler::run_worker(size_t queue)
+{
+    current_scheduler = this;
+    current_queue = queue;
+
+    while(true) {
+        if(run_one(queue)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleep_mutex);
+        _wake.wait(lock, [this]() { return _stopping || _queued > 0; });
+        if(_stopping && 0 == _queued) {
+            return;
+        }
+    }
+}
+
+} }
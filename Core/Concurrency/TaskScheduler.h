@@ -0,0 +1,116 @@
+#if !defined __TASKSCHEDULER_H__
+#define __TASKSCHEDULER_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <vector>
+
+namespace energonsoftware {
+namespace concurrency {
+
+/*
+Small work-stealing task scheduler.
+
+Every worker thread has its own queue, tasks submitted from a worker go
+on the back of its queue and it runs them newest first (so the data
+they touch is likely still in cache), idle workers steal the oldest task
+from the front of another queue. Tasks submitted from any other thread
+go on a shared queue that every worker takes from.
+
+Threads that wait on the scheduler (wait(), parallel_for()) run queued
+tasks while they wait, so the calling thread is one of the thread_count()
+threads doing the work and tasks may wait on other tasks without deadlocking.
+
+Tasks must not throw, parallel_for() and parallel_reduce() catch and
+rethrow exceptions from their bodies on the calling thread.
+*/
+class DllExport TaskScheduler
+{
+public:
+    typedef std::function<void()> Task;
+
+    // shared scheduler with a thread per hardware thread, started on first use
+    static TaskScheduler& global();
+
+public:
+    // thread_count is the number of threads that run tasks, including the calling thread
+    // so thread_count - 1 workers are started, 0 uses every hardware thread
+    explicit TaskScheduler(size_t thread_count = 0);
+
+    // NOTE: everything submitted must have finished
+    ~TaskScheduler();
+
+    DISALLOW_COPY_AND_ASSIGN(TaskScheduler);
+
+public:
+    size_t thread_count() const { return _threads.size() + 1; }
+
+    // queues task to run on any thread
+    void submit(Task task);
+
+    // runs queued tasks on this thread until done() is true
+    void wait(const std::function<bool()>& done);
+
+    // calls body(begin, end) for every chunk_size range of [0, count)
+    // (the last one may be shorter) across all of the threads and waits for them
+    // chunk_size should be large enough to be worth a task (several microseconds of work)
+    // and a multiple of a cache line worth of elements so that no two threads write the same line
+    // if body throws the remaining chunks still run and the first exception is rethrown
+    void parallel_for(size_t count, size_t chunk_size, const std::function<void(size_t, size_t)>& body);
+
+    // map(begin, end) reduces each chunk (see parallel_for()) to a T
+    // and the chunk results are folded with combine(T, T) in order
+    // starting from identity, so the result only depends on count and chunk_size,
+    // never on the thread count or which thread ran what
+    template<typename T, typename Map, typename Combine>
+    T parallel_reduce(size_t count, size_t chunk_size, const T& identity, Map map, Combine combine);
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+private:
+    // the queue this thread pushes to and pops from
+    size_t queue_index() const;
+
+    // runs one task, from queue first and then stolen from the others
+    bool run_one(size_t queue);
+
+    void run_worker(size_t queue);
+
+private:
+    // one per worker and the shared queue last
+    std::vector<std::unique_ptr<Queue>> _queues;
+    std::vector<std::thread> _threads;
+
+    std::atomic<size_t> _queued{0};
+
+    std::mutex _sleep_mutex;
+    std::condition_variable _wake;
+    bool _stopping = false;
+};
+
+template<typename T, typename Map, typename Combine>
+T TaskScheduler::parallel_reduce(size_t count, size_t chunk_size, const T& identity, Map map, Combine combine)
+{
+    const size_t chunks = (count + chunk_size - 1) / chunk_size;
+    std::vector<T> results(chunks, identity);
+    parallel_for(count, chunk_size, [&](size_t begin, size_t end) {
+        results[begin / chunk_size] = map(begin, end);
+    });
+
+    T result = identity;
+    for(const T& r : results) {
+        result = combine(result, r);
+    }
+    return result;
+}
+
+} }
+
+#endif
@@ -0,0 +1,461 @@
+#include "pch.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include "Core/Math/SIMD/Kernels.h"
+#include "PointCloud.h"
+
+// the format is little-endian and the mapped data is used as is
+#if defined __BYTE_ORDER__ && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+    #error "point clouds are only supported on little-endian hosts"
+#endif
+
+namespace energonsoftware {
+namespace io {
+
+const size_t PointCloudWriter::DefaultChunkSize;
+const size_t PointCloudFile::npos;
+
+namespace {
+
+const char Magic[8] = { 'E', 'S', 'P', 'C', 'L', 'O', 'U', 'D' };
+
+const uint32_t ChecksumsFlag = 1;
+
+// everything in the file is aligned to this
+const uint64_t FileAlignment = 64;
+
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint32_t column_count;
+    uint32_t reserved0;
+    uint64_t point_count;
+    uint64_t chunk_size;
+    uint64_t chunk_count;
+    uint64_t chunk_table;
+    uint64_t reserved1;
+};
+
+struct ColumnDescriptor
+{
+    // nul-terminated
+    char name[MaxColumnNameLength + 1];
+    uint32_t layout;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(FileHeader) == 64, "FileHeader must be 64 bytes");
+static_assert(sizeof(ColumnDescriptor) == 32, "ColumnDescriptor must be 32 bytes");
+static_assert(sizeof(math::Vector) == 16, "Vector must be 4 packed floats");
+
+// sizes saturate instead of wrapping so that a corrupt
+// header can't sneak a huge size past the bounds checks
+const uint64_t Saturated = std::numeric_limits<uint64_t>::max();
+
+uint64_t add(uint64_t a, uint64_t b)
+{
+    return a > Saturated - b ? Saturated : a + b;
+}
+
+uint64_t multiply(uint64_t a, uint64_t b)
+{
+    return 0 != a && b > Saturated / a ? Saturated : a * b;
+}
+
+uint64_t align(uint64_t size)
+{
+    return add(size, FileAlignment - 1) & ~(FileAlignment - 1);
+}
+
+// the first chunk starts after the header and column descriptors
+uint64_t data_start(size_t column_count)
+{
+    return align(sizeof(FileHeader) + column_count * sizeof(ColumnDescriptor));
+}
+
+// each stream component array is padded out to a whole number of cache lines
+uint64_t stream_stride(uint64_t points)
+{
+    return align(multiply(points, sizeof(float))) / sizeof(float);
+}
+
+uint64_t column_bytes(ColumnLayout layout, uint64_t points)
+{
+    return ColumnLayout::Stream == layout ? multiply(stream_stride(points), 4 * sizeof(float)) : align(multiply(points, sizeof(math::Vector)));
+}
+
+// the table entry of each chunk is its offset, its point count and a checksum per column
+size_t chunk_entry_size(size_t column_count)
+{
+    return 2 + column_count;
+}
+
+inline uint64_t rotl(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+// the xxHash64 round over 4 independent lanes, fast enough
+// to checksum at memory bandwidth (but not compatible with xxHash)
+uint64_t checksum(const char* const data, size_t size)
+{
+    const uint64_t Prime1 = 11400714785074694791ULL;
+    const uint64_t Prime2 = 14029467366897019727ULL;
+
+    uint64_t lanes[4] = { Prime1 + Prime2, Prime2, 0, 0 - Prime1 };
+
+    size_t i = 0;
+    for(; i + 32 <= size; i += 32) {
+        for(size_t l = 0; l < 4; ++l) {
+            uint64_t word;
+            std::memcpy(&word, data + i + l * 8, 8);
+            lanes[l] = rotl(lanes[l] + word * Prime2, 31) * Prime1;
+        }
+    }
+
+    uint64_t h = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18) + size;
+    for(; i < size; ++i) {
+        h = rotl(h ^ (static_cast<uint8_t>(data[i]) * Prime1), 11) * Prime2;
+    }
+
+    h ^= h >> 33;
+    h *= Prime2;
+    h ^= h >> 29;
+    return h;
+}
+
+}
+
+PointCloudWriter::PointCloudWriter(const std::string& path, const std::vector<PointCloudColumn>& columns, size_t chunk_size, bool checksums)
+    : _path(path), _columns(columns), _chunk_size(chunk_size), _checksums(checksums)
+{
+    assert(!_columns.empty());
+    assert(_chunk_size > 0);
+
+    for(size_t i = 0; i < _columns.size(); ++i) {
+        assert(!_columns[i].name.empty() && _columns[i].name.length() <= MaxColumnNameLength);
+        assert(_columns.end() == std::find_if(_columns.begin() + i + 1, _columns.end(), [this, i](const PointCloudColumn& c) { return c.name == _columns[i].name; }));
+    }
+
+    _file.open(path, std::ios::binary | std::ios::trunc);
+    if(!_file) {
+        fail("failed to create");
+    }
+
+    // the real header is written by close()
+    const FileHeader header = {};
+    write_bytes(&header, sizeof(header));
+
+    for(const PointCloudColumn& column : _columns) {
+        ColumnDescriptor descriptor = {};
+        std::memcpy(descriptor.name, column.name.c_str(), std::min(column.name.length(), MaxColumnNameLength));
+        descriptor.layout = static_cast<uint32_t>(column.layout);
+        write_bytes(&descriptor, sizeof(descriptor));
+    }
+
+    const char padding[FileAlignment] = {};
+    write_bytes(padding, static_cast<size_t>(data_start(_columns.size()) - _offset));
+
+    // with room for padding the last Vector out to FileAlignment
+    _buffers.resize(_columns.size());
+    for(auto& buffer : _buffers) {
+        buffer.resize(_chunk_size + FileAlignment / sizeof(math::Vector) - 1);
+    }
+}
+
+PointCloudWriter::~PointCloudWriter()
+{
+    try {
+        close();
+    } catch(const std::exception&) {
+    }
+}
+
+void PointCloudWriter::write(std::initializer_list<const math::Vector*> columns, size_t count)
+{
+    assert(!_closed);
+    assert(columns.size() == _columns.size());
+
+    size_t written = 0;
+    while(written < count) {
+        const size_t n = std::min(count - written, _chunk_size - _buffered);
+
+        size_t c = 0;
+        for(const math::Vector* v : columns) {
+            std::copy(v + written, v + written + n, _buffers[c++].begin() + _buffered);
+        }
+
+        _buffered += n;
+        written += n;
+
+        if(_buffered == _chunk_size) {
+            flush_chunk();
+        }
+    }
+    _size += count;
+}
+
+void PointCloudWriter::close()
+{
+    if(_closed) {
+        return;
+    }
+    _closed = true;
+
+    if(_buffered > 0) {
+        flush_chunk();
+    }
+
+    const uint64_t chunk_table = _offset;
+    write_bytes(_chunk_table.data(), _chunk_table.size() * sizeof(uint64_t));
+
+    FileHeader header = {};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = PointCloudVersion;
+    header.flags = _checksums ? ChecksumsFlag : 0;
+    header.column_count = static_cast<uint32_t>(_columns.size());
+    header.point_count = _size;
+    header.chunk_size = _chunk_size;
+    header.chunk_count = _chunk_table.size() / chunk_entry_size(_columns.size());
+    header.chunk_table = chunk_table;
+
+    _file.seekp(0);
+    write_bytes(&header, sizeof(header));
+
+    _file.close();
+    if(_file.fail()) {
+        fail("failed to close");
+    }
+}
+
+void PointCloudWriter::flush_chunk()
+{
+    _chunk_table.push_back(_offset);
+    _chunk_table.push_back(_buffered);
+
+    for(size_t c = 0; c < _columns.size(); ++c) {
+        const math::Vector* const v = _buffers[c].data();
+        const size_t size = static_cast<size_t>(column_bytes(_columns[c].layout, _buffered));
+
+        const char* data = reinterpret_cast<const char*>(v);
+        if(ColumnLayout::Stream == _columns[c].layout) {
+            // transpose into the 4 component arrays
+            const size_t stride = static_cast<size_t>(stream_stride(_buffered));
+            _stream.resize(4 * stride);
+            float* const x = _stream.data();
+            math::kernels().array.to_stream(reinterpret_cast<const float*>(v), math::StreamRef{ x, x + stride, x + 2 * stride, x + 3 * stride }, _buffered);
+
+            // zero the padding after each component so the checksum covers it too
+            for(size_t i = 0; i < 4; ++i) {
+                std::fill(x + i * stride + _buffered, x + (i + 1) * stride, 0.0f);
+            }
+            data = reinterpret_cast<const char*>(x);
+        } else {
+            // zero the padding in the buffer so the checksum covers it too
+            std::fill(_buffers[c].begin() + _buffered, _buffers[c].begin() + size / sizeof(math::Vector), math::Vector());
+        }
+
+        write_bytes(data, size);
+        _chunk_table.push_back(_checksums ? checksum(data, size) : 0);
+    }
+
+    _buffered = 0;
+}
+
+void PointCloudWriter::write_bytes(const void* const data, size_t size)
+{
+    _file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    if(!_file) {
+        fail("failed to write");
+    }
+    _offset += size;
+}
+
+void PointCloudWriter::fail(const char* what) const
+{
+    throw std::runtime_error(std::string(what) + " point cloud " + _path);
+}
+
+PointCloudFile::PointCloudFile(const std::string& path)
+    : _file(path)
+{
+    const uint64_t file_size = _file.size();
+    if(file_size < sizeof(FileHeader)) {
+        fail("truncated header in");
+    }
+
+    FileHeader header;
+    std::memcpy(&header, _file.data(), sizeof(header));
+    if(0 != std::memcmp(header.magic, Magic, sizeof(Magic))) {
+        fail("not a (finished) point cloud:");
+    }
+    if(header.version > PointCloudVersion) {
+        fail("unsupported version of point cloud");
+    }
+    if(0 == header.column_count || 0 == header.chunk_size) {
+        fail("invalid header in");
+    }
+
+    // every point takes at least a Vector worth of space in the
+    // file and a whole chunk has to be addressable in memory
+    if(header.point_count > file_size / sizeof(math::Vector) || header.chunk_size > std::numeric_limits<size_t>::max() / sizeof(math::Vector)) {
+        fail("invalid point count in");
+    }
+
+    const uint64_t start = data_start(header.column_count);
+    if(start > file_size) {
+        fail("truncated columns in");
+    }
+
+    const ColumnDescriptor* const descriptors = reinterpret_cast<const ColumnDescriptor*>(_file.data() + sizeof(FileHeader));
+    _columns.resize(header.column_count);
+    for(size_t c = 0; c < _columns.size(); ++c) {
+        const ColumnDescriptor& descriptor = descriptors[c];
+        if(nullptr == std::memchr(descriptor.name, 0, sizeof(descriptor.name)) || descriptor.layout > static_cast<uint32_t>(ColumnLayout::Stream)) {
+            fail("invalid column in");
+        }
+        _columns[c].name = descriptor.name;
+        _columns[c].layout = static_cast<ColumnLayout>(descriptor.layout);
+    }
+
+    // every chunk is full except the last
+    if(header.chunk_count != header.point_count / header.chunk_size + (0 != header.point_count % header.chunk_size)) {
+        fail("invalid chunk count in");
+    }
+
+    const uint64_t entry_bytes = chunk_entry_size(_columns.size()) * sizeof(uint64_t);
+    if(header.chunk_table < start || header.chunk_table > file_size || 0 != header.chunk_table % FileAlignment
+        || header.chunk_count > (file_size - header.chunk_table) / entry_bytes) {
+        fail("truncated chunk table in");
+    }
+
+    _size = static_cast<size_t>(header.point_count);
+    _chunk_size = static_cast<size_t>(header.chunk_size);
+    _chunk_count = static_cast<size_t>(header.chunk_count);
+    _checksums = 0 != (header.flags & ChecksumsFlag);
+    _chunk_table = reinterpret_cast<const uint64_t*>(_file.data() + header.chunk_table);
+
+    // make sure every chunk is where it claims to be so that
+    // the accessors don't have to check anything
+    for(size_t i = 0; i < _chunk_count; ++i) {
+        const uint64_t* const entry = chunk_entry(i);
+        const uint64_t expected = std::min<uint64_t>(_chunk_size, _size - chunk_start(i));
+        if(entry[1] != expected || 0 != entry[0] % FileAlignment || entry[0] < start) {
+            fail("invalid chunk in");
+        }
+
+        uint64_t bytes = 0;
+        for(const PointCloudColumn& column : _columns) {
+            bytes = add(bytes, column_bytes(column.layout, expected));
+        }
+        if(entry[0] > header.chunk_table || bytes > header.chunk_table - entry[0]) {
+            fail("truncated chunk in");
+        }
+    }
+}
+
+size_t PointCloudFile::find_column(const std::string& name) const
+{
+    for(size_t c = 0; c < _columns.size(); ++c) {
+        if(_columns[c].name == name) {
+            return c;
+        }
+    }
+    return npos;
+}
+
+size_t PointCloudFile::chunk_points(size_t chunk) const
+{
+    return static_cast<size_t>(chunk_entry(chunk)[1]);
+}
+
+memory::Span<const math::Vector> PointCloudFile::packed(size_t column, size_t chunk) const
+{
+    assert(ColumnLayout::Packed == _columns[column].layout);
+    return memory::Span<const math::Vector>(reinterpret_cast<const math::Vector*>(column_data(column, chunk)), chunk_points(chunk));
+}
+
+math::ConstStreamRef PointCloudFile::stream(size_t column, size_t chunk) const
+{
+    assert(ColumnLayout::Stream == _columns[column].layout);
+    const float* const x = reinterpret_cast<const float*>(column_data(column, chunk));
+    const size_t stride = static_cast<size_t>(stream_stride(chunk_points(chunk)));
+    return math::ConstStreamRef(x, x + stride, x + 2 * stride, x + 3 * stride);
+}
+
+void PointCloudFile::read(size_t column, math::Vector* const out) const
+{
+    for(size_t i = 0; i < _chunk_count; ++i) {
+        math::Vector* const r = out + chunk_start(i);
+        if(ColumnLayout::Packed == _columns[column].layout) {
+            const memory::Span<const math::Vector> v = packed(column, i);
+            std::copy(v.begin(), v.end(), r);
+        } else {
+            math::kernels().array.from_stream(stream(column, i), reinterpret_cast<float*>(r), chunk_points(i));
+        }
+    }
+}
+
+void PointCloudFile::prefetch(size_t chunk) const
+{
+    uint64_t bytes = 0;
+    for(const PointCloudColumn& column : _columns) {
+        bytes += column_bytes(column.layout, chunk_points(chunk));
+    }
+    _file.prefetch(static_cast<size_t>(chunk_entry(chunk)[0]), static_cast<size_t>(bytes));
+}
+
+bool PointCloudFile::verify(size_t chunk) const
+{
+    if(!_checksums) {
+        return true;
+    }
+
+    const uint64_t* const entry = chunk_entry(chunk);
+    for(size_t c = 0; c < _columns.size(); ++c) {
+        const size_t size = static_cast<size_t>(column_bytes(_columns[c].layout, entry[1]));
+        if(checksum(column_data(c, chunk), size) != entry[2 + c]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool PointCloudFile::verify() const
+{
+    for(size_t i = 0; i < _chunk_count; ++i) {
+        if(!verify(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const uint64_t* PointCloudFile::chunk_entry(size_t chunk) const
+{
+    assert(chunk < _chunk_count);
+    return _chunk_table + chunk * chunk_entry_size(_columns.size());
+}
+
+const char* PointCloudFile::column_data(size_t column, size_t chunk) const
+{
+    assert(column < _columns.size());
+
+    const uint64_t* const entry = chunk_entry(chunk);
+    uint64_t offset = entry[0];
+    for(size_t c = 0; c < column; ++c) {
+        offset += column_bytes(_columns[c].layout, entry[1]);
+    }
+    return _file.data() + offset;
+}
+
+void PointCloudFile::fail(const char* what) const
+{
+    throw std::runtime_error(std::string(what) + " " + _file.path());
+}
+
+} }
@@ -0,0 +1,210 @@
+#if !defined __POINTCLOUD_H__
+#define __POINTCLOUD_H__
+
+#include <fstream>
+#include <vector>
+#include "Core/Math/Vector.h"
+#include "Core/Math/SIMD/StreamRef.h"
+#include "Core/Memory/AlignedAllocator.h"
+#include "Core/Memory/Span.h"
+#include "Core/Platform/MappedFile.h"
+
+namespace energonsoftware {
+namespace io {
+
+/*
+Binary point cloud files.
+
+A point cloud is a set of named columns (positions, colors, normals, ...)
+with one Vector per point in each column. The file is written once
+by a PointCloudWriter and then memory-mapped by PointCloudFile, which
+hands out the Vectors straight out of the mapping without copying
+or parsing anything, so opening a file costs a few page faults
+and the data is only read from disk as it's touched.
+
+The points are split into chunks of (up to) chunk_size points so that
+the writer only has to buffer one chunk. Each column of a chunk is stored
+either as packed Vectors or as a stream (structure-of-arrays with
+each component in its own array, like a VectorStream), see ColumnLayout.
+Every column of every chunk starts on a 64 byte boundary.
+
+Each chunk optionally stores a 64-bit checksum of each of its columns.
+They're only checked by verify(), since that has to read the whole file.
+
+The format is little-endian and versioned, readers reject
+files with a newer PointCloudVersion than they understand.
+Nothing is byte-swapped, so this only builds for little-endian hosts.
+
+    header (64 bytes)
+    column descriptors (32 bytes each)
+    chunks
+    chunk table (one entry per chunk: offset, point count, a checksum per column)
+
+The header is written last, so a file that was never closed won't open.
+*/
+
+enum class ColumnLayout : uint32_t
+{
+    // Vectors one after the other, read as a Span of Vectors
+    Packed = 0,
+
+    // x, y, z and w each in their own (64 byte aligned) array,
+    // read as a ConstStreamRef for the stream batch APIs
+    Stream = 1
+};
+
+struct PointCloudColumn
+{
+    // at most MaxColumnNameLength characters
+    std::string name;
+    ColumnLayout layout;
+};
+
+const uint32_t PointCloudVersion = 1;
+
+const size_t MaxColumnNameLength = 23;
+
+/*
+Streams points into a new point cloud file.
+
+Points are buffered until a chunk is full and then written out,
+close() writes the last partial chunk, the chunk table and the header.
+All of the methods throw std::runtime_error if the file can't be written.
+*/
+class DllExport PointCloudWriter
+{
+public:
+    // 1MB per packed column
+    static const size_t DefaultChunkSize = 64 * 1024;
+
+public:
+    // columns must not be empty and their names must be unique
+    PointCloudWriter(const std::string& path, const std::vector<PointCloudColumn>& columns, size_t chunk_size = DefaultChunkSize, bool checksums = true);
+
+    // closes the file if close() wasn't called
+    // but swallows any error, call close() to find out if it worked
+    ~PointCloudWriter();
+
+    DISALLOW_COPY_AND_ASSIGN(PointCloudWriter);
+
+public:
+    // appends count points, columns has one array of count Vectors per column, in column order
+    void write(std::initializer_list<const math::Vector*> columns, size_t count);
+
+    // appends count points to a file with a single column
+    void write(const math::Vector* const v, size_t count) { write({ v }, count); }
+
+    void close();
+
+    // points written so far
+    size_t size() const { return _size; }
+
+private:
+    void flush_chunk();
+
+    void write_bytes(const void* const data, size_t size);
+
+    [[noreturn]] void fail(const char* what) const;
+
+private:
+    std::string _path;
+    std::ofstream _file;
+
+    std::vector<PointCloudColumn> _columns;
+    size_t _chunk_size;
+    bool _checksums;
+
+    // one chunk of each column
+    std::vector<memory::AlignedVector<math::Vector>> _buffers;
+    size_t _buffered = 0;
+
+    // transposed stream columns
+    std::vector<float> _stream;
+
+    // offset, count and a checksum per column of each chunk written
+    std::vector<uint64_t> _chunk_table;
+
+    uint64_t _offset = 0;
+    size_t _size = 0;
+    bool _closed = false;
+};
+
+/*
+A memory-mapped point cloud file.
+
+The spans and stream refs point into the mapping and are only valid
+as long as the PointCloudFile is open.
+*/
+class DllExport PointCloudFile
+{
+public:
+    static const size_t npos = static_cast<size_t>(-1);
+
+public:
+    // throws std::runtime_error if the file can't be mapped or isn't a valid point cloud
+    explicit PointCloudFile(const std::string& path);
+
+    DISALLOW_COPY_AND_ASSIGN(PointCloudFile);
+
+public:
+    // the number of points
+    size_t size() const { return _size; }
+
+    size_t column_count() const { return _columns.size(); }
+    const PointCloudColumn& column(size_t column) const { return _columns[column]; }
+
+    // the index of the named column or npos
+    size_t find_column(const std::string& name) const;
+
+    // every chunk except the last has exactly chunk_size() points
+    size_t chunk_size() const { return _chunk_size; }
+    size_t chunk_count() const { return _chunk_count; }
+
+    // the number of points in the chunk
+    size_t chunk_points(size_t chunk) const;
+
+    // the index of the first point in the chunk
+    size_t chunk_start(size_t chunk) const { return chunk * _chunk_size; }
+
+    bool has_checksums() const { return _checksums; }
+
+    // the points of a Packed column in the chunk
+    memory::Span<const math::Vector> packed(size_t column, size_t chunk) const;
+
+    // the points of a Stream column in the chunk
+    math::ConstStreamRef stream(size_t column, size_t chunk) const;
+
+    // copies every point of the column (of either layout) into out,
+    // which must have room for size() Vectors
+    void read(size_t column, math::Vector* const out) const;
+
+    // asks the OS to start reading the chunk in
+    void prefetch(size_t chunk) const;
+
+    // checks every column of the chunk against its checksum
+    // always true if the file has no checksums
+    bool verify(size_t chunk) const;
+    bool verify() const;
+
+private:
+    const uint64_t* chunk_entry(size_t chunk) const;
+
+    const char* column_data(size_t column, size_t chunk) const;
+
+    [[noreturn]] void fail(const char* what) const;
+
+private:
+    platform::MappedFile _file;
+
+    std::vector<PointCloudColumn> _columns;
+    size_t _size = 0;
+    size_t _chunk_size = 0;
+    size_t _chunk_count = 0;
+    bool _checksums = false;
+
+    const uint64_t* _chunk_table = nullptr;
+};
+
+} }
+
+#endif
@@ -0,0 +1,25 @@
+#include "pch.h"
+#include "AABB.h"
+
+namespace energonsoftware {
+namespace math {
+
+const AABB AABB::Empty;
+
+AABB AABB::from_points(const Point3* const points, size_t count)
+{
+    AABB ret;
+    for(size_t i = 0; i < count; ++i) {
+        ret.merge(points[i]);
+    }
+    return ret;
+}
+
+std::string AABB::str() const
+{
+    std::stringstream ss;
+    ss << "AABB(minimum:" << _minimum.str() << ", maximum:" << _maximum.str() << ")";
+    return ss.str();
+}
+
+} }
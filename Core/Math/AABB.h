@@ -0,0 +1,221 @@
+#if !defined __AABB_H__
+#define __AABB_H__
+
+#include <limits>
+#include "Vector.h"
+
+namespace energonsoftware {
+namespace math {
+
+/*
+Axis-aligned bounding box, the minimum and maximum corners as Vectors.
+
+Only x, y and z are used, w is always 0.
+
+A default constructed box is empty (the minimum is +infinity and the
+maximum is -infinity) so merging anything into it gives that thing's
+bounds and it doesn't contain or overlap anything. A box around a single
+point isn't empty. Boxes are closed, touching boxes overlap.
+*/
+class DllExport AABB
+{
+public:
+    static const AABB Empty;
+
+public:
+    // the bounds of count points, empty if there are none
+    static AABB from_points(const Point3* const points, size_t count);
+
+    static AABB from_center(const Point3& center, const Vector& half_extents)
+    {
+        return AABB(center - half_extents, center + half_extents);
+    }
+
+public:
+    AABB()
+        : _minimum(std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity()),
+            _maximum(-std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity())
+    {
+    }
+
+    AABB(const Point3& minimum, const Point3& maximum)
+        : _minimum(minimum.xyz()), _maximum(maximum.xyz())
+    {
+    }
+
+    DEFAULT_COPY_AND_ASSIGN(AABB);
+
+    AABB(AABB&& box) = default;
+
+    ~AABB() = default;
+
+public:
+    const Point3& minimum() const { return _minimum; }
+    const Point3& maximum() const { return _maximum; }
+
+    bool is_empty() const { return _minimum.x() > _maximum.x() || _minimum.y() > _maximum.y() || _minimum.z() > _maximum.z(); }
+
+    // NOTE: these are meaningless for empty boxes
+    Point3 center() const { return (_minimum + _maximum) * 0.5f; }
+    Vector extents() const { return _maximum - _minimum; }
+    Vector half_extents() const { return extents() * 0.5f; }
+
+    // 0 for empty boxes
+    float surface_area() const
+    {
+        if(is_empty()) {
+            return 0.0f;
+        }
+
+        const Vector e = extents();
+        return 2.0f * (e.x() * e.y() + e.y() * e.z() + e.z() * e.x());
+    }
+
+    float volume() const
+    {
+        if(is_empty()) {
+            return 0.0f;
+        }
+
+        const Vector e = extents();
+        return e.x() * e.y() * e.z();
+    }
+
+    // 0, 1 or 2
+    int longest_axis() const
+    {
+        const Vector e = extents();
+        return e.x() >= e.y()
+            ? (e.x() >= e.z() ? 0 : 2)
+            : (e.y() >= e.z() ? 1 : 2);
+    }
+
+    // grows the box to include point/box
+    AABB& merge(const Point3& point)
+    {
+        _minimum = _minimum.minimum(point.xyz());
+        _maximum = _maximum.maximum(point.xyz());
+        return *this;
+    }
+
+    AABB& merge(const AABB& box)
+    {
+        _minimum = _minimum.minimum(box._minimum);
+        _maximum = _maximum.maximum(box._maximum);
+        return *this;
+    }
+
+    AABB merged(const Point3& point) const { return AABB(*this).merge(point); }
+    AABB merged(const AABB& box) const { return AABB(*this).merge(box); }
+
+    // the overlap of the two boxes, empty if they don't overlap
+    AABB intersection(const AABB& box) const
+    {
+        AABB ret;
+        ret._minimum = _minimum.maximum(box._minimum);
+        ret._maximum = _maximum.minimum(box._maximum);
+        return ret.is_empty() ? AABB() : ret;
+    }
+
+    bool contains(const Point3& point) const
+    {
+#if defined USE_SSE
+        const __m128 P = point.simd();
+        const __m128 R = _mm_and_ps(_mm_cmple_ps(_minimum.simd(), P), _mm_cmple_ps(P, _maximum.simd()));
+        return 7 == (_mm_movemask_ps(R) & 7);
+#else
+        return _minimum.x() <= point.x() && point.x() <= _maximum.x()
+            && _minimum.y() <= point.y() && point.y() <= _maximum.y()
+            && _minimum.z() <= point.z() && point.z() <= _maximum.z();
+#endif
+    }
+
+    // true if all of box is inside of this box
+    // NOTE: every box contains the empty box
+    bool contains(const AABB& box) const
+    {
+        return box.is_empty() || (contains(box._minimum) && contains(box._maximum));
+    }
+
+    bool overlaps(const AABB& box) const
+    {
+#if defined USE_SSE
+        const __m128 R = _mm_and_ps(_mm_cmple_ps(_minimum.simd(), box._maximum.simd()), _mm_cmple_ps(box._minimum.simd(), _maximum.simd()));
+        return 7 == (_mm_movemask_ps(R) & 7);
+#else
+        return _minimum.x() <= box._maximum.x() && box._minimum.x() <= _maximum.x()
+            && _minimum.y() <= box._maximum.y() && box._minimum.y() <= _maximum.y()
+            && _minimum.z() <= box._maximum.z() && box._minimum.z() <= _maximum.z();
+#endif
+    }
+
+    // squared distance from point to the nearest point in the box, 0 if it's inside
+    float distance_squared(const Point3& point) const
+    {
+        const Vector d = (_minimum - point.xyz()).maximum(point.xyz() - _maximum).maximum(Vector::Zero);
+        return d * d;
+    }
+
+    // slab test of the ray origin + t * direction against the box,
+    // inv_direction is 1 / direction per component (infinite for 0 components)
+    // returns true and the entry distance in t (clamped to t_min)
+    // if the ray hits the box between t_min and t_max, empty boxes are never hit
+    // NOTE: a ray inside of a face plane (exactly on the boundary
+    // and parallel to it) may or may not hit
+    bool intersect_ray(const Point3& origin, const Vector& inv_direction, float t_min, float t_max, float& t) const
+    {
+        // the slabs of an empty box are inside out
+        if(is_empty()) {
+            return false;
+        }
+
+#if defined USE_SSE
+        const __m128 O = origin.simd(), I = inv_direction.simd();
+        const __m128 T1 = _mm_mul_ps(_mm_sub_ps(_minimum.simd(), O), I);
+        const __m128 T2 = _mm_mul_ps(_mm_sub_ps(_maximum.simd(), O), I);
+        const __m128 N = _mm_min_ps(T1, T2), F = _mm_max_ps(T1, T2);
+
+        // x, y and z only, the w lanes are meaningless
+        __m128 TN = _mm_max_ss(N, _mm_set_ss(t_min));
+        TN = _mm_max_ss(_mm_shuffle_ps(N, N, _MM_SHUFFLE(1, 1, 1, 1)), TN);
+        TN = _mm_max_ss(_mm_movehl_ps(N, N), TN);
+
+        __m128 TF = _mm_min_ss(F, _mm_set_ss(t_max));
+        TF = _mm_min_ss(_mm_shuffle_ps(F, F, _MM_SHUFFLE(1, 1, 1, 1)), TF);
+        TF = _mm_min_ss(_mm_movehl_ps(F, F), TF);
+
+        const float tn = _mm_cvtss_f32(TN), tf = _mm_cvtss_f32(TF);
+#else
+        float tn = t_min, tf = t_max;
+        for(int i = 0; i < 3; ++i) {
+            const float t1 = (_minimum[i] - origin[i]) * inv_direction[i];
+            const float t2 = (_maximum[i] - origin[i]) * inv_direction[i];
+            tn = MAX(MIN(t1, t2), tn);
+            tf = MIN(MAX(t1, t2), tf);
+        }
+#endif
+        if(tn > tf) {
+            return false;
+        }
+
+        t = tn;
+        return true;
+    }
+
+    std::string str() const;
+
+public:
+    bool operator==(const AABB& rhs) const { return _minimum == rhs._minimum && _maximum == rhs._maximum; }
+    bool operator!=(const AABB& rhs) const { return !(*this == rhs); }
+
+private:
+    Point3 _minimum;
+    Point3 _maximum;
+};
+
+static_assert(sizeof(AABB) == 32, "AABB must be exactly 2 Vectors");
+static_assert(std::is_trivially_copyable<AABB>::value, "AABB must be trivially copyable");
+
+} }
+
+#endif
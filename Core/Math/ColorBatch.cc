@@ -0,0 +1,96 @@
+#include "pch.h"
+#include "SIMD/Kernels.h"
+#include "ColorBatch.h"
+
+namespace energonsoftware {
+namespace math {
+namespace batch {
+
+// NOTE: Color is a Vector so arrays of them are exactly 4 packed floats per color
+
+void srgb_to_linear(const Color* const c, Color* const out, size_t count)
+{
+    kernels().color.srgb_to_linear(reinterpret_cast<const float*>(c), reinterpret_cast<float*>(out), count);
+}
+
+void linear_to_srgb(const Color* const c, Color* const out, size_t count)
+{
+    kernels().color.linear_to_srgb(reinterpret_cast<const float*>(c), reinterpret_cast<float*>(out), count);
+}
+
+void pack_rgba8(const Color* const c, uint32_t* const out, size_t count)
+{
+    kernels().color.pack_rgba8(reinterpret_cast<const float*>(c), out, count);
+}
+
+void unpack_rgba8(const uint32_t* const p, Color* const out, size_t count)
+{
+    kernels().color.unpack_rgba8(p, reinterpret_cast<float*>(out), count);
+}
+
+void pack_srgba8(const Color* const c, uint32_t* const out, size_t count)
+{
+    kernels().color.pack_srgba8(reinterpret_cast<const float*>(c), out, count);
+}
+
+void unpack_srgba8(const uint32_t* const p, Color* const out, size_t count)
+{
+    kernels().color.unpack_srgba8(p, reinterpret_cast<float*>(out), count);
+}
+
+void pack_rgb10a2(const Color* const c, uint32_t* const out, size_t count)
+{
+    kernels().color.pack_rgb10a2(reinterpret_cast<const float*>(c), out, count);
+}
+
+void unpack_rgb10a2(const uint32_t* const p, Color* const out, size_t count)
+{
+    kernels().color.unpack_rgb10a2(p, reinterpret_cast<float*>(out), count);
+}
+
+void pack_half(const Color* const c, uint16_t* const out, size_t count)
+{
+    kernels().encode.to_half(reinterpret_cast<const float*>(c), out, count * 4);
+}
+
+void unpack_half(const uint16_t* const h, Color* const out, size_t count)
+{
+    kernels().encode.from_half(h, reinterpret_cast<float*>(out), count * 4);
+}
+
+void premultiply(const Color* const c, Color* const out, size_t count)
+{
+    kernels().color.premultiply(reinterpret_cast<const float*>(c), reinterpret_cast<float*>(out), count);
+}
+
+void unpremultiply(const Color* const c, Color* const out, size_t count)
+{
+    kernels().color.unpremultiply(reinterpret_cast<const float*>(c), reinterpret_cast<float*>(out), count);
+}
+
+void blend(const Color* const src, const Color* const dst, Color* const out, size_t count, BlendMode mode)
+{
+    const ColorKernels& color = kernels().color;
+
+    void (*kernel)(const float*, const float*, float*, size_t) = nullptr;
+    switch(mode)
+    {
+    case BlendMode::Over:
+        kernel = color.blend_over;
+        break;
+    case BlendMode::Add:
+        kernel = color.blend_add;
+        break;
+    case BlendMode::Multiply:
+        kernel = color.blend_multiply;
+        break;
+    case BlendMode::Screen:
+        kernel = color.blend_screen;
+        break;
+    }
+    assert(nullptr != kernel);
+
+    kernel(reinterpret_cast<const float*>(src), reinterpret_cast<const float*>(dst), reinterpret_cast<float*>(out), count);
+}
+
+} } }
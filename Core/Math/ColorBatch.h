@@ -0,0 +1,74 @@
+#if !defined __COLORBATCH_H__
+#define __COLORBATCH_H__
+
+#include "Vector.h"
+
+namespace energonsoftware {
+namespace math {
+
+// Porter-Duff / separable blend modes for premultiplied colors (s over d)
+enum class BlendMode
+{
+    // s + d * (1 - sa)
+    Over,
+
+    // s + d, not clamped
+    Add,
+
+    // s * d + s * (1 - da) + d * (1 - sa)
+    Multiply,
+
+    // s + d - s * d
+    Screen
+};
+
+/*
+Batch color operations over packed arrays of RGBA Colors.
+
+These run the best kernels for the current CPU (see SIMD/Kernels.h).
+Output arrays must have room for count colors and may alias inputs of the same type.
+
+The sRGB conversions use the exact piecewise IEC 61966-2-1 curves with
+a polynomial pow(), both are within 1e-6 relative error (about 8 ulps)
+of the exact curves over [0, 1], so 8-bit values survive
+unpack_srgba8() -> pack_srgba8() exactly. Alpha is always linear.
+
+The 8-bit and 10-bit packings clamp each channel to [0, 1] (NaN goes to 0)
+and round to nearest, red is in the low bits. float16 rounds to nearest even,
+keeps denormals and overflows to infinity, exactly like F16C.
+*/
+namespace batch {
+
+DllExport void srgb_to_linear(const Color* const c, Color* const out, size_t count);
+DllExport void linear_to_srgb(const Color* const c, Color* const out, size_t count);
+
+// RGBA8 UNORM
+DllExport void pack_rgba8(const Color* const c, uint32_t* const out, size_t count);
+DllExport void unpack_rgba8(const uint32_t* const p, Color* const out, size_t count);
+
+// linear colors to and from RGBA8 with sRGB encoded color channels
+DllExport void pack_srgba8(const Color* const c, uint32_t* const out, size_t count);
+DllExport void unpack_srgba8(const uint32_t* const p, Color* const out, size_t count);
+
+// RGB10A2 UNORM
+DllExport void pack_rgb10a2(const Color* const c, uint32_t* const out, size_t count);
+DllExport void unpack_rgb10a2(const uint32_t* const p, Color* const out, size_t count);
+
+// RGBA16F, out has room for 4 * count halves
+DllExport void pack_half(const Color* const c, uint16_t* const out, size_t count);
+DllExport void unpack_half(const uint16_t* const h, Color* const out, size_t count);
+
+// multiplies rgb by alpha
+DllExport void premultiply(const Color* const c, Color* const out, size_t count);
+
+// divides rgb by alpha, fully transparent colors go to 0
+DllExport void unpremultiply(const Color* const c, Color* const out, size_t count);
+
+// blends each premultiplied src color onto the matching dst color
+DllExport void blend(const Color* const src, const Color* const dst, Color* const out, size_t count, BlendMode mode = BlendMode::Over);
+
+}
+
+} }
+
+#endif
@@ -0,0 +1,134 @@
+#include "pch.h"
+#include "Fixed.h"
+
+namespace energonsoftware {
+namespace math {
+
+const Fixed Fixed::Zero;
+const Fixed Fixed::One(1);
+const Fixed Fixed::Max(Fixed::from_raw(INT64_MAX));
+const Fixed Fixed::Min(Fixed::from_raw(INT64_MIN));
+const Fixed Fixed::Epsilon(Fixed::from_raw(1));
+
+namespace {
+
+// just enough unsigned 128-bit arithmetic for sqrt() and hypot()
+// (written out rather than using __int128 so that it's the same everywhere)
+struct UInt128
+{
+    uint64_t hi;
+    uint64_t lo;
+
+    static UInt128 square(uint64_t a)
+    {
+        const uint64_t lo = a & 0xffffffff, hi = a >> 32;
+        const uint64_t lo_lo = lo * lo, hi_lo = hi * lo, hi_hi = hi * hi;
+
+        // the two cross terms are the same
+        const uint64_t middle = (lo_lo >> 32) + (hi_lo & 0xffffffff) * 2;
+        return { hi_hi + (hi_lo >> 32) * 2 + (middle >> 32), (middle << 32) | (lo_lo & 0xffffffff) };
+    }
+
+    bool operator<(const UInt128& rhs) const { return hi == rhs.hi ? lo < rhs.lo : hi < rhs.hi; }
+    bool operator>=(const UInt128& rhs) const { return !(*this < rhs); }
+    bool is_zero() const { return 0 == hi && 0 == lo; }
+
+    UInt128 operator+(const UInt128& rhs) const
+    {
+        const uint64_t l = lo + rhs.lo;
+        return { hi + rhs.hi + (l < lo ? 1 : 0), l };
+    }
+
+    UInt128 operator-(const UInt128& rhs) const
+    {
+        return { hi - rhs.hi - (lo < rhs.lo ? 1 : 0), lo - rhs.lo };
+    }
+
+    // NOTE: shift must be in (0, 64)
+    UInt128 operator>>(int shift) const { return { hi >> shift, (lo >> shift) | (hi << (64 - shift)) }; }
+};
+
+// floor(sqrt(n)), one result bit per iteration
+uint64_t isqrt(UInt128 n)
+{
+    // the highest power of 4 <= n
+    UInt128 bit = { static_cast<uint64_t>(1) << 62, 0 };
+    while(n < bit) {
+        bit = bit >> 2;
+    }
+
+    UInt128 r = { 0, 0 };
+    while(!bit.is_zero()) {
+        const UInt128 t = r + bit;
+        if(n >= t) {
+            n = n - t;
+            r = (r >> 1) + bit;
+        } else {
+            r = r >> 1;
+        }
+        bit = bit >> 2;
+    }
+    return r.lo;
+}
+
+uint64_t magnitude(int64_t v)
+{
+    return v < 0 ? 0 - static_cast<uint64_t>(v) : static_cast<uint64_t>(v);
+}
+
+Fixed from_magnitude(uint64_t r, bool negative)
+{
+    return Fixed::from_raw(static_cast<int64_t>(negative ? 0 - r : r));
+}
+
+}
+
+Fixed Fixed::operator/(const Fixed& rhs) const
+{
+    assert(0 != rhs._raw);
+
+    // (a << 32) / b, the integer part directly
+    // and then the fraction one bit at a time by long division
+    const bool negative = (_raw < 0) != (rhs._raw < 0);
+    const uint64_t a = magnitude(_raw), b = magnitude(rhs._raw);
+
+    uint64_t q = a / b;
+    uint64_t r = a % b;
+    for(int i = 0; i < FractionBits; ++i) {
+        // r < b <= 2^63 so this can't overflow
+        r <<= 1;
+        q <<= 1;
+        if(r >= b) {
+            r -= b;
+            q |= 1;
+        }
+    }
+    return from_magnitude(q, negative);
+}
+
+std::string Fixed::str() const
+{
+    std::stringstream ss;
+    ss.precision(10);
+    ss << "Fixed(" << std::fixed << to_double() << ")";
+    return ss.str();
+}
+
+Fixed sqrt(Fixed f)
+{
+    assert(f >= Fixed::Zero);
+
+    // sqrt(raw / 2^32) * 2^32 == sqrt(raw * 2^32)
+    const uint64_t raw = static_cast<uint64_t>(f.raw());
+    return Fixed::from_raw(static_cast<int64_t>(isqrt({ raw >> 32, raw << 32 })));
+}
+
+Fixed hypot(Fixed a, Fixed b, Fixed c, Fixed d)
+{
+    // sqrt(sum((raw / 2^32)^2)) * 2^32 == sqrt(sum(raw^2))
+    const UInt128 sum = UInt128::square(magnitude(a.raw())) + UInt128::square(magnitude(b.raw()))
+        + UInt128::square(magnitude(c.raw())) + UInt128::square(magnitude(d.raw()));
+    return Fixed::from_raw(static_cast<int64_t>(isqrt(sum)));
+}
+
+} }
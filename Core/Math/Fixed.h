@@ -0,0 +1,146 @@
+#if !defined __FIXED_H__
+#define __FIXED_H__
+
+#include "Util.h"
+
+namespace energonsoftware {
+namespace math {
+
+/*
+Signed 32.32 fixed-point number.
+
+The range is about +/-2.1 billion with a constant precision of 2^-32
+(about 2.3e-10) everywhere in that range, which is what large worlds want
+from positions, and every operation is exact integer arithmetic so the
+results are bit-identical on every compiler and CPU (lockstep simulation).
+
+Multiplication and division round towards zero, results that
+don't fit the range wrap. Everything that squares (see hypot()) uses
+128-bit intermediates so lengths don't overflow before their result would.
+*/
+class DllExport Fixed
+{
+public:
+    static const int FractionBits = 32;
+    static const int64_t RawOne = static_cast<int64_t>(1) << FractionBits;
+
+    static const Fixed Zero;
+    static const Fixed One;
+    static const Fixed Max;
+    static const Fixed Min;
+
+    // the smallest step (2^-32)
+    static const Fixed Epsilon;
+
+public:
+    static constexpr Fixed from_raw(int64_t raw) { return Fixed(raw, Raw()); }
+
+public:
+    constexpr Fixed()
+        : _raw(0)
+    {
+    }
+
+    constexpr Fixed(int32_t i)
+        : _raw(static_cast<int64_t>(i) * RawOne)
+    {
+    }
+
+    // rounds to the nearest representable value
+    explicit Fixed(double d)
+        : _raw(std::llround(d * static_cast<double>(RawOne)))
+    {
+    }
+
+    DEFAULT_COPY_AND_ASSIGN(Fixed);
+
+    Fixed(Fixed&& f) = default;
+
+    ~Fixed() = default;
+
+public:
+    constexpr int64_t raw() const { return _raw; }
+
+    double to_double() const { return static_cast<double>(_raw) * (1.0 / static_cast<double>(RawOne)); }
+    float to_float() const { return static_cast<float>(to_double()); }
+
+    // the integer part, rounded towards negative infinity
+    constexpr int32_t floor() const { return static_cast<int32_t>(_raw >> FractionBits); }
+
+    // the fractional part (always >= 0)
+    constexpr Fixed fraction() const { return from_raw(_raw & (RawOne - 1)); }
+
+    std::string str() const;
+
+public:
+    constexpr bool operator==(const Fixed& rhs) const { return _raw == rhs._raw; }
+    constexpr bool operator!=(const Fixed& rhs) const { return _raw != rhs._raw; }
+    constexpr bool operator<(const Fixed& rhs) const { return _raw < rhs._raw; }
+    constexpr bool operator<=(const Fixed& rhs) const { return _raw <= rhs._raw; }
+    constexpr bool operator>(const Fixed& rhs) const { return _raw > rhs._raw; }
+    constexpr bool operator>=(const Fixed& rhs) const { return _raw >= rhs._raw; }
+
+    // NOTE: these go through uint64_t because signed overflow is undefined
+    constexpr Fixed operator+(const Fixed& rhs) const { return from_raw(static_cast<int64_t>(static_cast<uint64_t>(_raw) + static_cast<uint64_t>(rhs._raw))); }
+    constexpr Fixed operator-(const Fixed& rhs) const { return from_raw(static_cast<int64_t>(static_cast<uint64_t>(_raw) - static_cast<uint64_t>(rhs._raw))); }
+    constexpr Fixed operator-() const { return from_raw(static_cast<int64_t>(0 - static_cast<uint64_t>(_raw))); }
+
+    Fixed operator*(const Fixed& rhs) const
+    {
+        // 64x64 -> 128-bit product of the magnitudes from 32-bit halves,
+        // keeping the middle 64 bits
+        const bool negative = (_raw < 0) != (rhs._raw < 0);
+        const uint64_t a = magnitude(_raw), b = magnitude(rhs._raw);
+
+        const uint64_t a_lo = a & 0xffffffff, a_hi = a >> 32;
+        const uint64_t b_lo = b & 0xffffffff, b_hi = b >> 32;
+
+        const uint64_t lo_lo = a_lo * b_lo;
+        const uint64_t hi_lo = a_hi * b_lo;
+        const uint64_t lo_hi = a_lo * b_hi;
+        const uint64_t hi_hi = a_hi * b_hi;
+
+        const uint64_t middle = (lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi;
+        const uint64_t r = ((hi_hi + (hi_lo >> 32) + (middle >> 32)) << 32) | (middle & 0xffffffff);
+        return from_raw(static_cast<int64_t>(negative ? 0 - r : r));
+    }
+
+    // NOTE: rhs must not be 0
+    Fixed operator/(const Fixed& rhs) const;
+
+    Fixed& operator+=(const Fixed& rhs) { return *this = *this + rhs; }
+    Fixed& operator-=(const Fixed& rhs) { return *this = *this - rhs; }
+    Fixed& operator*=(const Fixed& rhs) { return *this = *this * rhs; }
+    Fixed& operator/=(const Fixed& rhs) { return *this = *this / rhs; }
+
+private:
+    struct Raw {};
+
+    constexpr Fixed(int64_t raw, Raw)
+        : _raw(raw)
+    {
+    }
+
+    // |v| as unsigned, which works for INT64_MIN as well
+    static constexpr uint64_t magnitude(int64_t v) { return v < 0 ? 0 - static_cast<uint64_t>(v) : static_cast<uint64_t>(v); }
+
+private:
+    int64_t _raw;
+};
+
+static_assert(sizeof(Fixed) == 8, "Fixed must be exactly 64 bits");
+static_assert(std::is_trivially_copyable<Fixed>::value, "Fixed must be trivially copyable");
+
+inline Fixed abs(Fixed f) { return f < Fixed::Zero ? -f : f; }
+
+// rounded down
+// NOTE: f must not be negative
+DllExport Fixed sqrt(Fixed f);
+
+// sqrt(a^2 + b^2 + c^2 + d^2), rounded down,
+// which only overflows if the result does
+DllExport Fixed hypot(Fixed a, Fixed b, Fixed c = Fixed(), Fixed d = Fixed());
+
+} }
+
+#endif
@@ -0,0 +1,161 @@
+#include "pch.h"
+#include <algorithm>
+#include <cfloat>
+#include "Core/Memory/Arena.h"
+#include "SIMD/Kernels.h"
+#include "Frustum.h"
+
+namespace energonsoftware {
+namespace math {
+
+// NOTE: Plane is guaranteed to be exactly 4 packed floats
+// so the planes can be handed straight to the kernels
+
+Frustum Frustum::from_matrix(const Matrix4& view_projection)
+{
+    // Gribb & Hartmann, a clip space point is inside
+    // if -w <= x, y, z <= w so each plane is the last row plus or minus another one
+    const Vector r0 = view_projection.row(0), r1 = view_projection.row(1);
+    const Vector r2 = view_projection.row(2), r3 = view_projection.row(3);
+
+    Frustum frustum;
+    frustum._planes[LeftPlane] = Plane(r3 + r0).normalize();
+    frustum._planes[RightPlane] = Plane(r3 - r0).normalize();
+    frustum._planes[BottomPlane] = Plane(r3 + r1).normalize();
+    frustum._planes[TopPlane] = Plane(r3 - r1).normalize();
+    frustum._planes[NearPlane] = Plane(r3 + r2).normalize();
+    frustum._planes[FarPlane] = Plane(r3 - r2).normalize();
+    return frustum;
+}
+
+Frustum::Frustum(const Plane* const planes)
+{
+    std::copy(planes, planes + PlaneCount, _planes);
+}
+
+bool Frustum::contains(const Point3& point) const
+{
+    for(const Plane& plane : _planes) {
+        if(!plane.in_front(point)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Frustum::intersects(const Point3& center, float radius) const
+{
+    for(const Plane& plane : _planes) {
+        if(plane.distance(center) < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Frustum::intersects(const AABB& box) const
+{
+    if(box.is_empty()) {
+        return false;
+    }
+
+    // the box is outside of a plane if its center is further
+    // behind it than the box's extent along the normal
+    const Point3 center = box.center();
+    const Vector half_extents = box.half_extents();
+    for(const Plane& plane : _planes) {
+        const Vector n = plane.normal();
+        const float radius = std::fabs(n.x()) * half_extents.x() + std::fabs(n.y()) * half_extents.y() + std::fabs(n.z()) * half_extents.z();
+        if(plane.distance(center) < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t Frustum::cull_spheres(const VectorStream& spheres, uint32_t* const visible) const
+{
+    return kernels().cull.spheres(spheres.ref(), reinterpret_cast<const float*>(_planes), PlaneCount, visible, spheres.size());
+}
+
+size_t Frustum::cull_boxes(const VectorStream& centers, const VectorStream& half_extents, uint32_t* const visible) const
+{
+    assert(centers.size() == half_extents.size());
+    return kernels().cull.boxes(centers.ref(), half_extents.ref(), reinterpret_cast<const float*>(_planes), PlaneCount, visible, centers.size());
+}
+
+size_t Frustum::cull_spheres(const Vector* const spheres, size_t count, uint32_t* const visible) const
+{
+    memory::Arena& scratch = memory::scratch_arena();
+
+    size_t n = 0;
+    for(size_t begin = 0; begin < count; begin += ScratchChunkSize) {
+        memory::ArenaScope scope(scratch);
+
+        const size_t chunk = std::min(ScratchChunkSize, count - begin);
+        const StreamRef stream = load_stream(spheres + begin, chunk, scratch);
+        n += offset_indices(visible + n, kernels().cull.spheres(stream, reinterpret_cast<const float*>(_planes), PlaneCount, visible + n, chunk), begin);
+    }
+    return n;
+}
+
+size_t Frustum::cull_boxes(const AABB* const boxes, size_t count, uint32_t* const visible) const
+{
+    memory::Arena& scratch = memory::scratch_arena();
+
+    size_t n = 0;
+    for(size_t begin = 0; begin < count; begin += ScratchChunkSize) {
+        memory::ArenaScope scope(scratch);
+
+        const size_t chunk = std::min(ScratchChunkSize, count - begin);
+        const size_t capacity = (chunk + 15) & ~static_cast<size_t>(15);
+        float* const data = scratch.allocate_array<float>(capacity * 6);
+        const StreamRef centers = { data, data + capacity, data + capacity * 2, nullptr };
+        const StreamRef half_extents = { data + capacity * 3, data + capacity * 4, data + capacity * 5, nullptr };
+
+        for(size_t i = 0; i < chunk; ++i) {
+            const AABB& box = boxes[begin + i];
+            if(box.is_empty()) {
+                // behind every plane, -infinity would give 0 * -infinity
+                // for normals with a zero component
+                centers.x[i] = centers.y[i] = centers.z[i] = 0.0f;
+                half_extents.x[i] = half_extents.y[i] = half_extents.z[i] = -FLT_MAX;
+                continue;
+            }
+
+            const Point3 center = box.center();
+            const Vector half_extent = box.half_extents();
+            centers.x[i] = center.x();
+            centers.y[i] = center.y();
+            centers.z[i] = center.z();
+            half_extents.x[i] = half_extent.x();
+            half_extents.y[i] = half_extent.y();
+            half_extents.z[i] = half_extent.z();
+        }
+
+        n += offset_indices(visible + n, kernels().cull.boxes(centers, half_extents, reinterpret_cast<const float*>(_planes), PlaneCount, visible + n, chunk), begin);
+    }
+    return n;
+}
+
+size_t Frustum::offset_indices(uint32_t* const visible, size_t count, size_t offset)
+{
+    for(size_t i = 0; i < count; ++i) {
+        visible[i] += static_cast<uint32_t>(offset);
+    }
+    return count;
+}
+
+std::string Frustum::str() const
+{
+    std::stringstream ss;
+    ss << "Frustum(left:" << _planes[LeftPlane].str()
+        << ", right:" << _planes[RightPlane].str()
+        << ", bottom:" << _planes[BottomPlane].str()
+        << ", top:" << _planes[TopPlane].str()
+        << ", near:" << _planes[NearPlane].str()
+        << ", far:" << _planes[FarPlane].str() << ")";
+    return ss.str();
+}
+
+} }
@@ -0,0 +1,100 @@
+#if !defined __FRUSTUM_H__
+#define __FRUSTUM_H__
+
+#include "AABB.h"
+#include "Matrix4.h"
+#include "Plane.h"
+#include "VectorStream.h"
+
+namespace energonsoftware {
+namespace math {
+
+/*
+View frustum as 6 normalized Planes facing inwards,
+so a point is inside if it's in front of every plane.
+
+The sphere and box tests are conservative: anything that
+intersects the frustum passes, but so can something outside of it
+that's in front of every plane (near an edge or corner). That's the
+usual trade-off for culling, it never drops anything visible.
+
+The bulk culling runs the best kernels for the current CPU
+(see SIMD/Kernels.h) over structure-of-arrays input and writes
+the indices of what passed, in order, with no gaps.
+*/
+class DllExport Frustum
+{
+public:
+    enum PlaneIndex
+    {
+        LeftPlane,
+        RightPlane,
+        BottomPlane,
+        TopPlane,
+        NearPlane,
+        FarPlane,
+
+        PlaneCount
+    };
+
+public:
+    // the frustum of a view-projection matrix (projection * view)
+    // that maps the view volume to a [-1, 1] clip cube (see Matrix4::perspective())
+    // in the space the matrix transforms from (world space for projection * view)
+    static Frustum from_matrix(const Matrix4& view_projection);
+
+public:
+    // every plane is the default Plane
+    Frustum() = default;
+
+    // NOTE: planes must have PlaneCount normalized planes in PlaneIndex order
+    explicit Frustum(const Plane* const planes);
+
+    DEFAULT_COPY_AND_ASSIGN(Frustum);
+
+    Frustum(Frustum&& frustum) = default;
+
+    ~Frustum() = default;
+
+public:
+    const Plane& plane(PlaneIndex index) const { return _planes[index]; }
+
+    // all PlaneCount of them in PlaneIndex order
+    const Plane* planes() const { return _planes; }
+
+    bool contains(const Point3& point) const;
+
+    bool intersects(const Point3& center, float radius) const;
+
+    // the empty box never intersects
+    bool intersects(const AABB& box) const;
+
+public:
+    // each sphere is (center, radius), writes the index of every sphere
+    // that passes to visible (which needs room for spheres.size()) in order
+    // and returns the number written
+    size_t cull_spheres(const VectorStream& spheres, uint32_t* const visible) const;
+
+    // boxes are given as centers and half extents (see AABB::center() and AABB::half_extents())
+    // in two streams of the same size, otherwise the same as cull_spheres()
+    size_t cull_boxes(const VectorStream& centers, const VectorStream& half_extents, uint32_t* const visible) const;
+
+    // the same over packed arrays, converted to structure-of-arrays a chunk at a time
+    // in memory::scratch_arena() so nothing is allocated once it has grown
+    // the empty box never passes
+    size_t cull_spheres(const Vector* const spheres, size_t count, uint32_t* const visible) const;
+    size_t cull_boxes(const AABB* const boxes, size_t count, uint32_t* const visible) const;
+
+    std::string str() const;
+
+private:
+    // adds offset to the count indices in visible, returns count
+    static size_t offset_indices(uint32_t* const visible, size_t count, size_t offset);
+
+private:
+    Plane _planes[PlaneCount];
+};
+
+} }
+
+#endif
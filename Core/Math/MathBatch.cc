@@ -0,0 +1,49 @@
+#include "pch.h"
+#include "SIMD/Kernels.h"
+#include "MathBatch.h"
+
+namespace energonsoftware {
+namespace math {
+namespace batch {
+
+void sin(const float* const x, float* const out, size_t count)
+{
+    kernels().floats.sin(x, out, count);
+}
+
+void cos(const float* const x, float* const out, size_t count)
+{
+    kernels().floats.cos(x, out, count);
+}
+
+void sincos(const float* const x, float* const sin_out, float* const cos_out, size_t count)
+{
+    kernels().floats.sincos(x, sin_out, cos_out, count);
+}
+
+void atan(const float* const x, float* const out, size_t count)
+{
+    kernels().floats.atan(x, out, count);
+}
+
+void atan2(const float* const y, const float* const x, float* const out, size_t count)
+{
+    kernels().floats.atan2(y, x, out, count);
+}
+
+void acos(const float* const x, float* const out, size_t count)
+{
+    kernels().floats.acos(x, out, count);
+}
+
+void exp(const float* const x, float* const out, size_t count)
+{
+    kernels().floats.exp(x, out, count);
+}
+
+void log(const float* const x, float* const out, size_t count)
+{
+    kernels().floats.log(x, out, count);
+}
+
+} } }
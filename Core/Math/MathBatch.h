@@ -0,0 +1,59 @@
+#if !defined __MATHBATCH_H__
+#define __MATHBATCH_H__
+
+namespace energonsoftware {
+namespace math {
+
+/*
+Batch elementary functions over float arrays.
+
+These run the best kernels for the current CPU (see SIMD/Kernels.h).
+Output arrays must have room for count floats and may alias the inputs.
+
+The polynomials are the Cephes single precision ones. The error bounds are the
+largest error against the exact result in units in the last place
+(ulps), measured over every float in the given range without fused multiply-add
+(the scalar and SSE tiers) and with it (AVX2 and AVX-512), which round a little
+differently but stay within the same bounds:
+
+    sin, cos, sincos    4 ulps for |x| <= 51471 (the worst is 3.6, cos next to
+                        one of its zeros), beyond that the error grows with |x|
+                        since there's no Payne-Hanek reduction,
+                        infinities and NaNs are NaN
+    atan                2.5 ulps
+    atan2               3 ulps (2.5 over 16 million random pairs,
+                        there are too many pairs to test them all)
+    acos                1.5 ulps over [-1, 1], NaN outside of it
+    exp                 1.5 ulps (the worst is 1.01), overflows to infinity
+                        above 88.72 and is denormal below -87.34 (down to 0
+                        at -103.97), NaNs are undefined
+    log                 1 ulp, denormals included, log(0) is -infinity
+                        and negative numbers and NaNs are NaN
+
+The C library functions are correctly rounded or close to it,
+these trade a couple of ulps for 4-16 floats at a time.
+*/
+namespace batch {
+
+DllExport void sin(const float* const x, float* const out, size_t count);
+DllExport void cos(const float* const x, float* const out, size_t count);
+
+// sin and cos of each element for the price of one of them
+DllExport void sincos(const float* const x, float* const sin_out, float* const cos_out, size_t count);
+
+DllExport void atan(const float* const x, float* const out, size_t count);
+
+// the angle of each (x, y) in [-pi, pi], signed zeros are handled like std::atan2()
+// NOTE: pairs where both x and y are infinite are undefined
+DllExport void atan2(const float* const y, const float* const x, float* const out, size_t count);
+
+DllExport void acos(const float* const x, float* const out, size_t count);
+
+DllExport void exp(const float* const x, float* const out, size_t count);
+DllExport void log(const float* const x, float* const out, size_t count);
+
+}
+
+} }
+
+#endif
@@ -0,0 +1,206 @@
+#include "pch.h"
+#include "Matrix4.h"
+
+namespace energonsoftware {
+namespace math {
+
+const Matrix4 Matrix4::Identity;
+const Matrix4 Matrix4::Zero(Vector::Zero, Vector::Zero, Vector::Zero, Vector::Zero);
+
+Matrix4 Matrix4::translation(const Vector& t)
+{
+    Matrix4 m;
+    m.set_column(3, t.homogeneous_position());
+    return m;
+}
+
+Matrix4 Matrix4::scale(const Vector& s)
+{
+    Matrix4 m;
+    m(0, 0) = s.x();
+    m(1, 1) = s.y();
+    m(2, 2) = s.z();
+    return m;
+}
+
+Matrix4 Matrix4::rotation(const Vector& axis, float angle)
+{
+    const Vector a = axis.xyz().normalized(Precision::Exact);
+    const float c = std::cos(angle), s = std::sin(angle), t = 1.0f - c;
+
+    return Matrix4(
+        Vector(t * a.x() * a.x() + c, t * a.x() * a.y() + s * a.z(), t * a.x() * a.z() - s * a.y(), 0.0f),
+        Vector(t * a.x() * a.y() - s * a.z(), t * a.y() * a.y() + c, t * a.y() * a.z() + s * a.x(), 0.0f),
+        Vector(t * a.x() * a.z() + s * a.y(), t * a.y() * a.z() - s * a.x(), t * a.z() * a.z() + c, 0.0f),
+        Vector::WAxis
+    );
+}
+
+Matrix4 Matrix4::look_at(const Vector& eye, const Vector& center, const Vector& up)
+{
+    const Vector f = (center - eye).xyz().normalized(Precision::Exact);
+    const Vector s = (f ^ up.xyz()).normalized(Precision::Exact);
+    const Vector u = s ^ f;
+    const Vector e = eye.xyz();
+
+    // rows are the camera basis (s, u, -f) and the translation moves eye to the origin
+    return Matrix4(
+        Vector(s.x(), u.x(), -f.x(), 0.0f),
+        Vector(s.y(), u.y(), -f.y(), 0.0f),
+        Vector(s.z(), u.z(), -f.z(), 0.0f),
+        Vector(-(s * e), -(u * e), f * e, 1.0f)
+    );
+}
+
+Matrix4 Matrix4::perspective(float fovy, float aspect, float znear, float zfar)
+{
+    const float f = 1.0f / std::tan(fovy * 0.5f);
+    const float depth = znear - zfar;
+
+    return Matrix4(
+        Vector(f / aspect, 0.0f, 0.0f, 0.0f),
+        Vector(0.0f, f, 0.0f, 0.0f),
+        Vector(0.0f, 0.0f, (zfar + znear) / depth, -1.0f),
+        Vector(0.0f, 0.0f, 2.0f * zfar * znear / depth, 0.0f)
+    );
+}
+
+Matrix4 Matrix4::orthographic(float left, float right, float bottom, float top, float znear, float zfar)
+{
+    const float width = right - left;
+    const float height = top - bottom;
+    const float depth = zfar - znear;
+
+    return Matrix4(
+        Vector(2.0f / width, 0.0f, 0.0f, 0.0f),
+        Vector(0.0f, 2.0f / height, 0.0f, 0.0f),
+        Vector(0.0f, 0.0f, -2.0f / depth, 0.0f),
+        Vector(-(right + left) / width, -(top + bottom) / height, -(zfar + znear) / depth, 1.0f)
+    );
+}
+
+namespace {
+
+// the 2x2 sub-determinants of the top and bottom pairs of columns
+// that both determinant() and inverse() are built from
+// see https://www.geometrictools.com/Documentation/LaplaceExpansionTheorem.pdf
+struct Minors
+{
+    float s[6];
+    float c[6];
+
+    explicit Minors(const float* const m)
+    {
+        // a[i][j] = m[i * 4 + j], which is the transpose of the matrix,
+        // but det(A) == det(A^T) and inverse(A^T) == inverse(A)^T
+        // so indexing the result the same way gives the right answer
+        s[0] = m[0] * m[5] - m[4] * m[1];
+        s[1] = m[0] * m[6] - m[4] * m[2];
+        s[2] = m[0] * m[7] - m[4] * m[3];
+        s[3] = m[1] * m[6] - m[5] * m[2];
+        s[4] = m[1] * m[7] - m[5] * m[3];
+        s[5] = m[2] * m[7] - m[6] * m[3];
+
+        c[5] = m[10] * m[15] - m[14] * m[11];
+        c[4] = m[9] * m[15] - m[13] * m[11];
+        c[3] = m[9] * m[14] - m[13] * m[10];
+        c[2] = m[8] * m[15] - m[12] * m[11];
+        c[1] = m[8] * m[14] - m[12] * m[10];
+        c[0] = m[8] * m[13] - m[12] * m[9];
+    }
+
+    float determinant() const
+    {
+        return s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] + s[5] * c[0];
+    }
+};
+
+}
+
+float Matrix4::determinant() const
+{
+    return Minors(_value).determinant();
+}
+
+Matrix4 Matrix4::inverse() const
+{
+    const float* const a = _value;
+    const Minors minors(a);
+    const float* const s = minors.s;
+    const float* const c = minors.c;
+
+    // adjugate
+    ALIGN(16) float r[16] = {
+         a[5] * c[5] - a[6] * c[4] + a[7] * c[3],
+        -a[1] * c[5] + a[2] * c[4] - a[3] * c[3],
+         a[13] * s[5] - a[14] * s[4] + a[15] * s[3],
+        -a[9] * s[5] + a[10] * s[4] - a[11] * s[3],
+
+        -a[4] * c[5] + a[6] * c[2] - a[7] * c[1],
+         a[0] * c[5] - a[2] * c[2] + a[3] * c[1],
+        -a[12] * s[5] + a[14] * s[2] - a[15] * s[1],
+         a[8] * s[5] - a[10] * s[2] + a[11] * s[1],
+
+         a[4] * c[4] - a[5] * c[2] + a[7] * c[0],
+        -a[0] * c[4] + a[1] * c[2] - a[3] * c[0],
+         a[12] * s[4] - a[13] * s[2] + a[15] * s[0],
+        -a[8] * s[4] + a[9] * s[2] - a[11] * s[0],
+
+        -a[4] * c[3] + a[5] * c[1] - a[6] * c[0],
+         a[0] * c[3] - a[1] * c[1] + a[2] * c[0],
+        -a[12] * s[3] + a[13] * s[1] - a[14] * s[0],
+         a[8] * s[3] - a[9] * s[1] + a[10] * s[0]
+    };
+
+    const float invdet = 1.0f / minors.determinant();
+#if defined USE_SSE
+    const __m128 S = _mm_set1_ps(invdet);
+    for(int i = 0; i < 16; i += 4) {
+        _mm_store_ps(r + i, _mm_mul_ps(_mm_load_ps(r + i), S));
+    }
+#else
+    for(float& v : r) {
+        v *= invdet;
+    }
+#endif
+    return Matrix4(r);
+}
+
+Matrix4 Matrix4::affine_inverse() const
+{
+    assert(is_affine());
+
+    // the rows of the inverse of the upper 3x3 are
+    // the cross-products of its columns over the determinant
+    const Vector c0 = column(0).xyz();
+    const Vector c1 = column(1).xyz();
+    const Vector c2 = column(2).xyz();
+
+    Vector r0 = c1 ^ c2;
+    const float invdet = 1.0f / (c0 * r0);
+    r0 *= invdet;
+    const Vector r1 = (c2 ^ c0) * invdet;
+    const Vector r2 = (c0 ^ c1) * invdet;
+
+    // the inverse translation is the original translation run backwards through the inverse rotation
+    const Vector t = translation();
+    return Matrix4(
+        Vector(r0.x(), r1.x(), r2.x(), 0.0f),
+        Vector(r0.y(), r1.y(), r2.y(), 0.0f),
+        Vector(r0.z(), r1.z(), r2.z(), 0.0f),
+        Vector(-(r0 * t), -(r1 * t), -(r2 * t), 1.0f)
+    );
+}
+
+std::string Matrix4::str() const
+{
+    std::stringstream ss;
+    ss << "Matrix4(" << std::fixed;
+    for(int row = 0; row < 4; ++row) {
+        ss << (0 == row ? "" : ", ") << "[" << (*this)(row, 0) << ", " << (*this)(row, 1) << ", " << (*this)(row, 2) << ", " << (*this)(row, 3) << "]";
+    }
+    ss << ")";
+    return ss.str();
+}
+
+} }
@@ -0,0 +1,205 @@
+#if !defined __MATRIX4_H__
+#define __MATRIX4_H__
+
+#include "Vector.h"
+
+namespace energonsoftware {
+namespace math {
+
+/*
+4x4 float matrix stored column-major (OpenGL style),
+so element (row, col) is at array()[col * 4 + row]
+and each column is laid out exactly like a Vector.
+
+Matrices multiply column Vectors on the right (M * v)
+so M1 * M2 applies M2 first.
+
+Like Vector this is non-virtual and trivially copyable
+so arrays of them can be memcpy'd or handed to graphics APIs.
+*/
+class DllExport Matrix4
+{
+public:
+    static const Matrix4 Identity;
+    static const Matrix4 Zero;
+
+public:
+    static Matrix4 translation(const Vector& t);
+    static Matrix4 scale(const Vector& s);
+    static Matrix4 scale(float s) { return scale(Vector(s, s, s)); }
+
+    // rotation of angle radians counter-clockwise around axis
+    static Matrix4 rotation(const Vector& axis, float angle);
+
+    // right-handed view matrix looking from eye towards center
+    static Matrix4 look_at(const Vector& eye, const Vector& center, const Vector& up);
+
+    // right-handed projections that map the view volume to a [-1, 1] clip cube
+    // fovy is the vertical field of view in radians
+    static Matrix4 perspective(float fovy, float aspect, float znear, float zfar);
+    static Matrix4 orthographic(float left, float right, float bottom, float top, float znear, float zfar);
+
+public:
+    // identity
+    Matrix4()
+        : _value{ 1.0f, 0.0f, 0.0f, 0.0f,
+                  0.0f, 1.0f, 0.0f, 0.0f,
+                  0.0f, 0.0f, 1.0f, 0.0f,
+                  0.0f, 0.0f, 0.0f, 1.0f }
+    {
+    }
+
+    // NOTE: m must have 16 floats in column-major order
+    explicit Matrix4(const float* const m)
+    {
+        std::memcpy(_value, m, sizeof(_value));
+    }
+
+    Matrix4(const Vector& c0, const Vector& c1, const Vector& c2, const Vector& c3)
+    {
+        set_column(0, c0);
+        set_column(1, c1);
+        set_column(2, c2);
+        set_column(3, c3);
+    }
+
+    DEFAULT_COPY_AND_ASSIGN(Matrix4);
+
+    Matrix4(Matrix4&& m) = default;
+
+    ~Matrix4() = default;
+
+public:
+    const float* array() const { return _value; }
+
+    float& operator()(int row, int col) { return _value[col * 4 + row]; }
+    float operator()(int row, int col) const { return _value[col * 4 + row]; }
+
+    Vector column(int col) const { return Vector(_value + col * 4); }
+    void set_column(int col, const Vector& v) { std::memcpy(_value + col * 4, v.array(), 4 * sizeof(float)); }
+
+    Vector row(int row) const { return Vector(_value[row], _value[4 + row], _value[8 + row], _value[12 + row]); }
+
+    Vector translation() const { return column(3).xyz(); }
+
+    bool is_affine() const { return 0.0f == _value[3] && 0.0f == _value[7] && 0.0f == _value[11] && 1.0f == _value[15]; }
+
+    Matrix4 transposed() const
+    {
+#if defined USE_SSE
+        Matrix4 m;
+        __m128 C0 = _mm_load_ps(_value);
+        __m128 C1 = _mm_load_ps(_value + 4);
+        __m128 C2 = _mm_load_ps(_value + 8);
+        __m128 C3 = _mm_load_ps(_value + 12);
+        _MM_TRANSPOSE4_PS(C0, C1, C2, C3);
+        _mm_store_ps(m._value, C0);
+        _mm_store_ps(m._value + 4, C1);
+        _mm_store_ps(m._value + 8, C2);
+        _mm_store_ps(m._value + 12, C3);
+        return m;
+#else
+        return Matrix4(row(0), row(1), row(2), row(3));
+#endif
+    }
+
+    float determinant() const;
+
+    // general inverse (cofactor expansion through 2x2 sub-determinants)
+    // NOTE: the result of inverting a singular matrix is undefined,
+    // use determinant() first if that is possible
+    Matrix4 inverse() const;
+
+    // fast inverse for affine transforms (is_affine() must be true)
+    // that only inverts the upper 3x3 and the translation
+    Matrix4 affine_inverse() const;
+
+    // M * (v.x, v.y, v.z, 1)
+    Vector transform_point(const Vector& v) const { return *this * v.homogeneous_position(); }
+
+    // M * (v.x, v.y, v.z, 0), translation is ignored
+    Vector transform_direction(const Vector& v) const { return *this * v.homogeneous_direction(); }
+
+    std::string str() const;
+
+public:
+    bool operator==(const Matrix4& rhs) const { return 0 == std::memcmp(_value, rhs._value, sizeof(_value)); }
+    bool operator!=(const Matrix4& rhs) const { return !(*this == rhs); }
+
+    Matrix4 operator*(const Matrix4& rhs) const
+    {
+        Matrix4 m;
+        multiply(_value, rhs._value, m._value);
+        return m;
+    }
+
+    Matrix4& operator*=(const Matrix4& rhs) { return *this = *this * rhs; }
+
+    Vector operator*(const Vector& rhs) const
+    {
+#if defined USE_SSE
+        __m128 V = rhs.simd();
+        __m128 R = _mm_mul_ps(_mm_load_ps(_value), _mm_shuffle_ps(V, V, _MM_SHUFFLE(0, 0, 0, 0)));
+        R = _mm_add_ps(R, _mm_mul_ps(_mm_load_ps(_value + 4), _mm_shuffle_ps(V, V, _MM_SHUFFLE(1, 1, 1, 1))));
+        R = _mm_add_ps(R, _mm_mul_ps(_mm_load_ps(_value + 8), _mm_shuffle_ps(V, V, _MM_SHUFFLE(2, 2, 2, 2))));
+        R = _mm_add_ps(R, _mm_mul_ps(_mm_load_ps(_value + 12), _mm_shuffle_ps(V, V, _MM_SHUFFLE(3, 3, 3, 3))));
+        return Vector(R);
+#else
+        return column(0) * rhs.x() + column(1) * rhs.y() + column(2) * rhs.z() + column(3) * rhs.w();
+#endif
+    }
+
+private:
+    // r = a * b, r must not alias a or b
+    static void multiply(const float* const a, const float* const b, float* const r)
+    {
+#if defined __AVX__
+        // two result columns per iteration, each lane of B holds one column of b
+        // and each lane of A holds the same column of a
+        __m256 A0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a));
+        __m256 A1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 4));
+        __m256 A2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 8));
+        __m256 A3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 12));
+        for(int i = 0; i < 16; i += 8) {
+            __m256 B = _mm256_loadu_ps(b + i);
+            __m256 R = _mm256_mul_ps(A0, _mm256_shuffle_ps(B, B, _MM_SHUFFLE(0, 0, 0, 0)));
+            R = _mm256_add_ps(R, _mm256_mul_ps(A1, _mm256_shuffle_ps(B, B, _MM_SHUFFLE(1, 1, 1, 1))));
+            R = _mm256_add_ps(R, _mm256_mul_ps(A2, _mm256_shuffle_ps(B, B, _MM_SHUFFLE(2, 2, 2, 2))));
+            R = _mm256_add_ps(R, _mm256_mul_ps(A3, _mm256_shuffle_ps(B, B, _MM_SHUFFLE(3, 3, 3, 3))));
+            _mm256_storeu_ps(r + i, R);
+        }
+#elif defined USE_SSE
+        // each column of the result is a linear combination of the columns of a
+        __m128 A0 = _mm_load_ps(a);
+        __m128 A1 = _mm_load_ps(a + 4);
+        __m128 A2 = _mm_load_ps(a + 8);
+        __m128 A3 = _mm_load_ps(a + 12);
+        for(int i = 0; i < 16; i += 4) {
+            __m128 B = _mm_load_ps(b + i);
+            __m128 R = _mm_mul_ps(A0, _mm_shuffle_ps(B, B, _MM_SHUFFLE(0, 0, 0, 0)));
+            R = _mm_add_ps(R, _mm_mul_ps(A1, _mm_shuffle_ps(B, B, _MM_SHUFFLE(1, 1, 1, 1))));
+            R = _mm_add_ps(R, _mm_mul_ps(A2, _mm_shuffle_ps(B, B, _MM_SHUFFLE(2, 2, 2, 2))));
+            R = _mm_add_ps(R, _mm_mul_ps(A3, _mm_shuffle_ps(B, B, _MM_SHUFFLE(3, 3, 3, 3))));
+            _mm_store_ps(r + i, R);
+        }
+#else
+        for(int col = 0; col < 4; ++col) {
+            for(int row = 0; row < 4; ++row) {
+                r[col * 4 + row] = a[row] * b[col * 4] + a[4 + row] * b[col * 4 + 1]
+                    + a[8 + row] * b[col * 4 + 2] + a[12 + row] * b[col * 4 + 3];
+            }
+        }
+#endif
+    }
+
+private:
+    ALIGN(16) float _value[16];
+};
+
+static_assert(sizeof(Matrix4) == 64, "Matrix4 must be exactly 16 floats");
+static_assert(alignof(Matrix4) == 16, "Matrix4 must be 16-byte aligned");
+static_assert(std::is_trivially_copyable<Matrix4>::value, "Matrix4 must be trivially copyable");
+
+} }
+
+#endif
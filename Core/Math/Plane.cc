@@ -0,0 +1,14 @@
+#include "pch.h"
+#include "Plane.h"
+
+namespace energonsoftware {
+namespace math {
+
+std::string Plane::str() const
+{
+    std::stringstream ss;
+    ss << "Plane(normal:" << normal().str() << ", d:" << d() << ")";
+    return ss.str();
+}
+
+} }
@@ -0,0 +1,98 @@
+#if !defined __PLANE_H__
+#define __PLANE_H__
+
+#include "Vector.h"
+
+namespace energonsoftware {
+namespace math {
+
+/*
+Plane as a Vector, the normal in x, y and z and d in w,
+so that the plane is every point p where normal * p + d = 0.
+
+The side the normal points towards is the front (or inside),
+where distance() is positive. Distances are only true distances
+if the normal is normalized, otherwise they're scaled by its length.
+
+Like Vector this is exactly 4 packed floats so arrays of Planes
+can be handed to anything that takes packed Vectors.
+*/
+class DllExport Plane
+{
+public:
+    // the plane through point facing along normal
+    static Plane from_point_normal(const Point3& point, const Vector& normal)
+    {
+        return Plane(normal, -(normal.xyz() * point.xyz()));
+    }
+
+    // the plane through 3 points, counter-clockwise is the front
+    // NOTE: the points must not be collinear
+    static Plane from_points(const Point3& a, const Point3& b, const Point3& c)
+    {
+        return from_point_normal(a, ((b - a) ^ (c - a)).normalized());
+    }
+
+public:
+    // the xz plane facing +y
+    Plane()
+        : _value(0.0f, 1.0f, 0.0f, 0.0f)
+    {
+    }
+
+    Plane(const Vector& normal, float d)
+        : _value(normal, d)
+    {
+    }
+
+    // v is (normal, d)
+    explicit Plane(const Vector& v)
+        : _value(v)
+    {
+    }
+
+    DEFAULT_COPY_AND_ASSIGN(Plane);
+
+    Plane(Plane&& plane) = default;
+
+    ~Plane() = default;
+
+public:
+    Vector normal() const { return _value.xyz(); }
+    float d() const { return _value.w(); }
+
+    // (normal, d)
+    const Vector& vector() const { return _value; }
+
+    // signed distance from the plane to point, positive in front
+    float distance(const Point3& point) const { return _value * point.homogeneous_position(); }
+
+    bool in_front(const Point3& point) const { return distance(point) >= 0.0f; }
+
+    // scales the plane so the normal is unit length
+    Plane& normalize() { _value /= normal().length(); return *this; }
+    Plane normalized() const { return Plane(*this).normalize(); }
+
+    // the same plane facing the other way
+    Plane flipped() const { return Plane(-_value); }
+
+    // the point on the plane nearest to point
+    // NOTE: the plane must be normalized
+    Point3 project(const Point3& point) const { return point - normal() * distance(point); }
+
+    std::string str() const;
+
+public:
+    bool operator==(const Plane& rhs) const { return _value == rhs._value; }
+    bool operator!=(const Plane& rhs) const { return !(*this == rhs); }
+
+private:
+    Vector _value;
+};
+
+static_assert(sizeof(Plane) == sizeof(Vector), "Plane must be exactly 1 Vector");
+static_assert(std::is_trivially_copyable<Plane>::value, "Plane must be trivially copyable");
+
+} }
+
+#endif
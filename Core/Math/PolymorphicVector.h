@@ -0,0 +1,41 @@
+#if !defined __POLYMORPHICVECTOR_H__
+#define __POLYMORPHICVECTOR_H__
+
+#include "Vector.h"
+
+namespace energonsoftware {
+namespace math {
+
+/*
+Opt-in polymorphic wrapper around Vector for code that needs
+to derive from it and delete through a base pointer
+(which is what the old virtual ~Vector() allowed).
+
+This carries a vtable pointer so it is twice the size of a Vector
+and should not be used for bulk storage.
+*/
+class DllExport PolymorphicVector : public Vector
+{
+public:
+    using Vector::Vector;
+
+    PolymorphicVector() = default;
+
+    PolymorphicVector(const Vector& v)
+        : Vector(v)
+    {
+    }
+
+    DEFAULT_COPY_AND_ASSIGN(PolymorphicVector);
+
+    PolymorphicVector(PolymorphicVector&& v) = default;
+    virtual ~PolymorphicVector() = default;
+
+public:
+    Vector& vector() { return *this; }
+    const Vector& vector() const { return *this; }
+};
+
+} }
+
+#endif
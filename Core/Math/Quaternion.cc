@@ -0,0 +1,87 @@
+#include "pch.h"
+#include "Quaternion.h"
+
+namespace energonsoftware {
+namespace math {
+
+const Quaternion Quaternion::Identity;
+
+Quaternion Quaternion::axis_angle(const Vector& axis, float angle)
+{
+    const float half = angle * 0.5f;
+    return Quaternion(axis.xyz().normalized(Precision::Exact) * std::sin(half), std::cos(half));
+}
+
+Quaternion Quaternion::from_matrix(const Matrix4& m)
+{
+    // Shepperd's method, picking the largest of w, x, y, z
+    // to divide by so that the result stays well-conditioned
+    const float trace = m(0, 0) + m(1, 1) + m(2, 2);
+    if(trace > 0.0f) {
+        const float s = 2.0f * std::sqrt(trace + 1.0f);
+        return Quaternion((m(2, 1) - m(1, 2)) / s, (m(0, 2) - m(2, 0)) / s, (m(1, 0) - m(0, 1)) / s, 0.25f * s);
+    }
+
+    if(m(0, 0) > m(1, 1) && m(0, 0) > m(2, 2)) {
+        const float s = 2.0f * std::sqrt(1.0f + m(0, 0) - m(1, 1) - m(2, 2));
+        return Quaternion(0.25f * s, (m(0, 1) + m(1, 0)) / s, (m(0, 2) + m(2, 0)) / s, (m(2, 1) - m(1, 2)) / s);
+    }
+
+    if(m(1, 1) > m(2, 2)) {
+        const float s = 2.0f * std::sqrt(1.0f + m(1, 1) - m(0, 0) - m(2, 2));
+        return Quaternion((m(0, 1) + m(1, 0)) / s, 0.25f * s, (m(1, 2) + m(2, 1)) / s, (m(0, 2) - m(2, 0)) / s);
+    }
+
+    const float s = 2.0f * std::sqrt(1.0f + m(2, 2) - m(0, 0) - m(1, 1));
+    return Quaternion((m(0, 2) + m(2, 0)) / s, (m(1, 2) + m(2, 1)) / s, 0.25f * s, (m(1, 0) - m(0, 1)) / s);
+}
+
+Matrix4 Quaternion::matrix() const
+{
+    const float xx = x() * x(), yy = y() * y(), zz = z() * z();
+    const float xy = x() * y(), xz = x() * z(), yz = y() * z();
+    const float wx = w() * x(), wy = w() * y(), wz = w() * z();
+
+    return Matrix4(
+        Vector(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f),
+        Vector(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f),
+        Vector(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f),
+        Vector::WAxis
+    );
+}
+
+Quaternion Quaternion::nlerp(const Quaternion& rhs, float t) const
+{
+    // q and -q are the same rotation, flip rhs to take the shorter arc
+    const Vector b = dot(rhs) < 0.0f ? -rhs.xyzw() : rhs.xyzw();
+    return Quaternion(xyzw().lerp(b, t).normalized(Precision::Exact));
+}
+
+Quaternion Quaternion::slerp(const Quaternion& rhs, float t) const
+{
+    float d = dot(rhs);
+    Vector b = rhs.xyzw();
+    if(d < 0.0f) {
+        d = -d;
+        b = -b;
+    }
+
+    // sin(theta) goes to 0 as the quaternions converge
+    // at which point nlerp is indistinguishable and doesn't divide by 0
+    if(d > 0.9995f) {
+        return Quaternion(xyzw().lerp(b, t).normalized(Precision::Exact));
+    }
+
+    const float theta = std::acos(d);
+    const float s = 1.0f / std::sin(theta);
+    return Quaternion(xyzw() * (std::sin((1.0f - t) * theta) * s) + b * (std::sin(t * theta) * s));
+}
+
+std::string Quaternion::str() const
+{
+    std::stringstream ss;
+    ss << "Quaternion(x:" << std::fixed << x() << ", y:" << y() << ", z:" << z() << ", w:" << w() << ")";
+    return ss.str();
+}
+
+} }
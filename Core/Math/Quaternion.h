@@ -0,0 +1,169 @@
+#if !defined __QUATERNION_H__
+#define __QUATERNION_H__
+
+#include "Matrix4.h"
+#include "Vector.h"
+
+namespace energonsoftware {
+namespace math {
+
+/*
+Rotation quaternion stored as (x, y, z, w) where w is the scalar part.
+
+This has the same size, alignment and component order as Vector (and VectorStorage)
+so arrays of them can be handed to the batch kernels without conversion.
+
+Everything that rotates assumes a unit quaternion.
+*/
+class DllExport Quaternion
+{
+public:
+    static const Quaternion Identity;
+
+public:
+    // rotation of angle radians counter-clockwise around axis
+    static Quaternion axis_angle(const Vector& axis, float angle);
+
+    // NOTE: the upper 3x3 of m must be a pure rotation
+    static Quaternion from_matrix(const Matrix4& m);
+
+public:
+    // identity
+    Quaternion()
+        : _value{0.0f, 0.0f, 0.0f, 1.0f}
+    {
+    }
+
+    Quaternion(float x, float y, float z, float w)
+        : _value{x, y, z, w}
+    {
+    }
+
+    // vector part from v.xyz()
+    Quaternion(const Vector& v, float w)
+        : _value{v.x(), v.y(), v.z(), w}
+    {
+    }
+
+    explicit Quaternion(const VectorStorage& q)
+        : _value{q.x, q.y, q.z, q.w}
+    {
+    }
+
+    DEFAULT_COPY_AND_ASSIGN(Quaternion);
+
+    Quaternion(Quaternion&& q) = default;
+
+    ~Quaternion() = default;
+
+public:
+    float x() const { return _value[0]; }
+    float y() const { return _value[1]; }
+    float z() const { return _value[2]; }
+    float w() const { return _value[3]; }
+
+    const float* array() const { return _value; }
+
+    VectorStorage storage() const { return { x(), y(), z(), w() }; }
+
+    // the vector part (w = 0)
+    Vector vector() const { return Vector(x(), y(), z()); }
+
+    float length_squared() const { return dot(*this); }
+    float length() const { return std::sqrt(length_squared()); }
+
+    // see Precision for the accuracy of each option
+    Quaternion& normalize(Precision precision = Precision::Refined) { return *this = normalized(precision); }
+    Quaternion normalized(Precision precision = Precision::Refined) const { return Quaternion(xyzw().normalized(precision)); }
+
+    float dot(const Quaternion& rhs) const { return xyzw() * rhs.xyzw(); }
+
+    Quaternion conjugate() const { return Quaternion(-x(), -y(), -z(), w()); }
+
+    // conjugate() is cheaper for unit quaternions
+    Quaternion inverse() const { return Quaternion(conjugate().xyzw() / length_squared()); }
+
+    // rotates v.xyz(), v.w is passed through
+    Vector rotate(const Vector& v) const
+    {
+        // v' = v + w * t + q.xyz x t where t = 2 * (q.xyz x v)
+        // which is cheaper than q * v * conjugate()
+        const Vector q = vector();
+        const Vector t = (q ^ v) * 2.0f;
+        return v + t * w() + (q ^ t);
+    }
+
+    Matrix4 matrix() const;
+
+    // normalized lerp along the shortest path
+    // cheap and accurate enough for small angles or when the rate doesn't matter
+    // t must be in [0, 1]
+    Quaternion nlerp(const Quaternion& rhs, float t) const;
+
+    // spherical lerp along the shortest path (constant angular velocity)
+    // t must be in [0, 1]
+    Quaternion slerp(const Quaternion& rhs, float t) const;
+
+    std::string str() const;
+
+public:
+    bool operator==(const Quaternion& rhs) const { return xyzw() == rhs.xyzw(); }
+    bool operator!=(const Quaternion& rhs) const { return !(*this == rhs); }
+
+    Quaternion operator-() const { return Quaternion(-xyzw()); }
+
+    // Hamilton product, applies rhs first
+    Quaternion operator*(const Quaternion& rhs) const
+    {
+#if defined USE_SSE
+        Quaternion q;
+        __m128 A = _mm_load_ps(_value);
+        __m128 B = _mm_load_ps(rhs._value);
+
+        // w1 * (x2, y2, z2, w2)
+        // + x1 * (w2, -z2, y2, -x2)
+        // + y1 * (z2, w2, -x2, -y2)
+        // + z1 * (-y2, x2, w2, -z2)
+        __m128 R = _mm_mul_ps(_mm_shuffle_ps(A, A, _MM_SHUFFLE(3, 3, 3, 3)), B);
+        R = _mm_add_ps(R, _mm_mul_ps(_mm_shuffle_ps(A, A, _MM_SHUFFLE(0, 0, 0, 0)),
+            _mm_xor_ps(_mm_shuffle_ps(B, B, _MM_SHUFFLE(0, 1, 2, 3)), _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f))));
+        R = _mm_add_ps(R, _mm_mul_ps(_mm_shuffle_ps(A, A, _MM_SHUFFLE(1, 1, 1, 1)),
+            _mm_xor_ps(_mm_shuffle_ps(B, B, _MM_SHUFFLE(1, 0, 3, 2)), _mm_set_ps(-0.0f, -0.0f, 0.0f, 0.0f))));
+        R = _mm_add_ps(R, _mm_mul_ps(_mm_shuffle_ps(A, A, _MM_SHUFFLE(2, 2, 2, 2)),
+            _mm_xor_ps(_mm_shuffle_ps(B, B, _MM_SHUFFLE(2, 3, 0, 1)), _mm_set_ps(-0.0f, 0.0f, 0.0f, -0.0f))));
+        _mm_store_ps(q._value, R);
+        return q;
+#else
+        return Quaternion(
+            w() * rhs.x() + x() * rhs.w() + y() * rhs.z() - z() * rhs.y(),
+            w() * rhs.y() - x() * rhs.z() + y() * rhs.w() + z() * rhs.x(),
+            w() * rhs.z() + x() * rhs.y() - y() * rhs.x() + z() * rhs.w(),
+            w() * rhs.w() - x() * rhs.x() - y() * rhs.y() - z() * rhs.z()
+        );
+#endif
+    }
+
+    Quaternion& operator*=(const Quaternion& rhs) { return *this = *this * rhs; }
+
+    Vector operator*(const Vector& rhs) const { return rotate(rhs); }
+
+private:
+    // all four components, for reusing the Vector math
+    explicit Quaternion(const Vector& q)
+        : _value{q.x(), q.y(), q.z(), q.w()}
+    {
+    }
+
+    Vector xyzw() const { return Vector(_value); }
+
+private:
+    ALIGN(16) float _value[4];
+};
+
+static_assert(sizeof(Quaternion) == sizeof(Vector), "Quaternion must be laid out like Vector");
+static_assert(alignof(Quaternion) == alignof(Vector), "Quaternion must be aligned like Vector");
+static_assert(std::is_trivially_copyable<Quaternion>::value, "Quaternion must be trivially copyable");
+
+} }
+
+#endif
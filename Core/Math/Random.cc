@@ -0,0 +1,134 @@
+#include "pch.h"
+#include "SIMD/Kernels.h"
+#include "Random.h"
+
+namespace energonsoftware {
+namespace math {
+
+void Xoshiro256::jump()
+{
+    static const uint64_t Jump[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+
+    uint64_t s[4] = { 0, 0, 0, 0 };
+    for(uint64_t jump : Jump) {
+        for(int b = 0; b < 64; ++b) {
+            if(0 != (jump & (1ULL << b))) {
+                for(int i = 0; i < 4; ++i) {
+                    s[i] ^= _state[i];
+                }
+            }
+            (*this)();
+        }
+    }
+
+    for(int i = 0; i < 4; ++i) {
+        _state[i] = s[i];
+    }
+}
+
+Random::Random(uint64_t seed)
+{
+    this->seed(seed);
+}
+
+void Random::seed(uint64_t seed)
+{
+    _engine.seed(seed);
+
+    // the bulk generators continue the SplitMix64 sequence
+    // so that they never share state with the scalar generator
+    SplitMix64 seeder(seed);
+    for(int i = 0; i < 4; ++i) {
+        seeder();
+    }
+
+    for(size_t i = 0; i < RandomLanes::Lanes; ++i) {
+        const uint64_t a = seeder(), b = seeder();
+        _lanes.s[0][i] = static_cast<uint32_t>(a);
+        _lanes.s[1][i] = static_cast<uint32_t>(a >> 32);
+        _lanes.s[2][i] = static_cast<uint32_t>(b);
+        _lanes.s[3][i] = static_cast<uint32_t>(b >> 32);
+    }
+}
+
+Vector Random::unit_vector()
+{
+    // Marsaglia (1972), see SIMD/RandomKernels.inl
+    float a, b, s;
+    do {
+        a = 2.0f * uniform() - 1.0f;
+        b = 2.0f * uniform() - 1.0f;
+        s = a * a + b * b;
+    } while(s > 1.0f);
+
+    const float m = 2.0f * std::sqrt(1.0f - s);
+    return Vector(a * m, b * m, 1.0f - 2.0f * s);
+}
+
+Vector Random::in_sphere(float radius)
+{
+    float a, b, c;
+    do {
+        a = 2.0f * uniform() - 1.0f;
+        b = 2.0f * uniform() - 1.0f;
+        c = 2.0f * uniform() - 1.0f;
+    } while(a * a + b * b + c * c > 1.0f);
+
+    return Vector(a * radius, b * radius, c * radius);
+}
+
+Vector Random::in_box(const Vector& min, const Vector& max)
+{
+    return Vector(uniform(min.x(), max.x()), uniform(min.y(), max.y()), uniform(min.z(), max.z()), uniform(min.w(), max.w()));
+}
+
+void Random::uniform(float* const out, size_t count)
+{
+    kernels().random.uniform(_lanes, out, count);
+}
+
+void Random::unit_vectors(Vector* const out, size_t count)
+{
+    kernels().random.unit_vectors(_lanes, reinterpret_cast<float*>(out), count);
+}
+
+void Random::in_sphere(Vector* const out, size_t count, float radius)
+{
+    kernels().random.in_sphere(_lanes, radius, reinterpret_cast<float*>(out), count);
+}
+
+void Random::in_box(Vector* const out, size_t count, const Vector& min, const Vector& max)
+{
+    kernels().random.in_box(_lanes, min.array(), max.array(), reinterpret_cast<float*>(out), count);
+}
+
+void Random::colors(Vector* const out, size_t count)
+{
+    static const Vector Black(0.0f, 0.0f, 0.0f, 1.0f);
+    static const Vector White(1.0f, 1.0f, 1.0f, 1.0f);
+
+    in_box(out, count, Black, White);
+}
+
+namespace {
+
+uint64_t random_device_seed()
+{
+    std::random_device device;
+    return (static_cast<uint64_t>(device()) << 32) | device();
+}
+
+}
+
+Random& thread_random()
+{
+    thread_local Random random(random_device_seed());
+    return random;
+}
+
+void seed_thread_random(uint64_t seed)
+{
+    thread_random().seed(seed);
+}
+
+} }
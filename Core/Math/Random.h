@@ -0,0 +1,221 @@
+#if !defined __RANDOM_H__
+#define __RANDOM_H__
+
+#include <cstdint>
+#include <limits>
+#include "Vector.h"
+#include "SIMD/RandomLanes.h"
+
+namespace energonsoftware {
+namespace math {
+
+// SplitMix64 (Steele, Lea and Flood)
+// used to expand a single seed into the state of the other generators
+class SplitMix64
+{
+public:
+    typedef uint64_t result_type;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+public:
+    explicit SplitMix64(uint64_t seed)
+        : _state(seed)
+    {
+    }
+
+    result_type operator()()
+    {
+        uint64_t z = (_state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+private:
+    uint64_t _state;
+};
+
+/*
+xoshiro256** (Blackman and Vigna), the general purpose 64-bit generator.
+
+This satisfies UniformRandomBitGenerator so it can be used
+with the standard library distributions.
+*/
+class DllExport Xoshiro256
+{
+public:
+    typedef uint64_t result_type;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+public:
+    explicit Xoshiro256(uint64_t seed = 0)
+    {
+        this->seed(seed);
+    }
+
+    Xoshiro256(uint64_t s0, uint64_t s1, uint64_t s2, uint64_t s3)
+        : _state{s0, s1, s2, s3}
+    {
+    }
+
+public:
+    void seed(uint64_t seed)
+    {
+        SplitMix64 seeder(seed);
+        for(uint64_t& s : _state) {
+            s = seeder();
+        }
+    }
+
+    result_type operator()()
+    {
+        const uint64_t result = rotl(_state[1] * 5, 7) * 9;
+        const uint64_t t = _state[1] << 17;
+
+        _state[2] ^= _state[0];
+        _state[3] ^= _state[1];
+        _state[1] ^= _state[2];
+        _state[0] ^= _state[3];
+        _state[2] ^= t;
+        _state[3] = rotl(_state[3], 45);
+
+        return result;
+    }
+
+    // uniform float in [0, 1)
+    float next_float()
+    {
+        return static_cast<float>((*this)() >> 40) * (1.0f / 16777216.0f);
+    }
+
+    // equivalent to 2^128 calls, used to generate non-overlapping sequences
+    void jump();
+
+private:
+    static uint64_t rotl(uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+private:
+    uint64_t _state[4];
+};
+
+/*
+PCG32 (O'Neill), a small-state 32-bit generator.
+
+Each stream (selected by sequence) is a distinct sequence for the same seed.
+*/
+class DllExport PCG32
+{
+public:
+    typedef uint32_t result_type;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+public:
+    explicit PCG32(uint64_t seed = 0, uint64_t sequence = 0)
+    {
+        this->seed(seed, sequence);
+    }
+
+public:
+    void seed(uint64_t seed, uint64_t sequence = 0)
+    {
+        _state = 0;
+        _increment = (sequence << 1) | 1;
+        (*this)();
+        _state += seed;
+        (*this)();
+    }
+
+    result_type operator()()
+    {
+        const uint64_t old = _state;
+        _state = old * 6364136223846793005ULL + _increment;
+
+        const uint32_t xorshifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        const uint32_t rot = static_cast<uint32_t>(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+    }
+
+    // uniform float in [0, 1)
+    float next_float()
+    {
+        return static_cast<float>((*this)() >> 8) * (1.0f / 16777216.0f);
+    }
+
+private:
+    uint64_t _state;
+    uint64_t _increment;
+};
+
+/*
+Seedable random number source for Vectors.
+
+The single-value functions use a Xoshiro256 and the bulk functions
+use a separate set of SIMD generators (see SIMD/Kernels.h) that produce
+the same random bits on every instruction set tier.
+
+Random is not thread-safe, use thread_random() for a per-thread instance
+rather than constructing (and seeding) a new generator per call.
+*/
+class DllExport Random
+{
+public:
+    explicit Random(uint64_t seed);
+
+    DEFAULT_COPY_AND_ASSIGN(Random);
+
+public:
+    // resets both the scalar and the bulk generators
+    void seed(uint64_t seed);
+
+    Xoshiro256& engine() { return _engine; }
+
+    // in [0, 1)
+    float uniform() { return _engine.next_float(); }
+
+    // in [min, max)
+    float uniform(float min, float max) { return min + (max - min) * uniform(); }
+
+    // uniformly distributed on the unit sphere
+    Vector unit_vector();
+
+    // uniformly distributed inside of a sphere
+    Vector in_sphere(float radius = 1.0f);
+
+    // uniformly distributed over the box [min, max)
+    Vector in_box(const Vector& min, const Vector& max);
+
+public:
+    // bulk versions of the above
+    // output arrays must have room for count elements
+    void uniform(float* const out, size_t count);
+    void unit_vectors(Vector* const out, size_t count);
+    void in_sphere(Vector* const out, size_t count, float radius = 1.0f);
+    void in_box(Vector* const out, size_t count, const Vector& min, const Vector& max);
+
+    // opaque colors, (r, g, b, 1) with each channel in [0, 1)
+    void colors(Vector* const out, size_t count);
+
+private:
+    Xoshiro256 _engine;
+    RandomLanes _lanes;
+};
+
+// the calling thread's Random
+// this is seeded from std::random_device the first time it is used on each thread
+DllExport Random& thread_random();
+
+// reseeds the calling thread's Random for reproducible sequences
+DllExport void seed_thread_random(uint64_t seed);
+
+} }
+
+#endif
@@ -0,0 +1,105 @@
+#include "pch.h"
+#include <algorithm>
+#include "Core/Memory/Arena.h"
+#include "SIMD/Kernels.h"
+#include "RayBatch.h"
+
+namespace energonsoftware {
+namespace math {
+namespace batch {
+
+// NOTE: Vector is guaranteed to be exactly 4 packed floats
+// so the primitives can be handed straight to the kernels
+
+namespace {
+
+// runs kernel(origins, directions, t, hits, count) over ScratchChunkSize rays at a time
+// loaded into memory::scratch_arena(), every chunk starts on a whole hits word
+template<typename Kernel>
+size_t intersect_chunks(const Vector* const origins, const Vector* const directions, size_t count, float* const t, uint32_t* const hits, const Kernel& kernel)
+{
+    memory::Arena& scratch = memory::scratch_arena();
+
+    size_t n = 0;
+    for(size_t begin = 0; begin < count; begin += ScratchChunkSize) {
+        memory::ArenaScope scope(scratch);
+
+        const size_t chunk = std::min(ScratchChunkSize, count - begin);
+        n += kernel(load_stream(origins + begin, chunk, scratch), load_stream(directions + begin, chunk, scratch), t + begin, hits + begin / 32, chunk);
+    }
+    return n;
+}
+
+}
+
+size_t intersect_sphere(const VectorStream& origins, const VectorStream& directions, const Point3& center, float radius, float* const t, uint32_t* const hits)
+{
+    assert(origins.size() == directions.size());
+
+    const Vector sphere(center.x(), center.y(), center.z(), radius);
+    return kernels().ray.sphere(origins.ref(), directions.ref(), reinterpret_cast<const float*>(&sphere), t, hits, origins.size());
+}
+
+size_t intersect_plane(const VectorStream& origins, const VectorStream& directions, const Vector& plane, float* const t, uint32_t* const hits)
+{
+    assert(origins.size() == directions.size());
+    return kernels().ray.plane(origins.ref(), directions.ref(), reinterpret_cast<const float*>(&plane), t, hits, origins.size());
+}
+
+size_t intersect_aabb(const VectorStream& origins, const VectorStream& directions, const AABB& box, float* const t, uint32_t* const hits)
+{
+    assert(origins.size() == directions.size());
+
+    // the slabs of an empty box are inside out
+    if(box.is_empty()) {
+        std::fill(hits, hits + (origins.size() + 31) / 32, 0);
+        return 0;
+    }
+
+    return kernels().ray.aabb(origins.ref(), directions.ref(),
+        reinterpret_cast<const float*>(&box.minimum()), reinterpret_cast<const float*>(&box.maximum()), t, hits, origins.size());
+}
+
+size_t intersect_triangle(const VectorStream& origins, const VectorStream& directions, const Point3& v0, const Point3& v1, const Point3& v2, float* const t, uint32_t* const hits)
+{
+    assert(origins.size() == directions.size());
+    return kernels().ray.triangle(origins.ref(), directions.ref(),
+        reinterpret_cast<const float*>(&v0), reinterpret_cast<const float*>(&v1), reinterpret_cast<const float*>(&v2), t, hits, origins.size());
+}
+
+size_t intersect_sphere(const Vector* const origins, const Vector* const directions, size_t count, const Point3& center, float radius, float* const t, uint32_t* const hits)
+{
+    const Vector sphere(center.x(), center.y(), center.z(), radius);
+    return intersect_chunks(origins, directions, count, t, hits, [&sphere](ConstStreamRef o, ConstStreamRef d, float* const ct, uint32_t* const chits, size_t n) {
+        return kernels().ray.sphere(o, d, reinterpret_cast<const float*>(&sphere), ct, chits, n);
+    });
+}
+
+size_t intersect_plane(const Vector* const origins, const Vector* const directions, size_t count, const Vector& plane, float* const t, uint32_t* const hits)
+{
+    return intersect_chunks(origins, directions, count, t, hits, [&plane](ConstStreamRef o, ConstStreamRef d, float* const ct, uint32_t* const chits, size_t n) {
+        return kernels().ray.plane(o, d, reinterpret_cast<const float*>(&plane), ct, chits, n);
+    });
+}
+
+size_t intersect_aabb(const Vector* const origins, const Vector* const directions, size_t count, const AABB& box, float* const t, uint32_t* const hits)
+{
+    if(box.is_empty()) {
+        std::fill(hits, hits + (count + 31) / 32, 0);
+        return 0;
+    }
+
+    return intersect_chunks(origins, directions, count, t, hits, [&box](ConstStreamRef o, ConstStreamRef d, float* const ct, uint32_t* const chits, size_t n) {
+        return kernels().ray.aabb(o, d, reinterpret_cast<const float*>(&box.minimum()), reinterpret_cast<const float*>(&box.maximum()), ct, chits, n);
+    });
+}
+
+size_t intersect_triangle(const Vector* const origins, const Vector* const directions, size_t count, const Point3& v0, const Point3& v1, const Point3& v2, float* const t, uint32_t* const hits)
+{
+    return intersect_chunks(origins, directions, count, t, hits, [&](ConstStreamRef o, ConstStreamRef d, float* const ct, uint32_t* const chits, size_t n) {
+        return kernels().ray.triangle(o, d, reinterpret_cast<const float*>(&v0), reinterpret_cast<const float*>(&v1), reinterpret_cast<const float*>(&v2), ct, chits, n);
+    });
+}
+
+}
+} }
@@ -0,0 +1,55 @@
+#if !defined __RAYBATCH_H__
+#define __RAYBATCH_H__
+
+#include "AABB.h"
+#include "Vector.h"
+#include "VectorStream.h"
+
+namespace energonsoftware {
+namespace math {
+
+/*
+Packet intersection of many rays against a single primitive.
+
+Ray i is origins[i] + t * directions[i] (only x, y and z are used and the
+directions don't need to be normalized), the streams must be the same size.
+
+t is the closest hit per ray so far: on input t[i] is the furthest
+distance that counts for ray i (infinity for no limit) and a hit in [0, t[i]]
+replaces it, so running one primitive after another leaves the closest
+hit of each ray. hits is a bitmask, bit (i % 32) of hits[i / 32] is set
+if ray i hit this primitive and cleared if it didn't, it must have room for
+(size + 31) / 32 words. Each returns the number of rays that hit.
+
+These run the best kernels for the current CPU (see SIMD/Kernels.h),
+4, 8 or 16 rays per pass. The overloads that take packed arrays of count
+Vectors convert them to structure-of-arrays a chunk at a time
+in memory::scratch_arena(), so nothing is allocated once it has grown.
+*/
+namespace batch {
+
+// rays starting inside of the sphere hit where they leave it
+DllExport size_t intersect_sphere(const VectorStream& origins, const VectorStream& directions, const Point3& center, float radius, float* const t, uint32_t* const hits);
+
+// plane is (normal, d) where normal * p + d = 0, both sides are hit
+// and rays parallel to the plane never are
+DllExport size_t intersect_plane(const VectorStream& origins, const VectorStream& directions, const Vector& plane, float* const t, uint32_t* const hits);
+
+// rays starting inside of the box hit at 0, the empty box is never hit
+// see AABB::intersect_ray()
+DllExport size_t intersect_aabb(const VectorStream& origins, const VectorStream& directions, const AABB& box, float* const t, uint32_t* const hits);
+
+// Moller-Trumbore, both sides are hit
+// and rays in the plane of the triangle never are
+DllExport size_t intersect_triangle(const VectorStream& origins, const VectorStream& directions, const Point3& v0, const Point3& v1, const Point3& v2, float* const t, uint32_t* const hits);
+
+DllExport size_t intersect_sphere(const Vector* const origins, const Vector* const directions, size_t count, const Point3& center, float radius, float* const t, uint32_t* const hits);
+DllExport size_t intersect_plane(const Vector* const origins, const Vector* const directions, size_t count, const Vector& plane, float* const t, uint32_t* const hits);
+DllExport size_t intersect_aabb(const Vector* const origins, const Vector* const directions, size_t count, const AABB& box, float* const t, uint32_t* const hits);
+DllExport size_t intersect_triangle(const Vector* const origins, const Vector* const directions, size_t count, const Point3& v0, const Point3& v1, const Point3& v2, float* const t, uint32_t* const hits);
+
+}
+
+} }
+
+#endif
@@ -0,0 +1,291 @@
+// array-of-structures batch kernels over packed Vectors
+// each iteration transposes F::Width Vectors into a WideVector
+// and reuses the structure-of-arrays math
+//
+// output arrays may alias input arrays
+//
+// NOTE: this is textually included inside of a kernel namespace
+// after MathFunctions.inl, StreamKernels.inl and WideMatrix.inl
+
+namespace array {
+
+// like stream::run() but also hands body the matrix m broadcast to the width it is working with
+// so that the broadcast happens once per batch rather than once per iteration
+template<typename F, typename Body>
+inline void run_matrix(const float* m, size_t count, const Body& body)
+{
+    const WideMatrix<F> wide(m);
+    const WideMatrix<Float1> narrow(m);
+
+    size_t i = 0;
+    for(; i + F::Width <= count; i += F::Width) {
+        body(wide, i);
+    }
+
+    for(; i < count; ++i) {
+        body(narrow, i);
+    }
+}
+
+template<typename F>
+void multiply(const float* a, const float* b, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        multiply(V::load_aos(a + i * 4), V::load_aos(b + i * 4)).store_aos(r + i * 4);
+    });
+}
+
+template<typename F>
+void dot(const float* a, const float* b, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        dot(V::load_aos(a + i * 4), V::load_aos(b + i * 4)).storeu(r + i);
+    });
+}
+
+template<typename F>
+void cross(const float* a, const float* b, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        cross(V::load_aos(a + i * 4), V::load_aos(b + i * 4)).store_aos(r + i * 4);
+    });
+}
+
+template<typename F>
+void length_squared(const float* a, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        const V v = V::load_aos(a + i * 4);
+        dot(v, v).storeu(r + i);
+    });
+}
+
+template<typename F>
+void length(const float* a, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        const V v = V::load_aos(a + i * 4);
+        sqrt(dot(v, v)).storeu(r + i);
+    });
+}
+
+template<typename F>
+void normalize(const float* a, float* r, size_t count, Precision precision)
+{
+    with_precision(precision, [=](auto p) {
+        stream::run<F>(count, [=](auto f, size_t i) {
+            using V = WideVector<decltype(f)>;
+            const V v = V::load_aos(a + i * 4);
+            (v * inverse_sqrt<decltype(p)::value>(dot(v, v))).store_aos(r + i * 4);
+        });
+    });
+}
+
+// atan(y / x) of each Vector (Vector::angle())
+template<typename F>
+void angle(const float* a, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        const V v = V::load_aos(a + i * 4);
+        atan(v.y / v.x).storeu(r + i);
+    });
+}
+
+// the angle between each pair of Vectors times scale (Vector::angle_radians())
+// as atan2(|a||b| sin, |a||b| cos) rather than acos() of the cosine,
+// which loses most of its precision near 0 and pi
+// |a|^2 |b|^2 - (a.b)^2 is the sum of the squared 2x2 minors (Lagrange's identity)
+// which don't cancel like the difference does, the Vectors are 4-dimensional
+// like Vector::angle_radians() so this is the general form of |a x b|
+template<typename F>
+void angle_between(const float* a, const float* b, float scale, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        typedef decltype(f) G;
+        using V = WideVector<G>;
+        const V va = V::load_aos(a + i * 4);
+        const V vb = V::load_aos(b + i * 4);
+
+        const G xy = va.x * vb.y - va.y * vb.x;
+        const G xz = va.x * vb.z - va.z * vb.x;
+        const G xw = va.x * vb.w - va.w * vb.x;
+        const G yz = va.y * vb.z - va.z * vb.y;
+        const G yw = va.y * vb.w - va.w * vb.y;
+        const G zw = va.z * vb.w - va.w * vb.z;
+        const G sine = sqrt(xy * xy + xz * xz + xw * xw + yz * yz + yw * yw + zw * zw);
+        (atan2(sine, dot(va, vb)) * G::set1(scale)).storeu(r + i);
+    });
+}
+
+// m is a column-major 4x4 matrix (see Matrix4)
+template<typename F>
+void transform(const float* m, const float* a, float* r, size_t count)
+{
+    run_matrix<F>(m, count, [=](const auto& M, size_t i) {
+        using V = WideVector<typename std::decay<decltype(M)>::type::Float>;
+        const V v = V::load_aos(a + i * 4);
+        M.transform(v.x, v.y, v.z, v.w).store_aos(r + i * 4);
+    });
+}
+
+template<typename F>
+void transform_points(const float* m, const float* a, float* r, size_t count)
+{
+    run_matrix<F>(m, count, [=](const auto& M, size_t i) {
+        using V = WideVector<typename std::decay<decltype(M)>::type::Float>;
+        const V v = V::load_aos(a + i * 4);
+        M.transform_point(v.x, v.y, v.z).store_aos(r + i * 4);
+    });
+}
+
+template<typename F>
+void transform_directions(const float* m, const float* a, float* r, size_t count)
+{
+    run_matrix<F>(m, count, [=](const auto& M, size_t i) {
+        using V = WideVector<typename std::decay<decltype(M)>::type::Float>;
+        const V v = V::load_aos(a + i * 4);
+        M.transform_direction(v.x, v.y, v.z).store_aos(r + i * 4);
+    });
+}
+
+// rotates every vector by the same quaternion q (4 floats, see Quaternion)
+template<typename F>
+void rotate(const float* q, const float* a, float* r, size_t count)
+{
+    // copied so that the broadcasts can be hoisted even if r aliases q
+    const float qx = q[0], qy = q[1], qz = q[2], qw = q[3];
+    stream::run<F>(count, [=](auto f, size_t i) {
+        using G = decltype(f);
+        using V = WideVector<G>;
+        const V Q = { G::set1(qx), G::set1(qy), G::set1(qz), G::set1(qw) };
+        rotate(Q, V::load_aos(a + i * 4)).store_aos(r + i * 4);
+    });
+}
+
+// rotates each vector by its own quaternion, q is count packed quaternions
+template<typename F>
+void rotate_each(const float* q, const float* a, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        rotate(V::load_aos(q + i * 4), V::load_aos(a + i * 4)).store_aos(r + i * 4);
+    });
+}
+
+// folds the lanes of a with op, first lane to last
+template<typename F, typename Op>
+inline float fold(F a, Op op)
+{
+    float lanes[F::Width];
+    a.storeu(lanes);
+
+    float r = lanes[0];
+    for(size_t i = 1; i < F::Width; ++i) {
+        r = op(r, lanes[i]);
+    }
+    return r;
+}
+
+// the reductions keep F::Width partial results per component
+// and fold them (and then the remainder) at the end
+
+template<typename F>
+void sum(const float* a, float* r, size_t count)
+{
+    WideVector<F> total = { F::zero(), F::zero(), F::zero(), F::zero() };
+    WideVector<Float1> tail = { Float1::zero(), Float1::zero(), Float1::zero(), Float1::zero() };
+
+    size_t i = 0;
+    for(; i + F::Width <= count; i += F::Width) {
+        total = total + WideVector<F>::load_aos(a + i * 4);
+    }
+
+    for(; i < count; ++i) {
+        tail = tail + WideVector<Float1>::load_aos(a + i * 4);
+    }
+
+    const auto add = [](float x, float y) { return x + y; };
+    r[0] = fold(total.x, add) + fold(tail.x, add);
+    r[1] = fold(total.y, add) + fold(tail.y, add);
+    r[2] = fold(total.z, add) + fold(tail.z, add);
+    r[3] = fold(total.w, add) + fold(tail.w, add);
+}
+
+template<typename F>
+float dot_sum(const float* a, const float* b, size_t count)
+{
+    F total = F::zero();
+    Float1 tail = Float1::zero();
+
+    size_t i = 0;
+    for(; i + F::Width <= count; i += F::Width) {
+        total = total + dot(WideVector<F>::load_aos(a + i * 4), WideVector<F>::load_aos(b + i * 4));
+    }
+
+    for(; i < count; ++i) {
+        tail = tail + dot(WideVector<Float1>::load_aos(a + i * 4), WideVector<Float1>::load_aos(b + i * 4));
+    }
+
+    const auto add = [](float x, float y) { return x + y; };
+    return fold(total, add) + fold(tail, add);
+}
+
+// +infinity/-infinity if count is 0
+template<typename F>
+void bounds(const float* a, float* minimum_out, float* maximum_out, size_t count)
+{
+    const F inf = F::set1(HUGE_VALF), negative_inf = F::set1(-HUGE_VALF);
+    WideVector<F> low = { inf, inf, inf, inf }, high = { negative_inf, negative_inf, negative_inf, negative_inf };
+
+    size_t i = 0;
+    for(; i + F::Width <= count; i += F::Width) {
+        const WideVector<F> v = WideVector<F>::load_aos(a + i * 4);
+        low = { minimum(low.x, v.x), minimum(low.y, v.y), minimum(low.z, v.z), minimum(low.w, v.w) };
+        high = { maximum(high.x, v.x), maximum(high.y, v.y), maximum(high.z, v.z), maximum(high.w, v.w) };
+    }
+
+    const auto min_op = [](float x, float y) { return MIN(x, y); };
+    const auto max_op = [](float x, float y) { return MAX(x, y); };
+    minimum_out[0] = fold(low.x, min_op);
+    minimum_out[1] = fold(low.y, min_op);
+    minimum_out[2] = fold(low.z, min_op);
+    minimum_out[3] = fold(low.w, min_op);
+    maximum_out[0] = fold(high.x, max_op);
+    maximum_out[1] = fold(high.y, max_op);
+    maximum_out[2] = fold(high.z, max_op);
+    maximum_out[3] = fold(high.w, max_op);
+
+    for(; i < count; ++i) {
+        for(size_t c = 0; c < 4; ++c) {
+            minimum_out[c] = MIN(minimum_out[c], a[i * 4 + c]);
+            maximum_out[c] = MAX(maximum_out[c], a[i * 4 + c]);
+        }
+    }
+}
+
+// transposes between packed Vectors and structure-of-arrays
+template<typename F>
+void to_stream(const float* a, StreamRef r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        V::load_aos(a + i * 4).store(r, i);
+    });
+}
+
+template<typename F>
+void from_stream(ConstStreamRef a, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        V::load(a, i).store_aos(r + i * 4);
+    });
+}
+
+}
@@ -0,0 +1,234 @@
+// color batch kernels over packed RGBA Colors (4 floats each)
+// the conversions transpose F::Width Colors so that every register holds one channel,
+// the alpha ops work on the packed floats (see below)
+//
+// output arrays may alias input arrays of the same type
+//
+// NOTE: this is textually included inside of a kernel namespace
+// after StreamKernels.inl, Half.inl and MathFunctions.inl
+
+namespace color {
+
+// the sRGB transfer functions (IEC 61966-2-1)
+template<typename F>
+inline F decode_srgb(F c)
+{
+    const F linear = c * F::set1(1.0f / 12.92f);
+    const F curve = pow(fmadd(c, F::set1(1.0f / 1.055f), F::set1(0.055f / 1.055f)), F::set1(2.4f));
+    return select(c <= F::set1(0.04045f), linear, curve);
+}
+
+template<typename F>
+inline F encode_srgb(F l)
+{
+    const F linear = l * F::set1(12.92f);
+    const F curve = fmadd(pow(l, F::set1(1.0f / 2.4f)), F::set1(1.055f), F::set1(-0.055f));
+    return select(l <= F::set1(0.0031308f), linear, curve);
+}
+
+// clamps to [0, 1] (NaN goes to 0) and rounds to an integer in [0, scale]
+template<typename F>
+inline typename F::UInt quantize(F c, float scale)
+{
+    return round_to_int(minimum(maximum(c, F::zero()), F::set1(1.0f)) * F::set1(scale));
+}
+
+// the bits-wide field of p at shift as a float in [0, 1]
+template<typename F, int Shift>
+inline F dequantize(typename F::UInt p, uint32_t mask, float scale)
+{
+    return to_float(shift_right<Shift>(p) & F::UInt::set1(mask)) * F::set1(1.0f / scale);
+}
+
+template<typename F>
+inline typename F::UInt pack8(const WideVector<F>& c)
+{
+    return quantize(c.x, 255.0f) | shift_left<8>(quantize(c.y, 255.0f)) | shift_left<16>(quantize(c.z, 255.0f)) | shift_left<24>(quantize(c.w, 255.0f));
+}
+
+template<typename F>
+inline WideVector<F> unpack8(typename F::UInt p)
+{
+    return { dequantize<F, 0>(p, 0xff, 255.0f), dequantize<F, 8>(p, 0xff, 255.0f), dequantize<F, 16>(p, 0xff, 255.0f), dequantize<F, 24>(p, 0xff, 255.0f) };
+}
+
+template<typename F>
+void srgb_to_linear(const float* a, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        const V c = V::load_aos(a + i * 4);
+        V { decode_srgb(c.x), decode_srgb(c.y), decode_srgb(c.z), c.w }.store_aos(r + i * 4);
+    });
+}
+
+template<typename F>
+void linear_to_srgb(const float* a, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        const V c = V::load_aos(a + i * 4);
+        V { encode_srgb(c.x), encode_srgb(c.y), encode_srgb(c.z), c.w }.store_aos(r + i * 4);
+    });
+}
+
+template<typename F>
+void pack_rgba8(const float* a, uint32_t* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        pack8(V::load_aos(a + i * 4)).storeu(r + i);
+    });
+}
+
+template<typename F>
+void unpack_rgba8(const uint32_t* a, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        typedef decltype(f) G;
+        unpack8<G>(G::UInt::loadu(a + i)).store_aos(r + i * 4);
+    });
+}
+
+template<typename F>
+void pack_srgba8(const float* a, uint32_t* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        const V c = V::load_aos(a + i * 4);
+        pack8(V { encode_srgb(c.x), encode_srgb(c.y), encode_srgb(c.z), c.w }).storeu(r + i);
+    });
+}
+
+template<typename F>
+void unpack_srgba8(const uint32_t* a, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        typedef decltype(f) G;
+        const WideVector<G> c = unpack8<G>(G::UInt::loadu(a + i));
+        WideVector<G> { decode_srgb(c.x), decode_srgb(c.y), decode_srgb(c.z), c.w }.store_aos(r + i * 4);
+    });
+}
+
+template<typename F>
+void pack_rgb10a2(const float* a, uint32_t* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        const V c = V::load_aos(a + i * 4);
+        (quantize(c.x, 1023.0f) | shift_left<10>(quantize(c.y, 1023.0f)) | shift_left<20>(quantize(c.z, 1023.0f)) | shift_left<30>(quantize(c.w, 3.0f))).storeu(r + i);
+    });
+}
+
+template<typename F>
+void unpack_rgb10a2(const uint32_t* a, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        typedef decltype(f) G;
+        const typename G::UInt p = G::UInt::loadu(a + i);
+        WideVector<G> { dequantize<G, 0>(p, 0x3ff, 1023.0f), dequantize<G, 10>(p, 0x3ff, 1023.0f), dequantize<G, 20>(p, 0x3ff, 1023.0f), dequantize<G, 30>(p, 0x3, 3.0f) }.store_aos(r + i * 4);
+    });
+}
+
+// premultiplying and blending only mix each channel with the alpha of its own color
+// so they run on the packed floats directly, F::Width / 4 colors at a time,
+// and the remainder one channel at a time
+
+// the alpha of the color that each lane starting at packed float i belongs to
+template<typename F>
+inline F load_alpha(const float* p, size_t i)
+{
+    return splat_w(F::loadu(p + i));
+}
+
+template<>
+inline Float1 load_alpha<Float1>(const float* p, size_t i)
+{
+    return Float1::set1(p[(i & ~static_cast<size_t>(3)) + 3]);
+}
+
+// true in the lanes starting at packed float i that hold alpha
+template<typename F>
+inline typename F::Mask alpha_lanes(size_t)
+{
+    static const float lanes[16] = { 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1 };
+    return F::loadu(lanes) > F::zero();
+}
+
+template<>
+inline Mask1 alpha_lanes<Float1>(size_t i)
+{
+    return { 3 == (i & 3) };
+}
+
+// NOTE: the remainder goes through the channels in order
+// so alpha is always overwritten last when r aliases the input
+
+template<typename F>
+void premultiply(const float* a, float* r, size_t count)
+{
+    stream::run<F>(count * 4, [=](auto f, size_t i) {
+        typedef decltype(f) G;
+        const G c = G::loadu(a + i);
+        select(alpha_lanes<G>(i), c, c * load_alpha<G>(a, i)).storeu(r + i);
+    });
+}
+
+// fully transparent colors go to 0
+template<typename F>
+void unpremultiply(const float* a, float* r, size_t count)
+{
+    stream::run<F>(count * 4, [=](auto f, size_t i) {
+        typedef decltype(f) G;
+        const G c = G::loadu(a + i);
+        const G alpha = load_alpha<G>(a, i);
+        const G inv = select(alpha > G::zero(), G::set1(1.0f) / alpha, G::zero());
+        select(alpha_lanes<G>(i), c, c * inv).storeu(r + i);
+    });
+}
+
+// calls op(s, d, sa, da) for each channel of each pair of premultiplied colors
+// where sa and da are the alphas of the colors
+template<typename F, typename Op>
+inline void blend(const float* s, const float* d, float* r, size_t count, const Op& op)
+{
+    stream::run<F>(count * 4, [=](auto f, size_t i) {
+        typedef decltype(f) G;
+        op(G::loadu(s + i), G::loadu(d + i), load_alpha<G>(s, i), load_alpha<G>(d, i)).storeu(r + i);
+    });
+}
+
+template<typename F>
+void blend_over(const float* s, const float* d, float* r, size_t count)
+{
+    blend<F>(s, d, r, count, [](auto sc, auto dc, auto sa, auto) {
+        return sc + dc * (decltype(sa)::set1(1.0f) - sa);
+    });
+}
+
+template<typename F>
+void blend_add(const float* s, const float* d, float* r, size_t count)
+{
+    blend<F>(s, d, r, count, [](auto sc, auto dc, auto, auto) {
+        return sc + dc;
+    });
+}
+
+template<typename F>
+void blend_multiply(const float* s, const float* d, float* r, size_t count)
+{
+    blend<F>(s, d, r, count, [](auto sc, auto dc, auto sa, auto da) {
+        typedef decltype(sa) G;
+        return sc * dc + sc * (G::set1(1.0f) - da) + dc * (G::set1(1.0f) - sa);
+    });
+}
+
+template<typename F>
+void blend_screen(const float* s, const float* d, float* r, size_t count)
+{
+    blend<F>(s, d, r, count, [](auto sc, auto dc, auto, auto) {
+        return sc + dc - sc * dc;
+    });
+}
+
+}
@@ -0,0 +1,80 @@
+// bulk culling kernels, written once against the FloatN interface
+// every pass tests F::Width spheres or boxes against all of the planes
+// and the remainder is finished with Float1
+//
+// each kernel tracks the smallest margin (signed distance plus radius)
+// over the planes and keeps everything whose margin isn't negative
+//
+// NOTE: this is textually included inside of a kernel namespace
+// after Float1.inl, the wide FloatN type and StreamKernels.inl
+
+namespace cull {
+
+// appends the indices of the lanes set in passed
+// elements i to i + Width, returns the number written
+//
+// every lane is written and only the passing ones are kept,
+// which is safe because at most i + lane indices have been written
+// before lane and so visible[n] is never past visible[i + lane]
+template<size_t Width>
+inline size_t compact(unsigned int passed, size_t i, uint32_t* visible, size_t n)
+{
+    if(0 == passed) {
+        return n;
+    }
+
+    for(size_t lane = 0; lane < Width; ++lane) {
+        visible[n] = static_cast<uint32_t>(i + lane);
+        n += (passed >> lane) & 1;
+    }
+    return n;
+}
+
+template<typename F>
+size_t spheres(ConstStreamRef spheres, const float* planes, size_t plane_count, uint32_t* visible, size_t count)
+{
+    size_t n = 0;
+    stream::run<F>(count, [&](auto f, size_t i) {
+        typedef decltype(f) G;
+
+        const G x = G::loadu(spheres.x + i), y = G::loadu(spheres.y + i), z = G::loadu(spheres.z + i);
+        const G r = G::loadu(spheres.w + i);
+
+        G margin = G::set1(HUGE_VALF);
+        for(size_t p = 0; p < plane_count; ++p) {
+            const float* const plane = planes + p * 4;
+            const G distance = fmadd(G::set1(plane[0]), x, fmadd(G::set1(plane[1]), y, fmadd(G::set1(plane[2]), z, G::set1(plane[3]))));
+            margin = minimum(margin, distance + r);
+        }
+
+        n = compact<G::Width>(bits(margin >= G::zero()), i, visible, n);
+    });
+    return n;
+}
+
+// the box's extent along each normal is its radius for that plane
+// see Frustum::intersects()
+template<typename F>
+size_t boxes(ConstStreamRef centers, ConstStreamRef half_extents, const float* planes, size_t plane_count, uint32_t* visible, size_t count)
+{
+    size_t n = 0;
+    stream::run<F>(count, [&](auto f, size_t i) {
+        typedef decltype(f) G;
+
+        const G x = G::loadu(centers.x + i), y = G::loadu(centers.y + i), z = G::loadu(centers.z + i);
+        const G ex = G::loadu(half_extents.x + i), ey = G::loadu(half_extents.y + i), ez = G::loadu(half_extents.z + i);
+
+        G margin = G::set1(HUGE_VALF);
+        for(size_t p = 0; p < plane_count; ++p) {
+            const float* const plane = planes + p * 4;
+            const G distance = fmadd(G::set1(plane[0]), x, fmadd(G::set1(plane[1]), y, fmadd(G::set1(plane[2]), z, G::set1(plane[3]))));
+            const G radius = fmadd(G::set1(std::fabs(plane[0])), ex, fmadd(G::set1(std::fabs(plane[1])), ey, G::set1(std::fabs(plane[2])) * ez));
+            margin = minimum(margin, distance + radius);
+        }
+
+        n = compact<G::Width>(bits(margin >= G::zero()), i, visible, n);
+    });
+    return n;
+}
+
+}
@@ -0,0 +1,146 @@
+// compact vector encoding kernels (see VectorEncoding.h)
+//
+// NOTE: this is textually included inside of a kernel namespace
+// after StreamKernels.inl, Half.inl and MathFunctions.inl
+
+namespace encode {
+
+// the float16 and bfloat16 conversions treat every float on its own
+// so they work on flat float arrays
+
+template<typename F>
+void to_half(const float* a, uint16_t* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        decltype(f)::loadu(a + i).store_half(r + i);
+    });
+}
+
+template<typename F>
+void from_half(const uint16_t* a, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        decltype(f)::load_half(a + i).storeu(r + i);
+    });
+}
+
+// bfloat16 is the top half of a float, rounded to nearest even
+// NaNs are kept quiet so they can't round to infinity
+template<typename F>
+void to_bfloat16(const float* a, uint16_t* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        typedef decltype(f) G;
+        typedef typename G::UInt U;
+
+        const G x = G::loadu(a + i);
+        const U bits = as_uint(x);
+        const U rounded = shift_right<16>(bits + U::set1(0x7fff) + (shift_right<16>(bits) & U::set1(1)));
+        const U nan = shift_right<16>(bits) | U::set1(0x0040);
+        select(abs(x) <= G::set1(HUGE_VALF), rounded, nan).store_u16(r + i);
+    });
+}
+
+template<typename F>
+void from_bfloat16(const uint16_t* a, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        typedef decltype(f) G;
+        as_float(shift_left<16>(G::UInt::load_u16(a + i))).storeu(r + i);
+    });
+}
+
+// octahedral unit vector encoding (Meyer et al. 2010, "On Floating-Point Normal Vectors")
+// the direction is projected onto the octahedron |x| + |y| + |z| = 1,
+// the lower half is folded over the upper half and the resulting x and y
+// in [-1, 1] are stored as snorm16, x in the low bits
+template<typename F>
+void to_octahedral(const float* a, uint32_t* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        typedef decltype(f) G;
+        typedef typename G::UInt U;
+
+        const WideVector<G> v = WideVector<G>::load_aos(a + i * 4);
+        const G l1 = abs(v.x) + abs(v.y) + abs(v.z);
+        const G inv = select(l1 > G::zero(), G::set1(1.0f) / l1, G::zero());
+        const G px = v.x * inv;
+        const G py = v.y * inv;
+
+        const typename G::Mask lower = v.z < G::zero();
+        const G ox = select(lower, copy_sign(G::set1(1.0f) - abs(py), px), px);
+        const G oy = select(lower, copy_sign(G::set1(1.0f) - abs(px), py), py);
+
+        const U qx = round_to_int(minimum(maximum(ox, G::set1(-1.0f)), G::set1(1.0f)) * G::set1(32767.0f));
+        const U qy = round_to_int(minimum(maximum(oy, G::set1(-1.0f)), G::set1(1.0f)) * G::set1(32767.0f));
+        ((qx & U::set1(0xffff)) | shift_left<16>(qy)).storeu(r + i);
+    });
+}
+
+// unpacked to unit vectors with w = 0
+template<typename F>
+void from_octahedral(const uint32_t* a, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        typedef decltype(f) G;
+        typedef typename G::UInt U;
+
+        // sign-extend each snorm16
+        const U p = U::loadu(a + i);
+        const U sx = ((p & U::set1(0xffff)) ^ U::set1(0x8000)) - U::set1(0x8000);
+        const U sy = (shift_right<16>(p) ^ U::set1(0x8000)) - U::set1(0x8000);
+        G x = maximum(to_float(sx) * G::set1(1.0f / 32767.0f), G::set1(-1.0f));
+        G y = maximum(to_float(sy) * G::set1(1.0f / 32767.0f), G::set1(-1.0f));
+
+        // unfold the lower half
+        const G z = G::set1(1.0f) - abs(x) - abs(y);
+        const G t = maximum(G::zero() - z, G::zero());
+        x = x - copy_sign(t, x);
+        y = y - copy_sign(t, y);
+
+        const G inv = G::set1(1.0f) / sqrt(x * x + y * y + z * z);
+        WideVector<G> { x * inv, y * inv, z * inv, G::zero() }.store_aos(r + i * 4);
+    });
+}
+
+// the per-component quantization parameters repeated over 16 lanes, the wide
+// types always start at a Vector boundary and load from the start and Float1
+// loads the one component at packed float i
+struct QuantizeLanes
+{
+    float offset[16];
+    float scale[16];
+
+    QuantizeLanes(const float* const o, const float* const s)
+    {
+        for(size_t i = 0; i < 16; ++i) {
+            offset[i] = o[i & 3];
+            scale[i] = s[i & 3];
+        }
+    }
+};
+
+// (v - offset) * scale for each component rounded to unorm16, 4 per Vector
+template<typename F>
+void quantize(const float* a, const float* offset, const float* scale, uint16_t* r, size_t count)
+{
+    const QuantizeLanes lanes(offset, scale);
+    stream::run<F>(count * 4, [=, &lanes](auto f, size_t i) {
+        typedef decltype(f) G;
+        const G q = (G::loadu(a + i) - G::loadu(lanes.offset + (i & 3))) * G::loadu(lanes.scale + (i & 3));
+        round_to_int(minimum(maximum(q, G::zero()), G::set1(65535.0f))).store_u16(r + i);
+    });
+}
+
+// offset + q * scale for each component
+template<typename F>
+void dequantize(const uint16_t* a, const float* offset, const float* scale, float* r, size_t count)
+{
+    const QuantizeLanes lanes(offset, scale);
+    stream::run<F>(count * 4, [=, &lanes](auto f, size_t i) {
+        typedef decltype(f) G;
+        fmadd(to_float(G::UInt::load_u16(a + i)), G::loadu(lanes.scale + (i & 3)), G::loadu(lanes.offset + (i & 3))).storeu(r + i);
+    });
+}
+
+}
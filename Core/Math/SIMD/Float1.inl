@@ -0,0 +1,142 @@
+// scalar stand-in for the SIMD float types
+// used by the reference kernels and for the remainder of every batch loop
+//
+// NOTE: this is textually included inside of a kernel namespace
+// so it must not include any headers itself
+
+// companion unsigned 32-bit integer type
+struct UInt1
+{
+    uint32_t v;
+
+    static UInt1 set1(uint32_t s) { return { s }; }
+    static UInt1 loadu(const uint32_t* const p) { return { *p }; }
+
+    // zero-extends 16-bit values
+    static UInt1 load_u16(const uint16_t* const p) { return { *p }; }
+
+    void storeu(uint32_t* const p) const { *p = v; }
+
+    // stores the low 16 bits of each lane
+    void store_u16(uint16_t* const p) const { *p = static_cast<uint16_t>(v); }
+};
+
+inline UInt1 operator+(UInt1 a, UInt1 b) { return { a.v + b.v }; }
+inline UInt1 operator-(UInt1 a, UInt1 b) { return { a.v - b.v }; }
+inline UInt1 operator&(UInt1 a, UInt1 b) { return { a.v & b.v }; }
+inline UInt1 operator|(UInt1 a, UInt1 b) { return { a.v | b.v }; }
+inline UInt1 operator^(UInt1 a, UInt1 b) { return { a.v ^ b.v }; }
+
+template<int N> inline UInt1 shift_left(UInt1 a) { return { a.v << N }; }
+template<int N> inline UInt1 shift_right(UInt1 a) { return { a.v >> N }; }
+
+// per-lane comparison results
+struct Mask1
+{
+    bool v;
+};
+
+// portable float16 conversion for the types without hardware support (see Half.inl)
+template<typename F> F half_to_float(typename F::UInt h);
+template<typename F> typename F::UInt float_to_half(F f);
+
+struct Float1
+{
+    static const size_t Width = 1;
+
+    typedef UInt1 UInt;
+    typedef Mask1 Mask;
+
+    float v;
+
+    static Float1 zero() { return { 0.0f }; }
+    static Float1 set1(float s) { return { s }; }
+    static Float1 loadu(const float* const p) { return { *p }; }
+
+    void storeu(float* const p) const { *p = v; }
+
+    // loads/stores float16 values, rounding to nearest even
+    static Float1 load_half(const uint16_t* const p) { return half_to_float<Float1>(UInt1::load_u16(p)); }
+
+    void store_half(uint16_t* const p) const { float_to_half(*this).store_u16(p); }
+
+    // loads/stores one Vector (array-of-structures)
+    static void load_aos(const float* const p, Float1& x, Float1& y, Float1& z, Float1& w)
+    {
+        x.v = p[0];
+        y.v = p[1];
+        z.v = p[2];
+        w.v = p[3];
+    }
+
+    static void store_aos(float* const p, Float1 x, Float1 y, Float1 z, Float1 w)
+    {
+        p[0] = x.v;
+        p[1] = y.v;
+        p[2] = z.v;
+        p[3] = w.v;
+    }
+};
+
+inline Float1 operator+(Float1 a, Float1 b) { return { a.v + b.v }; }
+inline Float1 operator-(Float1 a, Float1 b) { return { a.v - b.v }; }
+inline Float1 operator*(Float1 a, Float1 b) { return { a.v * b.v }; }
+inline Float1 operator/(Float1 a, Float1 b) { return { a.v / b.v }; }
+
+// a * b + c
+inline Float1 fmadd(Float1 a, Float1 b, Float1 c) { return { a.v * b.v + c.v }; }
+
+// bitmask of the lanes where a <= b
+inline unsigned int lanes_le(Float1 a, Float1 b) { return a.v <= b.v ? 1 : 0; }
+
+// converts the top 24 bits of each lane to a float in [0, 1)
+inline Float1 unit_float(UInt1 a) { return { static_cast<float>(a.v >> 8) * (1.0f / 16777216.0f) }; }
+
+inline Float1 sqrt(Float1 a) { return { std::sqrt(a.v) }; }
+
+// there's no scalar estimate instruction we can rely on
+// so this is exact, which satisfies every Precision
+inline Float1 rsqrt(Float1 a) { return { 1.0f / std::sqrt(a.v) }; }
+
+// lane-wise comparisons (false for NaNs), combine with & and |
+inline Mask1 operator<(Float1 a, Float1 b) { return { a.v < b.v }; }
+inline Mask1 operator<=(Float1 a, Float1 b) { return { a.v <= b.v }; }
+inline Mask1 operator>(Float1 a, Float1 b) { return { a.v > b.v }; }
+inline Mask1 operator>=(Float1 a, Float1 b) { return { a.v >= b.v }; }
+inline Mask1 operator&(Mask1 a, Mask1 b) { return { a.v && b.v }; }
+inline Mask1 operator|(Mask1 a, Mask1 b) { return { a.v || b.v }; }
+
+// bit i is set if lane i is true
+inline unsigned int bits(Mask1 m) { return m.v ? 1 : 0; }
+
+// a where m is true, b elsewhere
+inline Float1 select(Mask1 m, Float1 a, Float1 b) { return { m.v ? a.v : b.v }; }
+
+// NOTE: if either lane is NaN the result is the one from b (like SSE)
+inline Float1 minimum(Float1 a, Float1 b) { return { a.v < b.v ? a.v : b.v }; }
+inline Float1 maximum(Float1 a, Float1 b) { return { a.v > b.v ? a.v : b.v }; }
+
+// a where m is true, b elsewhere
+inline UInt1 select(Mask1 m, UInt1 a, UInt1 b) { return { m.v ? a.v : b.v }; }
+
+// reinterprets the bits of each lane
+inline UInt1 as_uint(Float1 a)
+{
+    UInt1 r;
+    std::memcpy(&r.v, &a.v, sizeof(r.v));
+    return r;
+}
+
+inline Float1 as_float(UInt1 a)
+{
+    Float1 r;
+    std::memcpy(&r.v, &a.v, sizeof(r.v));
+    return r;
+}
+
+// rounds to the nearest integer (ties to even) as a two's complement int32
+// NOTE: out of range lanes are undefined
+inline UInt1 round_to_int(Float1 a) { return { static_cast<uint32_t>(static_cast<int32_t>(std::nearbyint(a.v))) }; }
+
+// converts each lane as a two's complement int32
+inline Float1 to_float(UInt1 a) { return { static_cast<float>(static_cast<int32_t>(a.v)) }; }
@@ -0,0 +1,162 @@
+// 16-wide AVX-512 float
+//
+// NOTE: this is textually included inside of a kernel namespace
+// so it must not include any headers itself
+
+// companion unsigned 32-bit integer type
+struct UInt16
+{
+    __m512i v;
+
+    static UInt16 set1(uint32_t s) { return { _mm512_set1_epi32(static_cast<int>(s)) }; }
+    static UInt16 loadu(const uint32_t* const p) { return { _mm512_loadu_si512(p) }; }
+
+    // zero-extends 16-bit values
+    static UInt16 load_u16(const uint16_t* const p) { return { _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))) }; }
+
+    void storeu(uint32_t* const p) const { _mm512_storeu_si512(p, v); }
+
+    // stores the low 16 bits of each lane
+    void store_u16(uint16_t* const p) const { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm512_cvtepi32_epi16(v)); }
+};
+
+inline UInt16 operator+(UInt16 a, UInt16 b) { return { _mm512_add_epi32(a.v, b.v) }; }
+inline UInt16 operator-(UInt16 a, UInt16 b) { return { _mm512_sub_epi32(a.v, b.v) }; }
+inline UInt16 operator&(UInt16 a, UInt16 b) { return { _mm512_and_si512(a.v, b.v) }; }
+inline UInt16 operator|(UInt16 a, UInt16 b) { return { _mm512_or_si512(a.v, b.v) }; }
+inline UInt16 operator^(UInt16 a, UInt16 b) { return { _mm512_xor_si512(a.v, b.v) }; }
+
+template<int N> inline UInt16 shift_left(UInt16 a) { return { _mm512_slli_epi32(a.v, N) }; }
+template<int N> inline UInt16 shift_right(UInt16 a) { return { _mm512_srli_epi32(a.v, N) }; }
+
+// per-lane comparison results
+struct Mask16
+{
+    __mmask16 v;
+};
+
+struct Float16
+{
+    static const size_t Width = 16;
+
+    typedef UInt16 UInt;
+    typedef Mask16 Mask;
+
+    __m512 v;
+
+    static Float16 zero() { return { _mm512_setzero_ps() }; }
+    static Float16 set1(float s) { return { _mm512_set1_ps(s) }; }
+    static Float16 loadu(const float* const p) { return { _mm512_loadu_ps(p) }; }
+
+    void storeu(float* const p) const { _mm512_storeu_ps(p, v); }
+
+    // loads/stores float16 values, rounding to nearest even
+    static Float16 load_half(const uint16_t* const p) { return { _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))) }; }
+
+    void store_half(uint16_t* const p) const { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm512_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT)); }
+
+    // 4x4 transpose within each 128-bit lane
+    static void transpose(__m512& r0, __m512& r1, __m512& r2, __m512& r3)
+    {
+        const __m512 t0 = _mm512_unpacklo_ps(r0, r1);
+        const __m512 t1 = _mm512_unpackhi_ps(r0, r1);
+        const __m512 t2 = _mm512_unpacklo_ps(r2, r3);
+        const __m512 t3 = _mm512_unpackhi_ps(r2, r3);
+        r0 = _mm512_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        r1 = _mm512_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        r2 = _mm512_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        r3 = _mm512_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    }
+
+    // the in-lane transpose of 16 consecutive Vectors leaves lane j
+    // of 128-bit block i holding Vector 4j + i, this (self-inverse)
+    // permutation puts them back in their natural order
+    static __m512 natural_order(__m512 v)
+    {
+        const __m512i index = _mm512_set_epi32(15, 11, 7, 3, 14, 10, 6, 2, 13, 9, 5, 1, 12, 8, 4, 0);
+        return _mm512_permutexvar_ps(index, v);
+    }
+
+    // loads 16 consecutive Vectors (array-of-structures)
+    // and transposes them so that each register holds one component
+    static void load_aos(const float* const p, Float16& x, Float16& y, Float16& z, Float16& w)
+    {
+        __m512 r0 = _mm512_loadu_ps(p);
+        __m512 r1 = _mm512_loadu_ps(p + 16);
+        __m512 r2 = _mm512_loadu_ps(p + 32);
+        __m512 r3 = _mm512_loadu_ps(p + 48);
+        transpose(r0, r1, r2, r3);
+        x.v = natural_order(r0);
+        y.v = natural_order(r1);
+        z.v = natural_order(r2);
+        w.v = natural_order(r3);
+    }
+
+    static void store_aos(float* const p, Float16 x, Float16 y, Float16 z, Float16 w)
+    {
+        __m512 r0 = natural_order(x.v);
+        __m512 r1 = natural_order(y.v);
+        __m512 r2 = natural_order(z.v);
+        __m512 r3 = natural_order(w.v);
+        transpose(r0, r1, r2, r3);
+        _mm512_storeu_ps(p, r0);
+        _mm512_storeu_ps(p + 16, r1);
+        _mm512_storeu_ps(p + 32, r2);
+        _mm512_storeu_ps(p + 48, r3);
+    }
+};
+
+inline Float16 operator+(Float16 a, Float16 b) { return { _mm512_add_ps(a.v, b.v) }; }
+inline Float16 operator-(Float16 a, Float16 b) { return { _mm512_sub_ps(a.v, b.v) }; }
+inline Float16 operator*(Float16 a, Float16 b) { return { _mm512_mul_ps(a.v, b.v) }; }
+inline Float16 operator/(Float16 a, Float16 b) { return { _mm512_div_ps(a.v, b.v) }; }
+
+// a * b + c
+inline Float16 fmadd(Float16 a, Float16 b, Float16 c) { return { _mm512_fmadd_ps(a.v, b.v, c.v) }; }
+
+// bitmask of the lanes where a <= b
+inline unsigned int lanes_le(Float16 a, Float16 b) { return _mm512_cmp_ps_mask(a.v, b.v, _CMP_LE_OQ); }
+
+// converts the top 24 bits of each lane to a float in [0, 1)
+inline Float16 unit_float(UInt16 a) { return { _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_srli_epi32(a.v, 8)), _mm512_set1_ps(1.0f / 16777216.0f)) }; }
+
+inline Float16 sqrt(Float16 a) { return { _mm512_sqrt_ps(a.v) }; }
+
+// estimate, relative error <= 2^-14
+inline Float16 rsqrt(Float16 a) { return { _mm512_rsqrt14_ps(a.v) }; }
+
+// lane-wise comparisons (false for NaNs), combine with & and |
+inline Mask16 operator<(Float16 a, Float16 b) { return { _mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ) }; }
+inline Mask16 operator<=(Float16 a, Float16 b) { return { _mm512_cmp_ps_mask(a.v, b.v, _CMP_LE_OQ) }; }
+inline Mask16 operator>(Float16 a, Float16 b) { return { _mm512_cmp_ps_mask(a.v, b.v, _CMP_GT_OQ) }; }
+inline Mask16 operator>=(Float16 a, Float16 b) { return { _mm512_cmp_ps_mask(a.v, b.v, _CMP_GE_OQ) }; }
+inline Mask16 operator&(Mask16 a, Mask16 b) { return { static_cast<__mmask16>(a.v & b.v) }; }
+inline Mask16 operator|(Mask16 a, Mask16 b) { return { static_cast<__mmask16>(a.v | b.v) }; }
+
+// bit i is set if lane i is true
+inline unsigned int bits(Mask16 m) { return m.v; }
+
+// a where m is true, b elsewhere
+inline Float16 select(Mask16 m, Float16 a, Float16 b) { return { _mm512_mask_blend_ps(m.v, b.v, a.v) }; }
+
+// copies lane 3 of every group of 4 lanes over the group
+// (the w of each packed Vector when loaded with loadu())
+inline Float16 splat_w(Float16 a) { return { _mm512_permute_ps(a.v, _MM_SHUFFLE(3, 3, 3, 3)) }; }
+
+// NOTE: if either lane is NaN the result is the one from b (like SSE)
+inline Float16 minimum(Float16 a, Float16 b) { return { _mm512_min_ps(a.v, b.v) }; }
+inline Float16 maximum(Float16 a, Float16 b) { return { _mm512_max_ps(a.v, b.v) }; }
+
+// a where m is true, b elsewhere
+inline UInt16 select(Mask16 m, UInt16 a, UInt16 b) { return { _mm512_mask_blend_epi32(m.v, b.v, a.v) }; }
+
+// reinterprets the bits of each lane
+inline UInt16 as_uint(Float16 a) { return { _mm512_castps_si512(a.v) }; }
+inline Float16 as_float(UInt16 a) { return { _mm512_castsi512_ps(a.v) }; }
+
+// rounds to the nearest integer (ties to even) as a two's complement int32
+// NOTE: out of range lanes are undefined
+inline UInt16 round_to_int(Float16 a) { return { _mm512_cvtps_epi32(a.v) }; }
+
+// converts each lane as a two's complement int32
+inline Float16 to_float(UInt16 a) { return { _mm512_cvtepi32_ps(a.v) }; }
@@ -0,0 +1,150 @@
+// 4-wide SSE float
+//
+// NOTE: this is textually included inside of a kernel namespace
+// so it must not include any headers itself
+
+// companion unsigned 32-bit integer type
+struct UInt4
+{
+    __m128i v;
+
+    static UInt4 set1(uint32_t s) { return { _mm_set1_epi32(static_cast<int>(s)) }; }
+    static UInt4 loadu(const uint32_t* const p) { return { _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)) }; }
+
+    // zero-extends 16-bit values
+    static UInt4 load_u16(const uint16_t* const p)
+    {
+        return { _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)), _mm_setzero_si128()) };
+    }
+
+    void storeu(uint32_t* const p) const { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+
+    // stores the low 16 bits of each lane
+    void store_u16(uint16_t* const p) const
+    {
+        // SSE2 only has a signed saturating pack so sign-extend the low half first
+        const __m128i s = _mm_srai_epi32(_mm_slli_epi32(v, 16), 16);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_packs_epi32(s, s));
+    }
+};
+
+inline UInt4 operator+(UInt4 a, UInt4 b) { return { _mm_add_epi32(a.v, b.v) }; }
+inline UInt4 operator-(UInt4 a, UInt4 b) { return { _mm_sub_epi32(a.v, b.v) }; }
+inline UInt4 operator&(UInt4 a, UInt4 b) { return { _mm_and_si128(a.v, b.v) }; }
+inline UInt4 operator|(UInt4 a, UInt4 b) { return { _mm_or_si128(a.v, b.v) }; }
+inline UInt4 operator^(UInt4 a, UInt4 b) { return { _mm_xor_si128(a.v, b.v) }; }
+
+template<int N> inline UInt4 shift_left(UInt4 a) { return { _mm_slli_epi32(a.v, N) }; }
+template<int N> inline UInt4 shift_right(UInt4 a) { return { _mm_srli_epi32(a.v, N) }; }
+
+// per-lane comparison results
+struct Mask4
+{
+    __m128 v;
+};
+
+struct Float4
+{
+    static const size_t Width = 4;
+
+    typedef UInt4 UInt;
+    typedef Mask4 Mask;
+
+    __m128 v;
+
+    static Float4 zero() { return { _mm_setzero_ps() }; }
+    static Float4 set1(float s) { return { _mm_set1_ps(s) }; }
+    static Float4 loadu(const float* const p) { return { _mm_loadu_ps(p) }; }
+
+    void storeu(float* const p) const { _mm_storeu_ps(p, v); }
+
+    // loads/stores float16 values, rounding to nearest even
+    // NOTE: F16C isn't part of the SSE tiers so this is done in software
+    static Float4 load_half(const uint16_t* const p) { return half_to_float<Float4>(UInt4::load_u16(p)); }
+
+    void store_half(uint16_t* const p) const { float_to_half(*this).store_u16(p); }
+
+    // loads 4 consecutive Vectors (array-of-structures)
+    // and transposes them so that each register holds one component
+    static void load_aos(const float* const p, Float4& x, Float4& y, Float4& z, Float4& w)
+    {
+        __m128 r0 = _mm_loadu_ps(p);
+        __m128 r1 = _mm_loadu_ps(p + 4);
+        __m128 r2 = _mm_loadu_ps(p + 8);
+        __m128 r3 = _mm_loadu_ps(p + 12);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        x.v = r0;
+        y.v = r1;
+        z.v = r2;
+        w.v = r3;
+    }
+
+    static void store_aos(float* const p, Float4 x, Float4 y, Float4 z, Float4 w)
+    {
+        _MM_TRANSPOSE4_PS(x.v, y.v, z.v, w.v);
+        _mm_storeu_ps(p, x.v);
+        _mm_storeu_ps(p + 4, y.v);
+        _mm_storeu_ps(p + 8, z.v);
+        _mm_storeu_ps(p + 12, w.v);
+    }
+};
+
+inline Float4 operator+(Float4 a, Float4 b) { return { _mm_add_ps(a.v, b.v) }; }
+inline Float4 operator-(Float4 a, Float4 b) { return { _mm_sub_ps(a.v, b.v) }; }
+inline Float4 operator*(Float4 a, Float4 b) { return { _mm_mul_ps(a.v, b.v) }; }
+inline Float4 operator/(Float4 a, Float4 b) { return { _mm_div_ps(a.v, b.v) }; }
+
+// a * b + c
+// SSE has no fused multiply-add so this rounds twice
+inline Float4 fmadd(Float4 a, Float4 b, Float4 c) { return { _mm_add_ps(_mm_mul_ps(a.v, b.v), c.v) }; }
+
+// bitmask of the lanes where a <= b
+inline unsigned int lanes_le(Float4 a, Float4 b) { return static_cast<unsigned int>(_mm_movemask_ps(_mm_cmple_ps(a.v, b.v))); }
+
+// converts the top 24 bits of each lane to a float in [0, 1)
+inline Float4 unit_float(UInt4 a) { return { _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(a.v, 8)), _mm_set1_ps(1.0f / 16777216.0f)) }; }
+
+inline Float4 sqrt(Float4 a) { return { _mm_sqrt_ps(a.v) }; }
+
+// estimate, relative error <= 1.5 * 2^-12
+inline Float4 rsqrt(Float4 a) { return { _mm_rsqrt_ps(a.v) }; }
+
+// lane-wise comparisons (false for NaNs), combine with & and |
+inline Mask4 operator<(Float4 a, Float4 b) { return { _mm_cmplt_ps(a.v, b.v) }; }
+inline Mask4 operator<=(Float4 a, Float4 b) { return { _mm_cmple_ps(a.v, b.v) }; }
+inline Mask4 operator>(Float4 a, Float4 b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+inline Mask4 operator>=(Float4 a, Float4 b) { return { _mm_cmpge_ps(a.v, b.v) }; }
+inline Mask4 operator&(Mask4 a, Mask4 b) { return { _mm_and_ps(a.v, b.v) }; }
+inline Mask4 operator|(Mask4 a, Mask4 b) { return { _mm_or_ps(a.v, b.v) }; }
+
+// bit i is set if lane i is true
+inline unsigned int bits(Mask4 m) { return static_cast<unsigned int>(_mm_movemask_ps(m.v)); }
+
+// a where m is true, b elsewhere
+inline Float4 select(Mask4 m, Float4 a, Float4 b) { return { _mm_or_ps(_mm_and_ps(m.v, a.v), _mm_andnot_ps(m.v, b.v)) }; }
+
+// copies lane 3 of every group of 4 lanes over the group
+// (the w of each packed Vector when loaded with loadu())
+inline Float4 splat_w(Float4 a) { return { _mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(3, 3, 3, 3)) }; }
+
+// NOTE: if either lane is NaN the result is the one from b (like SSE)
+inline Float4 minimum(Float4 a, Float4 b) { return { _mm_min_ps(a.v, b.v) }; }
+inline Float4 maximum(Float4 a, Float4 b) { return { _mm_max_ps(a.v, b.v) }; }
+
+// a where m is true, b elsewhere
+inline UInt4 select(Mask4 m, UInt4 a, UInt4 b)
+{
+    const __m128i mi = _mm_castps_si128(m.v);
+    return { _mm_or_si128(_mm_and_si128(mi, a.v), _mm_andnot_si128(mi, b.v)) };
+}
+
+// reinterprets the bits of each lane
+inline UInt4 as_uint(Float4 a) { return { _mm_castps_si128(a.v) }; }
+inline Float4 as_float(UInt4 a) { return { _mm_castsi128_ps(a.v) }; }
+
+// rounds to the nearest integer (ties to even) as a two's complement int32
+// NOTE: out of range lanes are undefined
+inline UInt4 round_to_int(Float4 a) { return { _mm_cvtps_epi32(a.v) }; }
+
+// converts each lane as a two's complement int32
+inline Float4 to_float(UInt4 a) { return { _mm_cvtepi32_ps(a.v) }; }
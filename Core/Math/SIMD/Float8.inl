@@ -0,0 +1,160 @@
+// 8-wide AVX2/FMA float
+//
+// NOTE: this is textually included inside of a kernel namespace
+// so it must not include any headers itself
+
+// companion unsigned 32-bit integer type
+struct UInt8
+{
+    __m256i v;
+
+    static UInt8 set1(uint32_t s) { return { _mm256_set1_epi32(static_cast<int>(s)) }; }
+    static UInt8 loadu(const uint32_t* const p) { return { _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)) }; }
+
+    // zero-extends 16-bit values
+    static UInt8 load_u16(const uint16_t* const p) { return { _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) }; }
+
+    void storeu(uint32_t* const p) const { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+
+    // stores the low 16 bits of each lane
+    void store_u16(uint16_t* const p) const
+    {
+        const __m256i low = _mm256_and_si256(v, _mm256_set1_epi32(0xffff));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_packus_epi32(_mm256_castsi256_si128(low), _mm256_extracti128_si256(low, 1)));
+    }
+};
+
+inline UInt8 operator+(UInt8 a, UInt8 b) { return { _mm256_add_epi32(a.v, b.v) }; }
+inline UInt8 operator-(UInt8 a, UInt8 b) { return { _mm256_sub_epi32(a.v, b.v) }; }
+inline UInt8 operator&(UInt8 a, UInt8 b) { return { _mm256_and_si256(a.v, b.v) }; }
+inline UInt8 operator|(UInt8 a, UInt8 b) { return { _mm256_or_si256(a.v, b.v) }; }
+inline UInt8 operator^(UInt8 a, UInt8 b) { return { _mm256_xor_si256(a.v, b.v) }; }
+
+template<int N> inline UInt8 shift_left(UInt8 a) { return { _mm256_slli_epi32(a.v, N) }; }
+template<int N> inline UInt8 shift_right(UInt8 a) { return { _mm256_srli_epi32(a.v, N) }; }
+
+// per-lane comparison results
+struct Mask8
+{
+    __m256 v;
+};
+
+struct Float8
+{
+    static const size_t Width = 8;
+
+    typedef UInt8 UInt;
+    typedef Mask8 Mask;
+
+    __m256 v;
+
+    static Float8 zero() { return { _mm256_setzero_ps() }; }
+    static Float8 set1(float s) { return { _mm256_set1_ps(s) }; }
+    static Float8 loadu(const float* const p) { return { _mm256_loadu_ps(p) }; }
+
+    void storeu(float* const p) const { _mm256_storeu_ps(p, v); }
+
+    // loads/stores float16 values (F16C), rounding to nearest even
+    static Float8 load_half(const uint16_t* const p) { return { _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) }; }
+
+    void store_half(uint16_t* const p) const { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT)); }
+
+    // 4x4 transpose within each 128-bit lane
+    static void transpose(__m256& r0, __m256& r1, __m256& r2, __m256& r3)
+    {
+        const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+        const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+        const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+        const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+        r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    }
+
+    // loads 8 consecutive Vectors (array-of-structures)
+    // and transposes them so that each register holds one component
+    //
+    // row k holds Vectors k and k + 4 so that the in-lane transpose
+    // leaves the components in their natural order
+    static void load_aos(const float* const p, Float8& x, Float8& y, Float8& z, Float8& w)
+    {
+        __m256 r0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 16), 1);
+        __m256 r1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 20), 1);
+        __m256 r2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 24), 1);
+        __m256 r3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 12)), _mm_loadu_ps(p + 28), 1);
+        transpose(r0, r1, r2, r3);
+        x.v = r0;
+        y.v = r1;
+        z.v = r2;
+        w.v = r3;
+    }
+
+    static void store_aos(float* const p, Float8 x, Float8 y, Float8 z, Float8 w)
+    {
+        transpose(x.v, y.v, z.v, w.v);
+        _mm_storeu_ps(p, _mm256_castps256_ps128(x.v));
+        _mm_storeu_ps(p + 4, _mm256_castps256_ps128(y.v));
+        _mm_storeu_ps(p + 8, _mm256_castps256_ps128(z.v));
+        _mm_storeu_ps(p + 12, _mm256_castps256_ps128(w.v));
+        _mm_storeu_ps(p + 16, _mm256_extractf128_ps(x.v, 1));
+        _mm_storeu_ps(p + 20, _mm256_extractf128_ps(y.v, 1));
+        _mm_storeu_ps(p + 24, _mm256_extractf128_ps(z.v, 1));
+        _mm_storeu_ps(p + 28, _mm256_extractf128_ps(w.v, 1));
+    }
+};
+
+inline Float8 operator+(Float8 a, Float8 b) { return { _mm256_add_ps(a.v, b.v) }; }
+inline Float8 operator-(Float8 a, Float8 b) { return { _mm256_sub_ps(a.v, b.v) }; }
+inline Float8 operator*(Float8 a, Float8 b) { return { _mm256_mul_ps(a.v, b.v) }; }
+inline Float8 operator/(Float8 a, Float8 b) { return { _mm256_div_ps(a.v, b.v) }; }
+
+// a * b + c
+inline Float8 fmadd(Float8 a, Float8 b, Float8 c) { return { _mm256_fmadd_ps(a.v, b.v, c.v) }; }
+
+// bitmask of the lanes where a <= b
+inline unsigned int lanes_le(Float8 a, Float8 b) { return static_cast<unsigned int>(_mm256_movemask_ps(_mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ))); }
+
+// converts the top 24 bits of each lane to a float in [0, 1)
+inline Float8 unit_float(UInt8 a) { return { _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(a.v, 8)), _mm256_set1_ps(1.0f / 16777216.0f)) }; }
+
+inline Float8 sqrt(Float8 a) { return { _mm256_sqrt_ps(a.v) }; }
+
+// estimate, relative error <= 1.5 * 2^-12
+inline Float8 rsqrt(Float8 a) { return { _mm256_rsqrt_ps(a.v) }; }
+
+// lane-wise comparisons (false for NaNs), combine with & and |
+inline Mask8 operator<(Float8 a, Float8 b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ) }; }
+inline Mask8 operator<=(Float8 a, Float8 b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ) }; }
+inline Mask8 operator>(Float8 a, Float8 b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ) }; }
+inline Mask8 operator>=(Float8 a, Float8 b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ) }; }
+inline Mask8 operator&(Mask8 a, Mask8 b) { return { _mm256_and_ps(a.v, b.v) }; }
+inline Mask8 operator|(Mask8 a, Mask8 b) { return { _mm256_or_ps(a.v, b.v) }; }
+
+// bit i is set if lane i is true
+inline unsigned int bits(Mask8 m) { return static_cast<unsigned int>(_mm256_movemask_ps(m.v)); }
+
+// a where m is true, b elsewhere
+inline Float8 select(Mask8 m, Float8 a, Float8 b) { return { _mm256_blendv_ps(b.v, a.v, m.v) }; }
+
+// copies lane 3 of every group of 4 lanes over the group
+// (the w of each packed Vector when loaded with loadu())
+inline Float8 splat_w(Float8 a) { return { _mm256_permute_ps(a.v, _MM_SHUFFLE(3, 3, 3, 3)) }; }
+
+// NOTE: if either lane is NaN the result is the one from b (like SSE)
+inline Float8 minimum(Float8 a, Float8 b) { return { _mm256_min_ps(a.v, b.v) }; }
+inline Float8 maximum(Float8 a, Float8 b) { return { _mm256_max_ps(a.v, b.v) }; }
+
+// a where m is true, b elsewhere
+inline UInt8 select(Mask8 m, UInt8 a, UInt8 b) { return { _mm256_blendv_epi8(b.v, a.v, _mm256_castps_si256(m.v)) }; }
+
+// reinterprets the bits of each lane
+inline UInt8 as_uint(Float8 a) { return { _mm256_castps_si256(a.v) }; }
+inline Float8 as_float(UInt8 a) { return { _mm256_castsi256_ps(a.v) }; }
+
+// rounds to the nearest integer (ties to even) as a two's complement int32
+// NOTE: out of range lanes are undefined
+inline UInt8 round_to_int(Float8 a) { return { _mm256_cvtps_epi32(a.v) }; }
+
+// converts each lane as a two's complement int32
+inline Float8 to_float(UInt8 a) { return { _mm256_cvtepi32_ps(a.v) }; }
@@ -0,0 +1,60 @@
+// portable float16 (IEEE 754 binary16) conversion written against the FloatN interface
+// used by the types that don't have a hardware conversion (F16C or AVX-512)
+// and bit-for-bit identical to it: round to nearest even, denormals are kept,
+// overflow goes to infinity and NaNs stay quiet NaNs with the top of their payload
+//
+// based on the branchless conversions by Fabian Giesen
+// (https://gist.github.com/rygorous/2156668)
+//
+// NOTE: this is textually included inside of a kernel namespace
+// after the FloatN types
+
+// h holds a float16 in the low 16 bits of each lane
+template<typename F>
+F half_to_float(typename F::UInt h)
+{
+    typedef typename F::UInt U;
+
+    // move the exponent and mantissa into place and rebias the exponent
+    const U shifted = shift_left<13>(h & U::set1(0x7fff));
+    const F o = as_float(shifted + U::set1((127 - 15) << 23));
+
+    // infinities and NaNs need the rest of the exponent
+    // and zeros and denormals are renormalized by the FPU
+    const F inf_nan = as_float(as_uint(o) + U::set1((128 - 16) << 23));
+    const F magic = as_float(U::set1(113 << 23));
+    const F denormal = as_float(as_uint(o) + U::set1(1 << 23)) - magic;
+
+    // 65536 is one past the largest finite float16 after the rebias
+    // and 2^-14 is the smallest normal one
+    const F r = select(o >= F::set1(65536.0f), inf_nan, select(o < F::set1(6.103515625e-05f), denormal, o));
+    return as_float(as_uint(r) | shift_left<16>(h & U::set1(0x8000)));
+}
+
+// returns the float16 bits in the low 16 bits of each lane
+template<typename F>
+typename F::UInt float_to_half(F f)
+{
+    typedef typename F::UInt U;
+
+    const U bits = as_uint(f);
+    const U sign = bits & U::set1(0x80000000);
+    const U a = bits ^ sign;
+    const F abs = as_float(a);
+
+    // denormals are rounded by adding 0.5, which lines
+    // the float16 mantissa up with the bottom of the float mantissa
+    const U denorm_magic = U::set1(((127 - 15) + (23 - 10) + 1) << 23);
+    const U denormal = as_uint(abs + as_float(denorm_magic)) - denorm_magic;
+
+    // normals rebias the exponent and round to nearest even
+    const U mant_odd = shift_right<13>(a) & U::set1(1);
+    const U normal = shift_right<13>(a + U::set1((static_cast<uint32_t>(15 - 127) << 23) + 0xfff) + mant_odd);
+
+    // anything at or above 65520 rounds to infinity, NaNs keep the top of their payload
+    const U nan = U::set1(0x7e00) | (shift_right<13>(a) & U::set1(0x3ff));
+    const U overflow = select(abs <= F::set1(HUGE_VALF), U::set1(0x7c00), nan);
+
+    const U r = select(abs < F::set1(65536.0f), select(abs < F::set1(6.103515625e-05f), denormal, normal), overflow);
+    return r | shift_right<16>(sign);
+}
@@ -0,0 +1,87 @@
+// fills a KernelTable with every generic kernel instantiated for F
+//
+// NOTE: this is textually included inside of a kernel namespace
+// after all of the kernel .inl files
+
+template<typename F>
+void install_kernels(KernelTable& table)
+{
+    table.floats.invsqrt = stream::invsqrt<F>;
+    table.floats.sin = floats::sin<F>;
+    table.floats.cos = floats::cos<F>;
+    table.floats.sincos = floats::sincos<F>;
+    table.floats.atan = floats::atan<F>;
+    table.floats.atan2 = floats::atan2<F>;
+    table.floats.acos = floats::acos<F>;
+    table.floats.exp = floats::exp<F>;
+    table.floats.log = floats::log<F>;
+
+    table.stream.add = stream::add<F>;
+    table.stream.sub = stream::sub<F>;
+    table.stream.multiply = stream::multiply<F>;
+    table.stream.scale = stream::scale<F>;
+    table.stream.dot = stream::dot<F>;
+    table.stream.cross = stream::cross<F>;
+    table.stream.length_squared = stream::length_squared<F>;
+    table.stream.length = stream::length<F>;
+    table.stream.distance_squared = stream::distance_squared<F>;
+    table.stream.distance = stream::distance<F>;
+    table.stream.normalize = stream::normalize<F>;
+    table.stream.lerp = stream::lerp<F>;
+
+    table.array.multiply = array::multiply<F>;
+    table.array.dot = array::dot<F>;
+    table.array.cross = array::cross<F>;
+    table.array.length_squared = array::length_squared<F>;
+    table.array.length = array::length<F>;
+    table.array.normalize = array::normalize<F>;
+    table.array.angle = array::angle<F>;
+    table.array.angle_between = array::angle_between<F>;
+    table.array.transform = array::transform<F>;
+    table.array.transform_points = array::transform_points<F>;
+    table.array.transform_directions = array::transform_directions<F>;
+    table.array.rotate = array::rotate<F>;
+    table.array.rotate_each = array::rotate_each<F>;
+    table.array.sum = array::sum<F>;
+    table.array.dot_sum = array::dot_sum<F>;
+    table.array.bounds = array::bounds<F>;
+    table.array.to_stream = array::to_stream<F>;
+    table.array.from_stream = array::from_stream<F>;
+
+    table.random.uniform = rng::uniform<F>;
+    table.random.in_box = rng::in_box<F>;
+    table.random.unit_vectors = rng::unit_vectors<F>;
+    table.random.in_sphere = rng::in_sphere<F>;
+
+    table.ray.sphere = ray::sphere<F>;
+    table.ray.plane = ray::plane<F>;
+    table.ray.aabb = ray::aabb<F>;
+    table.ray.triangle = ray::triangle<F>;
+
+    table.cull.spheres = cull::spheres<F>;
+    table.cull.boxes = cull::boxes<F>;
+
+    table.color.srgb_to_linear = color::srgb_to_linear<F>;
+    table.color.linear_to_srgb = color::linear_to_srgb<F>;
+    table.color.pack_rgba8 = color::pack_rgba8<F>;
+    table.color.unpack_rgba8 = color::unpack_rgba8<F>;
+    table.color.pack_srgba8 = color::pack_srgba8<F>;
+    table.color.unpack_srgba8 = color::unpack_srgba8<F>;
+    table.color.pack_rgb10a2 = color::pack_rgb10a2<F>;
+    table.color.unpack_rgb10a2 = color::unpack_rgb10a2<F>;
+    table.color.premultiply = color::premultiply<F>;
+    table.color.unpremultiply = color::unpremultiply<F>;
+    table.color.blend_over = color::blend_over<F>;
+    table.color.blend_add = color::blend_add<F>;
+    table.color.blend_multiply = color::blend_multiply<F>;
+    table.color.blend_screen = color::blend_screen<F>;
+
+    table.encode.to_half = encode::to_half<F>;
+    table.encode.from_half = encode::from_half<F>;
+    table.encode.to_bfloat16 = encode::to_bfloat16<F>;
+    table.encode.from_bfloat16 = encode::from_bfloat16<F>;
+    table.encode.to_octahedral = encode::to_octahedral<F>;
+    table.encode.from_octahedral = encode::from_octahedral<F>;
+    table.encode.quantize = encode::quantize<F>;
+    table.encode.dequantize = encode::dequantize<F>;
+}
@@ -0,0 +1,43 @@
+// inverse square root at a compile-time Precision
+//
+// NOTE: this is textually included inside of a kernel namespace
+// after the FloatN types
+
+template<Precision P, typename F>
+inline F inverse_sqrt(F x)
+{
+    switch(P)
+    {
+    case Precision::Approximate:
+        return rsqrt(x);
+    case Precision::Refined:
+    {
+        // y' = y * (1.5 - 0.5 * x * y * y)
+        const F y = rsqrt(x);
+        return y * (F::set1(1.5f) - (F::set1(0.5f) * x) * (y * y));
+    }
+    case Precision::Exact:
+    default:
+        return F::set1(1.0f) / sqrt(x);
+    }
+}
+
+// calls body(p) where p is a std::integral_constant holding precision
+// so that kernels only branch on the precision once per batch
+template<typename Body>
+inline void with_precision(Precision precision, const Body& body)
+{
+    switch(precision)
+    {
+    case Precision::Approximate:
+        body(std::integral_constant<Precision, Precision::Approximate>());
+        break;
+    case Precision::Refined:
+        body(std::integral_constant<Precision, Precision::Refined>());
+        break;
+    case Precision::Exact:
+    default:
+        body(std::integral_constant<Precision, Precision::Exact>());
+        break;
+    }
+}
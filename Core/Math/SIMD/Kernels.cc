@@ -0,0 +1,192 @@
+#include "pch.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include "Core/Platform/CPU.h"
+#include "Kernels.h"
+
+namespace energonsoftware {
+namespace math {
+
+namespace {
+
+static const char* const SimdEnvironmentVariable = "ENERGONSOFTWARE_SIMD";
+
+std::string environment(const char* const name)
+{
+#if defined WIN32
+    char* value = nullptr;
+    size_t length = 0;
+    if(0 != _dupenv_s(&value, &length, name) || nullptr == value) {
+        return std::string();
+    }
+
+    std::string ret(value);
+    std::free(value);
+    return ret;
+#else
+    const char* const value = std::getenv(name);
+    return nullptr == value ? std::string() : std::string(value);
+#endif
+}
+
+bool parse_simd_level(std::string name, SimdLevel& level)
+{
+    std::transform(name.begin(), name.end(), name.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+
+    if("scalar" == name || "none" == name) {
+        level = SimdLevel::Scalar;
+    } else if("sse2" == name) {
+        level = SimdLevel::SSE2;
+    } else if("sse4.1" == name || "sse41" == name) {
+        level = SimdLevel::SSE41;
+    } else if("avx2" == name) {
+        level = SimdLevel::AVX2;
+    } else if("avx512" == name || "avx-512" == name) {
+        level = SimdLevel::AVX512;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+SimdLevel detect_max_simd_level()
+{
+#if defined SIMD_X86
+    const platform::CPUFeatures& cpu = platform::cpu_features();
+    if(cpu.avx512f && cpu.avx512dq && cpu.avx512bw && cpu.avx512vl && cpu.avx2 && cpu.fma) {
+        return SimdLevel::AVX512;
+    }
+
+    // every AVX2 CPU so far also has F16C but it's a separate feature bit
+    if(cpu.avx2 && cpu.fma && cpu.f16c) {
+        return SimdLevel::AVX2;
+    }
+
+    if(cpu.sse41) {
+        return SimdLevel::SSE41;
+    }
+
+    if(cpu.sse2) {
+        return SimdLevel::SSE2;
+    }
+#endif
+    return SimdLevel::Scalar;
+}
+
+KernelTable build_kernel_table(SimdLevel level)
+{
+    KernelTable table;
+    table.level = level;
+
+    install_scalar_kernels(table);
+#if defined SIMD_X86
+    if(level >= SimdLevel::SSE2) {
+        install_sse2_kernels(table);
+    }
+
+    if(level >= SimdLevel::SSE41) {
+        install_sse41_kernels(table);
+    }
+
+    if(level >= SimdLevel::AVX2) {
+        install_avx2_kernels(table);
+    }
+
+    if(level >= SimdLevel::AVX512) {
+        install_avx512_kernels(table);
+    }
+#endif
+    return table;
+}
+
+class Dispatcher
+{
+public:
+    static Dispatcher& instance()
+    {
+        static Dispatcher dispatcher;
+        return dispatcher;
+    }
+
+public:
+    SimdLevel max_level() const { return _max_level; }
+
+    const KernelTable& table(SimdLevel level) const
+    {
+        assert(level <= _max_level);
+        return _tables[static_cast<int>(level)];
+    }
+
+    const KernelTable& current() const { return *_current.load(std::memory_order_acquire); }
+
+    SimdLevel select(SimdLevel level)
+    {
+        level = std::min(level, _max_level);
+        _current.store(&table(level), std::memory_order_release);
+        return level;
+    }
+
+private:
+    Dispatcher()
+        : _max_level(detect_max_simd_level())
+    {
+        for(int i = 0; i <= static_cast<int>(_max_level); ++i) {
+            _tables[i] = build_kernel_table(static_cast<SimdLevel>(i));
+        }
+
+        SimdLevel level = _max_level;
+        parse_simd_level(environment(SimdEnvironmentVariable), level);
+        select(level);
+    }
+
+    DISALLOW_COPY_AND_ASSIGN(Dispatcher);
+
+private:
+    SimdLevel _max_level;
+    KernelTable _tables[static_cast<int>(SimdLevel::AVX512) + 1];
+    std::atomic<const KernelTable*> _current;
+};
+
+}
+
+const char* simd_level_name(SimdLevel level)
+{
+    switch(level)
+    {
+    case SimdLevel::Scalar:
+        return "scalar";
+    case SimdLevel::SSE2:
+        return "sse2";
+    case SimdLevel::SSE41:
+        return "sse4.1";
+    case SimdLevel::AVX2:
+        return "avx2";
+    case SimdLevel::AVX512:
+        return "avx512";
+    }
+    return "unknown";
+}
+
+const KernelTable& kernels()
+{
+    return Dispatcher::instance().current();
+}
+
+const KernelTable& kernels(SimdLevel level)
+{
+    return Dispatcher::instance().table(level);
+}
+
+SimdLevel max_simd_level()
+{
+    return Dispatcher::instance().max_level();
+}
+
+SimdLevel set_simd_level(SimdLevel level)
+{
+    return Dispatcher::instance().select(level);
+}
+
+} }
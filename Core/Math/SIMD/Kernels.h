@@ -0,0 +1,218 @@
+#if !defined __KERNELS_H__
+#define __KERNELS_H__
+
+#include "../Util.h"
+#include "RandomLanes.h"
+#include "StreamRef.h"
+
+#if defined _M_IX86 || defined _M_X64 || defined __i386__ || defined __x86_64__
+    #define SIMD_X86
+#endif
+
+namespace energonsoftware {
+namespace math {
+
+// instruction set tiers that batch kernels are compiled for
+// in increasing order of preference
+enum class SimdLevel
+{
+    Scalar,
+    SSE2,
+    SSE41,
+    AVX2,
+    AVX512
+};
+
+DllExport const char* simd_level_name(SimdLevel level);
+
+// kernels over flat float arrays
+struct FloatKernels
+{
+    void (*invsqrt)(const float* a, float* r, size_t count, Precision precision);
+
+    // elementary functions (see MathBatch.h)
+    void (*sin)(const float* a, float* r, size_t count);
+    void (*cos)(const float* a, float* r, size_t count);
+    void (*sincos)(const float* a, float* s, float* c, size_t count);
+    void (*atan)(const float* a, float* r, size_t count);
+    void (*atan2)(const float* y, const float* x, float* r, size_t count);
+    void (*acos)(const float* a, float* r, size_t count);
+    void (*exp)(const float* a, float* r, size_t count);
+    void (*log)(const float* a, float* r, size_t count);
+};
+
+// structure-of-arrays kernels (see VectorStream)
+struct StreamKernels
+{
+    void (*add)(ConstStreamRef a, ConstStreamRef b, StreamRef r, size_t count);
+    void (*sub)(ConstStreamRef a, ConstStreamRef b, StreamRef r, size_t count);
+    void (*multiply)(ConstStreamRef a, ConstStreamRef b, StreamRef r, size_t count);
+    void (*scale)(ConstStreamRef a, float s, StreamRef r, size_t count);
+    void (*dot)(ConstStreamRef a, ConstStreamRef b, float* r, size_t count);
+    void (*cross)(ConstStreamRef a, ConstStreamRef b, StreamRef r, size_t count);
+    void (*length_squared)(ConstStreamRef a, float* r, size_t count);
+    void (*length)(ConstStreamRef a, float* r, size_t count);
+    void (*distance_squared)(ConstStreamRef a, ConstStreamRef b, float* r, size_t count);
+    void (*distance)(ConstStreamRef a, ConstStreamRef b, float* r, size_t count);
+    void (*normalize)(ConstStreamRef a, StreamRef r, size_t count, Precision precision);
+    void (*lerp)(ConstStreamRef a, ConstStreamRef b, float t, StreamRef r, size_t count);
+};
+
+// array-of-structures kernels over packed Vectors (4 floats each)
+struct ArrayKernels
+{
+    void (*multiply)(const float* a, const float* b, float* r, size_t count);
+    void (*dot)(const float* a, const float* b, float* r, size_t count);
+    void (*cross)(const float* a, const float* b, float* r, size_t count);
+    void (*length_squared)(const float* a, float* r, size_t count);
+    void (*length)(const float* a, float* r, size_t count);
+    void (*normalize)(const float* a, float* r, size_t count, Precision precision);
+
+    // atan(y / x) of each vector and the angle between each pair times scale
+    void (*angle)(const float* a, float* r, size_t count);
+    void (*angle_between)(const float* a, const float* b, float scale, float* r, size_t count);
+
+    // m is a column-major 4x4 matrix
+    void (*transform)(const float* m, const float* a, float* r, size_t count);
+    void (*transform_points)(const float* m, const float* a, float* r, size_t count);
+    void (*transform_directions)(const float* m, const float* a, float* r, size_t count);
+
+    // q is a single quaternion (rotate) or count quaternions (rotate_each)
+    void (*rotate)(const float* q, const float* a, float* r, size_t count);
+    void (*rotate_each)(const float* q, const float* a, float* r, size_t count);
+
+    // reductions over every vector, r/minimum/maximum are a single packed Vector
+    // the lanes are folded in order so the result only depends on the tier
+    void (*sum)(const float* a, float* r, size_t count);
+    float (*dot_sum)(const float* a, const float* b, size_t count);
+    void (*bounds)(const float* a, float* minimum, float* maximum, size_t count);
+
+    // converts count Vectors to and from structure-of-arrays
+    void (*to_stream)(const float* a, StreamRef r, size_t count);
+    void (*from_stream)(ConstStreamRef a, float* r, size_t count);
+};
+
+// bulk random number kernels (see Random)
+// Vectors are written packed (4 floats each)
+struct RandomKernels
+{
+    void (*uniform)(RandomLanes& lanes, float* r, size_t count);
+    void (*in_box)(RandomLanes& lanes, const float* min, const float* max, float* r, size_t count);
+    void (*unit_vectors)(RandomLanes& lanes, float* r, size_t count);
+    void (*in_sphere)(RandomLanes& lanes, float radius, float* r, size_t count);
+};
+
+// packet ray intersection kernels (see RayBatch.h)
+// rays are origin + t * direction as structure-of-arrays (w is ignored)
+// primitives are packed Vectors (4 floats each), see the RayBatch.h functions
+// for the parameters and how t and hits are updated
+struct RayKernels
+{
+    size_t (*sphere)(ConstStreamRef origins, ConstStreamRef directions, const float* sphere, float* t, uint32_t* hits, size_t count);
+    size_t (*plane)(ConstStreamRef origins, ConstStreamRef directions, const float* plane, float* t, uint32_t* hits, size_t count);
+    size_t (*aabb)(ConstStreamRef origins, ConstStreamRef directions, const float* minimum, const float* maximum, float* t, uint32_t* hits, size_t count);
+    size_t (*triangle)(ConstStreamRef origins, ConstStreamRef directions, const float* v0, const float* v1, const float* v2, float* t, uint32_t* hits, size_t count);
+};
+
+// bulk culling against a set of planes (see Frustum)
+// planes are packed (normal, d) Vectors, anything in front of
+// every plane passes and its index is appended to visible
+// returns the number of indices written
+struct CullKernels
+{
+    // spheres are (center, radius)
+    size_t (*spheres)(ConstStreamRef spheres, const float* planes, size_t plane_count, uint32_t* visible, size_t count);
+    size_t (*boxes)(ConstStreamRef centers, ConstStreamRef half_extents, const float* planes, size_t plane_count, uint32_t* visible, size_t count);
+};
+
+// color kernels over packed RGBA Colors (see ColorBatch.h)
+// 8-bit and 10-bit formats are one uint32_t per color with red in the low bits
+struct ColorKernels
+{
+    void (*srgb_to_linear)(const float* a, float* r, size_t count);
+    void (*linear_to_srgb)(const float* a, float* r, size_t count);
+
+    void (*pack_rgba8)(const float* a, uint32_t* r, size_t count);
+    void (*unpack_rgba8)(const uint32_t* a, float* r, size_t count);
+    void (*pack_srgba8)(const float* a, uint32_t* r, size_t count);
+    void (*unpack_srgba8)(const uint32_t* a, float* r, size_t count);
+    void (*pack_rgb10a2)(const float* a, uint32_t* r, size_t count);
+    void (*unpack_rgb10a2)(const uint32_t* a, float* r, size_t count);
+
+    void (*premultiply)(const float* a, float* r, size_t count);
+    void (*unpremultiply)(const float* a, float* r, size_t count);
+
+    // src and dst are premultiplied
+    void (*blend_over)(const float* src, const float* dst, float* r, size_t count);
+    void (*blend_add)(const float* src, const float* dst, float* r, size_t count);
+    void (*blend_multiply)(const float* src, const float* dst, float* r, size_t count);
+    void (*blend_screen)(const float* src, const float* dst, float* r, size_t count);
+};
+
+// compact vector encodings (see VectorEncoding.h)
+struct EncodeKernels
+{
+    // count floats to and from float16 and bfloat16
+    void (*to_half)(const float* a, uint16_t* r, size_t count);
+    void (*from_half)(const uint16_t* a, float* r, size_t count);
+    void (*to_bfloat16)(const float* a, uint16_t* r, size_t count);
+    void (*from_bfloat16)(const uint16_t* a, float* r, size_t count);
+
+    // packed Vectors to and from 2 octahedral snorm16 coordinates, x in the low bits
+    void (*to_octahedral)(const float* a, uint32_t* r, size_t count);
+    void (*from_octahedral)(const uint32_t* a, float* r, size_t count);
+
+    // packed Vectors to and from 4 unorm16 per Vector, (v - offset) * scale
+    // offset and scale are single packed Vectors
+    void (*quantize)(const float* a, const float* offset, const float* scale, uint16_t* r, size_t count);
+    void (*dequantize)(const uint16_t* a, const float* offset, const float* scale, float* r, size_t count);
+};
+
+struct KernelTable
+{
+    SimdLevel level;
+
+    FloatKernels floats;
+    StreamKernels stream;
+    ArrayKernels array;
+    RandomKernels random;
+    RayKernels ray;
+    CullKernels cull;
+    ColorKernels color;
+    EncodeKernels encode;
+};
+
+/*
+Returns the kernels for the best instruction set supported by this CPU.
+
+The selection is made once, on first use, and can be forced down to a
+lower tier with the ENERGONSOFTWARE_SIMD environment variable
+(scalar, sse2, sse4.1, avx2 or avx512), which is useful for testing
+each tier on a single machine. Requesting an unsupported tier
+selects the best supported tier below it.
+*/
+DllExport const KernelTable& kernels();
+
+// the best tier supported by this CPU
+DllExport SimdLevel max_simd_level();
+
+// forces the active tier (clamped to max_simd_level())
+// and returns the tier actually selected
+// NOTE: this is intended for tests and benchmarks, it is not safe
+// to call while other threads are running batch operations
+DllExport SimdLevel set_simd_level(SimdLevel level);
+
+// the kernels for a specific tier, which must be supported
+DllExport const KernelTable& kernels(SimdLevel level);
+
+// each instruction set tier installs the kernels that it implements
+// over the top of the table built by the tiers below it
+void install_scalar_kernels(KernelTable& table);
+void install_sse2_kernels(KernelTable& table);
+void install_sse41_kernels(KernelTable& table);
+void install_avx2_kernels(KernelTable& table);
+void install_avx512_kernels(KernelTable& table);
+
+} }
+
+#endif
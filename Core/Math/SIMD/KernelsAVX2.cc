@@ -0,0 +1,40 @@
+#include "pch.h"
+#include "Kernels.h"
+#if defined SIMD_X86
+#if defined __GNUC__
+#pragma GCC target("avx2,fma,f16c")
+#endif
+#include <immintrin.h>
+
+namespace energonsoftware {
+namespace math {
+
+// 8-wide AVX2/FMA/F16C kernels
+namespace {
+
+#include "Float1.inl"
+#include "Float8.inl"
+#include "Half.inl"
+#include "MathFunctions.inl"
+#include "WideVector.inl"
+#include "WideMatrix.inl"
+#include "InvSqrt.inl"
+#include "StreamKernels.inl"
+#include "ArrayKernels.inl"
+#include "RandomKernels.inl"
+#include "RayKernels.inl"
+#include "CullKernels.inl"
+#include "ColorKernels.inl"
+#include "EncodeKernels.inl"
+#include "MathKernels.inl"
+#include "InstallKernels.inl"
+
+}
+
+void install_avx2_kernels(KernelTable& table)
+{
+    install_kernels<Float8>(table);
+}
+
+} }
+#endif
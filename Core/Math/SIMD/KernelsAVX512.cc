@@ -0,0 +1,45 @@
+#include "pch.h"
+#include "Kernels.h"
+#if defined SIMD_X86
+#if defined __GNUC__
+#pragma GCC target("avx512f,avx512dq,avx512bw,avx512vl,avx2,fma")
+#if !defined __clang__
+// GCC's own _mm512_undefined_*() helpers trip these warnings
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#endif
+#include <immintrin.h>
+
+namespace energonsoftware {
+namespace math {
+
+// 16-wide AVX-512 (F/DQ/BW/VL) kernels
+namespace {
+
+#include "Float1.inl"
+#include "Float16.inl"
+#include "Half.inl"
+#include "MathFunctions.inl"
+#include "WideVector.inl"
+#include "WideMatrix.inl"
+#include "InvSqrt.inl"
+#include "StreamKernels.inl"
+#include "ArrayKernels.inl"
+#include "RandomKernels.inl"
+#include "RayKernels.inl"
+#include "CullKernels.inl"
+#include "ColorKernels.inl"
+#include "EncodeKernels.inl"
+#include "MathKernels.inl"
+#include "InstallKernels.inl"
+
+}
+
+void install_avx512_kernels(KernelTable& table)
+{
+    install_kernels<Float16>(table);
+}
+
+} }
+#endif
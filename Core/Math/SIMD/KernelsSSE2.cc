@@ -0,0 +1,40 @@
+#include "pch.h"
+#include "Kernels.h"
+#if defined SIMD_X86
+#if defined __GNUC__
+#pragma GCC target("sse2")
+#endif
+#include <immintrin.h>
+
+namespace energonsoftware {
+namespace math {
+
+// 4-wide SSE2 kernels, the x86-64 baseline
+namespace {
+
+#include "Float1.inl"
+#include "Float4.inl"
+#include "Half.inl"
+#include "MathFunctions.inl"
+#include "WideVector.inl"
+#include "WideMatrix.inl"
+#include "InvSqrt.inl"
+#include "StreamKernels.inl"
+#include "ArrayKernels.inl"
+#include "RandomKernels.inl"
+#include "RayKernels.inl"
+#include "CullKernels.inl"
+#include "ColorKernels.inl"
+#include "EncodeKernels.inl"
+#include "MathKernels.inl"
+#include "InstallKernels.inl"
+
+}
+
+void install_sse2_kernels(KernelTable& table)
+{
+    install_kernels<Float4>(table);
+}
+
+} }
+#endif
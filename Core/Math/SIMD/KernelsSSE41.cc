@@ -0,0 +1,41 @@
+#include "pch.h"
+#include "Kernels.h"
+#if defined SIMD_X86
+#if defined __GNUC__
+#pragma GCC target("sse4.1")
+#endif
+#include <immintrin.h>
+
+namespace energonsoftware {
+namespace math {
+
+// 4-wide kernels built with SSE4.1 enabled so the compiler can use
+// the SSE4.1 blend, round and insert/extract instructions
+namespace {
+
+#include "Float1.inl"
+#include "Float4.inl"
+#include "Half.inl"
+#include "MathFunctions.inl"
+#include "WideVector.inl"
+#include "WideMatrix.inl"
+#include "InvSqrt.inl"
+#include "StreamKernels.inl"
+#include "ArrayKernels.inl"
+#include "RandomKernels.inl"
+#include "RayKernels.inl"
+#include "CullKernels.inl"
+#include "ColorKernels.inl"
+#include "EncodeKernels.inl"
+#include "MathKernels.inl"
+#include "InstallKernels.inl"
+
+}
+
+void install_sse41_kernels(KernelTable& table)
+{
+    install_kernels<Float4>(table);
+}
+
+} }
+#endif
@@ -0,0 +1,33 @@
+#include "pch.h"
+#include "Kernels.h"
+
+namespace energonsoftware {
+namespace math {
+
+// plain C++ reference kernels, always available
+namespace {
+
+#include "Float1.inl"
+#include "Half.inl"
+#include "MathFunctions.inl"
+#include "WideVector.inl"
+#include "WideMatrix.inl"
+#include "InvSqrt.inl"
+#include "StreamKernels.inl"
+#include "ArrayKernels.inl"
+#include "RandomKernels.inl"
+#include "RayKernels.inl"
+#include "CullKernels.inl"
+#include "ColorKernels.inl"
+#include "EncodeKernels.inl"
+#include "MathKernels.inl"
+#include "InstallKernels.inl"
+
+}
+
+void install_scalar_kernels(KernelTable& table)
+{
+    install_kernels<Float1>(table);
+}
+
+} }
@@ -0,0 +1,289 @@
+// elementary functions written against the FloatN interface
+// polynomial approximations from Cephes (http://www.netlib.org/cephes/)
+//
+// NOTE: this is textually included inside of a kernel namespace
+// after the FloatN types
+
+// |x|
+template<typename F>
+inline F abs(F x)
+{
+    return as_float(as_uint(x) & F::UInt::set1(0x7fffffff));
+}
+
+// the magnitude of x with the sign of s
+template<typename F>
+inline F copy_sign(F x, F s)
+{
+    typedef typename F::UInt U;
+    return as_float((as_uint(x) & U::set1(0x7fffffff)) | (as_uint(s) & U::set1(0x80000000)));
+}
+
+// ln(m) for x = m * 2^e with m in [sqrt(0.5), sqrt(2)), returns ln(m) and e
+// NOTE: zero, negative, denormal and non-finite lanes are undefined
+template<typename F>
+F log_significand(F x, F& e)
+{
+    typedef typename F::UInt U;
+
+    const U bits = as_uint(x);
+    e = to_float(shift_right<23>(bits) - U::set1(127));
+    F m = as_float((bits & U::set1(0x007fffff)) | U::set1(0x3f800000));
+
+    const typename F::Mask big = m > F::set1(1.41421356f);
+    m = select(big, m * F::set1(0.5f), m);
+    e = select(big, e + F::set1(1.0f), e);
+
+    // ln(1 + t)
+    const F t = m - F::set1(1.0f);
+    const F t2 = t * t;
+    F p = F::set1(7.0376836292e-2f);
+    p = fmadd(p, t, F::set1(-1.1514610310e-1f));
+    p = fmadd(p, t, F::set1(1.1676998740e-1f));
+    p = fmadd(p, t, F::set1(-1.2420140846e-1f));
+    p = fmadd(p, t, F::set1(1.4249322787e-1f));
+    p = fmadd(p, t, F::set1(-1.6668057665e-1f));
+    p = fmadd(p, t, F::set1(2.0000714765e-1f));
+    p = fmadd(p, t, F::set1(-2.4999993993e-1f));
+    p = fmadd(p, t, F::set1(3.3333331174e-1f));
+    return t + fmadd(p * t, t2, F::set1(-0.5f) * t2);
+}
+
+// base-2 logarithm of positive, normal x
+// NOTE: zero, negative, denormal and non-finite lanes are undefined
+template<typename F>
+F log2(F x)
+{
+    F e;
+    const F ln = log_significand(x, e);
+    return fmadd(ln, F::set1(1.44269504f), e);
+}
+
+// 2^x, saturating outside of [-126, 127]
+// NOTE: NaN lanes are undefined
+template<typename F>
+F exp2(F x)
+{
+    typedef typename F::UInt U;
+
+    x = minimum(maximum(x, F::set1(-126.0f)), F::set1(127.0f));
+
+    // x = n + f with f in [-0.5, 0.5]
+    const U n = round_to_int(x);
+    const F f = x - to_float(n);
+
+    F p = F::set1(1.535336188319500e-4f);
+    p = fmadd(p, f, F::set1(1.339887440266574e-3f));
+    p = fmadd(p, f, F::set1(9.618437357674640e-3f));
+    p = fmadd(p, f, F::set1(5.550332471162809e-2f));
+    p = fmadd(p, f, F::set1(2.402264791363012e-1f));
+    p = fmadd(p, f, F::set1(6.931472028550421e-1f));
+
+    // 2^n built directly in the exponent
+    const F scale = as_float(shift_left<23>(n + U::set1(127)));
+    return fmadd(p, f, F::set1(1.0f)) * scale;
+}
+
+// x^y for positive, normal x
+template<typename F>
+F pow(F x, F y)
+{
+    return exp2(y * log2(x));
+}
+
+// the error bounds of the functions below are documented in MathBatch.h
+//
+// the trigonometric reductions use pi/2 split into 4 parts (from SLEEF,
+// https://sleef.org/), the first 3 have at most 9 significant bits so q * part
+// is exact for |q| < 2^15 and x - q * pi/2 loses nothing for |x| < 51471
+
+// sin and cos of x
+// NOTE: infinite and NaN lanes are NaN, beyond |x| = 51471 the error
+// grows with |x| until the results are meaningless (but still in [-1, 1])
+template<typename F>
+void sincos(F x, F& s, F& c)
+{
+    typedef typename F::UInt U;
+
+    // x = q * pi/2 + r with r in [-pi/4, pi/4], q is clamped
+    // so that the conversion can't overflow (those lanes are already meaningless)
+    const U q = round_to_int(minimum(maximum(x * F::set1(0.636619772f), F::set1(-8388608.0f)), F::set1(8388608.0f)));
+    const F qf = to_float(q);
+    F r = fmadd(qf, F::set1(-1.5703125f), x);
+    r = fmadd(qf, F::set1(-4.8351287841796875e-4f), r);
+    r = fmadd(qf, F::set1(-3.1385570764541626e-7f), r);
+    r = fmadd(qf, F::set1(-6.0771006282767e-11f), r);
+    const F z = r * r;
+
+    // Cephes sinf() and cosf() polynomials over [-pi/4, pi/4]
+    F ps = F::set1(-1.9515295891e-4f);
+    ps = fmadd(ps, z, F::set1(8.3321608736e-3f));
+    ps = fmadd(ps, z, F::set1(-1.6666654611e-1f));
+    const F sin_r = fmadd(ps * z, r, r);
+
+    F pc = F::set1(2.443315711809948e-5f);
+    pc = fmadd(pc, z, F::set1(-1.388731625493765e-3f));
+    pc = fmadd(pc, z, F::set1(4.166664568298827e-2f));
+    const F cos_r = fmadd(pc * z, z, F::set1(1.0f) - F::set1(0.5f) * z);
+
+    // sin(r + q * pi/2) is sin(r), cos(r), -sin(r), -cos(r) for q = 0, 1, 2, 3 (mod 4)
+    // and cos(r + q * pi/2) is cos(r), -sin(r), -cos(r), sin(r)
+    const typename F::Mask odd = to_float(q & U::set1(1)) > F::zero();
+    const F sv = select(odd, cos_r, sin_r);
+    const F cv = select(odd, sin_r, cos_r);
+
+    // bit 1 of q (and of q + 1) moved up to the sign bit
+    const F sin_x = as_float(as_uint(sv) ^ shift_left<30>(q & U::set1(2)));
+    const F cos_x = as_float(as_uint(cv) ^ shift_left<30>((q + U::set1(1)) & U::set1(2)));
+
+    const typename F::Mask finite = abs(x) < F::set1(HUGE_VALF);
+    const F nan = x - x;
+    s = select(finite, minimum(maximum(sin_x, F::set1(-1.0f)), F::set1(1.0f)), nan);
+    c = select(finite, minimum(maximum(cos_x, F::set1(-1.0f)), F::set1(1.0f)), nan);
+}
+
+template<typename F>
+F sin(F x)
+{
+    F s, c;
+    sincos(x, s, c);
+    return s;
+}
+
+template<typename F>
+F cos(F x)
+{
+    F s, c;
+    sincos(x, s, c);
+    return c;
+}
+
+// atan(a) for a >= 0 (Cephes atanf()), infinity is pi/2
+template<typename F>
+F atan_positive(F a)
+{
+    // atan(a) = pi/2 + atan(-1/a) above tan(3pi/8)
+    // and pi/4 + atan((a - 1)/(a + 1)) above tan(pi/8)
+    const typename F::Mask big = a > F::set1(2.414213562373095f);
+    const typename F::Mask mid = a > F::set1(0.4142135623730950f);
+    const F one = F::set1(1.0f);
+    const F n = select(big, F::set1(-1.0f), select(mid, a - one, a));
+    const F d = select(big, a, select(mid, a + one, one));
+
+    // the offsets are split in 2 floats since they mostly cancel against t
+    const F offset = select(big, F::set1(1.57079637f), select(mid, F::set1(0.785398185f), F::zero()));
+    const F offset_low = select(big, F::set1(-4.37113883e-8f), select(mid, F::set1(-2.18556941e-8f), F::zero()));
+    const F t = n / d;
+    const F z = t * t;
+
+    F p = F::set1(8.05374449538e-2f);
+    p = fmadd(p, z, F::set1(-1.38776856032e-1f));
+    p = fmadd(p, z, F::set1(1.99777106478e-1f));
+    p = fmadd(p, z, F::set1(-3.33329491539e-1f));
+    return offset + (fmadd(p * z, t, t) + offset_low);
+}
+
+template<typename F>
+F atan(F x)
+{
+    return copy_sign(atan_positive(abs(x)), x);
+}
+
+// the angle of (x, y) in [-pi, pi], signed zeros are handled like std::atan2()
+// NOTE: lanes where both x and y are infinite are undefined
+template<typename F>
+F atan2(F y, F x)
+{
+    const F ax = abs(x);
+    const F ay = abs(y);
+
+    // atan of the smaller over the larger, which is in [0, 1]
+    const typename F::Mask steep = ay > ax;
+    const F n = select(steep, ax, ay);
+    const F d = select(steep, ay, ax);
+    F t = atan_positive(select(d > F::zero(), n / d, F::zero()));
+
+    // pi/2 - t for the steep half of each quadrant and pi - t for negative x,
+    // the constants are split in 2 floats to keep the results within an ulp or so
+    t = select(steep, (F::set1(1.57079637f) - t) + F::set1(-4.37113883e-8f), t);
+    t = select(copy_sign(F::set1(1.0f), x) < F::zero(), (F::set1(3.14159274f) - t) + F::set1(-8.74227766e-8f), t);
+    return copy_sign(t, y);
+}
+
+// arccosine of x in [-1, 1] (Cephes asinf()), anything outside is NaN
+template<typename F>
+F acos(F x)
+{
+    // asin(a) = pi/2 - 2 * asin(sqrt((1 - a) / 2)) above 0.5
+    const F a = abs(x);
+    const typename F::Mask big = a > F::set1(0.5f);
+    const F z = select(big, F::set1(0.5f) - F::set1(0.5f) * a, a * a);
+    const F s = select(big, sqrt(z), a);
+
+    F p = F::set1(4.2163199048e-2f);
+    p = fmadd(p, z, F::set1(2.4181311049e-2f));
+    p = fmadd(p, z, F::set1(4.5470025998e-2f));
+    p = fmadd(p, z, F::set1(7.4953002686e-2f));
+    p = fmadd(p, z, F::set1(1.6666752422e-1f));
+    const F asin_s = fmadd(p * z, s, s);
+
+    // acos(a) = 2 * asin(s) and acos(-a) = pi - 2 * asin(s) above 0.5
+    // and acos(x) = pi/2 - asin(x) below
+    const F twice = asin_s + asin_s;
+    const F outer = select(x < F::zero(), (F::set1(3.14159274f) - twice) + F::set1(-8.74227766e-8f), twice);
+    const F inner = (F::set1(1.57079637f) - copy_sign(asin_s, x)) + F::set1(-4.37113883e-8f);
+    return select(big, outer, inner);
+}
+
+// e^x (Cephes expf()), overflows to infinity above 88.72
+// and the results below FLT_MIN (x < -87.34) are denormal
+// NOTE: NaN lanes are undefined
+template<typename F>
+F exp(F x)
+{
+    typedef typename F::UInt U;
+
+    // below -104 and above 89 the result is already 0 or infinity
+    x = minimum(maximum(x, F::set1(-104.0f)), F::set1(89.0f));
+
+    // x = n * ln(2) + r with ln(2) split in 2 so that n * ln(2) is (nearly) exact
+    const U n = round_to_int(x * F::set1(1.44269504f));
+    const F nf = to_float(n);
+    F r = fmadd(nf, F::set1(-0.693359375f), x);
+    r = fmadd(nf, F::set1(2.12194440e-4f), r);
+    const F z = r * r;
+
+    F p = F::set1(1.9875691500e-4f);
+    p = fmadd(p, r, F::set1(1.3981999507e-3f));
+    p = fmadd(p, r, F::set1(8.3334519073e-3f));
+    p = fmadd(p, r, F::set1(4.1665795894e-2f));
+    p = fmadd(p, r, F::set1(1.6666665459e-1f));
+    p = fmadd(p, r, F::set1(5.0000001201e-1f));
+    p = fmadd(p, z, r) + F::set1(1.0f);
+
+    // 2^n as 2^h * 2^(n - h) so that both halves stay normal
+    // across the whole range, including the denormal results
+    const U h = round_to_int(nf * F::set1(0.5f));
+    const F scale_h = as_float(shift_left<23>(h + U::set1(127)));
+    const F scale_n = as_float(shift_left<23>(n - h + U::set1(127)));
+    return (p * scale_h) * scale_n;
+}
+
+// natural logarithm, log(0) is -infinity, log(infinity) is infinity
+// and negative and NaN lanes are NaN
+template<typename F>
+F log(F x)
+{
+    // denormals are scaled up by 2^24 first
+    const typename F::Mask denormal = x < F::set1(1.17549435e-38f);
+    F e;
+    const F ln = log_significand(select(denormal, x * F::set1(16777216.0f), x), e);
+    e = select(denormal, e - F::set1(24.0f), e);
+
+    // e * ln(2) + ln with ln(2) split in 2 (e * 0.693359375 is exact)
+    const F r = fmadd(e, F::set1(0.693359375f), fmadd(e, F::set1(-2.12194440e-4f), ln));
+
+    const F infinity = F::set1(HUGE_VALF);
+    const F special = select(x < F::zero(), infinity - infinity, F::zero() - infinity);
+    return select(x < infinity, select(x > F::zero(), r, special), x);
+}
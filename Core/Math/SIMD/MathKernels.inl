@@ -0,0 +1,78 @@
+// elementary function kernels over flat float arrays (see MathBatch.h)
+//
+// output arrays may alias input arrays
+//
+// NOTE: this is textually included inside of a kernel namespace
+// after StreamKernels.inl and MathFunctions.inl
+
+namespace floats {
+
+template<typename F>
+void sin(const float* a, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        sin(decltype(f)::loadu(a + i)).storeu(r + i);
+    });
+}
+
+template<typename F>
+void cos(const float* a, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        cos(decltype(f)::loadu(a + i)).storeu(r + i);
+    });
+}
+
+template<typename F>
+void sincos(const float* a, float* s, float* c, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        decltype(f) sv, cv;
+        sincos(decltype(f)::loadu(a + i), sv, cv);
+        sv.storeu(s + i);
+        cv.storeu(c + i);
+    });
+}
+
+template<typename F>
+void atan(const float* a, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        atan(decltype(f)::loadu(a + i)).storeu(r + i);
+    });
+}
+
+template<typename F>
+void atan2(const float* y, const float* x, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        typedef decltype(f) G;
+        atan2(G::loadu(y + i), G::loadu(x + i)).storeu(r + i);
+    });
+}
+
+template<typename F>
+void acos(const float* a, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        acos(decltype(f)::loadu(a + i)).storeu(r + i);
+    });
+}
+
+template<typename F>
+void exp(const float* a, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        exp(decltype(f)::loadu(a + i)).storeu(r + i);
+    });
+}
+
+template<typename F>
+void log(const float* a, float* r, size_t count)
+{
+    stream::run<F>(count, [=](auto f, size_t i) {
+        log(decltype(f)::loadu(a + i)).storeu(r + i);
+    });
+}
+
+}
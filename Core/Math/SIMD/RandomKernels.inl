@@ -0,0 +1,172 @@
+// bulk random number kernels built on RandomLanes
+// each block steps every generator once per random component
+// so the sequence does not depend on F::Width
+//
+// random Vectors are written packed (array-of-structures)
+//
+// NOTE: this is textually included inside of a kernel namespace
+// after Float1.inl, the wide FloatN type and WideVector.inl
+
+namespace rng {
+
+static const size_t Lanes = RandomLanes::Lanes;
+
+// steps every generator once and writes Lanes floats in [0, 1) to r
+template<typename F>
+inline void next(RandomLanes& lanes, float* r)
+{
+    typedef typename F::UInt U;
+
+    for(size_t i = 0; i < Lanes; i += F::Width) {
+        U s0 = U::loadu(lanes.s[0] + i);
+        U s1 = U::loadu(lanes.s[1] + i);
+        U s2 = U::loadu(lanes.s[2] + i);
+        U s3 = U::loadu(lanes.s[3] + i);
+
+        // xoshiro128+, only the top 24 bits are used
+        unit_float(s0 + s3).storeu(r + i);
+
+        const U t = shift_left<9>(s1);
+        s2 = s2 ^ s0;
+        s3 = s3 ^ s1;
+        s1 = s1 ^ s2;
+        s0 = s0 ^ s3;
+        s2 = s2 ^ t;
+        s3 = shift_left<11>(s3) ^ shift_right<21>(s3);
+
+        s0.storeu(lanes.s[0] + i);
+        s1.storeu(lanes.s[1] + i);
+        s2.storeu(lanes.s[2] + i);
+        s3.storeu(lanes.s[3] + i);
+    }
+}
+
+// appends the accepted lanes of a block to r and returns the new count
+inline size_t append(unsigned int accepted, const float* x, const float* y, const float* z, float* r, size_t n, size_t count)
+{
+    for(size_t i = 0; i < Lanes && n < count; ++i) {
+        if(0 != (accepted & (1u << i))) {
+            float* const v = r + n * 4;
+            v[0] = x[i];
+            v[1] = y[i];
+            v[2] = z[i];
+            v[3] = 0.0f;
+            ++n;
+        }
+    }
+    return n;
+}
+
+// count floats in [0, 1)
+template<typename F>
+void uniform(RandomLanes& lanes, float* r, size_t count)
+{
+    size_t i = 0;
+    for(; i + Lanes <= count; i += Lanes) {
+        next<F>(lanes, r + i);
+    }
+
+    if(i < count) {
+        float block[Lanes];
+        next<F>(lanes, block);
+        std::memcpy(r + i, block, (count - i) * sizeof(float));
+    }
+}
+
+// count Vectors uniformly distributed over the box [min, max)
+// min and max are 4 floats each
+template<typename F>
+void in_box(RandomLanes& lanes, const float* min, const float* max, float* r, size_t count)
+{
+    float u[4][Lanes];
+    float block[Lanes * 4];
+    for(size_t n = 0; n < count; n += Lanes) {
+        for(size_t k = 0; k < 4; ++k) {
+            next<F>(lanes, u[k]);
+        }
+
+        const size_t remaining = count - n < Lanes ? count - n : Lanes;
+        float* const out = Lanes == remaining ? r + n * 4 : block;
+        for(size_t i = 0; i < Lanes; i += F::Width) {
+            const WideVector<F> v = {
+                F::set1(min[0]) + F::set1(max[0] - min[0]) * F::loadu(u[0] + i),
+                F::set1(min[1]) + F::set1(max[1] - min[1]) * F::loadu(u[1] + i),
+                F::set1(min[2]) + F::set1(max[2] - min[2]) * F::loadu(u[2] + i),
+                F::set1(min[3]) + F::set1(max[3] - min[3]) * F::loadu(u[3] + i)
+            };
+            v.store_aos(out + i * 4);
+        }
+
+        if(out == block) {
+            std::memcpy(r + n * 4, block, remaining * 4 * sizeof(float));
+        }
+    }
+}
+
+// count Vectors uniformly distributed on the unit sphere (w = 0)
+template<typename F>
+void unit_vectors(RandomLanes& lanes, float* r, size_t count)
+{
+    float u[2][Lanes];
+    float x[Lanes], y[Lanes], z[Lanes];
+    for(size_t n = 0; n < count;) {
+        next<F>(lanes, u[0]);
+        next<F>(lanes, u[1]);
+
+        // Marsaglia (1972): pick (a, b) uniformly in the unit disc (~79% accepted)
+        // then (2a sqrt(1 - s), 2b sqrt(1 - s), 1 - 2s) with s = a^2 + b^2
+        // is uniform over the sphere without any trigonometry
+        unsigned int accepted = 0;
+        for(size_t i = 0; i < Lanes; i += F::Width) {
+            const F one = F::set1(1.0f);
+            const F two = F::set1(2.0f);
+
+            const F a = F::loadu(u[0] + i) * two - one;
+            const F b = F::loadu(u[1] + i) * two - one;
+            const F s = a * a + b * b;
+            accepted |= lanes_le(s, one) << i;
+
+            // rejected lanes may be NaN here, they are never appended
+            const F m = two * sqrt(one - s);
+            (a * m).storeu(x + i);
+            (b * m).storeu(y + i);
+            (one - two * s).storeu(z + i);
+        }
+
+        n = append(accepted, x, y, z, r, n, count);
+    }
+}
+
+// count Vectors uniformly distributed inside of a sphere (w = 0)
+template<typename F>
+void in_sphere(RandomLanes& lanes, float radius, float* r, size_t count)
+{
+    float u[3][Lanes];
+    float x[Lanes], y[Lanes], z[Lanes];
+    for(size_t n = 0; n < count;) {
+        for(size_t k = 0; k < 3; ++k) {
+            next<F>(lanes, u[k]);
+        }
+
+        // rejection sampling from the enclosing cube (~52% accepted)
+        unsigned int accepted = 0;
+        for(size_t i = 0; i < Lanes; i += F::Width) {
+            const F one = F::set1(1.0f);
+            const F two = F::set1(2.0f);
+            const F scale = F::set1(radius);
+
+            const F a = F::loadu(u[0] + i) * two - one;
+            const F b = F::loadu(u[1] + i) * two - one;
+            const F c = F::loadu(u[2] + i) * two - one;
+            accepted |= lanes_le(a * a + b * b + c * c, one) << i;
+
+            (a * scale).storeu(x + i);
+            (b * scale).storeu(y + i);
+            (c * scale).storeu(z + i);
+        }
+
+        n = append(accepted, x, y, z, r, n, count);
+    }
+}
+
+}
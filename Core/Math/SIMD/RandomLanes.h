@@ -0,0 +1,22 @@
+#if !defined __RANDOMLANES_H__
+#define __RANDOMLANES_H__
+
+#include <cstdint>
+
+namespace energonsoftware {
+namespace math {
+
+// state for the bulk random kernels: Lanes independent xoshiro128+ generators
+// word k of generator i is s[k][i] so that any SIMD width up to Lanes
+// can step several generators at once and every instruction set tier
+// produces the same sequence of random bits
+struct RandomLanes
+{
+    static const size_t Lanes = 16;
+
+    uint32_t s[4][Lanes];
+};
+
+} }
+
+#endif
@@ -0,0 +1,166 @@
+// packet ray intersection kernels, written once against the FloatN interface
+// every pass tests F::Width rays against a single primitive
+// and the remainder is finished with Float1
+//
+// each kernel computes the hit distance of every ray and then keeps
+// the hits between 0 and the ray's current t (see update()), misses
+// and hits behind the origin fall out of the comparisons as NaN or out of range
+//
+// NOTE: this is textually included inside of a kernel namespace
+// after Float1.inl, the wide FloatN type, WideVector.inl and StreamKernels.inl
+
+namespace ray {
+
+// x, y and z of the rays i to i + F::Width
+template<typename F>
+inline WideVector<F> load3(const ConstStreamRef& s, size_t i)
+{
+    return { F::loadu(s.x + i), F::loadu(s.y + i), F::loadu(s.z + i), F::zero() };
+}
+
+// a packed Vector in every lane
+template<typename F>
+inline WideVector<F> broadcast3(const float* const p)
+{
+    return { F::set1(p[0]), F::set1(p[1]), F::set1(p[2]), F::zero() };
+}
+
+template<typename F>
+inline F dot3(const WideVector<F>& a, const WideVector<F>& b)
+{
+    return fmadd(a.x, b.x, fmadd(a.y, b.y, a.z * b.z));
+}
+
+inline size_t bit_count(unsigned int b)
+{
+    size_t count = 0;
+    for(; 0 != b; b &= b - 1) {
+        ++count;
+    }
+    return count;
+}
+
+// keeps the hits at t_hit in [0, t] and writes the hit bits of the rays i to i + F::Width
+// returns the number of hits
+template<typename F, typename M>
+inline size_t update(M hit, F t_hit, float* t, uint32_t* hits, size_t i)
+{
+    const F current = F::loadu(t + i);
+    const M closer = hit & (t_hit >= F::zero()) & (t_hit <= current);
+    select(closer, t_hit, current).storeu(t + i);
+
+    // F::Width divides 32 so a block never straddles two words
+    const unsigned int b = bits(closer);
+    const uint32_t lanes = static_cast<uint32_t>((uint64_t(1) << F::Width) - 1) << (i % 32);
+    uint32_t& word = hits[i / 32];
+    word = (word & ~lanes) | (static_cast<uint32_t>(b) << (i % 32));
+    return bit_count(b);
+}
+
+// sphere is (center, radius), rays starting inside hit where they leave
+template<typename F>
+size_t sphere(ConstStreamRef origins, ConstStreamRef directions, const float* sphere, float* t, uint32_t* hits, size_t count)
+{
+    size_t found = 0;
+    stream::run<F>(count, [&](auto f, size_t i) {
+        typedef decltype(f) G;
+
+        const WideVector<G> oc = load3<G>(origins, i) - broadcast3<G>(sphere);
+        const WideVector<G> d = load3<G>(directions, i);
+
+        // a * t^2 + 2 * b * t + c = 0
+        const G a = dot3(d, d);
+        const G b = dot3(oc, d);
+        const G c = dot3(oc, oc) - G::set1(sphere[3] * sphere[3]);
+        const G discriminant = b * b - a * c;
+
+        const G root = sqrt(maximum(discriminant, G::zero()));
+        const G t0 = (G::zero() - b - root) / a;
+        const G t1 = (root - b) / a;
+        const G t_hit = select(t0 >= G::zero(), t0, t1);
+
+        found += update(discriminant >= G::zero(), t_hit, t, hits, i);
+    });
+    return found;
+}
+
+// plane is (normal, d) where normal * p + d = 0, both sides hit
+// rays parallel to the plane never do
+template<typename F>
+size_t plane(ConstStreamRef origins, ConstStreamRef directions, const float* plane, float* t, uint32_t* hits, size_t count)
+{
+    size_t found = 0;
+    stream::run<F>(count, [&](auto f, size_t i) {
+        typedef decltype(f) G;
+
+        const WideVector<G> n = broadcast3<G>(plane);
+        const G denominator = dot3(n, load3<G>(directions, i));
+        const G distance = dot3(n, load3<G>(origins, i)) + G::set1(plane[3]);
+        const G t_hit = (G::zero() - distance) / denominator;
+
+        found += update((denominator < G::zero()) | (denominator > G::zero()), t_hit, t, hits, i);
+    });
+    return found;
+}
+
+// slab test, see AABB::intersect_ray()
+// rays starting inside hit at 0
+template<typename F>
+size_t aabb(ConstStreamRef origins, ConstStreamRef directions, const float* box_minimum, const float* box_maximum, float* t, uint32_t* hits, size_t count)
+{
+    size_t found = 0;
+    stream::run<F>(count, [&](auto f, size_t i) {
+        typedef decltype(f) G;
+
+        const WideVector<G> o = load3<G>(origins, i);
+        const WideVector<G> d = load3<G>(directions, i);
+        const G one = G::set1(1.0f);
+
+        // infinite for 0 components
+        const G ix = one / d.x, iy = one / d.y, iz = one / d.z;
+        const G x1 = (G::set1(box_minimum[0]) - o.x) * ix, x2 = (G::set1(box_maximum[0]) - o.x) * ix;
+        const G y1 = (G::set1(box_minimum[1]) - o.y) * iy, y2 = (G::set1(box_maximum[1]) - o.y) * iy;
+        const G z1 = (G::set1(box_minimum[2]) - o.z) * iz, z2 = (G::set1(box_maximum[2]) - o.z) * iz;
+
+        const G t_near = maximum(maximum(minimum(x1, x2), minimum(y1, y2)), maximum(minimum(z1, z2), G::zero()));
+        const G t_far = minimum(minimum(maximum(x1, x2), maximum(y1, y2)), maximum(z1, z2));
+
+        found += update(t_near <= t_far, t_near, t, hits, i);
+    });
+    return found;
+}
+
+// Moller-Trumbore, both sides hit
+// rays in the plane of the triangle never do
+template<typename F>
+size_t triangle(ConstStreamRef origins, ConstStreamRef directions, const float* v0, const float* v1, const float* v2, float* t, uint32_t* hits, size_t count)
+{
+    const float e1[3] = { v1[0] - v0[0], v1[1] - v0[1], v1[2] - v0[2] };
+    const float e2[3] = { v2[0] - v0[0], v2[1] - v0[1], v2[2] - v0[2] };
+
+    size_t found = 0;
+    stream::run<F>(count, [&](auto f, size_t i) {
+        typedef decltype(f) G;
+
+        const WideVector<G> edge1 = broadcast3<G>(e1), edge2 = broadcast3<G>(e2);
+        const WideVector<G> d = load3<G>(directions, i);
+
+        const WideVector<G> p = cross(d, edge2);
+        const G determinant = dot3(edge1, p);
+        const G inv_determinant = G::set1(1.0f) / determinant;
+
+        // barycentric coordinates of the hit
+        const WideVector<G> s = load3<G>(origins, i) - broadcast3<G>(v0);
+        const G u = dot3(s, p) * inv_determinant;
+        const WideVector<G> q = cross(s, edge1);
+        const G v = dot3(d, q) * inv_determinant;
+
+        const G t_hit = dot3(edge2, q) * inv_determinant;
+
+        const auto inside = (u >= G::zero()) & (v >= G::zero()) & (u + v <= G::set1(1.0f));
+        found += update(((determinant < G::zero()) | (determinant > G::zero())) & inside, t_hit, t, hits, i);
+    });
+    return found;
+}
+
+}
@@ -0,0 +1,153 @@
+// structure-of-arrays batch kernels, written once against the FloatN interface
+// every kernel processes F::Width vectors per iteration
+// and finishes the remainder with Float1
+//
+// output streams may alias input streams
+//
+// NOTE: this is textually included inside of a kernel namespace
+// after Float1.inl, the wide FloatN type, WideVector.inl and InvSqrt.inl
+
+namespace stream {
+
+// calls body(f, i) for every F::Width block of the batch and then
+// for each remaining element, f only carries the type to work with
+template<typename F, typename Body>
+inline void run(size_t count, const Body& body)
+{
+    size_t i = 0;
+    for(; i + F::Width <= count; i += F::Width) {
+        body(F::zero(), i);
+    }
+
+    for(; i < count; ++i) {
+        body(Float1::zero(), i);
+    }
+}
+
+// inverse square root of each element of a flat float array
+template<typename F>
+void invsqrt(const float* a, float* r, size_t count, Precision precision)
+{
+    with_precision(precision, [=](auto p) {
+        run<F>(count, [=](auto f, size_t i) {
+            inverse_sqrt<decltype(p)::value>(decltype(f)::loadu(a + i)).storeu(r + i);
+        });
+    });
+}
+
+template<typename F>
+void add(ConstStreamRef a, ConstStreamRef b, StreamRef r, size_t count)
+{
+    run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        (V::load(a, i) + V::load(b, i)).store(r, i);
+    });
+}
+
+template<typename F>
+void sub(ConstStreamRef a, ConstStreamRef b, StreamRef r, size_t count)
+{
+    run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        (V::load(a, i) - V::load(b, i)).store(r, i);
+    });
+}
+
+template<typename F>
+void multiply(ConstStreamRef a, ConstStreamRef b, StreamRef r, size_t count)
+{
+    run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        multiply(V::load(a, i), V::load(b, i)).store(r, i);
+    });
+}
+
+template<typename F>
+void scale(ConstStreamRef a, float s, StreamRef r, size_t count)
+{
+    run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        (V::load(a, i) * decltype(f)::set1(s)).store(r, i);
+    });
+}
+
+template<typename F>
+void dot(ConstStreamRef a, ConstStreamRef b, float* r, size_t count)
+{
+    run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        dot(V::load(a, i), V::load(b, i)).storeu(r + i);
+    });
+}
+
+template<typename F>
+void cross(ConstStreamRef a, ConstStreamRef b, StreamRef r, size_t count)
+{
+    run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        cross(V::load(a, i), V::load(b, i)).store(r, i);
+    });
+}
+
+template<typename F>
+void length_squared(ConstStreamRef a, float* r, size_t count)
+{
+    run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        const V v = V::load(a, i);
+        dot(v, v).storeu(r + i);
+    });
+}
+
+template<typename F>
+void length(ConstStreamRef a, float* r, size_t count)
+{
+    run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        const V v = V::load(a, i);
+        sqrt(dot(v, v)).storeu(r + i);
+    });
+}
+
+template<typename F>
+void distance_squared(ConstStreamRef a, ConstStreamRef b, float* r, size_t count)
+{
+    run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        const V v = V::load(b, i) - V::load(a, i);
+        dot(v, v).storeu(r + i);
+    });
+}
+
+template<typename F>
+void distance(ConstStreamRef a, ConstStreamRef b, float* r, size_t count)
+{
+    run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        const V v = V::load(b, i) - V::load(a, i);
+        sqrt(dot(v, v)).storeu(r + i);
+    });
+}
+
+template<typename F>
+void normalize(ConstStreamRef a, StreamRef r, size_t count, Precision precision)
+{
+    with_precision(precision, [=](auto p) {
+        run<F>(count, [=](auto f, size_t i) {
+            using V = WideVector<decltype(f)>;
+            const V v = V::load(a, i);
+            (v * inverse_sqrt<decltype(p)::value>(dot(v, v))).store(r, i);
+        });
+    });
+}
+
+template<typename F>
+void lerp(ConstStreamRef a, ConstStreamRef b, float t, StreamRef r, size_t count)
+{
+    run<F>(count, [=](auto f, size_t i) {
+        using V = WideVector<decltype(f)>;
+        lerp(V::load(a, i), V::load(b, i), decltype(f)::set1(t)).store(r, i);
+    });
+}
+
+}
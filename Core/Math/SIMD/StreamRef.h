@@ -0,0 +1,37 @@
+#if !defined __STREAMREF_H__
+#define __STREAMREF_H__
+
+namespace energonsoftware {
+namespace math {
+
+// raw structure-of-arrays pointers for the batch kernels
+// each pointer refers to one component of the same set of vectors
+struct StreamRef
+{
+    float* x;
+    float* y;
+    float* z;
+    float* w;
+};
+
+struct ConstStreamRef
+{
+    const float* x;
+    const float* y;
+    const float* z;
+    const float* w;
+
+    ConstStreamRef(const float* x, const float* y, const float* z, const float* w)
+        : x(x), y(y), z(z), w(w)
+    {
+    }
+
+    ConstStreamRef(const StreamRef& r)
+        : x(r.x), y(r.y), z(r.z), w(r.w)
+    {
+    }
+};
+
+} }
+
+#endif
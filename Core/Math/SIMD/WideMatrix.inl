@@ -0,0 +1,53 @@
+// a column-major 4x4 matrix with every element broadcast to F::Width lanes
+// so that one matrix can be applied to a WideVector of different Vectors
+//
+// NOTE: this is textually included inside of a kernel namespace
+// after WideVector.inl
+
+template<typename F>
+struct WideMatrix
+{
+    typedef F Float;
+
+    F m[16];
+
+    explicit WideMatrix(const float* const matrix)
+    {
+        for(size_t i = 0; i < 16; ++i) {
+            m[i] = F::set1(matrix[i]);
+        }
+    }
+
+    // M * (x, y, z, w)
+    WideVector<F> transform(const F& x, const F& y, const F& z, const F& w) const
+    {
+        return {
+            m[0] * x + m[4] * y + m[8] * z + m[12] * w,
+            m[1] * x + m[5] * y + m[9] * z + m[13] * w,
+            m[2] * x + m[6] * y + m[10] * z + m[14] * w,
+            m[3] * x + m[7] * y + m[11] * z + m[15] * w
+        };
+    }
+
+    // M * (x, y, z, 1)
+    WideVector<F> transform_point(const F& x, const F& y, const F& z) const
+    {
+        return {
+            m[0] * x + m[4] * y + m[8] * z + m[12],
+            m[1] * x + m[5] * y + m[9] * z + m[13],
+            m[2] * x + m[6] * y + m[10] * z + m[14],
+            m[3] * x + m[7] * y + m[11] * z + m[15]
+        };
+    }
+
+    // M * (x, y, z, 0)
+    WideVector<F> transform_direction(const F& x, const F& y, const F& z) const
+    {
+        return {
+            m[0] * x + m[4] * y + m[8] * z,
+            m[1] * x + m[5] * y + m[9] * z,
+            m[2] * x + m[6] * y + m[10] * z,
+            m[3] * x + m[7] * y + m[11] * z
+        };
+    }
+};
@@ -0,0 +1,108 @@
+// a SIMD-width bundle of Vectors in structure-of-arrays form
+// F is one of the FloatN types and each lane holds a different Vector
+//
+// NOTE: this is textually included inside of a kernel namespace
+// so it must not include any headers itself
+
+template<typename F>
+struct WideVector
+{
+    F x, y, z, w;
+
+    static WideVector load(const ConstStreamRef& s, size_t i)
+    {
+        return { F::loadu(s.x + i), F::loadu(s.y + i), F::loadu(s.z + i), F::loadu(s.w + i) };
+    }
+
+    void store(const StreamRef& s, size_t i) const
+    {
+        x.storeu(s.x + i);
+        y.storeu(s.y + i);
+        z.storeu(s.z + i);
+        w.storeu(s.w + i);
+    }
+
+    // loads/stores F::Width packed Vectors (array-of-structures)
+    static WideVector load_aos(const float* const p)
+    {
+        WideVector v;
+        F::load_aos(p, v.x, v.y, v.z, v.w);
+        return v;
+    }
+
+    void store_aos(float* const p) const
+    {
+        F::store_aos(p, x, y, z, w);
+    }
+};
+
+template<typename F>
+inline WideVector<F> operator+(const WideVector<F>& a, const WideVector<F>& b)
+{
+    return { a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w };
+}
+
+template<typename F>
+inline WideVector<F> operator-(const WideVector<F>& a, const WideVector<F>& b)
+{
+    return { a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w };
+}
+
+template<typename F>
+inline WideVector<F> operator*(const WideVector<F>& a, F s)
+{
+    return { a.x * s, a.y * s, a.z * s, a.w * s };
+}
+
+// component-wise multiply (Vector::multiply)
+template<typename F>
+inline WideVector<F> multiply(const WideVector<F>& a, const WideVector<F>& b)
+{
+    return { a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w };
+}
+
+template<typename F>
+inline F dot(const WideVector<F>& a, const WideVector<F>& b)
+{
+    return fmadd(a.x, b.x, fmadd(a.y, b.y, fmadd(a.z, b.z, a.w * b.w)));
+}
+
+// 3-dimensional cross-product, w is always 0
+template<typename F>
+inline WideVector<F> cross(const WideVector<F>& a, const WideVector<F>& b)
+{
+    return {
+        a.y * b.z - a.z * b.y,
+        a.z * b.x - a.x * b.z,
+        a.x * b.y - a.y * b.x,
+        F::zero()
+    };
+}
+
+// rotates v.xyz by the unit quaternion q stored as (x, y, z, w), v.w is passed through
+template<typename F>
+inline WideVector<F> rotate(const WideVector<F>& q, const WideVector<F>& v)
+{
+    // v' = v + w * t + q.xyz x t where t = 2 * (q.xyz x v)
+    const WideVector<F> t = cross(q, v) * F::set1(2.0f);
+    const WideVector<F> u = cross(q, t);
+    return {
+        fmadd(t.x, q.w, v.x + u.x),
+        fmadd(t.y, q.w, v.y + u.y),
+        fmadd(t.z, q.w, v.z + u.z),
+        v.w
+    };
+}
+
+// (1 - t) * a + t * b, which is exact at both endpoints
+template<typename F>
+inline WideVector<F> lerp(const WideVector<F>& a, const WideVector<F>& b, F t)
+{
+    const F s = F::set1(1.0f) - t;
+    return {
+        fmadd(b.x, t, a.x * s),
+        fmadd(b.y, t, a.y * s),
+        fmadd(b.z, t, a.z * s),
+        fmadd(b.w, t, a.w * s)
+    };
+}
@@ -6,6 +6,18 @@
 #endif
 
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined USE_SSE
+// NOTE: only SSE/SSE2 may be used outside of the runtime-dispatched kernels
+// (see SIMD/Kernels.h) since that is all we can assume every CPU has
+#include <emmintrin.h>
+#endif
+
+#if defined __AVX__
+#include <immintrin.h>
+#endif
 
 namespace energonsoftware {
 namespace math {
@@ -99,27 +111,91 @@ inline unsigned int power_of_2(unsigned int i)
     return i + 1;
 }
 
-inline float invsqrt(float x)
+// precision of the inverse square root family (and everything built on it)
+enum class Precision
 {
+    // hardware estimate, about 12 bits
+    // (relative error < 2e-3 without SSE)
+    Approximate,
+
+    // estimate plus one Newton-Raphson iteration, about 22 bits
+    // (relative error < 5e-6 without SSE)
+    Refined,
+
+    // 1.0f / sqrt(x)
+    Exact
+};
+
 #if defined USE_SSE
-    __m128 V = _mm_set_ss(x);
-    _mm_store_ss(&x, _mm_rsqrt_ss(V));
+// 4-wide inverse square root
+// NOTE: the Refined result for 0 is NaN rather than infinity
+inline __m128 invsqrt(__m128 x, Precision precision = Precision::Refined)
+{
+    switch(precision)
+    {
+    case Precision::Approximate:
+        return _mm_rsqrt_ps(x);
+    case Precision::Refined:
+    {
+        // y' = y * (1.5 - 0.5 * x * y * y)
+        __m128 y = _mm_rsqrt_ps(x);
+        __m128 hx = _mm_mul_ps(_mm_set1_ps(0.5f), x);
+        return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(hx, _mm_mul_ps(y, y))));
+    }
+    case Precision::Exact:
+    default:
+        return _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(x));
+    }
+}
+#endif
+
+#if defined __AVX__
+// 8-wide inverse square root
+// NOTE: this is only available to translation units built with AVX enabled,
+// everything else should go through batch::invsqrt() which dispatches at runtime
+inline __m256 invsqrt(__m256 x, Precision precision = Precision::Refined)
+{
+    switch(precision)
+    {
+    case Precision::Approximate:
+        return _mm256_rsqrt_ps(x);
+    case Precision::Refined:
+    {
+        __m256 y = _mm256_rsqrt_ps(x);
+        __m256 hx = _mm256_mul_ps(_mm256_set1_ps(0.5f), x);
+        return _mm256_mul_ps(y, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(hx, _mm256_mul_ps(y, y))));
+    }
+    case Precision::Exact:
+    default:
+        return _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(x));
+    }
+}
+#endif
+
+inline float invsqrt(float x, Precision precision = Precision::Refined)
+{
+#if defined USE_SSE
+    _mm_store_ss(&x, invsqrt(_mm_set_ss(x), precision));
     return x;
-#elif 1
+#else
+    if(Precision::Exact == precision) {
+        return 1.0f / std::sqrt(x);
+    }
+
     // taken from http://www.beyond3d.com/content/articles/8/
     // and https://en.wikipedia.org/wiki/Fast_inverse_square_root
-    // TODO: this breaks strict-aliasing in gcc,
-    // is there a better way to do it?
+    // (using memcpy rather than pointer casts to avoid breaking strict-aliasing)
     static const float threehalfs = 1.5f;
     float xhalf = x * 0.5f;
-    int i = *reinterpret_cast<long*>(&x);       // evil floating point bit level hacking
+    int32_t i;
+    std::memcpy(&i, &x, sizeof(i));             // evil floating point bit level hacking
     i = 0x5f3759df - (i >> 1);                  // what the fuck?
-    x = *reinterpret_cast<float*>(&i);
+    std::memcpy(&x, &i, sizeof(x));
     x = x * (threehalfs - xhalf * x * x);       // 1st iteration
-    //x = x * (threehalfs - xhalf * x * x);       // 1st iteration, this can be removed
+    if(Precision::Refined == precision) {
+        x = x * (threehalfs - xhalf * x * x);   // 2nd iteration
+    }
     return x;
-#else
-    return 1.0f / std::sqrt(x);
 #endif
 }
 
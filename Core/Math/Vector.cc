@@ -1,4 +1,7 @@
 #include "pch.h"
+#include <cstring>
+#include "Random.h"
+#include "VectorText.h"
 #include "Vector.h"
 
 namespace energonsoftware {
@@ -25,18 +28,24 @@ Vector Vector::random()
 
 Vector Vector::random(float length)
 {
-    std::default_random_engine engine;
-    std::uniform_real_distribution<float> distribution(-0.5f, 0.5f);
-    auto generator = std::bind(distribution, engine);
-
-    return Vector(generator(), generator(), generator()).set_length(length);
+    return thread_random().unit_vector() * length;
 }
 
+// same text as streaming the components with std::fixed
+// but the string is the only allocation
 std::string Vector::str() const
 {
-    std::stringstream ss;
-    ss << "Vector(x:" << std::fixed << x() << ", y:" << y() << ", z:" << z() << ", w:" << w() << ")";
-    return ss.str();
+    static const char* const Labels[] = { "Vector(x:", ", y:", ", z:", ", w:" };
+
+    char buffer[4 * MaxFloatChars + 32];
+    char* p = buffer;
+    for(int i = 0; i < 4; ++i) {
+        const size_t length = std::strlen(Labels[i]);
+        std::memcpy(p, Labels[i], length);
+        p = to_chars(p + length, buffer + sizeof(buffer), _value[i], FloatFormat::Fixed, 6);
+    }
+    *p++ = ')';
+    return std::string(buffer, p);
 }
 
 } }
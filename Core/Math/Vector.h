@@ -6,6 +6,18 @@
 namespace energonsoftware {
 namespace math {
 
+/*
+Layout-stable storage for a Vector.
+
+This is guaranteed to have the same size, alignment and
+component order as Vector so it is safe to memcpy, write to disk
+or hand to another API without going through the Vector interface.
+*/
+struct ALIGN(16) VectorStorage
+{
+    float x, y, z, w;
+};
+
 /*
 Represents a size-agnostic Vector (based on a 4-dimensional vector)
 with specialization where required.
@@ -13,6 +25,10 @@ with specialization where required.
 For less-than-4-dimensional vectors, the unused components should be constrained to 0.
 Care should be taken to avoid misusing this class and to avoid
 mixing sizes where it is mathematically inappropriate to do so.
+
+Vector is deliberately non-virtual, trivially copyable and standard layout
+so that arrays of them are tightly packed (16 bytes each) and can be memcpy'd.
+Use PolymorphicVector if a virtual destructor is actually required.
 */
 class DllExport Vector
 {
@@ -33,6 +49,8 @@ public:
     static const Vector WAxis;
 
 public:
+    // uniformly distributed direction using the calling thread's
+    // generator (see seed_thread_random() in Random.h)
     // length = 1.0f
     static Vector random();
 
@@ -82,10 +100,25 @@ public:
         std::copy(v.begin(), v.end(), _value);
     }
 
+    explicit Vector(const VectorStorage& v)
+        : _value{v.x, v.y, v.z, v.w}
+    {
+    }
+
+#if defined USE_SSE
+    // see simd()
+    explicit Vector(__m128 v)
+    {
+        _mm_store_ps(_value, v);
+    }
+#endif
+
     DEFAULT_COPY_AND_ASSIGN(Vector);
 
     Vector(Vector&& v) = default;
-    virtual ~Vector() = default;
+
+    // NOTE: this must remain non-virtual (see the class comment)
+    ~Vector() = default;
 
 public:
     void x(float x) { _value[0] = x; }
@@ -102,6 +135,17 @@ public:
 
     const float* array() const { return _value; }
 
+    VectorStorage storage() const { return { x(), y(), z(), w() }; }
+
+#if defined USE_SSE
+    // the components as a register
+    // every SSE operation below goes register to register through simd()
+    // and Vector(__m128) so that chained arithmetic compiles down to
+    // one run of SIMD instructions without storing each temporary,
+    // and SIMD code outside of Vector can do the same
+    __m128 simd() const { return _mm_load_ps(_value); }
+#endif
+
     void zero() { _value[0] = _value[1] = _value[2] = _value[3] = 0.0f; }
 
     bool is_zero() const { return 0.0f == x() && 0.0f == y() && 0.0f == z() && 0.0f == w(); }
@@ -110,12 +154,8 @@ public:
     float length_squared() const
     {
 #if defined USE_SSE
-        float d;
-        __m128 A = _mm_load_ps(_value);
-        __m128 R1 = _mm_mul_ps(A, A);
-        __m128 R2 = _mm_hadd_ps(R1, R1);
-        _mm_store_ss(&d, _mm_hadd_ps(R2, R2));
-        return d;
+        __m128 A = simd();
+        return _mm_cvtss_f32(hsum(_mm_mul_ps(A, A)));
 #else
         return *this * *this;
 #endif
@@ -124,12 +164,8 @@ public:
     float length() const
     {
 #if defined USE_SSE
-        float d;
-        __m128 A = _mm_load_ps(_value);
-        __m128 R1 = _mm_mul_ps(A, A);
-        __m128 R2 = _mm_hadd_ps(R1, R1);
-        _mm_store_ss(&d, _mm_sqrt_ss(_mm_hadd_ps(R2, R2)));
-        return d;
+        __m128 A = simd();
+        return _mm_cvtss_f32(_mm_sqrt_ss(hsum(_mm_mul_ps(A, A))));
 #else
         return std::sqrt(length_squared());
 #endif
@@ -137,8 +173,9 @@ public:
 
     Vector& set_length(float len) { return *this *= len / length(); }
 
-    Vector& normalize() { return *this *= invsqrt(length_squared()); }
-    Vector normalized() const { return *this * invsqrt(length_squared()); }
+    // see Precision for the accuracy of each option
+    Vector& normalize(Precision precision = Precision::Refined) { return *this *= invsqrt(length_squared(), precision); }
+    Vector normalized(Precision precision = Precision::Refined) const { return *this * invsqrt(length_squared(), precision); }
 
     // TODO: this probably should use an epsilon
     bool perpendicular(const Vector& rhs) const { return *this * rhs == 0.0f; }
@@ -156,8 +193,25 @@ public:
         return MAX(ret, std::fabs(w()));
     }
 
-    float distance_squared(const Vector& other) const { return (other - *this).length_squared(); }
-    float distance(const Vector& other) const { return (other - *this).length(); }
+    float distance_squared(const Vector& other) const
+    {
+#if defined USE_SSE
+        __m128 D = _mm_sub_ps(other.simd(), simd());
+        return _mm_cvtss_f32(hsum(_mm_mul_ps(D, D)));
+#else
+        return (other - *this).length_squared();
+#endif
+    }
+
+    float distance(const Vector& other) const
+    {
+#if defined USE_SSE
+        __m128 D = _mm_sub_ps(other.simd(), simd());
+        return _mm_cvtss_f32(_mm_sqrt_ss(hsum(_mm_mul_ps(D, D))));
+#else
+        return (other - *this).length();
+#endif
+    }
 
     // angle wrt the x/y plane
     float angle() const { return std::atan(y() / x()); }
@@ -167,23 +221,49 @@ public:
 
     // interpolates between this point and rhs
     // t must be in [0, 1]
-    Vector lerp(const Vector& rhs, double t) const { return (1.0 - t) * *this + t * rhs; }
+    Vector lerp(const Vector& rhs, double t) const
+    {
+#if defined USE_SSE
+        // rounds exactly the same as the scalar version
+        __m128 S = _mm_set1_ps(static_cast<float>(1.0 - t));
+        __m128 T = _mm_set1_ps(static_cast<float>(t));
+        return Vector(_mm_add_ps(_mm_mul_ps(simd(), S), _mm_mul_ps(rhs.simd(), T)));
+#else
+        return (1.0 - t) * *this + t * rhs;
+#endif
+    }
 
     // multiplies two vectors (not a dot-product)
     // useful for colors and things that are not actually mathematical vectors
     Vector multiply(const Vector& rhs) const
     {
 #if defined USE_SSE
-        ALIGN(16) float p[4];
-        __m128 A = _mm_load_ps(_value);
-        __m128 B = _mm_load_ps(rhs._value);
-        _mm_store_ps(p, _mm_mul_ps(A, B));
-        return Vector(p);
+        return Vector(_mm_mul_ps(simd(), rhs.simd()));
 #else
         return Vector(x() * rhs.x(), y() * rhs.y(), z() * rhs.z(), w() * rhs.w());
 #endif
     }
 
+    // component-wise min/max (see AABB)
+    // NOTE: if either component is NaN the result is the one from rhs
+    Vector minimum(const Vector& rhs) const
+    {
+#if defined USE_SSE
+        return Vector(_mm_min_ps(simd(), rhs.simd()));
+#else
+        return Vector(MIN(x(), rhs.x()), MIN(y(), rhs.y()), MIN(z(), rhs.z()), MIN(w(), rhs.w()));
+#endif
+    }
+
+    Vector maximum(const Vector& rhs) const
+    {
+#if defined USE_SSE
+        return Vector(_mm_max_ps(simd(), rhs.simd()));
+#else
+        return Vector(MAX(x(), rhs.x()), MAX(y(), rhs.y()), MAX(z(), rhs.z()), MAX(w(), rhs.w()));
+#endif
+    }
+
     // creates a homogeneous 3-dimensional vector
     Vector homogeneous_position() const { return Vector(x(), y(), z(), 1.0f); }
     Vector homogeneous_direction() const { return Vector(x(), y(), z(), 0.0f); }
@@ -218,11 +298,7 @@ public:
     Vector operator+(const Vector& rhs) const
     {
 #if defined USE_SSE
-        ALIGN(16) float p[4];
-        __m128 A = _mm_load_ps(_value);
-        __m128 B = _mm_load_ps(rhs._value);
-        _mm_store_ps(p, _mm_add_ps(A, B));
-        return Vector(p);
+        return Vector(_mm_add_ps(simd(), rhs.simd()));
 #else
         return Vector(x() + rhs.x(), y() + rhs.y(), z() + rhs.z(), w() + rhs.w());
 #endif
@@ -231,9 +307,7 @@ public:
     Vector& operator+=(const Vector& rhs)
     {
 #if defined USE_SSE
-        __m128 A = _mm_load_ps(_value);
-        __m128 B = _mm_load_ps(rhs._value);
-        _mm_store_ps(_value, _mm_add_ps(A, B));
+        _mm_store_ps(_value, _mm_add_ps(simd(), rhs.simd()));
         return *this;
 #else
         return ((*this) = (*this) + rhs);
@@ -243,11 +317,7 @@ public:
     Vector operator-(const Vector& rhs) const
     {
 #if defined USE_SSE
-        ALIGN(16) float p[4];
-        __m128 A = _mm_load_ps(_value);
-        __m128 B = _mm_load_ps(rhs._value);
-        _mm_store_ps(p, _mm_sub_ps(A, B));
-        return Vector(p);
+        return Vector(_mm_sub_ps(simd(), rhs.simd()));
 #else
         return Vector(x() - rhs.x(), y() - rhs.y(), z() - rhs.z(), w() - rhs.w());
 #endif
@@ -256,9 +326,7 @@ public:
     Vector& operator-=(const Vector& rhs)
     {
 #if defined USE_SSE
-        __m128 A = _mm_load_ps(_value);
-        __m128 B = _mm_load_ps(rhs._value);
-        _mm_store_ps(_value, _mm_sub_ps(A, B));
+        _mm_store_ps(_value, _mm_sub_ps(simd(), rhs.simd()));
         return *this;
 #else
         return ((*this) = (*this) - rhs);
@@ -268,11 +336,7 @@ public:
     Vector operator*(float rhs) const
     {
 #if defined USE_SSE
-        ALIGN(16) float p[4];
-        __m128 A = _mm_load_ps(_value);
-        __m128 S = _mm_set1_ps(rhs);
-        _mm_store_ps(p, _mm_mul_ps(A, S));
-        return Vector(p);
+        return Vector(_mm_mul_ps(simd(), _mm_set1_ps(rhs)));
 #else
         return Vector(x() * rhs, y() * rhs, z() * rhs, w() * rhs);
 #endif
@@ -281,9 +345,7 @@ public:
     Vector& operator*=(float rhs)
     {
 #if defined USE_SSE
-        __m128 A = _mm_load_ps(_value);
-        __m128 S = _mm_set1_ps(rhs);
-        _mm_store_ps(_value, _mm_mul_ps(A, S));
+        _mm_store_ps(_value, _mm_mul_ps(simd(), _mm_set1_ps(rhs)));
         return *this;
 #else
         return *this = *this * rhs;
@@ -293,11 +355,7 @@ public:
     Vector operator/(float rhs) const
     {
 #if defined USE_SSE
-        ALIGN(16) float p[4];
-        __m128 A = _mm_load_ps(_value);
-        __m128 S = _mm_set1_ps(rhs);
-        _mm_store_ps(p, _mm_div_ps(A, S));
-        return Vector(p);
+        return Vector(_mm_div_ps(simd(), _mm_set1_ps(rhs)));
 #else
         return Vector(x() / rhs, y() / rhs, z() / rhs, w() / rhs);
 #endif
@@ -306,37 +364,29 @@ public:
     Vector& operator/=(float rhs)
     {
 #if defined USE_SSE
-        __m128 A = _mm_load_ps(_value);
-        __m128 S = _mm_set1_ps(rhs);
-        _mm_store_ps(_value, _mm_div_ps(A, S));
+        _mm_store_ps(_value, _mm_div_ps(simd(), _mm_set1_ps(rhs)));
         return *this;
 #else
         return ((*this) = (*this) / rhs);
 #endif
     }
 
-    Vector operator-() const { return Vector(-x(), -y(), -z(), -w()); }
+    Vector operator-() const
+    {
+#if defined USE_SSE
+        // flips the sign bits, exactly like the scalar negation
+        return Vector(_mm_xor_ps(simd(), _mm_set1_ps(-0.0f)));
+#else
+        return Vector(-x(), -y(), -z(), -w());
+#endif
+    }
 
     // dot-product
     float operator*(const Vector& rhs) const
     {
 #if defined USE_SSE
-        float d;
-        __m128 A = _mm_load_ps(_value);
-        __m128 B = _mm_load_ps(rhs._value);
-
-        // multiply the vector components
-        __m128 R1 = _mm_mul_ps(A, B);
-
-        // first horizontal add gives us
-        // [R1.3 + R1.2, R1.1 + R1.0, R1.3 + R1.2, R1.1 + R1.0]
-        __m128 R2 = _mm_hadd_ps(R1, R1);
-
-        // second horizontal add gives us
-        // [R2.3 + R2.2, R2.1 + R2.0, R2.3 + R2.2, R2.1 + R2.0]
-        // which finishes the sum
-        _mm_store_ss(&d, _mm_hadd_ps(R2, R2));
-        return d;
+        // multiply the vector components and sum them
+        return _mm_cvtss_f32(hsum(_mm_mul_ps(simd(), rhs.simd())));
 #else
         return x() * rhs.x() + y() * rhs.y() + z() * rhs.z() + w() * rhs.w();
 #endif
@@ -350,13 +400,7 @@ public:
         assert(0.0f == rhs[3]);
         assert(0 == reinterpret_cast<size_t>(rhs) % 16);
 #if defined USE_SSE
-        float d;
-        __m128 A = _mm_load_ps(_value);
-        __m128 B = _mm_load_ps(rhs);
-        __m128 R1 = _mm_mul_ps(A, B);
-        __m128 R2 = _mm_hadd_ps(R1, R1);
-        _mm_store_ss(&d, _mm_hadd_ps(R2, R2));
-        return d;
+        return _mm_cvtss_f32(hsum(_mm_mul_ps(simd(), _mm_load_ps(rhs))));
 #else
         return x() * rhs[0] + y() * rhs[1] + z() * rhs[2] + w() * rhs[3];
 #endif
@@ -366,25 +410,7 @@ public:
     Vector operator^(const Vector& rhs) const
     {
 #if defined USE_SSE
-        ALIGN(16) float p[4];
-        __m128 A = _mm_load_ps(_value);
-        __m128 B = _mm_load_ps(rhs._value);
-
-        // _MM_SHUFFLE(w, z, y, x) builds the 8-bit shuffle opcode
-        // first multiply has the following operands:
-        //      A1 = (y, z, x, w), B1 = (z, x, y, w) = (ay * bz, az * bx, ax * by, aw * bw)
-        // second multiply has the following operands:
-        //      A2 = (z, x, y, w), B2 = (y, z, x, w) = (az * by, ax * bz, ay * bx, aw * bw)
-        // final subtraction gives the proper cross-product:
-        //      (ay * bz - az * by, az * bx - ax * bz, ax * by - ay * bx, 0.0)
-
-        _mm_store_ps(p,
-            _mm_sub_ps(
-                _mm_mul_ps(_mm_shuffle_ps(A, A, _MM_SHUFFLE(3, 0, 2, 1)), _mm_shuffle_ps(B, B, _MM_SHUFFLE(3, 1, 0, 2))),
-                _mm_mul_ps(_mm_shuffle_ps(A, A, _MM_SHUFFLE(3, 1, 0, 2)), _mm_shuffle_ps(B, B, _MM_SHUFFLE(3, 0, 2, 1)))
-            )
-        );
-        return Vector(p);
+        return Vector(cross(simd(), rhs.simd()));
 #else
         return Vector(
             y() * rhs.z() - z() * rhs.y(),
@@ -397,9 +423,31 @@ public:
     Vector& operator^=(const Vector& rhs)
     {
 #if defined USE_SSE
-        __m128 A = _mm_load_ps(_value);
-        __m128 B = _mm_load_ps(rhs._value);
+        _mm_store_ps(_value, cross(simd(), rhs.simd()));
+        return *this;
+#else
+        return *this = *this ^ rhs;
+#endif
+    }
 
+public:
+    friend Vector operator*(float lhs, const Vector& rhs) { return rhs * lhs; }
+
+private:
+#if defined USE_SSE
+    // sums the 4 components of A into the lowest component
+    // NOTE: this only uses SSE (_mm_hadd_ps is SSE3, which we can't assume)
+    static __m128 hsum(__m128 A)
+    {
+        // [A.0 + A.2, A.1 + A.3, ...]
+        __m128 R1 = _mm_add_ps(A, _mm_movehl_ps(A, A));
+
+        // [R1.0 + R1.1, ...] which finishes the sum
+        return _mm_add_ss(R1, _mm_shuffle_ps(R1, R1, _MM_SHUFFLE(1, 1, 1, 1)));
+    }
+
+    static __m128 cross(__m128 A, __m128 B)
+    {
         // _MM_SHUFFLE(w, z, y, x) builds the 8-bit shuffle opcode
         // first multiply has the following operands:
         //      A1 = (y, z, x, w), B1 = (z, x, y, w) = (ay * bz, az * bx, ax * by, aw * bw)
@@ -407,26 +455,26 @@ public:
         //      A2 = (z, x, y, w), B2 = (y, z, x, w) = (az * by, ax * bz, ay * bx, aw * bw)
         // final subtraction gives the proper cross-product:
         //      (ay * bz - az * by, az * bx - ax * bz, ax * by - ay * bx, 0.0)
-
-        _mm_store_ps(_value,
-            _mm_sub_ps(
-                _mm_mul_ps(_mm_shuffle_ps(A, A, _MM_SHUFFLE(3, 0, 2, 1)), _mm_shuffle_ps(B, B, _MM_SHUFFLE(3, 1, 0, 2))),
-                _mm_mul_ps(_mm_shuffle_ps(A, A, _MM_SHUFFLE(3, 1, 0, 2)), _mm_shuffle_ps(B, B, _MM_SHUFFLE(3, 0, 2, 1)))
-            )
+        return _mm_sub_ps(
+            _mm_mul_ps(_mm_shuffle_ps(A, A, _MM_SHUFFLE(3, 0, 2, 1)), _mm_shuffle_ps(B, B, _MM_SHUFFLE(3, 1, 0, 2))),
+            _mm_mul_ps(_mm_shuffle_ps(A, A, _MM_SHUFFLE(3, 1, 0, 2)), _mm_shuffle_ps(B, B, _MM_SHUFFLE(3, 0, 2, 1)))
         );
-        return *this;
-#else
-        return *this = *this ^ rhs;
-#endif
     }
+#endif
 
-public:
-    friend Vector operator*(float lhs, const Vector& rhs) { return rhs * lhs; }
-
-private:
     ALIGN(16) float _value[4] = { 0, 0, 0, 0 };
 };
 
+static_assert(sizeof(Vector) == 16, "Vector must be exactly 4 floats");
+static_assert(alignof(Vector) == 16, "Vector must be 16-byte aligned");
+static_assert(std::is_standard_layout<Vector>::value, "Vector must be standard layout");
+static_assert(std::is_trivially_copyable<Vector>::value, "Vector must be trivially copyable");
+static_assert(std::is_trivially_destructible<Vector>::value, "Vector must be trivially destructible");
+
+static_assert(sizeof(VectorStorage) == sizeof(Vector), "VectorStorage must match the Vector layout");
+static_assert(alignof(VectorStorage) == alignof(Vector), "VectorStorage must match the Vector alignment");
+static_assert(std::is_pod<VectorStorage>::value, "VectorStorage must be POD");
+
 // some useful specializations that we can
 // derive from the more general Vector class
 using Vector2 = Vector;
@@ -0,0 +1,226 @@
+#include "pch.h"
+#include "Core/Concurrency/TaskScheduler.h"
+#include "SIMD/Kernels.h"
+#include "VectorBatch.h"
+
+namespace energonsoftware {
+namespace math {
+namespace batch {
+
+// NOTE: Vector is guaranteed to be exactly 4 packed floats
+// so arrays of them can be handed straight to the kernels
+
+void multiply(const Vector* const a, const Vector* const b, Vector* const out, size_t count)
+{
+    kernels().array.multiply(reinterpret_cast<const float*>(a), reinterpret_cast<const float*>(b), reinterpret_cast<float*>(out), count);
+}
+
+void dot(const Vector* const a, const Vector* const b, float* const out, size_t count)
+{
+    kernels().array.dot(reinterpret_cast<const float*>(a), reinterpret_cast<const float*>(b), out, count);
+}
+
+void cross(const Vector* const a, const Vector* const b, Vector* const out, size_t count)
+{
+    kernels().array.cross(reinterpret_cast<const float*>(a), reinterpret_cast<const float*>(b), reinterpret_cast<float*>(out), count);
+}
+
+void length_squared(const Vector* const v, float* const out, size_t count)
+{
+    kernels().array.length_squared(reinterpret_cast<const float*>(v), out, count);
+}
+
+void length(const Vector* const v, float* const out, size_t count)
+{
+    kernels().array.length(reinterpret_cast<const float*>(v), out, count);
+}
+
+void normalize(const Vector* const v, Vector* const out, size_t count, Precision precision)
+{
+    kernels().array.normalize(reinterpret_cast<const float*>(v), reinterpret_cast<float*>(out), count, precision);
+}
+
+void angle(const Vector* const v, float* const out, size_t count)
+{
+    kernels().array.angle(reinterpret_cast<const float*>(v), out, count);
+}
+
+void angle_radians(const Vector* const a, const Vector* const b, float* const out, size_t count)
+{
+    kernels().array.angle_between(reinterpret_cast<const float*>(a), reinterpret_cast<const float*>(b), 1.0f, out, count);
+}
+
+void angle_degrees(const Vector* const a, const Vector* const b, float* const out, size_t count)
+{
+    kernels().array.angle_between(reinterpret_cast<const float*>(a), reinterpret_cast<const float*>(b), static_cast<float>(RAD_DEG(1.0)), out, count);
+}
+
+void transform(const Matrix4& m, const Vector* const v, Vector* const out, size_t count)
+{
+    kernels().array.transform(m.array(), reinterpret_cast<const float*>(v), reinterpret_cast<float*>(out), count);
+}
+
+void transform_points(const Matrix4& m, const Vector* const v, Vector* const out, size_t count)
+{
+    kernels().array.transform_points(m.array(), reinterpret_cast<const float*>(v), reinterpret_cast<float*>(out), count);
+}
+
+void transform_directions(const Matrix4& m, const Vector* const v, Vector* const out, size_t count)
+{
+    kernels().array.transform_directions(m.array(), reinterpret_cast<const float*>(v), reinterpret_cast<float*>(out), count);
+}
+
+// NOTE: Quaternion is laid out exactly like Vector
+
+void rotate(const Quaternion& q, const Vector* const v, Vector* const out, size_t count)
+{
+    kernels().array.rotate(q.array(), reinterpret_cast<const float*>(v), reinterpret_cast<float*>(out), count);
+}
+
+void rotate(const Quaternion* const q, const Vector* const v, Vector* const out, size_t count)
+{
+    kernels().array.rotate_each(reinterpret_cast<const float*>(q), reinterpret_cast<const float*>(v), reinterpret_cast<float*>(out), count);
+}
+
+namespace {
+
+// the kernel results of a single ParallelChunkSize range
+
+Vector sum_chunk(const Vector* const v, size_t count)
+{
+    Vector r;
+    kernels().array.sum(reinterpret_cast<const float*>(v), reinterpret_cast<float*>(&r), count);
+    return r;
+}
+
+float dot_sum_chunk(const Vector* const a, const Vector* const b, size_t count)
+{
+    return kernels().array.dot_sum(reinterpret_cast<const float*>(a), reinterpret_cast<const float*>(b), count);
+}
+
+AABB bounds_chunk(const Vector* const v, size_t count)
+{
+    Vector minimum, maximum;
+    kernels().array.bounds(reinterpret_cast<const float*>(v), reinterpret_cast<float*>(&minimum), reinterpret_cast<float*>(&maximum), count);
+    return AABB(minimum, maximum);
+}
+
+}
+
+// NOTE: these fold the ranges exactly like TaskScheduler::parallel_reduce()
+
+Vector sum(const Vector* const v, size_t count)
+{
+    Vector r;
+    for(size_t begin = 0; begin < count; begin += ParallelChunkSize) {
+        r += sum_chunk(v + begin, MIN(ParallelChunkSize, count - begin));
+    }
+    return r;
+}
+
+float dot_sum(const Vector* const a, const Vector* const b, size_t count)
+{
+    float r = 0.0f;
+    for(size_t begin = 0; begin < count; begin += ParallelChunkSize) {
+        r += dot_sum_chunk(a + begin, b + begin, MIN(ParallelChunkSize, count - begin));
+    }
+    return r;
+}
+
+AABB bounds(const Vector* const v, size_t count)
+{
+    return bounds_chunk(v, count);
+}
+
+void invsqrt(const float* const x, float* const out, size_t count, Precision precision)
+{
+    kernels().floats.invsqrt(x, out, count, precision);
+}
+
+void transform(concurrency::TaskScheduler& scheduler, const Matrix4& m, const Vector* const v, Vector* const out, size_t count)
+{
+    scheduler.parallel_for(count, ParallelChunkSize, [&](size_t begin, size_t end) {
+        transform(m, v + begin, out + begin, end - begin);
+    });
+}
+
+void transform_points(concurrency::TaskScheduler& scheduler, const Matrix4& m, const Vector* const v, Vector* const out, size_t count)
+{
+    scheduler.parallel_for(count, ParallelChunkSize, [&](size_t begin, size_t end) {
+        transform_points(m, v + begin, out + begin, end - begin);
+    });
+}
+
+void transform_directions(concurrency::TaskScheduler& scheduler, const Matrix4& m, const Vector* const v, Vector* const out, size_t count)
+{
+    scheduler.parallel_for(count, ParallelChunkSize, [&](size_t begin, size_t end) {
+        transform_directions(m, v + begin, out + begin, end - begin);
+    });
+}
+
+void normalize(concurrency::TaskScheduler& scheduler, const Vector* const v, Vector* const out, size_t count, Precision precision)
+{
+    scheduler.parallel_for(count, ParallelChunkSize, [&](size_t begin, size_t end) {
+        normalize(v + begin, out + begin, end - begin, precision);
+    });
+}
+
+Vector sum(concurrency::TaskScheduler& scheduler, const Vector* const v, size_t count)
+{
+    return scheduler.parallel_reduce(count, ParallelChunkSize, Vector::Zero,
+        [v](size_t begin, size_t end) { return sum_chunk(v + begin, end - begin); },
+        [](const Vector& a, const Vector& b) { return a + b; });
+}
+
+float dot_sum(concurrency::TaskScheduler& scheduler, const Vector* const a, const Vector* const b, size_t count)
+{
+    return scheduler.parallel_reduce(count, ParallelChunkSize, 0.0f,
+        [a, b](size_t begin, size_t end) { return dot_sum_chunk(a + begin, b + begin, end - begin); },
+        [](float x, float y) { return x + y; });
+}
+
+AABB bounds(concurrency::TaskScheduler& scheduler, const Vector* const v, size_t count)
+{
+    return scheduler.parallel_reduce(count, ParallelChunkSize, AABB::Empty,
+        [v](size_t begin, size_t end) { return bounds_chunk(v + begin, end - begin); },
+        [](const AABB& a, const AABB& b) { return a.merged(b); });
+}
+
+void relative_to(const VectorD* const v, const VectorD& origin, Vector* const out, size_t count)
+{
+    const double* const a = origin.array();
+    float* const r = reinterpret_cast<float*>(out);
+#if defined __AVX__
+    const __m256d O = _mm256_loadu_pd(a);
+    for(size_t i = 0; i < count; ++i) {
+        _mm_store_ps(r + i * 4, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(v[i].array()), O)));
+    }
+#elif defined USE_SSE
+    const __m128d O0 = _mm_load_pd(a);
+    const __m128d O1 = _mm_load_pd(a + 2);
+    for(size_t i = 0; i < count; ++i) {
+        const double* const p = v[i].array();
+        _mm_store_ps(r + i * 4, _mm_movelh_ps(
+            _mm_cvtpd_ps(_mm_sub_pd(_mm_load_pd(p), O0)),
+            _mm_cvtpd_ps(_mm_sub_pd(_mm_load_pd(p + 2), O1))));
+    }
+#else
+    for(size_t i = 0; i < count; ++i) {
+        const double* const p = v[i].array();
+        for(size_t j = 0; j < 4; ++j) {
+            r[i * 4 + j] = static_cast<float>(p[j] - a[j]);
+        }
+    }
+#endif
+}
+
+void relative_to(const VectorFixed* const v, const VectorFixed& origin, Vector* const out, size_t count)
+{
+    // there's no packed 64-bit integer to float conversion before AVX-512
+    // so this is left to the compiler
+    for(size_t i = 0; i < count; ++i) {
+        out[i] = v[i].relative_to(origin);
+    }
+}
+
+} } }
@@ -0,0 +1,108 @@
+#if !defined __VECTORBATCH_H__
+#define __VECTORBATCH_H__
+
+#include "AABB.h"
+#include "Matrix4.h"
+#include "Quaternion.h"
+#include "Vector.h"
+#include "VectorD.h"
+#include "VectorFixed.h"
+
+namespace energonsoftware {
+
+namespace concurrency {
+class TaskScheduler;
+}
+
+namespace math {
+
+/*
+Batch versions of the Vector operations over packed arrays of Vectors.
+
+These run the best kernels for the current CPU (see SIMD/Kernels.h).
+Output arrays must have room for count elements and may alias the inputs.
+
+The overloads that take a TaskScheduler split the work into ranges
+of ParallelChunkSize elements and spread them over the scheduler's threads.
+The reductions always add up ParallelChunkSize ranges on their own and then
+the range results in order, with or without a scheduler, so the parallel
+and serial results are identical for any thread count (on the same SIMD tier).
+*/
+namespace batch {
+
+// multiplies two vectors (not a dot-product)
+DllExport void multiply(const Vector* const a, const Vector* const b, Vector* const out, size_t count);
+
+// dot-product
+DllExport void dot(const Vector* const a, const Vector* const b, float* const out, size_t count);
+
+// 3-dimensional cross-product
+DllExport void cross(const Vector* const a, const Vector* const b, Vector* const out, size_t count);
+
+DllExport void length_squared(const Vector* const v, float* const out, size_t count);
+DllExport void length(const Vector* const v, float* const out, size_t count);
+
+// see Precision for the accuracy of each option
+DllExport void normalize(const Vector* const v, Vector* const out, size_t count, Precision precision = Precision::Refined);
+
+// atan(y / x) of each vector (see Vector::angle())
+DllExport void angle(const Vector* const v, float* const out, size_t count);
+
+// the angle between each pair of vectors (see Vector::angle_radians())
+// this is computed from both the sine and the cosine, so unlike Vector::angle_radians()
+// it stays accurate for (nearly) parallel and opposite vectors, zero vectors give 0
+DllExport void angle_radians(const Vector* const a, const Vector* const b, float* const out, size_t count);
+DllExport void angle_degrees(const Vector* const a, const Vector* const b, float* const out, size_t count);
+
+// m * v for each vector
+DllExport void transform(const Matrix4& m, const Vector* const v, Vector* const out, size_t count);
+
+// m * (x, y, z, 1) for each vector, regardless of its w
+DllExport void transform_points(const Matrix4& m, const Vector* const v, Vector* const out, size_t count);
+
+// m * (x, y, z, 0) for each vector, regardless of its w
+DllExport void transform_directions(const Matrix4& m, const Vector* const v, Vector* const out, size_t count);
+
+// rotates each vector by q (see Quaternion::rotate())
+DllExport void rotate(const Quaternion& q, const Vector* const v, Vector* const out, size_t count);
+
+// rotates each vector by the matching quaternion in q
+DllExport void rotate(const Quaternion* const q, const Vector* const v, Vector* const out, size_t count);
+
+// component-wise sum of every vector
+DllExport Vector sum(const Vector* const v, size_t count);
+
+// sum of the dot-products of each pair
+DllExport float dot_sum(const Vector* const a, const Vector* const b, size_t count);
+
+// the bounds of x, y and z of every vector, empty if count is 0
+DllExport AABB bounds(const Vector* const v, size_t count);
+
+// inverse square root of each element
+DllExport void invsqrt(const float* const x, float* const out, size_t count, Precision precision = Precision::Refined);
+
+// the number of elements each thread is handed at a time by the parallel overloads,
+// 256KB of Vectors and a multiple of a cache line of Vector or float output
+static const size_t ParallelChunkSize = 16384;
+
+// parallel versions of the above
+DllExport void transform(concurrency::TaskScheduler& scheduler, const Matrix4& m, const Vector* const v, Vector* const out, size_t count);
+DllExport void transform_points(concurrency::TaskScheduler& scheduler, const Matrix4& m, const Vector* const v, Vector* const out, size_t count);
+DllExport void transform_directions(concurrency::TaskScheduler& scheduler, const Matrix4& m, const Vector* const v, Vector* const out, size_t count);
+DllExport void normalize(concurrency::TaskScheduler& scheduler, const Vector* const v, Vector* const out, size_t count, Precision precision = Precision::Refined);
+DllExport Vector sum(concurrency::TaskScheduler& scheduler, const Vector* const v, size_t count);
+DllExport float dot_sum(concurrency::TaskScheduler& scheduler, const Vector* const a, const Vector* const b, size_t count);
+DllExport AABB bounds(concurrency::TaskScheduler& scheduler, const Vector* const v, size_t count);
+
+// (v - origin) for each vector as float Vectors for rendering
+// see VectorD::relative_to() and VectorFixed::relative_to()
+// NOTE: these don't go through the kernels, the double version uses
+// the baseline instruction set (SSE2, or AVX if the build enables it)
+DllExport void relative_to(const VectorD* const v, const VectorD& origin, Vector* const out, size_t count);
+DllExport void relative_to(const VectorFixed* const v, const VectorFixed& origin, Vector* const out, size_t count);
+
+}
+
+} }
+
+#endif
@@ -0,0 +1,32 @@
+#include "pch.h"
+#include "VectorD.h"
+
+namespace energonsoftware {
+namespace math {
+
+const VectorD VectorD::Zero(0.0, 0.0, 0.0, 0.0);
+
+const VectorD VectorD::XAxis(1.0, 0.0, 0.0);
+const VectorD VectorD::YAxis(0.0, 1.0, 0.0);
+const VectorD VectorD::ZAxis(0.0, 0.0, 1.0);
+const VectorD VectorD::WAxis(0.0, 0.0, 0.0, 1.0);
+
+Vector VectorD::vector() const
+{
+#if defined __AVX__
+    return Vector(_mm256_cvtpd_ps(_mm256_loadu_pd(_value)));
+#elif defined USE_SSE
+    return Vector(_mm_movelh_ps(_mm_cvtpd_ps(_mm_load_pd(_value)), _mm_cvtpd_ps(_mm_load_pd(_value + 2))));
+#else
+    return Vector(static_cast<float>(x()), static_cast<float>(y()), static_cast<float>(z()), static_cast<float>(w()));
+#endif
+}
+
+std::string VectorD::str() const
+{
+    std::stringstream ss;
+    ss << "VectorD(x:" << std::fixed << x() << ", y:" << y() << ", z:" << z() << ", w:" << w() << ")";
+    return ss.str();
+}
+
+} }
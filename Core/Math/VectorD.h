@@ -0,0 +1,317 @@
+#if !defined __VECTORD_H__
+#define __VECTORD_H__
+
+#include "Vector.h"
+
+namespace energonsoftware {
+namespace math {
+
+/*
+Double-precision version of Vector for positions that
+outgrow float (float only has 1mm precision out to about 16km).
+
+This has the same API as Vector. The arithmetic runs 4 doubles at a time
+with AVX (__m256d) or 2 at a time with SSE2 (__m128d) depending on the build.
+
+Rendering should stay in float by converting positions relative to the camera,
+see relative_to() and batch::relative_to() (VectorBatch.h), which subtract
+in double before converting so that nearby geometry keeps full float precision.
+
+Like Vector this is non-virtual and trivially copyable.
+*/
+class DllExport VectorD
+{
+public:
+    static const VectorD Zero;
+
+    static const VectorD XAxis;
+    static const VectorD YAxis;
+    static const VectorD ZAxis;
+    static const VectorD WAxis;
+
+public:
+    VectorD()
+        : _value{0.0, 0.0, 0.0, 0.0}
+    {
+    }
+
+    explicit VectorD(double x)
+        : _value{x, 0.0, 0.0, 0.0}
+    {
+    }
+
+    VectorD(double x, double y)
+        : _value{x, y, 0.0, 0.0}
+    {
+    }
+
+    VectorD(double x, double y, double z)
+        : _value{x, y, z, 0.0}
+    {
+    }
+
+    VectorD(double x, double y, double z, double w)
+        : _value{x, y, z, w}
+    {
+    }
+
+    VectorD(const VectorD& v, double w)
+        : _value{v.x(), v.y(), v.z(), w}
+    {
+    }
+
+    // NOTE: v must have at least 4 doubles
+    explicit VectorD(const double* const v)
+        : _value{v[0], v[1], v[2], v[3]}
+    {
+    }
+
+    explicit VectorD(const Vector& v)
+        : _value{v.x(), v.y(), v.z(), v.w()}
+    {
+    }
+
+    DEFAULT_COPY_AND_ASSIGN(VectorD);
+
+    VectorD(VectorD&& v) = default;
+
+    ~VectorD() = default;
+
+public:
+    void x(double x) { _value[0] = x; }
+    double x() const { return _value[0]; }
+
+    void y(double y) { _value[1] = y; }
+    double y() const { return _value[1]; }
+
+    void z(double z) { _value[2] = z; }
+    double z() const { return _value[2]; }
+
+    void w(double w) { _value[3] = w; }
+    double w() const { return _value[3]; }
+
+    const double* array() const { return _value; }
+
+    void zero() { _value[0] = _value[1] = _value[2] = _value[3] = 0.0; }
+
+    bool is_zero() const { return 0.0 == x() && 0.0 == y() && 0.0 == z() && 0.0 == w(); }
+
+    // rounds to the nearest float Vector
+    // NOTE: use relative_to() for positions
+    Vector vector() const;
+
+    // (this - origin) as a float Vector
+    // the subtraction is done in double so only the distance
+    // from origin (not from the world origin) affects the precision
+    Vector relative_to(const VectorD& origin) const { return (*this - origin).vector(); }
+
+public:
+    double length_squared() const { return *this * *this; }
+    double length() const { return std::sqrt(length_squared()); }
+
+    VectorD& set_length(double len) { return *this *= len / length(); }
+
+    // Precision is accepted for compatibility with Vector,
+    // doubles are always normalized exactly
+    VectorD& normalize(Precision precision = Precision::Refined) { return *this = normalized(precision); }
+    VectorD normalized(Precision = Precision::Refined) const { return *this / length(); }
+
+    bool perpendicular(const VectorD& rhs) const { return *this * rhs == 0.0; }
+
+    bool same_direction(const VectorD& rhs) const { return *this * rhs > 0.0; }
+    bool opposite_direction(const VectorD& rhs) const { return *this * rhs < 0.0; }
+
+    double manhattan_normal() const { return std::fabs(x()) + std::fabs(y()) + std::fabs(z()) + std::fabs(w()); }
+
+    double infinite_normal() const
+    {
+        double ret = std::fabs(x());
+        ret = MAX(ret, std::fabs(y()));
+        ret = MAX(ret, std::fabs(z()));
+        return MAX(ret, std::fabs(w()));
+    }
+
+    double distance_squared(const VectorD& other) const { return (other - *this).length_squared(); }
+    double distance(const VectorD& other) const { return (other - *this).length(); }
+
+    // angle wrt the x/y plane
+    double angle() const { return std::atan(y() / x()); }
+
+    double angle_radians(const VectorD& other) const { return std::acos((*this * other) / (length() * other.length())); }
+    double angle_degrees(const VectorD& other) const { return RAD_DEG(angle_radians(other)); }
+
+    // interpolates between this point and rhs
+    // t must be in [0, 1]
+    VectorD lerp(const VectorD& rhs, double t) const { return *this + (rhs - *this) * t; }
+
+    // multiplies two vectors (not a dot-product)
+    VectorD multiply(const VectorD& rhs) const
+    {
+#if defined USE_SSE
+        VectorD v;
+        store(v._value, mul(load(_value), load(rhs._value)));
+        return v;
+#else
+        return VectorD(x() * rhs.x(), y() * rhs.y(), z() * rhs.z(), w() * rhs.w());
+#endif
+    }
+
+    // creates a homogeneous 3-dimensional vector
+    VectorD homogeneous_position() const { return VectorD(x(), y(), z(), 1.0); }
+    VectorD homogeneous_direction() const { return VectorD(x(), y(), z(), 0.0); }
+
+    VectorD xy() const { return VectorD(x(), y()); }
+    VectorD xz() const { return VectorD(x(), z()); }
+    VectorD yz() const { return VectorD(y(), z()); }
+    VectorD xyz() const { return VectorD(x(), y(), z()); }
+
+    std::string str() const;
+
+public:
+    double& operator[](int index) { return _value[index]; }
+    const double& operator[](int index) const { return _value[index]; }
+
+    bool operator==(const VectorD& rhs) const { return x() == rhs.x() && y() == rhs.y() && z() == rhs.z() && w() == rhs.w(); }
+    bool operator!=(const VectorD& rhs) const { return !(*this == rhs); }
+
+    bool operator<(const VectorD& rhs) const {
+        return x() == rhs.x()
+                ? y() == rhs.y()
+                  ? z() < rhs.z()
+                  : y() < rhs.y()
+                : x() < rhs.x();
+    }
+
+    VectorD operator+(const VectorD& rhs) const
+    {
+#if defined USE_SSE
+        VectorD v;
+        store(v._value, add(load(_value), load(rhs._value)));
+        return v;
+#else
+        return VectorD(x() + rhs.x(), y() + rhs.y(), z() + rhs.z(), w() + rhs.w());
+#endif
+    }
+
+    VectorD& operator+=(const VectorD& rhs) { return *this = *this + rhs; }
+
+    VectorD operator-(const VectorD& rhs) const
+    {
+#if defined USE_SSE
+        VectorD v;
+        store(v._value, sub(load(_value), load(rhs._value)));
+        return v;
+#else
+        return VectorD(x() - rhs.x(), y() - rhs.y(), z() - rhs.z(), w() - rhs.w());
+#endif
+    }
+
+    VectorD& operator-=(const VectorD& rhs) { return *this = *this - rhs; }
+
+    VectorD operator*(double rhs) const
+    {
+#if defined USE_SSE
+        VectorD v;
+        store(v._value, mul(load(_value), set1(rhs)));
+        return v;
+#else
+        return VectorD(x() * rhs, y() * rhs, z() * rhs, w() * rhs);
+#endif
+    }
+
+    VectorD& operator*=(double rhs) { return *this = *this * rhs; }
+
+    VectorD operator/(double rhs) const
+    {
+#if defined USE_SSE
+        VectorD v;
+        store(v._value, div(load(_value), set1(rhs)));
+        return v;
+#else
+        return VectorD(x() / rhs, y() / rhs, z() / rhs, w() / rhs);
+#endif
+    }
+
+    VectorD& operator/=(double rhs) { return *this = *this / rhs; }
+
+    VectorD operator-() const { return VectorD(-x(), -y(), -z(), -w()); }
+
+    // dot-product
+    double operator*(const VectorD& rhs) const
+    {
+#if defined USE_SSE
+        return hsum(mul(load(_value), load(rhs._value)));
+#else
+        return x() * rhs.x() + y() * rhs.y() + z() * rhs.z() + w() * rhs.w();
+#endif
+    }
+
+    // 3-dimensional cross-product
+    // NOTE: this is scalar, the lane crossing shuffles cost more than they save for doubles
+    VectorD operator^(const VectorD& rhs) const
+    {
+        return VectorD(
+            y() * rhs.z() - z() * rhs.y(),
+            z() * rhs.x() - x() * rhs.z(),
+            x() * rhs.y() - y() * rhs.x()
+        );
+    }
+
+    VectorD& operator^=(const VectorD& rhs) { return *this = *this ^ rhs; }
+
+public:
+    friend VectorD operator*(double lhs, const VectorD& rhs) { return rhs * lhs; }
+
+private:
+#if defined __AVX__
+    // all 4 components in one register
+    typedef __m256d Register;
+
+    static Register load(const double* const v) { return _mm256_loadu_pd(v); }
+    static void store(double* const r, Register v) { _mm256_storeu_pd(r, v); }
+    static Register set1(double s) { return _mm256_set1_pd(s); }
+    static Register add(Register a, Register b) { return _mm256_add_pd(a, b); }
+    static Register sub(Register a, Register b) { return _mm256_sub_pd(a, b); }
+    static Register mul(Register a, Register b) { return _mm256_mul_pd(a, b); }
+    static Register div(Register a, Register b) { return _mm256_div_pd(a, b); }
+
+    static double hsum(Register a)
+    {
+        // [a0 + a2, a1 + a3] then the two halves of that
+        __m128d r = _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(r, _mm_unpackhi_pd(r, r)));
+    }
+#elif defined USE_SSE
+    // (x, y) and (z, w)
+    struct Register
+    {
+        __m128d lo, hi;
+    };
+
+    static Register load(const double* const v) { return { _mm_load_pd(v), _mm_load_pd(v + 2) }; }
+    static void store(double* const r, Register v) { _mm_store_pd(r, v.lo); _mm_store_pd(r + 2, v.hi); }
+    static Register set1(double s) { return { _mm_set1_pd(s), _mm_set1_pd(s) }; }
+    static Register add(Register a, Register b) { return { _mm_add_pd(a.lo, b.lo), _mm_add_pd(a.hi, b.hi) }; }
+    static Register sub(Register a, Register b) { return { _mm_sub_pd(a.lo, b.lo), _mm_sub_pd(a.hi, b.hi) }; }
+    static Register mul(Register a, Register b) { return { _mm_mul_pd(a.lo, b.lo), _mm_mul_pd(a.hi, b.hi) }; }
+    static Register div(Register a, Register b) { return { _mm_div_pd(a.lo, b.lo), _mm_div_pd(a.hi, b.hi) }; }
+
+    static double hsum(Register a)
+    {
+        __m128d r = _mm_add_pd(a.lo, a.hi);
+        return _mm_cvtsd_f64(_mm_add_sd(r, _mm_unpackhi_pd(r, r)));
+    }
+#endif
+
+    // NOTE: only 16-byte aligned (the AVX path uses unaligned loads)
+    // because C++14 allocators don't have to honor anything larger
+    ALIGN(16) double _value[4];
+};
+
+static_assert(sizeof(VectorD) == 32, "VectorD must be exactly 4 doubles");
+static_assert(alignof(VectorD) == 16, "VectorD must be 16-byte aligned");
+static_assert(std::is_trivially_copyable<VectorD>::value, "VectorD must be trivially copyable");
+
+} }
+
+#endif
@@ -0,0 +1,70 @@
+#include "pch.h"
+#include "SIMD/Kernels.h"
+#include "VectorEncoding.h"
+
+namespace energonsoftware {
+namespace math {
+namespace batch {
+
+// NOTE: Vector is guaranteed to be exactly 4 packed floats and the
+// encoded types are packed 16-bit values, so arrays of either can be
+// handed straight to the kernels
+
+void encode_half(const Vector* const v, HalfVector* const out, size_t count)
+{
+    kernels().encode.to_half(reinterpret_cast<const float*>(v), reinterpret_cast<uint16_t*>(out), count * 4);
+}
+
+void decode_half(const HalfVector* const h, Vector* const out, size_t count)
+{
+    kernels().encode.from_half(reinterpret_cast<const uint16_t*>(h), reinterpret_cast<float*>(out), count * 4);
+}
+
+void encode_bfloat16(const Vector* const v, BFloat16Vector* const out, size_t count)
+{
+    kernels().encode.to_bfloat16(reinterpret_cast<const float*>(v), reinterpret_cast<uint16_t*>(out), count * 4);
+}
+
+void decode_bfloat16(const BFloat16Vector* const b, Vector* const out, size_t count)
+{
+    kernels().encode.from_bfloat16(reinterpret_cast<const uint16_t*>(b), reinterpret_cast<float*>(out), count * 4);
+}
+
+void encode_octahedral(const Vector* const normals, OctahedralNormal* const out, size_t count)
+{
+    kernels().encode.to_octahedral(reinterpret_cast<const float*>(normals), reinterpret_cast<uint32_t*>(out), count);
+}
+
+void decode_octahedral(const OctahedralNormal* const n, Normal3* const out, size_t count)
+{
+    kernels().encode.from_octahedral(reinterpret_cast<const uint32_t*>(n), reinterpret_cast<float*>(out), count);
+}
+
+// a flat axis quantizes everything to 0
+
+void quantize(const AABB& bounds, const Point3* const points, QuantizedPosition* const out, size_t count)
+{
+    assert(!bounds.is_empty());
+
+    const Vector extents = bounds.extents();
+    const float offset[4] = { bounds.minimum().x(), bounds.minimum().y(), bounds.minimum().z(), 0.0f };
+    const float scale[4] = {
+        extents.x() > 0.0f ? 65535.0f / extents.x() : 0.0f,
+        extents.y() > 0.0f ? 65535.0f / extents.y() : 0.0f,
+        extents.z() > 0.0f ? 65535.0f / extents.z() : 0.0f,
+        0.0f
+    };
+    kernels().encode.quantize(reinterpret_cast<const float*>(points), offset, scale, reinterpret_cast<uint16_t*>(out), count);
+}
+
+void dequantize(const AABB& bounds, const QuantizedPosition* const q, Point3* const out, size_t count)
+{
+    assert(!bounds.is_empty());
+
+    const Vector extents = bounds.extents();
+    const float offset[4] = { bounds.minimum().x(), bounds.minimum().y(), bounds.minimum().z(), 0.0f };
+    const float scale[4] = { extents.x() / 65535.0f, extents.y() / 65535.0f, extents.z() / 65535.0f, 0.0f };
+    kernels().encode.dequantize(reinterpret_cast<const uint16_t*>(q), offset, scale, reinterpret_cast<float*>(out), count);
+}
+
+} } }
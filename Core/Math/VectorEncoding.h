@@ -0,0 +1,146 @@
+#if !defined __VECTORENCODING_H__
+#define __VECTORENCODING_H__
+
+#include "AABB.h"
+#include "Vector.h"
+
+namespace energonsoftware {
+namespace math {
+
+/*
+Compact storage formats for Vectors.
+
+A Vector is 16 bytes, these trade some precision for 2-4x less memory
+(and cache and bandwidth) for data that is mostly read. Decode into Vectors
+to do math with them. The error bounds below are for the decoded Vectors.
+
+HalfVector (8 bytes) is IEEE float16, rounded to nearest even.
+The relative error is at most 2^-11 (0.05%) for magnitudes in
+[2^-14, 65504], below that the absolute error is at most 2^-25.
+Magnitudes of 65520 and up become infinity.
+
+BFloat16Vector (8 bytes) is the top half of a float, rounded to nearest even.
+It has the full float range but the relative error is at most 2^-8 (0.4%).
+
+OctahedralNormal (4 bytes) is the direction of a Vector (x, y and z)
+as 2 snorm16 octahedral coordinates. The decoded unit vectors are
+within 0.0001 radians (0.006 degrees) of the exact direction
+(the measured worst case is 0.000065) and unit length to within 2e-7.
+A zero vector decodes to (0, 0, 1).
+
+QuantizedPosition (8 bytes) is x, y and z as unorm16 fractions of a bounding box.
+The error on each axis is at most half a step, extent / 131070, plus the
+rounding of the decoded float. Anything outside the box is clamped to it.
+The decoded w is 0.
+*/
+struct HalfVector
+{
+    uint16_t x, y, z, w;
+};
+
+struct BFloat16Vector
+{
+    uint16_t x, y, z, w;
+};
+
+struct OctahedralNormal
+{
+    uint16_t x, y;
+};
+
+struct QuantizedPosition
+{
+    // w is always 0
+    uint16_t x, y, z, w;
+};
+
+static_assert(sizeof(HalfVector) == 8, "HalfVector must be 4 packed halves");
+static_assert(sizeof(BFloat16Vector) == 8, "BFloat16Vector must be 4 packed bfloat16");
+static_assert(sizeof(OctahedralNormal) == 4, "OctahedralNormal must be 2 packed snorm16");
+static_assert(sizeof(QuantizedPosition) == 8, "QuantizedPosition must be 4 packed unorm16");
+
+/*
+Batch encoding and decoding.
+
+These run the best kernels for the current CPU (see SIMD/Kernels.h),
+the float16 conversion uses F16C on the AVX2 and AVX-512 tiers.
+*/
+namespace batch {
+
+DllExport void encode_half(const Vector* const v, HalfVector* const out, size_t count);
+DllExport void decode_half(const HalfVector* const h, Vector* const out, size_t count);
+
+DllExport void encode_bfloat16(const Vector* const v, BFloat16Vector* const out, size_t count);
+DllExport void decode_bfloat16(const BFloat16Vector* const b, Vector* const out, size_t count);
+
+// the normals don't have to be normalized, w is ignored
+DllExport void encode_octahedral(const Vector* const normals, OctahedralNormal* const out, size_t count);
+DllExport void decode_octahedral(const OctahedralNormal* const n, Normal3* const out, size_t count);
+
+// bounds must not be empty, w is ignored
+DllExport void quantize(const AABB& bounds, const Point3* const points, QuantizedPosition* const out, size_t count);
+DllExport void dequantize(const AABB& bounds, const QuantizedPosition* const q, Point3* const out, size_t count);
+
+}
+
+// single Vector versions of the above
+
+inline HalfVector encode_half(const Vector& v)
+{
+    HalfVector h;
+    batch::encode_half(&v, &h, 1);
+    return h;
+}
+
+inline Vector decode(const HalfVector& h)
+{
+    Vector v;
+    batch::decode_half(&h, &v, 1);
+    return v;
+}
+
+inline BFloat16Vector encode_bfloat16(const Vector& v)
+{
+    BFloat16Vector b;
+    batch::encode_bfloat16(&v, &b, 1);
+    return b;
+}
+
+inline Vector decode(const BFloat16Vector& b)
+{
+    Vector v;
+    batch::decode_bfloat16(&b, &v, 1);
+    return v;
+}
+
+inline OctahedralNormal encode_octahedral(const Vector& normal)
+{
+    OctahedralNormal n;
+    batch::encode_octahedral(&normal, &n, 1);
+    return n;
+}
+
+inline Normal3 decode(const OctahedralNormal& n)
+{
+    Normal3 v;
+    batch::decode_octahedral(&n, &v, 1);
+    return v;
+}
+
+inline QuantizedPosition quantize(const AABB& bounds, const Point3& p)
+{
+    QuantizedPosition q;
+    batch::quantize(bounds, &p, &q, 1);
+    return q;
+}
+
+inline Point3 dequantize(const AABB& bounds, const QuantizedPosition& q)
+{
+    Point3 p;
+    batch::dequantize(bounds, &q, &p, 1);
+    return p;
+}
+
+} }
+
+#endif
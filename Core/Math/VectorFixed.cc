@@ -0,0 +1,22 @@
+#include "pch.h"
+#include "VectorFixed.h"
+
+namespace energonsoftware {
+namespace math {
+
+const VectorFixed VectorFixed::Zero;
+
+const VectorFixed VectorFixed::XAxis(1, 0, 0);
+const VectorFixed VectorFixed::YAxis(0, 1, 0);
+const VectorFixed VectorFixed::ZAxis(0, 0, 1);
+const VectorFixed VectorFixed::WAxis(0, 0, 0, 1);
+
+std::string VectorFixed::str() const
+{
+    std::stringstream ss;
+    ss.precision(10);
+    ss << "VectorFixed(x:" << std::fixed << x().to_double() << ", y:" << y().to_double() << ", z:" << z().to_double() << ", w:" << w().to_double() << ")";
+    return ss.str();
+}
+
+} }
@@ -0,0 +1,212 @@
+#if !defined __VECTORFIXED_H__
+#define __VECTORFIXED_H__
+
+#include "Fixed.h"
+#include "Vector.h"
+#include "VectorD.h"
+
+namespace energonsoftware {
+namespace math {
+
+/*
+32.32 fixed-point (see Fixed) version of Vector
+for deterministic simulation of large worlds.
+
+This has the same API as Vector with Fixed in place of float.
+Every result is bit-identical across compilers and CPUs.
+
+Rendering should convert positions relative to the camera,
+see relative_to() and batch::relative_to() (VectorBatch.h),
+which subtract exactly before converting to float.
+
+NOTE: dot-products (and length_squared) overflow once the
+result passes the Fixed range (lengths past about 46340),
+length(), distance() and normalize() don't.
+*/
+class DllExport VectorFixed
+{
+public:
+    static const VectorFixed Zero;
+
+    static const VectorFixed XAxis;
+    static const VectorFixed YAxis;
+    static const VectorFixed ZAxis;
+    static const VectorFixed WAxis;
+
+public:
+    VectorFixed()
+        : _value{}
+    {
+    }
+
+    VectorFixed(Fixed x, Fixed y)
+        : _value{x, y, Fixed(), Fixed()}
+    {
+    }
+
+    VectorFixed(Fixed x, Fixed y, Fixed z)
+        : _value{x, y, z, Fixed()}
+    {
+    }
+
+    VectorFixed(Fixed x, Fixed y, Fixed z, Fixed w)
+        : _value{x, y, z, w}
+    {
+    }
+
+    VectorFixed(const VectorFixed& v, Fixed w)
+        : _value{v.x(), v.y(), v.z(), w}
+    {
+    }
+
+    // rounds each component to the nearest representable value
+    explicit VectorFixed(const VectorD& v)
+        : _value{Fixed(v.x()), Fixed(v.y()), Fixed(v.z()), Fixed(v.w())}
+    {
+    }
+
+    explicit VectorFixed(const Vector& v)
+        : _value{Fixed(v.x()), Fixed(v.y()), Fixed(v.z()), Fixed(v.w())}
+    {
+    }
+
+    DEFAULT_COPY_AND_ASSIGN(VectorFixed);
+
+    VectorFixed(VectorFixed&& v) = default;
+
+    ~VectorFixed() = default;
+
+public:
+    void x(Fixed x) { _value[0] = x; }
+    Fixed x() const { return _value[0]; }
+
+    void y(Fixed y) { _value[1] = y; }
+    Fixed y() const { return _value[1]; }
+
+    void z(Fixed z) { _value[2] = z; }
+    Fixed z() const { return _value[2]; }
+
+    void w(Fixed w) { _value[3] = w; }
+    Fixed w() const { return _value[3]; }
+
+    const Fixed* array() const { return _value; }
+
+    void zero() { *this = VectorFixed(); }
+
+    bool is_zero() const { return *this == Zero; }
+
+    VectorD vector_d() const { return VectorD(x().to_double(), y().to_double(), z().to_double(), w().to_double()); }
+
+    // rounds to the nearest float Vector
+    // NOTE: use relative_to() for positions
+    Vector vector() const { return Vector(x().to_float(), y().to_float(), z().to_float(), w().to_float()); }
+
+    // (this - origin) as a float Vector
+    // the subtraction is exact so only the distance
+    // from origin (not from the world origin) affects the precision
+    Vector relative_to(const VectorFixed& origin) const { return (*this - origin).vector(); }
+
+public:
+    Fixed length_squared() const { return *this * *this; }
+    Fixed length() const { return hypot(x(), y(), z(), w()); }
+
+    VectorFixed& set_length(Fixed len) { return *this *= len / length(); }
+
+    // Precision is accepted for compatibility with Vector,
+    // the result is always exact (rounded towards zero)
+    VectorFixed& normalize(Precision precision = Precision::Refined) { return *this = normalized(precision); }
+    VectorFixed normalized(Precision = Precision::Refined) const { return *this / length(); }
+
+    bool perpendicular(const VectorFixed& rhs) const { return *this * rhs == Fixed::Zero; }
+
+    bool same_direction(const VectorFixed& rhs) const { return *this * rhs > Fixed::Zero; }
+    bool opposite_direction(const VectorFixed& rhs) const { return *this * rhs < Fixed::Zero; }
+
+    Fixed manhattan_normal() const { return abs(x()) + abs(y()) + abs(z()) + abs(w()); }
+
+    Fixed infinite_normal() const
+    {
+        Fixed ret = abs(x());
+        ret = MAX(ret, abs(y()));
+        ret = MAX(ret, abs(z()));
+        return MAX(ret, abs(w()));
+    }
+
+    Fixed distance_squared(const VectorFixed& other) const { return (other - *this).length_squared(); }
+    Fixed distance(const VectorFixed& other) const { return (other - *this).length(); }
+
+    // interpolates between this point and rhs
+    // t must be in [0, 1]
+    VectorFixed lerp(const VectorFixed& rhs, Fixed t) const { return *this + (rhs - *this) * t; }
+
+    // multiplies two vectors (not a dot-product)
+    VectorFixed multiply(const VectorFixed& rhs) const { return VectorFixed(x() * rhs.x(), y() * rhs.y(), z() * rhs.z(), w() * rhs.w()); }
+
+    // creates a homogeneous 3-dimensional vector
+    VectorFixed homogeneous_position() const { return VectorFixed(x(), y(), z(), Fixed::One); }
+    VectorFixed homogeneous_direction() const { return VectorFixed(x(), y(), z(), Fixed()); }
+
+    VectorFixed xy() const { return VectorFixed(x(), y()); }
+    VectorFixed xz() const { return VectorFixed(x(), z()); }
+    VectorFixed yz() const { return VectorFixed(y(), z()); }
+    VectorFixed xyz() const { return VectorFixed(x(), y(), z()); }
+
+    std::string str() const;
+
+public:
+    Fixed& operator[](int index) { return _value[index]; }
+    const Fixed& operator[](int index) const { return _value[index]; }
+
+    bool operator==(const VectorFixed& rhs) const { return x() == rhs.x() && y() == rhs.y() && z() == rhs.z() && w() == rhs.w(); }
+    bool operator!=(const VectorFixed& rhs) const { return !(*this == rhs); }
+
+    bool operator<(const VectorFixed& rhs) const {
+        return x() == rhs.x()
+                ? y() == rhs.y()
+                  ? z() < rhs.z()
+                  : y() < rhs.y()
+                : x() < rhs.x();
+    }
+
+    VectorFixed operator+(const VectorFixed& rhs) const { return VectorFixed(x() + rhs.x(), y() + rhs.y(), z() + rhs.z(), w() + rhs.w()); }
+    VectorFixed& operator+=(const VectorFixed& rhs) { return *this = *this + rhs; }
+
+    VectorFixed operator-(const VectorFixed& rhs) const { return VectorFixed(x() - rhs.x(), y() - rhs.y(), z() - rhs.z(), w() - rhs.w()); }
+    VectorFixed& operator-=(const VectorFixed& rhs) { return *this = *this - rhs; }
+
+    VectorFixed operator*(Fixed rhs) const { return VectorFixed(x() * rhs, y() * rhs, z() * rhs, w() * rhs); }
+    VectorFixed& operator*=(Fixed rhs) { return *this = *this * rhs; }
+
+    VectorFixed operator/(Fixed rhs) const { return VectorFixed(x() / rhs, y() / rhs, z() / rhs, w() / rhs); }
+    VectorFixed& operator/=(Fixed rhs) { return *this = *this / rhs; }
+
+    VectorFixed operator-() const { return VectorFixed(-x(), -y(), -z(), -w()); }
+
+    // dot-product
+    Fixed operator*(const VectorFixed& rhs) const { return x() * rhs.x() + y() * rhs.y() + z() * rhs.z() + w() * rhs.w(); }
+
+    // 3-dimensional cross-product
+    VectorFixed operator^(const VectorFixed& rhs) const
+    {
+        return VectorFixed(
+            y() * rhs.z() - z() * rhs.y(),
+            z() * rhs.x() - x() * rhs.z(),
+            x() * rhs.y() - y() * rhs.x()
+        );
+    }
+
+    VectorFixed& operator^=(const VectorFixed& rhs) { return *this = *this ^ rhs; }
+
+public:
+    friend VectorFixed operator*(Fixed lhs, const VectorFixed& rhs) { return rhs * lhs; }
+
+private:
+    Fixed _value[4];
+};
+
+static_assert(sizeof(VectorFixed) == 32, "VectorFixed must be exactly 4 Fixed");
+static_assert(std::is_trivially_copyable<VectorFixed>::value, "VectorFixed must be trivially copyable");
+
+} }
+
+#endif
@@ -0,0 +1,345 @@
+#if !defined __VECTORN_H__
+#define __VECTORN_H__
+
+#include <utility>
+#include "Vector.h"
+
+namespace energonsoftware {
+namespace math {
+
+namespace detail {
+
+template<typename... Args>
+struct all_arithmetic : std::true_type
+{
+};
+
+template<typename A, typename... Args>
+struct all_arithmetic<A, Args...> : std::integral_constant<bool, std::is_arithmetic<A>::value && all_arithmetic<Args...>::value>
+{
+};
+
+}
+
+/*
+Fixed-dimension vector of N (2, 3 or 4) components of type T
+(float, double or int32_t).
+
+Unlike Vector, which always stores and computes all 4 components,
+this only stores and computes the components that it has,
+so a Vector2f is 8 bytes and its dot-product is 2 multiplies and an add.
+Every operation is expanded over exactly N components at compile-time
+(no loops, no padding) which leaves the compiler free to keep small
+vectors in registers or vectorize arrays of them.
+
+Everything that doesn't need a square root or modify the vector is constexpr
+(C++11 constexpr only, v140 doesn't have the relaxed C++14 rules).
+
+Like Vector this is non-virtual, trivially copyable and standard layout,
+but it is only aligned to T so arrays of them are tightly packed.
+Use Vector (or VectorStream) for data that goes through the SIMD batch kernels.
+*/
+template<typename T, size_t N>
+class VectorN
+{
+public:
+    static_assert(N >= 2 && N <= 4, "VectorN must have 2, 3 or 4 components");
+    static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value || std::is_same<T, int32_t>::value,
+        "VectorN must be float, double or int32_t");
+
+    static const size_t Size = N;
+
+    typedef T value_type;
+
+    // the type of length() and friends, integer vectors measure in float
+    typedef typename std::conditional<std::is_same<T, double>::value, double, float>::type real_type;
+
+public:
+    static constexpr VectorN fill(T value) { return fill(value, std::make_index_sequence<N>()); }
+
+    // the unit vector along axis (0 is x)
+    static constexpr VectorN unit(size_t axis) { return unit(axis, std::make_index_sequence<N>()); }
+
+public:
+    constexpr VectorN()
+        : _value{}
+    {
+    }
+
+    // exactly N components, converted to T
+    template<typename... Args, typename = typename std::enable_if<sizeof...(Args) == N && detail::all_arithmetic<Args...>::value>::type>
+    constexpr VectorN(Args... args)
+        : _value{static_cast<T>(args)...}
+    {
+    }
+
+    // NOTE: v must have at least N values
+    explicit constexpr VectorN(const T* const v)
+        : VectorN(v, std::make_index_sequence<N>())
+    {
+    }
+
+    // converts each component (with the usual float to int truncation)
+    template<typename U>
+    explicit constexpr VectorN(const VectorN<U, N>& v)
+        : VectorN(v, std::make_index_sequence<N>())
+    {
+    }
+
+    // the first N components of v
+    explicit VectorN(const Vector& v)
+        : VectorN(v.array(), std::make_index_sequence<N>())
+    {
+    }
+
+    DEFAULT_COPY_AND_ASSIGN(VectorN);
+
+    VectorN(VectorN&& v) = default;
+
+    ~VectorN() = default;
+
+public:
+    void x(T x) { _value[0] = x; }
+    constexpr T x() const { return _value[0]; }
+
+    void y(T y) { _value[1] = y; }
+    constexpr T y() const { return _value[1]; }
+
+    void z(T z) { static_assert(N >= 3, "VectorN has no z component"); _value[2] = z; }
+    constexpr T z() const { static_assert(N >= 3, "VectorN has no z component"); return _value[2]; }
+
+    void w(T w) { static_assert(N >= 4, "VectorN has no w component"); _value[3] = w; }
+    constexpr T w() const { static_assert(N >= 4, "VectorN has no w component"); return _value[3]; }
+
+    constexpr const T* array() const { return _value; }
+
+    void zero() { *this = VectorN(); }
+
+    constexpr bool is_zero() const { return *this == VectorN(); }
+
+    // the first 2 or 3 components
+    constexpr VectorN<T, 2> xy() const { return VectorN<T, 2>(_value[0], _value[1]); }
+    constexpr VectorN<T, 3> xyz() const { static_assert(N >= 3, "VectorN has no z component"); return VectorN<T, 3>(_value[0], _value[1], _value[2]); }
+
+    // zero-padded (or truncated) to a 4 component Vector
+    Vector vector() const { return vector(std::make_index_sequence<N>()); }
+
+public:
+    constexpr T length_squared() const { return dot(*this); }
+    real_type length() const { return std::sqrt(static_cast<real_type>(length_squared())); }
+
+    // see Precision for the accuracy of each option
+    // NOTE: double vectors are always normalized exactly
+    VectorN& normalize(Precision precision = Precision::Refined) { return *this = normalized(precision); }
+
+    VectorN normalized(Precision precision = Precision::Refined) const
+    {
+        static_assert(!std::is_integral<T>::value, "integer vectors can't be normalized");
+        return *this * inverse_length(precision);
+    }
+
+    constexpr T distance_squared(const VectorN& other) const { return (other - *this).length_squared(); }
+    real_type distance(const VectorN& other) const { return (other - *this).length(); }
+
+    constexpr T manhattan_normal() const { return map(*this, Abs(), std::make_index_sequence<N>()).sum(); }
+    constexpr T infinite_normal() const { return map(*this, Abs(), std::make_index_sequence<N>()).max_component(); }
+
+    // manhattan_normal() of the difference (grid distance for integer vectors)
+    constexpr T manhattan_distance(const VectorN& other) const { return (other - *this).manhattan_normal(); }
+
+    constexpr T sum() const { return sum(std::make_index_sequence<N>()); }
+    constexpr T min_component() const { return min_component(std::make_index_sequence<N>()); }
+    constexpr T max_component() const { return max_component(std::make_index_sequence<N>()); }
+
+    constexpr T dot(const VectorN& rhs) const { return multiply(rhs).sum(); }
+
+    // 2-dimensional cross-product (the z of the 3-dimensional one)
+    // positive if rhs is counter-clockwise from this
+    constexpr T perp_dot(const VectorN& rhs) const
+    {
+        static_assert(2 == N, "perp_dot is only defined for 2 components");
+        return _value[0] * rhs._value[1] - _value[1] * rhs._value[0];
+    }
+
+    // this rotated 90 degrees counter-clockwise
+    constexpr VectorN perpendicular() const
+    {
+        static_assert(2 == N, "perpendicular is only defined for 2 components");
+        return VectorN(-_value[1], _value[0]);
+    }
+
+    // interpolates between this point and rhs
+    // t must be in [0, 1]
+    constexpr VectorN lerp(const VectorN& rhs, T t) const
+    {
+        static_assert(!std::is_integral<T>::value, "integer vectors can't be interpolated");
+        return *this + (rhs - *this) * t;
+    }
+
+    // multiplies two vectors (not a dot-product)
+    constexpr VectorN multiply(const VectorN& rhs) const { return zip(*this, rhs, std::multiplies<T>(), std::make_index_sequence<N>()); }
+
+    // component-wise minimum and maximum
+    constexpr VectorN minimum(const VectorN& rhs) const { return zip(*this, rhs, Min(), std::make_index_sequence<N>()); }
+    constexpr VectorN maximum(const VectorN& rhs) const { return zip(*this, rhs, Max(), std::make_index_sequence<N>()); }
+
+    std::string str() const
+    {
+        std::stringstream ss;
+        ss << "VectorN(" << std::fixed;
+        for(size_t i = 0; i < N; ++i) {
+            ss << (0 == i ? "" : ", ") << "xyzw"[i] << ":" << _value[i];
+        }
+        ss << ")";
+        return ss.str();
+    }
+
+public:
+    T& operator[](size_t index) { return _value[index]; }
+    constexpr const T& operator[](size_t index) const { return _value[index]; }
+
+    constexpr bool operator==(const VectorN& rhs) const { return equal(rhs, std::make_index_sequence<N>()); }
+    constexpr bool operator!=(const VectorN& rhs) const { return !(*this == rhs); }
+
+    // lexicographic, so VectorN can be used as an ordered key
+    constexpr bool operator<(const VectorN& rhs) const { return less(rhs, 0); }
+
+    constexpr VectorN operator+(const VectorN& rhs) const { return zip(*this, rhs, std::plus<T>(), std::make_index_sequence<N>()); }
+    VectorN& operator+=(const VectorN& rhs) { return *this = *this + rhs; }
+
+    constexpr VectorN operator-(const VectorN& rhs) const { return zip(*this, rhs, std::minus<T>(), std::make_index_sequence<N>()); }
+    VectorN& operator-=(const VectorN& rhs) { return *this = *this - rhs; }
+
+    constexpr VectorN operator*(T rhs) const { return zip(*this, fill(rhs), std::multiplies<T>(), std::make_index_sequence<N>()); }
+    VectorN& operator*=(T rhs) { return *this = *this * rhs; }
+
+    constexpr VectorN operator/(T rhs) const { return zip(*this, fill(rhs), std::divides<T>(), std::make_index_sequence<N>()); }
+    VectorN& operator/=(T rhs) { return *this = *this / rhs; }
+
+    constexpr VectorN operator-() const { return map(*this, std::negate<T>(), std::make_index_sequence<N>()); }
+
+    // dot-product
+    constexpr T operator*(const VectorN& rhs) const { return dot(rhs); }
+
+    // 3-dimensional cross-product
+    constexpr VectorN operator^(const VectorN& rhs) const
+    {
+        static_assert(3 == N, "the cross-product is only defined for 3 components");
+        return VectorN(
+            _value[1] * rhs._value[2] - _value[2] * rhs._value[1],
+            _value[2] * rhs._value[0] - _value[0] * rhs._value[2],
+            _value[0] * rhs._value[1] - _value[1] * rhs._value[0]
+        );
+    }
+
+    VectorN& operator^=(const VectorN& rhs) { return *this = *this ^ rhs; }
+
+public:
+    friend constexpr VectorN operator*(T lhs, const VectorN& rhs) { return rhs * lhs; }
+
+private:
+    // std::abs/min/max aren't constexpr in C++14
+    struct Abs
+    {
+        constexpr T operator()(T a) const { return a < 0 ? -a : a; }
+    };
+
+    struct Min
+    {
+        constexpr T operator()(T a, T b) const { return b < a ? b : a; }
+    };
+
+    struct Max
+    {
+        constexpr T operator()(T a, T b) const { return a < b ? b : a; }
+    };
+
+    template<typename U, size_t... I>
+    constexpr VectorN(const U* const v, std::index_sequence<I...>)
+        : _value{static_cast<T>(v[I])...}
+    {
+    }
+
+    template<typename U, size_t... I>
+    constexpr VectorN(const VectorN<U, N>& v, std::index_sequence<I...>)
+        : _value{static_cast<T>(v[I])...}
+    {
+    }
+
+    template<size_t... I>
+    static constexpr VectorN fill(T value, std::index_sequence<I...>) { return VectorN(((void)I, value)...); }
+
+    template<size_t... I>
+    static constexpr VectorN unit(size_t axis, std::index_sequence<I...>) { return VectorN((I == axis ? 1 : 0)...); }
+
+    template<typename Op, size_t... I>
+    static constexpr VectorN map(const VectorN& a, Op op, std::index_sequence<I...>) { return VectorN(op(a._value[I])...); }
+
+    template<typename Op, size_t... I>
+    static constexpr VectorN zip(const VectorN& a, const VectorN& b, Op op, std::index_sequence<I...>) { return VectorN(op(a._value[I], b._value[I])...); }
+
+    // left folds over exactly N components
+    template<typename Op, typename V>
+    static constexpr V fold(Op, V a) { return a; }
+
+    template<typename Op, typename V, typename... Rest>
+    static constexpr V fold(Op op, V a, V b, Rest... rest) { return fold(op, static_cast<V>(op(a, b)), rest...); }
+
+    template<size_t... I>
+    constexpr T sum(std::index_sequence<I...>) const { return fold(std::plus<T>(), _value[I]...); }
+
+    template<size_t... I>
+    constexpr T min_component(std::index_sequence<I...>) const { return fold(Min(), _value[I]...); }
+
+    template<size_t... I>
+    constexpr T max_component(std::index_sequence<I...>) const { return fold(Max(), _value[I]...); }
+
+    template<size_t... I>
+    constexpr bool equal(const VectorN& rhs, std::index_sequence<I...>) const { return fold(std::logical_and<bool>(), (_value[I] == rhs._value[I])...); }
+
+    // the first component from index on that differs decides
+    constexpr bool less(const VectorN& rhs, size_t index) const
+    {
+        return index < N && (_value[index] != rhs._value[index] ? _value[index] < rhs._value[index] : less(rhs, index + 1));
+    }
+
+    template<size_t... I>
+    Vector vector(std::index_sequence<I...>) const
+    {
+        const float v[4] = { static_cast<float>(_value[I])... };
+        return Vector(v);
+    }
+
+    T inverse_length(Precision precision) const
+    {
+        return std::is_same<T, float>::value
+            ? static_cast<T>(invsqrt(static_cast<float>(length_squared()), precision))
+            : static_cast<T>(1.0 / std::sqrt(static_cast<double>(length_squared())));
+    }
+
+private:
+    T _value[N];
+};
+
+typedef VectorN<float, 2> Vector2f;
+typedef VectorN<float, 3> Vector3f;
+typedef VectorN<float, 4> Vector4f;
+
+typedef VectorN<double, 2> Vector2d;
+typedef VectorN<double, 3> Vector3d;
+typedef VectorN<double, 4> Vector4d;
+
+typedef VectorN<int32_t, 2> Vector2i;
+typedef VectorN<int32_t, 3> Vector3i;
+typedef VectorN<int32_t, 4> Vector4i;
+
+static_assert(sizeof(Vector2f) == 8, "Vector2f must be exactly 2 floats");
+static_assert(sizeof(Vector3f) == 12, "Vector3f must be exactly 3 floats");
+static_assert(sizeof(Vector2i) == 8, "Vector2i must be exactly 2 ints");
+static_assert(sizeof(Vector3d) == 24, "Vector3d must be exactly 3 doubles");
+static_assert(std::is_standard_layout<Vector3f>::value, "VectorN must be standard layout");
+static_assert(std::is_trivially_copyable<Vector3f>::value, "VectorN must be trivially copyable");
+
+} }
+
+#endif
@@ -0,0 +1,237 @@
+#include "pch.h"
+#include <cstring>
+#include "Core/Memory/AlignedAllocator.h"
+#include "Core/Memory/Arena.h"
+#include "SIMD/Kernels.h"
+#include "VectorStream.h"
+
+namespace energonsoftware {
+namespace math {
+
+namespace {
+
+// rounds up to a whole number of aligned blocks so that
+// every component array starts on an aligned boundary
+size_t padded_capacity(size_t capacity)
+{
+    static const size_t block = VectorStream::Alignment / sizeof(float);
+    return (capacity + block - 1) & ~(block - 1);
+}
+
+float* allocate(size_t count)
+{
+    return static_cast<float*>(memory::aligned_allocate(count * sizeof(float), VectorStream::Alignment));
+}
+
+void deallocate(float* p)
+{
+    memory::aligned_deallocate(p);
+}
+
+}
+
+VectorStream::VectorStream(size_t size)
+{
+    resize(size);
+}
+
+VectorStream::VectorStream(const Vector* const v, size_t count)
+{
+    load(v, count);
+}
+
+VectorStream::VectorStream(const VectorStream& v)
+{
+    *this = v;
+}
+
+VectorStream& VectorStream::operator=(const VectorStream& v)
+{
+    if(this == &v) {
+        return *this;
+    }
+
+    _size = 0;
+    reserve(v._size);
+    if(v._size > 0) {
+        for(size_t i = 0; i < 4; ++i) {
+            std::memcpy(component(i), v.component(i), v._size * sizeof(float));
+        }
+    }
+    _size = v._size;
+    return *this;
+}
+
+VectorStream::VectorStream(VectorStream&& v)
+    : _data(v._data), _size(v._size), _capacity(v._capacity)
+{
+    v._data = nullptr;
+    v._size = v._capacity = 0;
+}
+
+VectorStream& VectorStream::operator=(VectorStream&& v)
+{
+    std::swap(_data, v._data);
+    std::swap(_size, v._size);
+    std::swap(_capacity, v._capacity);
+    return *this;
+}
+
+VectorStream::~VectorStream()
+{
+    deallocate(_data);
+}
+
+void VectorStream::reserve(size_t capacity)
+{
+    if(capacity > _capacity) {
+        reallocate(capacity);
+    }
+}
+
+void VectorStream::resize(size_t size)
+{
+    reserve(size);
+    for(size_t i = 0; size > _size && i < 4; ++i) {
+        std::memset(component(i) + _size, 0, (size - _size) * sizeof(float));
+    }
+    _size = size;
+}
+
+void VectorStream::push_back(const Vector& v)
+{
+    if(_size == _capacity) {
+        reserve(MAX(_capacity * 2, Alignment / sizeof(float)));
+    }
+
+    ++_size;
+    set(_size - 1, v);
+}
+
+void VectorStream::load(const Vector* const v, size_t count)
+{
+    _size = 0;
+    reserve(count);
+    _size = count;
+    kernels().array.to_stream(reinterpret_cast<const float*>(v), ref(), count);
+}
+
+void VectorStream::store(Vector* const v) const
+{
+    kernels().array.from_stream(ref(), reinterpret_cast<float*>(v), _size);
+}
+
+void VectorStream::reallocate(size_t capacity)
+{
+    capacity = padded_capacity(capacity);
+
+    float* data = allocate(capacity * 4);
+    if(nullptr != _data) {
+        for(size_t i = 0; i < 4; ++i) {
+            std::memcpy(data + i * capacity, component(i), _size * sizeof(float));
+        }
+    }
+
+    deallocate(_data);
+    _data = data;
+    _capacity = capacity;
+}
+
+void VectorStream::length_squared(float* const out) const
+{
+    kernels().stream.length_squared(ref(), out, _size);
+}
+
+void VectorStream::length(float* const out) const
+{
+    kernels().stream.length(ref(), out, _size);
+}
+
+VectorStream& VectorStream::normalize(Precision precision)
+{
+    kernels().stream.normalize(ref(), ref(), _size, precision);
+    return *this;
+}
+
+void VectorStream::normalized(VectorStream& out, Precision precision) const
+{
+    out.resize(_size);
+    kernels().stream.normalize(ref(), out.ref(), _size, precision);
+}
+
+void VectorStream::distance_squared(const VectorStream& other, float* const out) const
+{
+    assert(other._size == _size);
+    kernels().stream.distance_squared(ref(), other.ref(), out, _size);
+}
+
+void VectorStream::distance(const VectorStream& other, float* const out) const
+{
+    assert(other._size == _size);
+    kernels().stream.distance(ref(), other.ref(), out, _size);
+}
+
+void VectorStream::lerp(const VectorStream& rhs, float t, VectorStream& out) const
+{
+    assert(rhs._size == _size);
+    out.resize(_size);
+    kernels().stream.lerp(ref(), rhs.ref(), t, out.ref(), _size);
+}
+
+void VectorStream::multiply(const VectorStream& rhs, VectorStream& out) const
+{
+    assert(rhs._size == _size);
+    out.resize(_size);
+    kernels().stream.multiply(ref(), rhs.ref(), out.ref(), _size);
+}
+
+void VectorStream::dot(const VectorStream& rhs, float* const out) const
+{
+    assert(rhs._size == _size);
+    kernels().stream.dot(ref(), rhs.ref(), out, _size);
+}
+
+void VectorStream::cross(const VectorStream& rhs, VectorStream& out) const
+{
+    assert(rhs._size == _size);
+    out.resize(_size);
+    kernels().stream.cross(ref(), rhs.ref(), out.ref(), _size);
+}
+
+VectorStream& VectorStream::operator+=(const VectorStream& rhs)
+{
+    assert(rhs._size == _size);
+    kernels().stream.add(ref(), rhs.ref(), ref(), _size);
+    return *this;
+}
+
+VectorStream& VectorStream::operator-=(const VectorStream& rhs)
+{
+    assert(rhs._size == _size);
+    kernels().stream.sub(ref(), rhs.ref(), ref(), _size);
+    return *this;
+}
+
+VectorStream& VectorStream::operator*=(float rhs)
+{
+    kernels().stream.scale(ref(), rhs, ref(), _size);
+    return *this;
+}
+
+VectorStream& VectorStream::operator^=(const VectorStream& rhs)
+{
+    assert(rhs._size == _size);
+    kernels().stream.cross(ref(), rhs.ref(), ref(), _size);
+    return *this;
+}
+
+StreamRef load_stream(const Vector* const v, size_t count, memory::Arena& arena)
+{
+    const size_t capacity = padded_capacity(count);
+    float* const data = static_cast<float*>(arena.allocate(capacity * 4 * sizeof(float), VectorStream::Alignment));
+    const StreamRef r = { data, data + capacity, data + capacity * 2, data + capacity * 3 };
+    kernels().array.to_stream(reinterpret_cast<const float*>(v), r, count);
+    return r;
+}
+
+} }
@@ -0,0 +1,152 @@
+#if !defined __VECTORSTREAM_H__
+#define __VECTORSTREAM_H__
+
+#include "Vector.h"
+#include "SIMD/StreamRef.h"
+
+namespace energonsoftware {
+
+namespace memory {
+class Arena;
+}
+
+namespace math {
+
+/*
+Structure-of-arrays container of Vectors.
+
+Each component is stored in its own cache-line aligned array
+so that the batch operations can process a full SIMD register
+worth of Vectors per instruction without any shuffling.
+
+The batch operations mirror the Vector API. Operations that produce
+a scalar per Vector write to a caller-provided array that must have room
+for at least size() floats. Operations between two streams require
+the streams to be the same size.
+*/
+class DllExport VectorStream
+{
+public:
+    // alignment of each component array
+    static const size_t Alignment = 64;
+
+public:
+    VectorStream() = default;
+    explicit VectorStream(size_t size);
+    VectorStream(const Vector* const v, size_t count);
+
+    VectorStream(const VectorStream& v);
+    VectorStream& operator=(const VectorStream& v);
+
+    VectorStream(VectorStream&& v);
+    VectorStream& operator=(VectorStream&& v);
+
+    ~VectorStream();
+
+public:
+    size_t size() const { return _size; }
+    size_t capacity() const { return _capacity; }
+    bool empty() const { return 0 == _size; }
+
+    void reserve(size_t capacity);
+
+    // new vectors are zeroed
+    void resize(size_t size);
+
+    void clear() { _size = 0; }
+
+    void push_back(const Vector& v);
+
+    Vector get(size_t index) const
+    {
+        assert(index < _size);
+        return Vector(x()[index], y()[index], z()[index], w()[index]);
+    }
+
+    void set(size_t index, const Vector& v)
+    {
+        assert(index < _size);
+        x()[index] = v.x();
+        y()[index] = v.y();
+        z()[index] = v.z();
+        w()[index] = v.w();
+    }
+
+    Vector operator[](size_t index) const { return get(index); }
+
+    // converts to/from array-of-structures
+    void load(const Vector* const v, size_t count);
+    void store(Vector* const v) const;
+
+    float* x() { return component(0); }
+    const float* x() const { return component(0); }
+
+    float* y() { return component(1); }
+    const float* y() const { return component(1); }
+
+    float* z() { return component(2); }
+    const float* z() const { return component(2); }
+
+    float* w() { return component(3); }
+    const float* w() const { return component(3); }
+
+    StreamRef ref() { return { x(), y(), z(), w() }; }
+    ConstStreamRef ref() const { return ConstStreamRef(x(), y(), z(), w()); }
+
+public:
+    void length_squared(float* const out) const;
+    void length(float* const out) const;
+
+    // see Precision for the accuracy of each option
+    VectorStream& normalize(Precision precision = Precision::Refined);
+    void normalized(VectorStream& out, Precision precision = Precision::Refined) const;
+
+    void distance_squared(const VectorStream& other, float* const out) const;
+    void distance(const VectorStream& other, float* const out) const;
+
+    // interpolates between each vector in this stream and rhs
+    // t must be in [0, 1]
+    void lerp(const VectorStream& rhs, float t, VectorStream& out) const;
+
+    // multiplies two streams (not a dot-product)
+    void multiply(const VectorStream& rhs, VectorStream& out) const;
+
+    // dot-product
+    void dot(const VectorStream& rhs, float* const out) const;
+
+    // 3-dimensional cross-product
+    void cross(const VectorStream& rhs, VectorStream& out) const;
+
+public:
+    VectorStream& operator+=(const VectorStream& rhs);
+    VectorStream& operator-=(const VectorStream& rhs);
+    VectorStream& operator*=(float rhs);
+    VectorStream& operator/=(float rhs) { return *this *= 1.0f / rhs; }
+    VectorStream& operator^=(const VectorStream& rhs);
+
+private:
+    float* component(size_t index) const { return _data + index * _capacity; }
+
+    void reallocate(size_t capacity);
+
+private:
+    // all four component arrays share a single allocation
+    float* _data = nullptr;
+    size_t _size = 0;
+    size_t _capacity = 0;
+};
+
+// transposes count Vectors into structure-of-arrays storage allocated from arena
+// and laid out like a VectorStream's, for handing AoS data to the stream kernels
+// the storage is only valid until the arena is rewound
+DllExport StreamRef load_stream(const Vector* const v, size_t count, memory::Arena& arena);
+
+// the overloads of the stream batch APIs that take packed Vectors
+// load_stream() this many at a time into memory::scratch_arena(),
+// few enough that each chunk is still in L1 when the kernel reads it
+// (a multiple of 32 so that chunks start on a whole hit mask word)
+const size_t ScratchChunkSize = 1024;
+
+} }
+
+#endif
@@ -0,0 +1,570 @@
+#include "pch.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "VectorText.h"
+
+namespace energonsoftware {
+namespace math {
+
+namespace {
+
+// every power of 10 up to 10^22 is exact as a double
+const double ExactPowers[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// the powers that scale any float into [1, 10^9) (the larger ones are rounded)
+const double Powers[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22, 1e23,
+    1e24, 1e25, 1e26, 1e27, 1e28, 1e29, 1e30, 1e31, 1e32, 1e33, 1e34, 1e35,
+    1e36, 1e37, 1e38, 1e39, 1e40, 1e41, 1e42, 1e43, 1e44, 1e45, 1e46, 1e47,
+    1e48, 1e49, 1e50, 1e51, 1e52, 1e53, 1e54
+};
+
+const uint64_t IntegerPowers[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL
+};
+
+const char DigitPairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// writes n without leading zeros, at least width digits (zero padded)
+char* write_integer(char* p, uint64_t n, int width = 1)
+{
+    char digits[20];
+    char* d = digits + sizeof(digits);
+    while(n >= 100) {
+        d -= 2;
+        std::memcpy(d, DigitPairs + (n % 100) * 2, 2);
+        n /= 100;
+    }
+    if(n >= 10) {
+        d -= 2;
+        std::memcpy(d, DigitPairs + n * 2, 2);
+    } else {
+        *--d = static_cast<char>('0' + n);
+    }
+
+    for(int count = static_cast<int>(digits + sizeof(digits) - d); count < width; ++count) {
+        *p++ = '0';
+    }
+
+    const size_t count = static_cast<size_t>(digits + sizeof(digits) - d);
+    std::memcpy(p, d, count);
+    return p + count;
+}
+
+// writes inf, nan (with the sign) if v is one
+char* write_special(char* p, float v)
+{
+    if(std::signbit(v)) {
+        *p++ = '-';
+    }
+    std::memcpy(p, std::isnan(v) ? "nan" : "inf", 3);
+    return p + 3;
+}
+
+// n * 10^exponent correctly rounded to a float using a single double operation
+// (Clinger's fast path), false if that isn't exact enough and strtof() is needed
+bool decimal_to_float(uint64_t n, int exponent, float& value)
+{
+    if(0 == n) {
+        value = 0.0f;
+        return true;
+    }
+
+    // both n and 10^exponent have to be exact doubles for the result to be correctly rounded
+    if(n > (1ULL << 53) || exponent < -22 || exponent > 22) {
+        return false;
+    }
+
+    const double d = exponent < 0 ? static_cast<double>(n) / ExactPowers[-exponent] : static_cast<double>(n) * ExactPowers[exponent];
+
+    // leave subnormals and overflow to strtof()
+    if(d < FLT_MIN || d > FLT_MAX) {
+        return false;
+    }
+
+    // rounding the double to a float rounds twice, which is only wrong
+    // if the double landed exactly halfway between 2 floats but wasn't exact
+    const bool exact = exponent >= 0 && d < 9007199254740992.0;
+    uint64_t bits;
+    std::memcpy(&bits, &d, sizeof(bits));
+    if(!exact && 0x10000000 == (bits & 0x1fffffff)) {
+        return false;
+    }
+
+    value = static_cast<float>(d);
+    return true;
+}
+
+// strtof() on a nul-terminated copy of [first, last)
+float parse_slow(const char* const first, const char* const last, const char** end)
+{
+    const size_t length = static_cast<size_t>(last - first);
+
+    char buffer[65];
+    if(length < sizeof(buffer)) {
+        std::memcpy(buffer, first, length);
+        buffer[length] = '\0';
+
+        char* e = nullptr;
+        const float value = std::strtof(buffer, &e);
+        *end = first + (e - buffer);
+        return value;
+    }
+
+    const std::string copy(first, last);
+    char* e = nullptr;
+    const float value = std::strtof(copy.c_str(), &e);
+    *end = first + (e - copy.c_str());
+    return value;
+}
+
+// true if n * 10^exponent parses back to a
+bool round_trips(uint64_t n, int exponent, float a)
+{
+    float value;
+    if(!decimal_to_float(n, exponent, value)) {
+        char buffer[32];
+        const int length = std::snprintf(buffer, sizeof(buffer), "%llue%d", static_cast<unsigned long long>(n), exponent);
+        const char* end;
+        value = parse_slow(buffer, buffer + length, &end);
+    }
+    return value == a;
+}
+
+// writes n * 10^-scale
+char* write_shortest(char* p, uint64_t n, int scale)
+{
+    while(0 == n % 10) {
+        n /= 10;
+        --scale;
+    }
+
+    char digits[20];
+    const int count = static_cast<int>(write_integer(digits, n) - digits);
+
+    // the exponent of the first digit
+    const int exponent = count - 1 - scale;
+
+    if(exponent < -4 || exponent >= 9) {
+        *p++ = digits[0];
+        if(count > 1) {
+            *p++ = '.';
+            std::memcpy(p, digits + 1, count - 1);
+            p += count - 1;
+        }
+        *p++ = 'e';
+        if(exponent < 0) {
+            *p++ = '-';
+        }
+        return write_integer(p, static_cast<uint64_t>(std::abs(exponent)));
+    }
+
+    if(exponent < 0) {
+        *p++ = '0';
+        *p++ = '.';
+        for(int i = -1; i > exponent; --i) {
+            *p++ = '0';
+        }
+        std::memcpy(p, digits, count);
+        return p + count;
+    }
+
+    if(count <= exponent + 1) {
+        std::memcpy(p, digits, count);
+        p += count;
+        for(int i = count; i <= exponent; ++i) {
+            *p++ = '0';
+        }
+        return p;
+    }
+
+    std::memcpy(p, digits, exponent + 1);
+    p += exponent + 1;
+    *p++ = '.';
+    std::memcpy(p, digits + exponent + 1, count - exponent - 1);
+    return p + count - exponent - 1;
+}
+
+// finds the decimal closest to a with digits significant digits and returns
+// true if it parses back to a, the scaling isn't exact so the
+// candidates are checked by parsing them and ties can go either way
+bool closest_round_trips(float a, int exponent10, int digits, uint64_t& n, int& scale)
+{
+    scale = digits - 1 - exponent10;
+    const double scaled = scale < 0 ? a / Powers[-scale] : a * Powers[scale];
+
+    // NOTE: this can round up to 10^digits, which is still a candidate
+    const double rounded = std::nearbyint(scaled);
+    n = static_cast<uint64_t>(rounded);
+    if(round_trips(n, -scale, a)) {
+        return true;
+    }
+
+    // the scaling error could have rounded the wrong way
+    if(std::fabs(scaled - rounded) > 0.49) {
+        const uint64_t other = scaled > rounded ? n + 1 : n - 1;
+        if(round_trips(other, -scale, a)) {
+            n = other;
+            return true;
+        }
+    }
+    return false;
+}
+
+// if the closest decimal with some number of significant digits parses back to a float
+// then so does the closest with more digits, and 9 digits always do, so the shortest
+// can be found by bisection, except for powers of 2 where the floats below are closer
+// than the ones above and a closer decimal could be further than the float below
+char* format_shortest(char* p, float v)
+{
+    if(std::signbit(v)) {
+        *p++ = '-';
+    }
+
+    const float a = std::fabs(v);
+    if(0.0f == a) {
+        *p++ = '0';
+        return p;
+    }
+
+    // the exponent of the first digit, the estimate is low by at most 1
+    int exponent2;
+    const float significand = std::frexp(a, &exponent2);
+    int exponent10 = static_cast<int>(std::floor((exponent2 - 1) * 0.30102999566398119521));
+    if((exponent10 > 0 ? a / Powers[exponent10] : a * Powers[-exponent10]) >= 10.0) {
+        ++exponent10;
+    }
+
+    uint64_t n = 0;
+    int scale = 0;
+    if(0.5f == significand) {
+        for(int digits = 1; digits <= 9; ++digits) {
+            if(closest_round_trips(a, exponent10, digits, n, scale)) {
+                return write_shortest(p, n, scale);
+            }
+        }
+    } else {
+        int low = 1, high = 9;
+        uint64_t best = 0;
+        int best_scale = 0;
+        while(low < high) {
+            const int digits = (low + high) / 2;
+            if(closest_round_trips(a, exponent10, digits, n, scale)) {
+                high = digits;
+                best = n;
+                best_scale = scale;
+            } else {
+                low = digits + 1;
+            }
+        }
+
+        if(0 != best && high == best_scale + exponent10 + 1) {
+            return write_shortest(p, best, best_scale);
+        }
+        if(closest_round_trips(a, exponent10, high, n, scale)) {
+            return write_shortest(p, n, scale);
+        }
+    }
+
+    // not reachable as far as we know, but printf() gets it right
+    char buffer[32];
+    const int length = std::snprintf(buffer, sizeof(buffer), "%.9g", static_cast<double>(a));
+    std::memcpy(p, buffer, length);
+    return p + length;
+}
+
+// the product of a float's 24-bit significand and 10^precision (at most 21 bits) fits
+// exactly in a double, so rounding that to an integer rounds exactly like printf()
+char* format_fixed(char* p, float v, int precision)
+{
+    if(std::signbit(v)) {
+        *p++ = '-';
+    }
+
+    const float a = std::fabs(v);
+    if(a >= 16777216.0f) {
+        // an integer
+        if(a < 1e19f) {
+            p = write_integer(p, static_cast<uint64_t>(a));
+        } else {
+            // too big for uint64_t, %.0f doesn't depend on the locale
+            char buffer[MaxFloatChars];
+            const int length = std::snprintf(buffer, sizeof(buffer), "%.0f", static_cast<double>(a));
+            std::memcpy(p, buffer, length);
+            p += length;
+        }
+
+        if(precision > 0) {
+            *p++ = '.';
+            std::memset(p, '0', precision);
+            p += precision;
+        }
+        return p;
+    }
+
+    const uint64_t n = static_cast<uint64_t>(std::nearbyint(static_cast<double>(a) * ExactPowers[precision]));
+    p = write_integer(p, n / IntegerPowers[precision]);
+    if(precision > 0) {
+        *p++ = '.';
+        p = write_integer(p, n % IntegerPowers[precision], precision);
+    }
+    return p;
+}
+
+// copies [text, end) to [first, last) if it fits
+char* copy_out(char* const first, char* const last, const char* const text, const char* const end)
+{
+    const size_t length = static_cast<size_t>(end - text);
+    if(length > static_cast<size_t>(last - first)) {
+        return nullptr;
+    }
+    std::memcpy(first, text, length);
+    return first + length;
+}
+
+bool is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+bool is_separator(char c)
+{
+    return ' ' == c || '\t' == c || ',' == c;
+}
+
+bool is_line_end(char c)
+{
+    return '\n' == c || '\r' == c;
+}
+
+// the start of the next line
+const char* next_line(const char* const p, const char* const last)
+{
+    const char* const newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(last - p)));
+    return nullptr == newline ? last : newline + 1;
+}
+
+}
+
+char* to_chars(char* const first, char* const last, float v, FloatFormat format, int precision)
+{
+    assert(precision >= 0 && precision <= 9);
+
+    char buffer[MaxFloatChars];
+    char* end;
+    if(!std::isfinite(v)) {
+        end = write_special(buffer, v);
+    } else if(FloatFormat::Fixed == format) {
+        end = format_fixed(buffer, v, precision);
+    } else {
+        end = format_shortest(buffer, v);
+    }
+    return copy_out(first, last, buffer, end);
+}
+
+const char* from_chars(const char* const first, const char* const last, float& value)
+{
+    const char* p = first;
+    const bool negative = p < last && '-' == *p;
+    if(p < last && ('-' == *p || '+' == *p)) {
+        ++p;
+    }
+
+    // up to 19 significant digits fit in n, past that they only have to be
+    // counted (and anything other than 0 means the value isn't exact)
+    uint64_t n = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool truncated = false;
+    bool any = false;
+
+    for(; p < last && is_digit(*p); ++p) {
+        any = true;
+        const int d = *p - '0';
+        if(digits < 19) {
+            if(0 != n || 0 != d) {
+                n = n * 10 + d;
+                ++digits;
+            }
+        } else {
+            ++exponent;
+            truncated = truncated || 0 != d;
+        }
+    }
+
+    if(p < last && '.' == *p) {
+        ++p;
+        for(; p < last && is_digit(*p); ++p) {
+            any = true;
+            const int d = *p - '0';
+            if(digits < 19) {
+                if(0 != n || 0 != d) {
+                    n = n * 10 + d;
+                    ++digits;
+                }
+                --exponent;
+            } else {
+                truncated = truncated || 0 != d;
+            }
+        }
+    }
+
+    if(!any) {
+        // inf, infinity or nan (or nothing)
+        if(p == last || ('i' != *p && 'I' != *p && 'n' != *p && 'N' != *p)) {
+            return nullptr;
+        }
+
+        const char* end;
+        const float special = parse_slow(first, std::min(last, first + 16), &end);
+        if(end == first || std::isfinite(special)) {
+            return nullptr;
+        }
+        value = special;
+        return end;
+    }
+
+    // an exponent needs at least one digit, "1e" is 1 followed by an e
+    if(p < last && ('e' == *p || 'E' == *p)) {
+        const char* e = p + 1;
+        const bool negative_exponent = e < last && '-' == *e;
+        if(e < last && ('-' == *e || '+' == *e)) {
+            ++e;
+        }
+
+        if(e < last && is_digit(*e)) {
+            int explicit_exponent = 0;
+            for(; e < last && is_digit(*e); ++e) {
+                // anything this big is 0 or infinity anyway
+                if(explicit_exponent < 100000) {
+                    explicit_exponent = explicit_exponent * 10 + (*e - '0');
+                }
+            }
+            exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+            p = e;
+        }
+    }
+
+    float f;
+    if(truncated || !decimal_to_float(n, exponent, f)) {
+        const char* end;
+        value = parse_slow(first, p, &end);
+        return p;
+    }
+
+    value = negative ? -f : f;
+    return p;
+}
+
+char* to_chars(char* const first, char* const last, const Vector& v, size_t components, FloatFormat format, int precision)
+{
+    assert(components >= 1 && components <= 4);
+
+    char* p = first;
+    for(size_t i = 0; i < components; ++i) {
+        if(i > 0) {
+            if(p == last) {
+                return nullptr;
+            }
+            *p++ = ' ';
+        }
+
+        p = to_chars(p, last, v[static_cast<int>(i)], format, precision);
+        if(nullptr == p) {
+            return nullptr;
+        }
+    }
+    return p;
+}
+
+FormatVectorsResult format_vectors(char* const first, char* const last, const Vector* const v, size_t count, const VectorTextFormat& format)
+{
+    const size_t prefix_length = nullptr == format.prefix ? 0 : std::strlen(format.prefix);
+
+    char* p = first;
+    for(size_t i = 0; i < count; ++i) {
+        char* line = p;
+        if(prefix_length > 0) {
+            if(static_cast<size_t>(last - line) <= prefix_length) {
+                return { i, p };
+            }
+            std::memcpy(line, format.prefix, prefix_length);
+            line += prefix_length;
+            *line++ = ' ';
+        }
+
+        line = to_chars(line, last, v[i], format.components, format.float_format, format.precision);
+        if(nullptr == line || line == last) {
+            return { i, p };
+        }
+        *line++ = '\n';
+        p = line;
+    }
+    return { count, p };
+}
+
+ParseVectorsResult parse_vectors(const char* const first, const char* const last, Vector* const out, size_t capacity, const VectorTextFormat& format)
+{
+    assert(format.components >= 1 && format.components <= 4);
+
+    const size_t prefix_length = nullptr == format.prefix ? 0 : std::strlen(format.prefix);
+
+    size_t count = 0;
+    const char* p = first;
+    while(p < last) {
+        const char* const line = p;
+        while(p < last && (' ' == *p || '\t' == *p)) {
+            ++p;
+        }
+
+        // blank lines and comments
+        if(p == last || is_line_end(*p) || '#' == *p) {
+            p = next_line(p, last);
+            continue;
+        }
+
+        if(prefix_length > 0) {
+            if(static_cast<size_t>(last - p) <= prefix_length || 0 != std::memcmp(p, format.prefix, prefix_length) || !is_separator(p[prefix_length])) {
+                p = next_line(p, last);
+                continue;
+            }
+            p += prefix_length;
+        }
+
+        if(count == capacity) {
+            return { count, line, true };
+        }
+
+        Vector v = format.defaults;
+        for(size_t i = 0; i < format.components; ++i) {
+            while(p < last && is_separator(*p)) {
+                ++p;
+            }
+
+            float component;
+            p = from_chars(p, last, component);
+            if(nullptr == p || (p < last && !is_separator(*p) && !is_line_end(*p))) {
+                return { count, line, false };
+            }
+            v[static_cast<int>(i)] = component;
+        }
+
+        out[count++] = v;
+        p = next_line(p, last);
+    }
+    return { count, last, true };
+}
+
+} }
@@ -0,0 +1,108 @@
+#if !defined __VECTORTEXT_H__
+#define __VECTORTEXT_H__
+
+#include "Vector.h"
+
+namespace energonsoftware {
+namespace math {
+
+/*
+Allocation-free float and Vector text conversion (std::to_chars
+and std::from_chars are C++17, and the float versions came even later).
+
+Everything writes into or reads from caller buffers and never allocates
+(except for parsing some inputs longer than 64 characters, see from_chars()).
+The decimal point is always '.', the few values that fall back
+to the C library assume the "C" locale.
+*/
+
+enum class FloatFormat
+{
+    // the fewest significant digits (at most 9) that parse back to exactly the same float,
+    // in scientific notation for magnitudes below 1e-4 and from 1e9 up (1.5e-05 is 1.5e-5)
+    Shortest,
+
+    // precision digits after the decimal point, rounded like printf("%.*f")
+    Fixed
+};
+
+// enough for any float in either format (a fixed float with 9 decimal places)
+const size_t MaxFloatChars = 50;
+
+// writes v to [first, last) and returns the end of the text,
+// or nullptr (and writes nothing) if it doesn't fit
+// precision is only used by FloatFormat::Fixed and must be at most 9
+// infinities and NaNs are written as inf, -inf, nan and -nan
+DllExport char* to_chars(char* const first, char* const last, float v, FloatFormat format = FloatFormat::Shortest, int precision = 6);
+
+// parses a float at first like strtof() in the "C" locale (without hex floats),
+// the result is correctly rounded
+// returns the end of the float or nullptr if there isn't one
+// NOTE: inputs of more than 19 significant digits and the rare inputs that
+// can't be rounded exactly with double arithmetic go through strtof(),
+// which allocates if the number is longer than 64 characters
+DllExport const char* from_chars(const char* const first, const char* const last, float& value);
+
+/*
+Vectors as lines of text, one Vector per line with the components separated
+by spaces: "x y z w" (or "x y z" and so on if there are fewer components).
+
+When parsing, any mix of spaces, tabs and commas separates the components,
+so OBJ, CSV and ASCII PLY data all work, and any extra values
+at the end of a line (vertex colors for instance) are ignored.
+Blank lines, lines that start with '#' and (if there's a prefix)
+lines that don't start with the prefix are skipped.
+*/
+struct VectorTextFormat
+{
+    // the number of components on each line, from 1 (x) to 4 (x y z w)
+    size_t components = 4;
+
+    // the components that aren't on the line when parsing
+    Vector defaults;
+
+    // written before the components and required when parsing, "v" for OBJ vertices
+    // (nullptr for none)
+    const char* prefix = nullptr;
+
+    // used when writing
+    FloatFormat float_format = FloatFormat::Shortest;
+    int precision = 6;
+};
+
+struct FormatVectorsResult
+{
+    // the number of Vectors written
+    size_t count;
+
+    // the end of the text
+    char* ptr;
+};
+
+struct ParseVectorsResult
+{
+    // the number of Vectors parsed
+    size_t count;
+
+    // where parsing stopped: the end of the input, the first line
+    // that didn't fit in out, or the line that failed to parse
+    const char* ptr;
+
+    // false if ptr is a line that failed to parse
+    bool ok;
+};
+
+// writes the first component count of each Vector, separated by spaces
+// returns the end of the text or nullptr if it doesn't fit
+DllExport char* to_chars(char* const first, char* const last, const Vector& v, size_t components = 4, FloatFormat format = FloatFormat::Shortest, int precision = 6);
+
+// writes as many whole lines (each ending in '\n') as fit in [first, last)
+DllExport FormatVectorsResult format_vectors(char* const first, char* const last, const Vector* const v, size_t count, const VectorTextFormat& format = VectorTextFormat());
+
+// parses up to capacity Vectors from the lines in [first, last)
+// the last line doesn't need a trailing newline, call again from ptr to continue
+DllExport ParseVectorsResult parse_vectors(const char* const first, const char* const last, Vector* const out, size_t capacity, const VectorTextFormat& format = VectorTextFormat());
+
+} }
+
+#endif
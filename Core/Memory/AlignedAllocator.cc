@@ -0,0 +1,44 @@
+#include "pch.h"
+#if defined WIN32
+#include <malloc.h>
+#endif
+#include <cstdlib>
+#include "AlignedAllocator.h"
+
+namespace energonsoftware {
+namespace memory {
+
+void* aligned_allocate(size_t size, size_t alignment)
+{
+    assert(0 == (alignment & (alignment - 1)));
+
+    if(0 == size) {
+        return nullptr;
+    }
+
+    void* p = nullptr;
+#if defined WIN32
+    p = _aligned_malloc(size, alignment);
+#else
+    // posix_memalign() only takes multiples of sizeof(void*)
+    if(0 != posix_memalign(&p, alignment < sizeof(void*) ? sizeof(void*) : alignment, size)) {
+        p = nullptr;
+    }
+#endif
+
+    if(nullptr == p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void aligned_deallocate(void* p)
+{
+#if defined WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+} }
@@ -0,0 +1,81 @@
+#if !defined __ALIGNEDALLOCATOR_H__
+#define __ALIGNEDALLOCATOR_H__
+
+#include <limits>
+#include <new>
+#include <vector>
+
+namespace energonsoftware {
+namespace memory {
+
+// alignment must be a power of two
+// returns nullptr for size 0 and throws std::bad_alloc if the allocation fails
+DllExport void* aligned_allocate(size_t size, size_t alignment);
+
+// p must come from aligned_allocate() (or be nullptr)
+DllExport void aligned_deallocate(void* p);
+
+/*
+Standard allocator that aligns every allocation to Alignment (and never less than alignof(T)).
+
+operator new is only required to honor alignments up to alignof(std::max_align_t)
+before C++17, which is 8 bytes on some platforms, so a plain std::vector<Vector>
+can hand out storage that the aligned SSE loads in Vector fault on.
+*/
+template<typename T, size_t Alignment = alignof(T)>
+class AlignedAllocator
+{
+public:
+    static_assert(0 == (Alignment & (Alignment - 1)), "Alignment must be a power of two");
+
+    typedef T value_type;
+
+    template<typename U>
+    struct rebind
+    {
+        typedef AlignedAllocator<U, Alignment> other;
+    };
+
+public:
+    AlignedAllocator() = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&)
+    {
+    }
+
+public:
+    T* allocate(size_t count)
+    {
+        if(count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(aligned_allocate(count * sizeof(T), Alignment > alignof(T) ? Alignment : alignof(T)));
+    }
+
+    void deallocate(T* p, size_t)
+    {
+        aligned_deallocate(p);
+    }
+};
+
+// every AlignedAllocator can free what any other allocated
+template<typename T, typename U, size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&)
+{
+    return true;
+}
+
+template<typename T, typename U, size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&)
+{
+    return false;
+}
+
+// std::vector that is safe for Vector, Matrix4 and the other over-aligned types
+template<typename T, size_t Alignment = alignof(T)>
+using AlignedVector = std::vector<T, AlignedAllocator<T, Alignment>>;
+
+} }
+
+#endif
@@ -0,0 +1,137 @@
+#include "pch.h"
+#include <algorithm>
+#include "AlignedAllocator.h"
+#include "Arena.h"
+
+namespace energonsoftware {
+namespace memory {
+
+const size_t Arena::DefaultAlignment;
+const size_t Arena::BlockAlignment;
+const size_t Arena::DefaultBlockSize;
+
+Arena& scratch_arena()
+{
+    thread_local Arena arena;
+    return arena;
+}
+
+Arena::Arena(size_t block_size)
+    : _block_size(std::max(block_size, BlockAlignment))
+{
+}
+
+Arena::~Arena()
+{
+    release();
+}
+
+void* Arena::allocate(size_t size, size_t alignment)
+{
+    assert(alignment > 0 && 0 == (alignment & (alignment - 1)));
+    assert(alignment <= BlockAlignment);
+
+    size_t offset = (_offset + alignment - 1) & ~(alignment - 1);
+    if(_blocks.empty() || offset > _blocks[_block].size || size > _blocks[_block].size - offset) {
+        // blocks start on BlockAlignment so offset 0 is aligned for anything
+        next_block(size);
+        offset = 0;
+    }
+
+    void* p = _blocks[_block].data + offset;
+    _offset = offset + size;
+
+    ++_allocations;
+    _peak = std::max(_peak, used());
+    return p;
+}
+
+void Arena::rewind(const Marker& m)
+{
+    assert(m.block < _block || (m.block == _block && m.offset <= _offset));
+
+    if(m.block != _block) {
+        _filled = 0;
+        for(size_t i = 0; i < m.block; ++i) {
+            _filled += _blocks[i].size;
+        }
+    }
+
+    _block = m.block;
+    _offset = m.offset;
+}
+
+void Arena::reset()
+{
+    if(_blocks.size() > 1) {
+        size_t capacity = 0;
+        for(const Block& block : _blocks) {
+            capacity += block.size;
+        }
+
+        release();
+
+        _blocks.push_back({ static_cast<char*>(aligned_allocate(capacity, BlockAlignment)), capacity });
+        ++_system_allocations;
+    }
+
+    _block = 0;
+    _offset = 0;
+    _filled = 0;
+    _allocations = 0;
+}
+
+void Arena::release()
+{
+    for(const Block& block : _blocks) {
+        aligned_deallocate(block.data);
+    }
+    _blocks.clear();
+
+    _block = 0;
+    _offset = 0;
+    _filled = 0;
+}
+
+Arena::Stats Arena::stats() const
+{
+    Stats stats;
+    stats.used = used();
+    stats.peak = _peak;
+    stats.capacity = 0;
+    for(const Block& block : _blocks) {
+        stats.capacity += block.size;
+    }
+    stats.block_count = _blocks.size();
+    stats.allocations = _allocations;
+    stats.system_allocations = _system_allocations;
+    return stats;
+}
+
+void Arena::next_block(size_t size)
+{
+    // blocks after the current one are left over from before a rewind()
+    const size_t next = _blocks.empty() ? 0 : _block + 1;
+    if(!_blocks.empty()) {
+        _filled += _blocks[_block].size;
+    }
+
+    if(next < _blocks.size() && _blocks[next].size >= size) {
+        _block = next;
+        _offset = 0;
+        return;
+    }
+
+    // too small, so a new block goes in front of it
+    // (reserve first so that the insert can't throw and leak the block)
+    _blocks.reserve(_blocks.size() + 1);
+
+    const size_t block_size = std::max(_block_size, size);
+    _blocks.insert(_blocks.begin() + next, { static_cast<char*>(aligned_allocate(block_size, BlockAlignment)), block_size });
+    ++_system_allocations;
+
+    _block = next;
+    _offset = 0;
+}
+
+} }
@@ -0,0 +1,222 @@
+#if !defined __ARENA_H__
+#define __ARENA_H__
+
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace energonsoftware {
+namespace memory {
+
+/*
+Linear (bump) allocator for short-lived allocations such as
+per-frame temporaries and the scratch buffers of the batch APIs.
+
+Allocating bumps an offset in the current block and nothing is freed
+individually, everything is released at once by rewind() or reset().
+When a block fills up a new one is added, and reset() replaces several blocks
+with a single one large enough for all of them, so an arena that's reset
+every frame stops allocating from the system once it has seen its largest frame.
+
+Memory handed out is uninitialized and destructors are never run,
+allocate_array() only takes trivially destructible types to enforce that.
+
+Not thread-safe, use one arena per thread (see scratch_arena()).
+*/
+class DllExport Arena
+{
+public:
+    // enough for Vector, Matrix4 and the other SSE types
+    static const size_t DefaultAlignment = 16;
+
+    // blocks are cache-line aligned
+    static const size_t BlockAlignment = 64;
+
+    static const size_t DefaultBlockSize = 64 * 1024;
+
+    // the position of the arena, see mark() and rewind()
+    struct Marker
+    {
+        size_t block;
+        size_t offset;
+    };
+
+    struct Stats
+    {
+        // bytes handed out (including alignment padding) since the last reset()
+        size_t used;
+
+        // the most used has ever been
+        size_t peak;
+
+        // bytes in all of the blocks
+        size_t capacity;
+
+        size_t block_count;
+
+        // allocate() calls since the last reset()
+        size_t allocations;
+
+        // blocks that have ever been allocated from the system
+        size_t system_allocations;
+    };
+
+public:
+    // the first block is allocated on first use
+    explicit Arena(size_t block_size = DefaultBlockSize);
+    ~Arena();
+
+    DISALLOW_COPY_AND_ASSIGN(Arena);
+
+public:
+    // alignment must be a power of two, no larger than BlockAlignment
+    // size 0 returns a valid (aligned) pointer that must not be dereferenced
+    void* allocate(size_t size, size_t alignment = DefaultAlignment);
+
+    template<typename T>
+    T* allocate_array(size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "Arena never runs destructors");
+        if(count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T) > DefaultAlignment ? alignof(T) : DefaultAlignment));
+    }
+
+    // releases everything allocated since mark() returned m
+    // the blocks are kept for reuse
+    Marker mark() const { return { _block, _offset }; }
+    void rewind(const Marker& m);
+
+    // releases everything, call once per frame
+    // if the last frame needed more than one block they're
+    // replaced by a single block with room for all of it
+    void reset();
+
+    // frees every block
+    void release();
+
+    Stats stats() const;
+
+private:
+    struct Block
+    {
+        char* data;
+        size_t size;
+    };
+
+private:
+    // moves on to (or adds) a block after the current one with room for size bytes
+    void next_block(size_t size);
+
+    // the unused end of each filled block counts as used
+    size_t used() const { return _filled + _offset; }
+
+private:
+    size_t _block_size;
+
+    std::vector<Block> _blocks;
+    size_t _block = 0;
+    size_t _offset = 0;
+
+    // bytes in the blocks before the current one
+    size_t _filled = 0;
+
+    size_t _peak = 0;
+    size_t _allocations = 0;
+    size_t _system_allocations = 0;
+};
+
+/*
+Rewinds an arena to where it was when the scope was entered.
+*/
+class ArenaScope
+{
+public:
+    explicit ArenaScope(Arena& arena)
+        : _arena(arena), _marker(arena.mark())
+    {
+    }
+
+    ~ArenaScope()
+    {
+        _arena.rewind(_marker);
+    }
+
+    DISALLOW_COPY_AND_ASSIGN(ArenaScope);
+
+private:
+    Arena& _arena;
+    Arena::Marker _marker;
+};
+
+// per-thread arena for temporary buffers inside of a call
+// always allocate from it inside of an ArenaScope so that nested users don't collide
+// and nothing outlives the call, it is never reset
+DllExport Arena& scratch_arena();
+
+/*
+Standard allocator over an Arena, deallocate() does nothing.
+
+For containers that live no longer than the arena's current frame
+(or ArenaScope), the arena must outlive every container that uses it.
+*/
+template<typename T>
+class ArenaAllocator
+{
+public:
+    typedef T value_type;
+
+    template<typename U>
+    struct rebind
+    {
+        typedef ArenaAllocator<U> other;
+    };
+
+public:
+    explicit ArenaAllocator(Arena& arena)
+        : _arena(&arena)
+    {
+    }
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& allocator)
+        : _arena(&allocator.arena())
+    {
+    }
+
+public:
+    Arena& arena() const { return *_arena; }
+
+    T* allocate(size_t count)
+    {
+        if(count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(_arena->allocate(count * sizeof(T), alignof(T) > Arena::DefaultAlignment ? alignof(T) : Arena::DefaultAlignment));
+    }
+
+    void deallocate(T*, size_t)
+    {
+    }
+
+private:
+    Arena* _arena;
+};
+
+template<typename T, typename U>
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs)
+{
+    return &lhs.arena() == &rhs.arena();
+}
+
+template<typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+} }
+
+#endif
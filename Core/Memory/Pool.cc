@@ -0,0 +1,95 @@
+#include "pch.h"
+#include <algorithm>
+#include "Pool.h"
+
+namespace energonsoftware {
+namespace memory {
+
+const size_t Pool::DefaultAlignment;
+const size_t Pool::DefaultBlocksPerPage;
+
+Pool::Pool(size_t block_size, size_t alignment, size_t blocks_per_page)
+    : _alignment(std::max(alignment, alignof(FreeBlock))), _blocks_per_page(std::max(blocks_per_page, static_cast<size_t>(1)))
+{
+    assert(0 == (alignment & (alignment - 1)));
+
+    // free blocks hold the free list pointer
+    block_size = std::max(block_size, sizeof(FreeBlock));
+    _block_size = (block_size + _alignment - 1) & ~(_alignment - 1);
+}
+
+Pool::~Pool()
+{
+    release();
+}
+
+void* Pool::allocate()
+{
+    void* p = nullptr;
+    if(nullptr != _free) {
+        p = _free;
+        _free = _free->next;
+    } else {
+        if(_next == _blocks_per_page) {
+            ++_page;
+            _next = 0;
+        }
+
+        if(_page == _pages.size()) {
+            _pages.reserve(_pages.size() + 1);
+            _pages.push_back(static_cast<char*>(aligned_allocate(_block_size * _blocks_per_page, _alignment)));
+        }
+
+        p = _pages[_page] + _next * _block_size;
+        ++_next;
+    }
+
+    ++_live;
+    _peak = std::max(_peak, _live);
+    return p;
+}
+
+void Pool::deallocate(void* p)
+{
+    if(nullptr == p) {
+        return;
+    }
+
+    assert(_live > 0);
+
+    FreeBlock* block = static_cast<FreeBlock*>(p);
+    block->next = _free;
+    _free = block;
+    --_live;
+}
+
+void Pool::reset()
+{
+    _page = 0;
+    _next = 0;
+    _free = nullptr;
+    _live = 0;
+}
+
+void Pool::release()
+{
+    for(char* page : _pages) {
+        aligned_deallocate(page);
+    }
+    _pages.clear();
+
+    reset();
+}
+
+Pool::Stats Pool::stats() const
+{
+    Stats stats;
+    stats.block_size = _block_size;
+    stats.live = _live;
+    stats.peak = _peak;
+    stats.capacity = _pages.size() * _blocks_per_page;
+    stats.page_count = _pages.size();
+    return stats;
+}
+
+} }
@@ -0,0 +1,203 @@
+#if !defined __POOL_H__
+#define __POOL_H__
+
+#include <limits>
+#include <new>
+#include <utility>
+#include <vector>
+#include "AlignedAllocator.h"
+
+namespace energonsoftware {
+namespace memory {
+
+/*
+Fixed-size block allocator.
+
+Blocks are carved out of pages of blocks_per_page blocks, freed blocks
+go on an intrusive free list and are handed out again first,
+so allocate() and deallocate() are a couple of pointer moves
+and the system is only called when every page is full.
+
+reset() returns every block at once (without running destructors),
+the pages are kept for reuse.
+
+Not thread-safe.
+*/
+class DllExport Pool
+{
+public:
+    static const size_t DefaultAlignment = 16;
+    static const size_t DefaultBlocksPerPage = 256;
+
+    struct Stats
+    {
+        // size of each block after rounding up to the alignment
+        size_t block_size;
+
+        // blocks allocated and not yet freed
+        size_t live;
+
+        // the most blocks that have ever been live
+        size_t peak;
+
+        // blocks in all of the pages
+        size_t capacity;
+
+        size_t page_count;
+    };
+
+public:
+    // block_size is rounded up to a multiple of alignment (and to hold a pointer)
+    // alignment must be a power of two
+    explicit Pool(size_t block_size, size_t alignment = DefaultAlignment, size_t blocks_per_page = DefaultBlocksPerPage);
+    ~Pool();
+
+    DISALLOW_COPY_AND_ASSIGN(Pool);
+
+public:
+    size_t block_size() const { return _block_size; }
+    size_t alignment() const { return _alignment; }
+
+    void* allocate();
+
+    // p must have come from this pool's allocate()
+    void deallocate(void* p);
+
+    // constructs a T in a block
+    template<typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        assert(sizeof(T) <= _block_size && alignof(T) <= _alignment);
+
+        void* p = allocate();
+        try {
+            return new(p) T(std::forward<Args>(args)...);
+        } catch(...) {
+            deallocate(p);
+            throw;
+        }
+    }
+
+    // destroys a T from create()
+    template<typename T>
+    void destroy(T* p)
+    {
+        if(nullptr != p) {
+            p->~T();
+            deallocate(p);
+        }
+    }
+
+    // releases every block, the pages are kept
+    void reset();
+
+    // frees every page
+    void release();
+
+    Stats stats() const;
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+private:
+    size_t _block_size;
+    size_t _alignment;
+    size_t _blocks_per_page;
+
+    std::vector<char*> _pages;
+
+    // blocks past _next in page _page have never been handed out
+    // since the last reset()
+    size_t _page = 0;
+    size_t _next = 0;
+
+    FreeBlock* _free = nullptr;
+
+    size_t _live = 0;
+    size_t _peak = 0;
+};
+
+/*
+Standard allocator over a Pool for node-based containers
+(std::list, std::map, std::unordered_map nodes, ...).
+
+Single objects that fit in a block come from the pool,
+anything else (arrays, bucket tables) falls back to aligned_allocate().
+The pool must outlive every container that uses it.
+*/
+template<typename T>
+class PoolAllocator
+{
+public:
+    typedef T value_type;
+
+    template<typename U>
+    struct rebind
+    {
+        typedef PoolAllocator<U> other;
+    };
+
+public:
+    explicit PoolAllocator(Pool& pool)
+        : _pool(&pool)
+    {
+    }
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>& allocator)
+        : _pool(&allocator.pool())
+    {
+    }
+
+public:
+    Pool& pool() const { return *_pool; }
+
+    T* allocate(size_t count)
+    {
+        if(pooled(count)) {
+            return static_cast<T*>(_pool->allocate());
+        }
+
+        if(count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(aligned_allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t count)
+    {
+        if(pooled(count)) {
+            _pool->deallocate(p);
+        } else {
+            aligned_deallocate(p);
+        }
+    }
+
+private:
+    bool pooled(size_t count) const
+    {
+        return 1 == count && sizeof(T) <= _pool->block_size() && alignof(T) <= _pool->alignment();
+    }
+
+private:
+    Pool* _pool;
+};
+
+template<typename T, typename U>
+bool operator==(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs)
+{
+    return &lhs.pool() == &rhs.pool();
+}
+
+template<typename T, typename U>
+bool operator!=(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+} }
+
+#endif
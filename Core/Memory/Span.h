@@ -0,0 +1,64 @@
+#if !defined __SPAN_H__
+#define __SPAN_H__
+
+namespace energonsoftware {
+namespace memory {
+
+/*
+Non-owning view of count contiguous Ts (std::span before C++20).
+
+Spans are cheap to copy and pass by value,
+the memory they refer to has to outlive them.
+*/
+template<typename T>
+class Span
+{
+public:
+    typedef T element_type;
+    typedef T* iterator;
+
+public:
+    Span() = default;
+
+    Span(T* const data, size_t size)
+        : _data(data), _size(size)
+    {
+    }
+
+    // Span<const T> from Span<T>
+    template<typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    Span(const Span<U>& s)
+        : _data(s.data()), _size(s.size())
+    {
+    }
+
+public:
+    T* data() const { return _data; }
+    size_t size() const { return _size; }
+    size_t size_bytes() const { return _size * sizeof(T); }
+    bool empty() const { return 0 == _size; }
+
+    T* begin() const { return _data; }
+    T* end() const { return _data + _size; }
+
+    T& operator[](size_t index) const
+    {
+        assert(index < _size);
+        return _data[index];
+    }
+
+    // the count elements starting at offset, clamped to the end of the span
+    Span subspan(size_t offset, size_t count) const
+    {
+        assert(offset <= _size);
+        return Span(_data + offset, count < _size - offset ? count : _size - offset);
+    }
+
+private:
+    T* _data = nullptr;
+    size_t _size = 0;
+};
+
+} }
+
+#endif
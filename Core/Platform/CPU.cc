@@ -0,0 +1,140 @@
+#include "pch.h"
+#if defined _MSC_VER
+#include <intrin.h>
+#elif defined __i386__ || defined __x86_64__
+#include <cpuid.h>
+#endif
+#include <cstring>
+#include "CPU.h"
+
+namespace energonsoftware {
+namespace platform {
+
+namespace {
+
+#if defined _MSC_VER || defined __i386__ || defined __x86_64__
+#define HAS_CPUID
+
+// returns { eax, ebx, ecx, edx }
+void cpuid(unsigned int leaf, unsigned int subleaf, unsigned int (&regs)[4])
+{
+#if defined _MSC_VER
+    int r[4];
+    __cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+    std::memcpy(regs, r, sizeof(regs));
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// extended control register 0, which tells us
+// which register states the OS saves on a context switch
+unsigned long long xgetbv0()
+{
+#if defined _MSC_VER
+    return _xgetbv(0);
+#else
+    unsigned int eax, edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+#endif
+
+bool bit(unsigned int reg, int bit)
+{
+    return 0 != (reg & (1U << bit));
+}
+
+CPUFeatures detect()
+{
+    CPUFeatures features;
+
+#if defined HAS_CPUID
+    unsigned int regs[4];
+    cpuid(0, 0, regs);
+    const unsigned int max_leaf = regs[0];
+
+    char vendor[13] = { 0 };
+    std::memcpy(vendor, &regs[1], 4);
+    std::memcpy(vendor + 4, &regs[3], 4);
+    std::memcpy(vendor + 8, &regs[2], 4);
+    features.vendor = vendor;
+
+    if(max_leaf < 1) {
+        return features;
+    }
+
+    cpuid(1, 0, regs);
+    features.sse2 = bit(regs[3], 26);
+    features.sse3 = bit(regs[2], 0);
+    features.ssse3 = bit(regs[2], 9);
+    features.sse41 = bit(regs[2], 19);
+    features.sse42 = bit(regs[2], 20);
+    features.popcnt = bit(regs[2], 23);
+
+    // AVX needs the OS to save the XMM/YMM state (XCR0 bits 1 and 2)
+    const bool osxsave = bit(regs[2], 27);
+    const unsigned long long xcr0 = osxsave ? xgetbv0() : 0;
+    const bool os_avx = 0x6 == (xcr0 & 0x6);
+
+    // and AVX-512 additionally needs the opmask and ZMM state (XCR0 bits 5, 6 and 7)
+    const bool os_avx512 = os_avx && 0xe0 == (xcr0 & 0xe0);
+
+    features.avx = os_avx && bit(regs[2], 28);
+    features.fma = features.avx && bit(regs[2], 12);
+    features.f16c = features.avx && bit(regs[2], 29);
+
+    if(max_leaf >= 7) {
+        cpuid(7, 0, regs);
+        features.avx2 = features.avx && bit(regs[1], 5);
+        features.avx512f = os_avx512 && bit(regs[1], 16);
+        features.avx512dq = features.avx512f && bit(regs[1], 17);
+        features.avx512bw = features.avx512f && bit(regs[1], 30);
+        features.avx512vl = features.avx512f && bit(regs[1], 31);
+    }
+#endif
+
+    return features;
+}
+
+}
+
+std::string CPUFeatures::str() const
+{
+    std::stringstream ss;
+    ss << "CPU(vendor:" << (vendor.empty() ? "unknown" : vendor);
+
+    static const std::pair<const char*, bool CPUFeatures::*> flags[] = {
+        { "sse2", &CPUFeatures::sse2 },
+        { "sse3", &CPUFeatures::sse3 },
+        { "ssse3", &CPUFeatures::ssse3 },
+        { "sse4.1", &CPUFeatures::sse41 },
+        { "sse4.2", &CPUFeatures::sse42 },
+        { "popcnt", &CPUFeatures::popcnt },
+        { "avx", &CPUFeatures::avx },
+        { "avx2", &CPUFeatures::avx2 },
+        { "fma", &CPUFeatures::fma },
+        { "f16c", &CPUFeatures::f16c },
+        { "avx512f", &CPUFeatures::avx512f },
+        { "avx512dq", &CPUFeatures::avx512dq },
+        { "avx512bw", &CPUFeatures::avx512bw },
+        { "avx512vl", &CPUFeatures::avx512vl },
+    };
+
+    for(const auto& flag : flags) {
+        if(this->*flag.second) {
+            ss << ", " << flag.first;
+        }
+    }
+    ss << ")";
+    return ss.str();
+}
+
+const CPUFeatures& cpu_features()
+{
+    static const CPUFeatures features = detect();
+    return features;
+}
+
+} }
@@ -0,0 +1,38 @@
+#if !defined __CPU_H__
+#define __CPU_H__
+
+namespace energonsoftware {
+namespace platform {
+
+// instruction set extensions supported by the current CPU (and OS)
+// everything is false on non-x86 platforms
+struct DllExport CPUFeatures
+{
+    bool sse2 = false;
+    bool sse3 = false;
+    bool ssse3 = false;
+    bool sse41 = false;
+    bool sse42 = false;
+    bool popcnt = false;
+
+    // these also require the OS to save the extended register state
+    bool avx = false;
+    bool avx2 = false;
+    bool fma = false;
+    bool f16c = false;
+
+    bool avx512f = false;
+    bool avx512dq = false;
+    bool avx512bw = false;
+    bool avx512vl = false;
+
+    std::string vendor;
+    std::string str() const;
+};
+
+// detected once on first use
+DllExport const CPUFeatures& cpu_features();
+
+} }
+
+#endif
@@ -0,0 +1,156 @@
+#include "pch.h"
+#if defined WIN32
+#if !defined NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <stdexcept>
+#include "MappedFile.h"
+
+namespace energonsoftware {
+namespace platform {
+
+namespace {
+
+[[noreturn]] void fail(const std::string& path, const char* what)
+{
+#if defined WIN32
+    throw std::runtime_error(std::string(what) + " " + path + " (error " + std::to_string(GetLastError()) + ")");
+#else
+    throw std::runtime_error(std::string(what) + " " + path + ": " + std::strerror(errno));
+#endif
+}
+
+}
+
+MappedFile::MappedFile(const std::string& path)
+{
+    open(path);
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+void MappedFile::open(const std::string& path)
+{
+    close();
+
+#if defined WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(INVALID_HANDLE_VALUE == file) {
+        fail(path, "failed to open");
+    }
+
+    LARGE_INTEGER size;
+    if(!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        fail(path, "failed to stat");
+    }
+
+    // a zero-length file can't be mapped
+    HANDLE mapping = nullptr;
+    const void* data = nullptr;
+    if(size.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        data = nullptr == mapping ? nullptr : MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if(nullptr == data) {
+            if(nullptr != mapping) {
+                CloseHandle(mapping);
+            }
+            CloseHandle(file);
+            fail(path, "failed to map");
+        }
+    }
+
+    _file = file;
+    _mapping = mapping;
+    _size = static_cast<size_t>(size.QuadPart);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) {
+        fail(path, "failed to open");
+    }
+
+    struct stat st;
+    if(0 != fstat(fd, &st)) {
+        ::close(fd);
+        fail(path, "failed to stat");
+    }
+
+    // a zero-length file can't be mapped
+    const void* data = nullptr;
+    if(st.st_size > 0) {
+        data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        if(MAP_FAILED == data) {
+            ::close(fd);
+            fail(path, "failed to map");
+        }
+    }
+
+    // the mapping keeps its own reference to the file
+    ::close(fd);
+    _size = static_cast<size_t>(st.st_size);
+#endif
+
+    _data = static_cast<const char*>(data);
+    _path = path;
+    _open = true;
+}
+
+void MappedFile::close()
+{
+    if(!_open) {
+        return;
+    }
+
+#if defined WIN32
+    if(nullptr != _data) {
+        UnmapViewOfFile(_data);
+    }
+    if(nullptr != _mapping) {
+        CloseHandle(_mapping);
+    }
+    CloseHandle(_file);
+    _file = _mapping = nullptr;
+#else
+    if(nullptr != _data) {
+        munmap(const_cast<char*>(_data), _size);
+    }
+#endif
+
+    _path.clear();
+    _data = nullptr;
+    _size = 0;
+    _open = false;
+}
+
+void MappedFile::prefetch(size_t offset, size_t size) const
+{
+    if(offset >= _size || 0 == size) {
+        return;
+    }
+    size = (std::min)(size, _size - offset);
+
+#if defined WIN32
+    WIN32_MEMORY_RANGE_ENTRY range = { const_cast<char*>(_data + offset), size };
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+    // madvise() needs a page-aligned start
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t start = offset & ~(page - 1);
+    madvise(const_cast<char*>(_data + start), size + (offset - start), MADV_WILLNEED);
+#endif
+}
+
+} }
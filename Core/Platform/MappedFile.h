@@ -0,0 +1,60 @@
+#if !defined __MAPPEDFILE_H__
+#define __MAPPEDFILE_H__
+
+namespace energonsoftware {
+namespace platform {
+
+/*
+Read-only memory mapping of an entire file.
+
+Nothing is read when the file is opened, pages are faulted in by the OS
+the first time they're touched (and shared with every other process
+mapping the same file), so opening a large file is close to free.
+
+The data starts on a page boundary. The file must not be truncated
+while it's mapped, that's undefined behavior on every platform.
+*/
+class DllExport MappedFile
+{
+public:
+    MappedFile() = default;
+
+    // throws std::runtime_error if the file can't be opened or mapped
+    explicit MappedFile(const std::string& path);
+
+    ~MappedFile();
+
+    DISALLOW_COPY_AND_ASSIGN(MappedFile);
+
+public:
+    // throws std::runtime_error if the file can't be opened or mapped
+    void open(const std::string& path);
+    void close();
+
+    bool is_open() const { return _open; }
+
+    // an empty file maps to nullptr
+    const char* data() const { return _data; }
+    size_t size() const { return _size; }
+
+    const std::string& path() const { return _path; }
+
+    // hints that the pages covering [offset, offset + size) will be read soon
+    // so the OS can start reading them in ahead of the page faults
+    void prefetch(size_t offset, size_t size) const;
+
+private:
+    std::string _path;
+    const char* _data = nullptr;
+    size_t _size = 0;
+    bool _open = false;
+
+#if defined WIN32
+    void* _file = nullptr;
+    void* _mapping = nullptr;
+#endif
+};
+
+} }
+
+#endif
@@ -0,0 +1,534 @@
+#include "pch.h"
+#include <algorithm>
+#include <thread>
+#include "BVH.h"
+
+namespace energonsoftware {
+namespace spatial {
+
+const BVH::Index BVH::InvalidIndex;
+const size_t BVH::MaxSize;
+const uint32_t BVH::PrimitiveBit;
+const size_t BVH::MaxDepth;
+const size_t BVH::MaxStackSize;
+
+namespace {
+
+// subtrees smaller than this aren't worth starting a thread for
+const uint32_t ParallelThreshold = 1 << 15;
+
+// the number of SAH candidate splits per axis is Bins - 1
+const int Bins = 16;
+
+// past this depth nodes are split at the median (rather than with the SAH)
+// which is always deep enough to finish by MaxDepth, even for MaxSize primitives
+const size_t MedianDepth = 48;
+
+}
+
+/*
+Builds each node by splitting its primitives into up to 4 clusters,
+each cluster becomes either a primitive (if it has only one) or a child node.
+
+Subtrees of at least ParallelThreshold primitives are built into
+their own node arrays (on separate threads if there are any)
+that are appended once they're finished, the layout only depends on the
+primitives so every thread count builds exactly the same tree.
+*/
+class BVH::Builder
+{
+    static_assert(MedianDepth + 16 <= MaxDepth, "the median splits must finish by MaxDepth");
+
+public:
+    Builder(const AABB* const boxes, size_t count)
+        : _boxes(boxes), _centroids(count), _order(count)
+    {
+        for(size_t i = 0; i < count; ++i) {
+            _centroids[i] = boxes[i].center();
+            _order[i] = static_cast<uint32_t>(i);
+        }
+    }
+
+public:
+    void build(const AABB& bounds, size_t max_threads, std::vector<Node>& nodes)
+    {
+        build({ 0, static_cast<uint32_t>(_order.size()), bounds }, 1, max_threads, nodes);
+    }
+
+private:
+    struct Cluster
+    {
+        uint32_t begin;
+        uint32_t end;
+        AABB bounds;
+
+        uint32_t count() const { return end - begin; }
+    };
+
+    // a subtree built into its own node array
+    struct Subtree
+    {
+        Cluster cluster;
+        size_t slot;
+        std::vector<Node> nodes;
+    };
+
+    // builds the node over the cluster and its subtrees at the end of nodes
+    void build(const Cluster& root, size_t depth, size_t threads, std::vector<Node>& nodes)
+    {
+        assert(depth <= MaxDepth);
+
+        // split the clusters with the largest surface area (or count past MedianDepth) until there are 4
+        Cluster clusters[4] = { root };
+        float areas[4] = { root.bounds.surface_area() };
+        size_t cluster_count = 1;
+
+        // small enough for a primitive per child, which is what splitting would end up with
+        if(root.count() <= 4) {
+            for(uint32_t i = 0; i < root.count(); ++i) {
+                clusters[i] = { root.begin + i, root.begin + i + 1, _boxes[_order[root.begin + i]] };
+            }
+            cluster_count = root.count();
+        }
+
+        while(cluster_count < 4) {
+            size_t best = cluster_count;
+            for(size_t i = 0; i < cluster_count; ++i) {
+                if(clusters[i].count() < 2) {
+                    continue;
+                }
+
+                if(best == cluster_count
+                    || (depth < MedianDepth ? areas[i] > areas[best] : clusters[i].count() > clusters[best].count())) {
+                    best = i;
+                }
+            }
+
+            if(best == cluster_count) {
+                break;
+            }
+
+            const Cluster cluster = clusters[best];
+            AABB left, right;
+            const uint32_t middle = split(cluster.begin, cluster.end, depth >= MedianDepth, left, right);
+
+            clusters[best] = { cluster.begin, middle, left };
+            areas[best] = left.surface_area();
+            clusters[cluster_count] = { middle, cluster.end, right };
+            areas[cluster_count] = right.surface_area();
+            ++cluster_count;
+        }
+
+        const size_t node = nodes.size();
+        nodes.push_back(empty_node());
+
+        std::vector<Subtree> subtrees;
+        for(size_t i = 0; i < cluster_count; ++i) {
+            const Cluster& cluster = clusters[i];
+            set_bounds(nodes[node], i, cluster.bounds);
+
+            if(1 == cluster.count()) {
+                nodes[node].children[i] = PrimitiveBit | _order[cluster.begin];
+            } else if(cluster.count() >= ParallelThreshold) {
+                subtrees.push_back({ cluster, i, std::vector<Node>() });
+            } else {
+                nodes[node].children[i] = static_cast<uint32_t>(nodes.size());
+                build(cluster, depth + 1, 1, nodes);
+            }
+        }
+
+        // the last subtree runs on this thread
+        std::vector<std::thread> workers;
+        const size_t subtree_threads = MAX(size_t(1), threads / MAX(size_t(1), subtrees.size()));
+        for(size_t i = 0; i < subtrees.size(); ++i) {
+            Subtree& subtree = subtrees[i];
+            if(threads > 1 && i + 1 < subtrees.size()) {
+                workers.emplace_back([this, &subtree, depth, subtree_threads]() {
+                    build(subtree.cluster, depth + 1, subtree_threads, subtree.nodes);
+                });
+            } else {
+                build(subtree.cluster, depth + 1, subtree_threads, subtree.nodes);
+            }
+        }
+
+        for(std::thread& worker : workers) {
+            worker.join();
+        }
+
+        // append the subtrees and move their node indices to match
+        for(const Subtree& subtree : subtrees) {
+            const uint32_t offset = static_cast<uint32_t>(nodes.size());
+            nodes[node].children[subtree.slot] = offset;
+            for(Node n : subtree.nodes) {
+                for(int i = 0; i < 4; ++i) {
+                    if(0 == (n.children[i] & PrimitiveBit)) {
+                        n.children[i] += offset;
+                    }
+                }
+                nodes.push_back(n);
+            }
+        }
+    }
+
+    // partitions [begin, end) (at least 2 primitives) and returns where the second half starts
+    // with the bounds of each half in left and right
+    uint32_t split(uint32_t begin, uint32_t end, bool median, AABB& left, AABB& right)
+    {
+        uint32_t* const first = _order.data() + begin;
+        uint32_t* const last = _order.data() + end;
+
+        AABB centroid_bounds;
+        for(const uint32_t* i = first; i != last; ++i) {
+            centroid_bounds.merge(_centroids[*i]);
+        }
+
+        const Vector extents = centroid_bounds.extents();
+        const Vector& lo = centroid_bounds.minimum();
+        if(!median && extents.x() + extents.y() + extents.z() > 0.0f) {
+            // bin the primitives by centroid along each axis
+            struct Bin
+            {
+                AABB bounds;
+                uint32_t count = 0;
+            };
+
+            Bin bins[3][Bins];
+            float scale[3];
+            for(int axis = 0; axis < 3; ++axis) {
+                scale[axis] = extents[axis] > 0.0f ? Bins * 0.9999f / extents[axis] : 0.0f;
+            }
+
+            for(const uint32_t* i = first; i != last; ++i) {
+                for(int axis = 0; axis < 3; ++axis) {
+                    Bin& bin = bins[axis][bin_index(*i, axis, lo[axis], scale[axis])];
+                    bin.bounds.merge(_boxes[*i]);
+                    ++bin.count;
+                }
+            }
+
+            // sweep for the split with the lowest cost
+            // (surface area times primitive count on each side)
+            int best_axis = -1, best_bin = 0;
+            float best_cost = std::numeric_limits<float>::infinity();
+            for(int axis = 0; axis < 3; ++axis) {
+                if(extents[axis] <= 0.0f) {
+                    continue;
+                }
+
+                float right_costs[Bins];
+                AABB right;
+                uint32_t right_count = 0;
+                for(int i = Bins - 1; i > 0; --i) {
+                    right.merge(bins[axis][i].bounds);
+                    right_count += bins[axis][i].count;
+                    right_costs[i] = right.surface_area() * right_count;
+                }
+
+                AABB left;
+                uint32_t left_count = 0;
+                for(int i = 0; i < Bins - 1; ++i) {
+                    left.merge(bins[axis][i].bounds);
+                    left_count += bins[axis][i].count;
+
+                    if(0 == left_count || left_count == end - begin) {
+                        continue;
+                    }
+
+                    const float cost = left.surface_area() * left_count + right_costs[i + 1];
+                    if(cost < best_cost) {
+                        best_cost = cost;
+                        best_axis = axis;
+                        best_bin = i;
+                    }
+                }
+            }
+
+            if(best_axis >= 0) {
+                left = right = AABB::Empty;
+                for(int i = 0; i < Bins; ++i) {
+                    (i <= best_bin ? left : right).merge(bins[best_axis][i].bounds);
+                }
+
+                const float axis_lo = lo[best_axis], axis_scale = scale[best_axis];
+                const uint32_t* const middle = std::partition(first, last, [this, best_axis, best_bin, axis_lo, axis_scale](uint32_t i) {
+                    return bin_index(i, best_axis, axis_lo, axis_scale) <= best_bin;
+                });
+                return static_cast<uint32_t>(middle - _order.data());
+            }
+        }
+
+        // the median of the widest axis, ties are broken by index
+        const int axis = centroid_bounds.longest_axis();
+        const Vector* const centroids = _centroids.data();
+        uint32_t* const middle = first + (end - begin) / 2;
+        std::nth_element(first, middle, last, [centroids, axis](uint32_t a, uint32_t b) {
+            const float ca = centroids[a][axis], cb = centroids[b][axis];
+            return ca == cb ? a < b : ca < cb;
+        });
+
+        const uint32_t ret = static_cast<uint32_t>(middle - _order.data());
+        left = bounds(begin, ret);
+        right = bounds(ret, end);
+        return ret;
+    }
+
+    int bin_index(uint32_t primitive, int axis, float lo, float scale) const
+    {
+        const int bin = static_cast<int>((_centroids[primitive][axis] - lo) * scale);
+        return MIN(MAX(bin, 0), Bins - 1);
+    }
+
+    AABB bounds(uint32_t begin, uint32_t end) const
+    {
+        AABB ret;
+        for(uint32_t i = begin; i < end; ++i) {
+            ret.merge(_boxes[_order[i]]);
+        }
+        return ret;
+    }
+
+    static Node empty_node()
+    {
+        Node node;
+        for(int i = 0; i < 4; ++i) {
+            set_bounds(node, i, AABB::Empty);
+            node.children[i] = InvalidIndex;
+        }
+        return node;
+    }
+
+    static void set_bounds(Node& node, size_t slot, const AABB& box)
+    {
+        node.minimum_x[slot] = box.minimum().x();
+        node.minimum_y[slot] = box.minimum().y();
+        node.minimum_z[slot] = box.minimum().z();
+        node.maximum_x[slot] = box.maximum().x();
+        node.maximum_y[slot] = box.maximum().y();
+        node.maximum_z[slot] = box.maximum().z();
+    }
+
+private:
+    const AABB* const _boxes;
+
+    std::vector<Vector> _centroids;
+    std::vector<uint32_t> _order;
+};
+
+BVH::BVH(const AABB* const boxes, size_t count, size_t max_threads)
+{
+    build(boxes, count, max_threads);
+}
+
+void BVH::build(const AABB* const boxes, size_t count, size_t max_threads)
+{
+    assert(count <= MaxSize);
+
+    clear();
+    if(0 == count) {
+        return;
+    }
+
+    if(0 == max_threads) {
+        max_threads = MAX(1u, std::thread::hardware_concurrency());
+    }
+
+    // a 4-wide tree has at most one node per 3 primitives
+    _nodes.reserve(count / 3 + 1);
+
+    for(size_t i = 0; i < count; ++i) {
+        _bounds.merge(boxes[i]);
+    }
+    _size = count;
+
+    Builder builder(boxes, count);
+    builder.build(_bounds, max_threads, _nodes);
+}
+
+void BVH::clear()
+{
+    _nodes.clear();
+    _bounds = AABB::Empty;
+    _size = 0;
+}
+
+void BVH::collect(uint32_t node, std::vector<Index>& out) const
+{
+    uint32_t stack[MaxStackSize];
+    size_t top = 0;
+    stack[top++] = node;
+    while(top > 0) {
+        const Node& n = _nodes[stack[--top]];
+        for(int i = 0; i < 4 && InvalidIndex != n.children[i]; ++i) {
+            if(0 != (n.children[i] & PrimitiveBit)) {
+                out.push_back(n.children[i] & ~PrimitiveBit);
+            } else {
+                stack[top++] = n.children[i];
+            }
+        }
+    }
+}
+
+size_t BVH::query_overlap(const AABB& box, std::vector<Index>& out) const
+{
+    const size_t start = out.size();
+    if(empty()) {
+        return 0;
+    }
+
+#if defined USE_SSE
+    const __m128 MINX = _mm_set1_ps(box.minimum().x()), MINY = _mm_set1_ps(box.minimum().y()), MINZ = _mm_set1_ps(box.minimum().z());
+    const __m128 MAXX = _mm_set1_ps(box.maximum().x()), MAXY = _mm_set1_ps(box.maximum().y()), MAXZ = _mm_set1_ps(box.maximum().z());
+#endif
+
+    uint32_t stack[MaxStackSize];
+    size_t top = 0;
+    stack[top++] = 0;
+    while(top > 0) {
+        const Node& node = _nodes[stack[--top]];
+
+        // unused children have empty bounds, which never overlap
+#if defined USE_SSE
+        const __m128 X = _mm_and_ps(_mm_cmple_ps(_mm_load_ps(node.minimum_x), MAXX), _mm_cmple_ps(MINX, _mm_load_ps(node.maximum_x)));
+        const __m128 Y = _mm_and_ps(_mm_cmple_ps(_mm_load_ps(node.minimum_y), MAXY), _mm_cmple_ps(MINY, _mm_load_ps(node.maximum_y)));
+        const __m128 Z = _mm_and_ps(_mm_cmple_ps(_mm_load_ps(node.minimum_z), MAXZ), _mm_cmple_ps(MINZ, _mm_load_ps(node.maximum_z)));
+        int mask = _mm_movemask_ps(_mm_and_ps(_mm_and_ps(X, Y), Z));
+#else
+        int mask = 0;
+        for(int i = 0; i < 4; ++i) {
+            const AABB child(Point3(node.minimum_x[i], node.minimum_y[i], node.minimum_z[i]),
+                Point3(node.maximum_x[i], node.maximum_y[i], node.maximum_z[i]));
+            mask |= child.overlaps(box) ? 1 << i : 0;
+        }
+#endif
+
+        for(int i = 0; 0 != mask; ++i, mask >>= 1) {
+            if(0 == (mask & 1)) {
+                continue;
+            }
+
+            if(0 != (node.children[i] & PrimitiveBit)) {
+                out.push_back(node.children[i] & ~PrimitiveBit);
+            } else {
+                stack[top++] = node.children[i];
+            }
+        }
+    }
+    return out.size() - start;
+}
+
+size_t BVH::query_ray(const Point3& origin, const Vector& direction, float t_max, std::vector<Index>& out) const
+{
+    const size_t start = out.size();
+    if(empty() || t_max < 0.0f) {
+        return 0;
+    }
+
+    const Ray ray(origin, direction);
+
+    uint32_t stack[MaxStackSize];
+    size_t top = 0;
+    stack[top++] = 0;
+    while(top > 0) {
+        const Node& node = _nodes[stack[--top]];
+
+        ALIGN(16) float t_near[4];
+        int mask = intersect_ray(node, ray, t_max, t_near);
+        for(int i = 0; 0 != mask; ++i, mask >>= 1) {
+            if(0 == (mask & 1)) {
+                continue;
+            }
+
+            if(0 != (node.children[i] & PrimitiveBit)) {
+                out.push_back(node.children[i] & ~PrimitiveBit);
+            } else {
+                stack[top++] = node.children[i];
+            }
+        }
+    }
+    return out.size() - start;
+}
+
+size_t BVH::query_frustum(const Vector* const planes, size_t count, std::vector<Index>& out) const
+{
+    const size_t start = out.size();
+    if(empty()) {
+        return 0;
+    }
+
+    uint32_t stack[MaxStackSize];
+    size_t top = 0;
+    stack[top++] = 0;
+    while(top > 0) {
+        const Node& node = _nodes[stack[--top]];
+
+        // for each plane the corner furthest along the normal decides
+        // if a box is outside and the nearest decides if it's entirely inside,
+        // which corner that is only depends on the signs of the normal
+#if defined USE_SSE
+        __m128 OUTSIDE = _mm_setzero_ps(), INSIDE = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for(size_t p = 0; p < count; ++p) {
+            const Vector& plane = planes[p];
+            const __m128 NX = _mm_set1_ps(plane.x()), NY = _mm_set1_ps(plane.y()), NZ = _mm_set1_ps(plane.z());
+            const __m128 D = _mm_set1_ps(plane.w());
+
+            const __m128 FAR_X = _mm_load_ps(plane.x() >= 0.0f ? node.maximum_x : node.minimum_x);
+            const __m128 FAR_Y = _mm_load_ps(plane.y() >= 0.0f ? node.maximum_y : node.minimum_y);
+            const __m128 FAR_Z = _mm_load_ps(plane.z() >= 0.0f ? node.maximum_z : node.minimum_z);
+            const __m128 NEAR_X = _mm_load_ps(plane.x() >= 0.0f ? node.minimum_x : node.maximum_x);
+            const __m128 NEAR_Y = _mm_load_ps(plane.y() >= 0.0f ? node.minimum_y : node.maximum_y);
+            const __m128 NEAR_Z = _mm_load_ps(plane.z() >= 0.0f ? node.minimum_z : node.maximum_z);
+
+            const __m128 DF = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(NX, FAR_X), _mm_mul_ps(NY, FAR_Y)), _mm_mul_ps(NZ, FAR_Z)), D);
+            const __m128 DN = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(NX, NEAR_X), _mm_mul_ps(NY, NEAR_Y)), _mm_mul_ps(NZ, NEAR_Z)), D);
+
+            OUTSIDE = _mm_or_ps(OUTSIDE, _mm_cmplt_ps(DF, _mm_setzero_ps()));
+            INSIDE = _mm_and_ps(INSIDE, _mm_cmpge_ps(DN, _mm_setzero_ps()));
+        }
+
+        const int used = valid(node);
+        int mask = ~_mm_movemask_ps(OUTSIDE) & used;
+        const int inside = _mm_movemask_ps(INSIDE) & used;
+#else
+        int outside = 0, inside = 0xf;
+        for(size_t p = 0; p < count; ++p) {
+            const Vector& plane = planes[p];
+            for(int i = 0; i < 4; ++i) {
+                const float far_x = plane.x() >= 0.0f ? node.maximum_x[i] : node.minimum_x[i];
+                const float far_y = plane.y() >= 0.0f ? node.maximum_y[i] : node.minimum_y[i];
+                const float far_z = plane.z() >= 0.0f ? node.maximum_z[i] : node.minimum_z[i];
+                const float near_x = plane.x() >= 0.0f ? node.minimum_x[i] : node.maximum_x[i];
+                const float near_y = plane.y() >= 0.0f ? node.minimum_y[i] : node.maximum_y[i];
+                const float near_z = plane.z() >= 0.0f ? node.minimum_z[i] : node.maximum_z[i];
+
+                outside |= plane.x() * far_x + plane.y() * far_y + plane.z() * far_z + plane.w() < 0.0f ? 1 << i : 0;
+                if(plane.x() * near_x + plane.y() * near_y + plane.z() * near_z + plane.w() < 0.0f) {
+                    inside &= ~(1 << i);
+                }
+            }
+        }
+
+        const int used = valid(node);
+        int mask = ~outside & used;
+        inside &= used;
+#endif
+
+        for(int i = 0; 0 != mask; ++i, mask >>= 1) {
+            if(0 == (mask & 1)) {
+                continue;
+            }
+
+            const uint32_t child = node.children[i];
+            if(0 != (child & PrimitiveBit)) {
+                out.push_back(child & ~PrimitiveBit);
+            } else if(0 != (inside & (1 << i))) {
+                // nothing under it can be outside
+                collect(child, out);
+            } else {
+                stack[top++] = child;
+            }
+        }
+    }
+    return out.size() - start;
+}
+
+} }
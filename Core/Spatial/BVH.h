@@ -0,0 +1,290 @@
+#if !defined __BVH_H__
+#define __BVH_H__
+
+#include <limits>
+#include <vector>
+#include "Core/Math/AABB.h"
+#include "Core/Math/Frustum.h"
+
+namespace energonsoftware {
+namespace spatial {
+
+using math::AABB;
+using math::Frustum;
+using math::Point3;
+using math::Vector;
+
+/*
+Bounding volume hierarchy over a set of AABBs (one per primitive),
+built once and then only queried.
+
+Every node has up to 4 children, each either another node or a single
+primitive, with the child bounds stored as structure-of-arrays so
+that a query tests all 4 of them at once with SSE. The nodes are a
+single flat array with the root first.
+
+The tree is built top-down with the surface area heuristic (binned),
+splitting each node into 2 and then splitting the child with the
+largest surface area until there are 4. Large subtrees are built on
+separate threads, the result doesn't depend on the thread count.
+
+Results are indices into the array the tree was built from.
+
+Queries are const and safe to run from multiple threads at once.
+*/
+class DllExport BVH
+{
+public:
+    typedef uint32_t Index;
+
+    static const Index InvalidIndex = 0xffffffff;
+
+    // the most primitives
+    static const size_t MaxSize = 0x7fffffff;
+
+public:
+    BVH() = default;
+
+    // see build()
+    BVH(const AABB* const boxes, size_t count, size_t max_threads = 0);
+
+    DEFAULT_COPY_AND_ASSIGN(BVH);
+
+    BVH(BVH&& bvh) = default;
+
+    ~BVH() = default;
+
+public:
+    // replaces the tree with one over count primitives
+    // NOTE: the boxes must not be empty
+    // max_threads limits the build threads, 0 uses every hardware thread
+    void build(const AABB* const boxes, size_t count, size_t max_threads = 0);
+
+    void clear();
+
+    // the number of primitives
+    size_t size() const { return _size; }
+    bool empty() const { return 0 == _size; }
+
+    size_t node_count() const { return _nodes.size(); }
+
+    // the bounds of every primitive
+    const AABB& bounds() const { return _bounds; }
+
+public:
+    // each of these appends the indices of the matching primitives to out
+    // in no particular order and returns the number found
+
+    // primitives whose boxes overlap box
+    size_t query_overlap(const AABB& box, std::vector<Index>& out) const;
+
+    // primitives whose boxes the ray origin + t * direction
+    // hits for t in [0, t_max], direction doesn't need to be normalized
+    size_t query_ray(const Point3& origin, const Vector& direction, float t_max, std::vector<Index>& out) const;
+
+    // primitives whose boxes are at least partly inside of every plane,
+    // each plane is (normal, d) and the inside is where normal * p + d >= 0
+    // (a frustum with the normals pointing inwards)
+    // NOTE: this is conservative, a box outside of the frustum
+    // that's inside of every plane (near a corner) is included
+    size_t query_frustum(const Vector* const planes, size_t count, std::vector<Index>& out) const;
+
+    size_t query_frustum(const Frustum& frustum, std::vector<Index>& out) const
+    {
+        // Plane is laid out exactly like Vector
+        return query_frustum(&frustum.plane(Frustum::LeftPlane).vector(), Frustum::PlaneCount, out);
+    }
+
+    // closest hit along the ray origin + t * direction for t in [0, t],
+    // returns the index of the hit primitive and the distance in t,
+    // or InvalidIndex (and t is unchanged) if nothing is hit
+    //
+    // intersect(Index index, float t_box, float& t) tests one primitive,
+    // t_box is where the ray enters the primitive's box (a lower bound
+    // on the hit) and t is the closest hit so far, if the primitive is hit
+    // closer than that it should set t and return true
+    //
+    // primitives are tested roughly nearest first and never
+    // if their box is further away than the closest hit
+    template<typename Intersect>
+    Index cast_ray(const Point3& origin, const Vector& direction, float& t, Intersect intersect) const;
+
+    // the closest primitive box hit along the ray
+    Index cast_ray(const Point3& origin, const Vector& direction, float& t) const
+    {
+        return cast_ray(origin, direction, t, [](Index, float t_box, float& t_hit) {
+            t_hit = t_box;
+            return true;
+        });
+    }
+
+private:
+    // the children of a node, unused slots are InvalidIndex and always last
+    struct ALIGN(16) Node
+    {
+        float minimum_x[4], minimum_y[4], minimum_z[4];
+        float maximum_x[4], maximum_y[4], maximum_z[4];
+
+        // primitives are PrimitiveBit | index, nodes are just the index
+        uint32_t children[4];
+    };
+
+    static const uint32_t PrimitiveBit = 0x80000000;
+
+    // the deepest tree that the build produces
+    static const size_t MaxDepth = 64;
+
+    // each node visited pushes at most 3 more than it pops
+    static const size_t MaxStackSize = 3 * MaxDepth + 1;
+
+    // the ray broadcast to every lane
+    struct ALIGN(16) Ray
+    {
+        float origin_x[4], origin_y[4], origin_z[4];
+        float inv_direction_x[4], inv_direction_y[4], inv_direction_z[4];
+
+        Ray(const Point3& origin, const Vector& direction)
+        {
+            for(int i = 0; i < 4; ++i) {
+                origin_x[i] = origin.x();
+                origin_y[i] = origin.y();
+                origin_z[i] = origin.z();
+
+                // infinite for 0 components
+                inv_direction_x[i] = 1.0f / direction.x();
+                inv_direction_y[i] = 1.0f / direction.y();
+                inv_direction_z[i] = 1.0f / direction.z();
+            }
+        }
+    };
+
+    class Builder;
+
+private:
+    // the mask of the used children
+    static int valid(const Node& node)
+    {
+#if defined USE_SSE
+        const __m128i C = _mm_load_si128(reinterpret_cast<const __m128i*>(node.children));
+        return ~_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(C, _mm_set1_epi32(-1)))) & 0xf;
+#else
+        int mask = 0;
+        for(int i = 0; i < 4; ++i) {
+            mask |= InvalidIndex != node.children[i] ? 1 << i : 0;
+        }
+        return mask;
+#endif
+    }
+
+    // slab test of the ray against each child, see AABB::intersect_ray()
+    // returns the mask of the children hit for t in [0, t_max]
+    // with where the ray enters them in t_near
+    static int intersect_ray(const Node& node, const Ray& ray, float t_max, float* const t_near)
+    {
+#if defined USE_SSE
+        const __m128 OX = _mm_load_ps(ray.origin_x), OY = _mm_load_ps(ray.origin_y), OZ = _mm_load_ps(ray.origin_z);
+        const __m128 IX = _mm_load_ps(ray.inv_direction_x), IY = _mm_load_ps(ray.inv_direction_y), IZ = _mm_load_ps(ray.inv_direction_z);
+
+        const __m128 X1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minimum_x), OX), IX);
+        const __m128 X2 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maximum_x), OX), IX);
+        const __m128 Y1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minimum_y), OY), IY);
+        const __m128 Y2 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maximum_y), OY), IY);
+        const __m128 Z1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minimum_z), OZ), IZ);
+        const __m128 Z2 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maximum_z), OZ), IZ);
+
+        const __m128 TN = _mm_max_ps(_mm_max_ps(_mm_min_ps(X1, X2), _mm_min_ps(Y1, Y2)), _mm_max_ps(_mm_min_ps(Z1, Z2), _mm_setzero_ps()));
+        const __m128 TF = _mm_min_ps(_mm_min_ps(_mm_max_ps(X1, X2), _mm_max_ps(Y1, Y2)), _mm_min_ps(_mm_max_ps(Z1, Z2), _mm_set1_ps(t_max)));
+
+        _mm_store_ps(t_near, TN);
+        return _mm_movemask_ps(_mm_cmple_ps(TN, TF)) & valid(node);
+#else
+        int mask = 0;
+        for(int i = 0; i < 4; ++i) {
+            const float x1 = (node.minimum_x[i] - ray.origin_x[i]) * ray.inv_direction_x[i];
+            const float x2 = (node.maximum_x[i] - ray.origin_x[i]) * ray.inv_direction_x[i];
+            const float y1 = (node.minimum_y[i] - ray.origin_y[i]) * ray.inv_direction_y[i];
+            const float y2 = (node.maximum_y[i] - ray.origin_y[i]) * ray.inv_direction_y[i];
+            const float z1 = (node.minimum_z[i] - ray.origin_z[i]) * ray.inv_direction_z[i];
+            const float z2 = (node.maximum_z[i] - ray.origin_z[i]) * ray.inv_direction_z[i];
+
+            const float tn = MAX(MAX(MIN(x1, x2), MIN(y1, y2)), MAX(MIN(z1, z2), 0.0f));
+            const float tf = MIN(MIN(MAX(x1, x2), MAX(y1, y2)), MIN(MAX(z1, z2), t_max));
+
+            t_near[i] = tn;
+            mask |= tn <= tf ? 1 << i : 0;
+        }
+        return mask & valid(node);
+#endif
+    }
+
+    // appends every primitive under node to out
+    void collect(uint32_t node, std::vector<Index>& out) const;
+
+private:
+    std::vector<Node> _nodes;
+    AABB _bounds;
+    size_t _size = 0;
+};
+
+template<typename Intersect>
+BVH::Index BVH::cast_ray(const Point3& origin, const Vector& direction, float& t, Intersect intersect) const
+{
+    Index hit = InvalidIndex;
+    if(empty()) {
+        return hit;
+    }
+
+    const Ray ray(origin, direction);
+
+    // a node or primitive with where the ray enters its box
+    struct Visit
+    {
+        uint32_t child;
+        float t;
+    };
+
+    Visit stack[MaxStackSize];
+    size_t top = 0;
+    stack[top++] = { 0, 0.0f };
+    while(top > 0) {
+        const Visit visit = stack[--top];
+        if(visit.t > t) {
+            continue;
+        }
+
+        if(0 != (visit.child & PrimitiveBit)) {
+            const Index index = visit.child & ~PrimitiveBit;
+            if(intersect(index, visit.t, t)) {
+                hit = index;
+            }
+            continue;
+        }
+
+        const Node& node = _nodes[visit.child];
+
+        ALIGN(16) float t_near[4];
+        const int mask = intersect_ray(node, ray, t, t_near);
+        if(0 == mask) {
+            continue;
+        }
+
+        // furthest first so the nearest is on top of the stack
+        Visit* const begin = stack + top;
+        for(int i = 0; i < 4; ++i) {
+            if(0 == (mask & (1 << i))) {
+                continue;
+            }
+
+            Visit* v = stack + top++;
+            for(; v != begin && (v - 1)->t < t_near[i]; --v) {
+                *v = *(v - 1);
+            }
+            *v = { node.children[i], t_near[i] };
+        }
+    }
+    return hit;
+}
+
+} }
+
+#endif
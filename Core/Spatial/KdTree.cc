@@ -0,0 +1,344 @@
+#include "pch.h"
+#include <algorithm>
+#include <thread>
+#include "NearestHeap.h"
+#include "KdTree.h"
+
+namespace energonsoftware {
+namespace spatial {
+
+const KdTree::Index KdTree::InvalidIndex;
+const size_t KdTree::LeafSize;
+const uint32_t KdTree::Leaf;
+
+namespace {
+
+// subtrees smaller than this aren't worth starting a thread for
+const size_t ParallelThreshold = 1 << 15;
+
+// deep enough for any tree that Index can address
+const size_t MaxStackSize = 64;
+
+// the leaf scans read whole groups of 4 so the arrays are padded
+const size_t Padding = 3;
+
+}
+
+/*
+Builds the tree in two passes, first the node layout (which only depends
+on the point count) and then the splits, which are independent per subtree
+and can run in parallel because each one only touches its own range of
+the nodes and of the point order.
+*/
+class KdTree::Builder
+{
+public:
+    Builder(KdTree& tree, const Point3* const points, size_t count)
+        : _tree(tree), _points(points), _order(count)
+    {
+        for(size_t i = 0; i < count; ++i) {
+            _order[i] = static_cast<uint32_t>(i);
+        }
+    }
+
+public:
+    void build(size_t max_threads)
+    {
+        layout(0, static_cast<uint32_t>(_order.size()));
+        split(0, max_threads);
+
+        const size_t count = _order.size();
+        _tree._x.assign(count + Padding, 0.0f);
+        _tree._y.assign(count + Padding, 0.0f);
+        _tree._z.assign(count + Padding, 0.0f);
+        _tree._indices.resize(count);
+        _tree._positions.resize(count);
+        for(size_t i = 0; i < count; ++i) {
+            const Point3& point = _points[_order[i]];
+            _tree._x[i] = point.x();
+            _tree._y[i] = point.y();
+            _tree._z[i] = point.z();
+            _tree._indices[i] = _order[i];
+            _tree._positions[_order[i]] = static_cast<uint32_t>(i);
+        }
+    }
+
+private:
+    // depth-first, so the left child always follows its parent
+    void layout(uint32_t begin, uint32_t count)
+    {
+        const size_t node = _tree._nodes.size();
+        _ranges.push_back({ begin, count });
+
+        if(count <= LeafSize) {
+            _tree._nodes.push_back({ 0.0f, Leaf, begin, count });
+            return;
+        }
+
+        _tree._nodes.push_back({ 0.0f, 0, 0, 0 });
+
+        const uint32_t left = count / 2;
+        layout(begin, left);
+        _tree._nodes[node].index = static_cast<uint32_t>(_tree._nodes.size());
+        layout(begin + left, count - left);
+    }
+
+    void split(size_t node, size_t threads)
+    {
+        Node& n = _tree._nodes[node];
+        if(Leaf == n.axis) {
+            return;
+        }
+
+        const Range range = _ranges[node];
+        uint32_t* const begin = _order.data() + range.begin;
+        uint32_t* const end = begin + range.count;
+
+        // split the widest axis of the bounds
+        Vector lo = _points[*begin], hi = lo;
+        for(const uint32_t* i = begin + 1; i != end; ++i) {
+            const Point3& point = _points[*i];
+            lo = Vector(MIN(lo.x(), point.x()), MIN(lo.y(), point.y()), MIN(lo.z(), point.z()));
+            hi = Vector(MAX(hi.x(), point.x()), MAX(hi.y(), point.y()), MAX(hi.z(), point.z()));
+        }
+
+        const Vector extent = hi - lo;
+        const int axis = extent.x() >= extent.y()
+            ? (extent.x() >= extent.z() ? 0 : 2)
+            : (extent.y() >= extent.z() ? 1 : 2);
+
+        // ties are broken by index so the tree is the same every time
+        const Point3* const points = _points;
+        uint32_t* const middle = begin + range.count / 2;
+        std::nth_element(begin, middle, end, [points, axis](uint32_t a, uint32_t b) {
+            const float pa = points[a][axis], pb = points[b][axis];
+            return pa == pb ? a < b : pa < pb;
+        });
+
+        n.axis = static_cast<uint32_t>(axis);
+        n.split = _points[*middle][axis];
+
+        const size_t left = node + 1, right = n.index;
+        if(threads > 1 && range.count >= ParallelThreshold) {
+            std::thread thread([this, left, threads]() { split(left, threads / 2); });
+            split(right, threads - threads / 2);
+            thread.join();
+        } else {
+            split(left, 1);
+            split(right, 1);
+        }
+    }
+
+private:
+    KdTree& _tree;
+    const Point3* const _points;
+
+    std::vector<uint32_t> _order;
+    std::vector<Range> _ranges;
+};
+
+KdTree::KdTree(const Point3* const points, size_t count, size_t max_threads)
+{
+    build(points, count, max_threads);
+}
+
+void KdTree::build(const Point3* const points, size_t count, size_t max_threads)
+{
+    assert(count < InvalidIndex);
+
+    clear();
+    if(0 == count) {
+        return;
+    }
+
+    if(0 == max_threads) {
+        max_threads = MAX(1u, std::thread::hardware_concurrency());
+    }
+
+    Builder builder(*this, points, count);
+    builder.build(max_threads);
+}
+
+void KdTree::clear()
+{
+    _x.clear();
+    _y.clear();
+    _z.clear();
+    _indices.clear();
+    _positions.clear();
+    _nodes.clear();
+}
+
+Point3 KdTree::point(Index index) const
+{
+    assert(index < size());
+
+    const uint32_t i = _positions[index];
+    return Point3(_x[i], _y[i], _z[i]);
+}
+
+KdTree::Index KdTree::nearest(const Point3& center) const
+{
+    std::vector<Index> found;
+    return 0 == query_nearest(center, 1, found) ? InvalidIndex : found[0];
+}
+
+// NOTE: the leaf scans sum the squares in the same order as
+// Vector::distance_squared() ((x + z) + y with SSE, x + y + z without)
+// so the distances match it exactly
+
+size_t KdTree::query_radius(const Point3& center, float radius, std::vector<Index>& out) const
+{
+    const size_t start = out.size();
+    if(empty() || radius < 0.0f) {
+        return 0;
+    }
+
+    const float c[3] = { center.x(), center.y(), center.z() };
+    const float radius_squared = radius * radius;
+
+    uint32_t stack[MaxStackSize];
+    size_t top = 0;
+    stack[top++] = 0;
+    while(top > 0) {
+        const uint32_t index = stack[--top];
+        const Node& node = _nodes[index];
+
+        if(Leaf != node.axis) {
+            const float d = c[node.axis] - node.split;
+            if(d >= -radius) {
+                stack[top++] = node.index;
+            }
+            if(d <= radius) {
+                stack[top++] = index + 1;
+            }
+            continue;
+        }
+
+#if defined USE_SSE
+        const __m128 CX = _mm_set1_ps(c[0]), CY = _mm_set1_ps(c[1]), CZ = _mm_set1_ps(c[2]);
+        const __m128 R = _mm_set1_ps(radius_squared);
+        for(uint32_t i = node.index, end = node.index + node.count; i < end; i += 4) {
+            const __m128 DX = _mm_sub_ps(_mm_loadu_ps(_x.data() + i), CX);
+            const __m128 DY = _mm_sub_ps(_mm_loadu_ps(_y.data() + i), CY);
+            const __m128 DZ = _mm_sub_ps(_mm_loadu_ps(_z.data() + i), CZ);
+            const __m128 D = _mm_add_ps(_mm_add_ps(_mm_mul_ps(DX, DX), _mm_mul_ps(DZ, DZ)), _mm_mul_ps(DY, DY));
+
+            // only the lanes inside of the leaf count
+            int mask = _mm_movemask_ps(_mm_cmple_ps(D, R));
+            if(end - i < 4) {
+                mask &= (1 << (end - i)) - 1;
+            }
+            for(uint32_t j = 0; 0 != mask; ++j, mask >>= 1) {
+                if(0 != (mask & 1)) {
+                    out.push_back(_indices[i + j]);
+                }
+            }
+        }
+#else
+        for(uint32_t i = node.index, end = node.index + node.count; i < end; ++i) {
+            const float dx = _x[i] - c[0], dy = _y[i] - c[1], dz = _z[i] - c[2];
+            if(dx * dx + dy * dy + dz * dz <= radius_squared) {
+                out.push_back(_indices[i]);
+            }
+        }
+#endif
+    }
+    return out.size() - start;
+}
+
+size_t KdTree::query_nearest(const Point3& center, size_t k, std::vector<Index>& out, float max_distance) const
+{
+    if(empty() || 0 == k || max_distance < 0.0f) {
+        return 0;
+    }
+
+    const float c[3] = { center.x(), center.y(), center.z() };
+    NearestHeap nearest(k, max_distance * max_distance);
+
+    // each node with a lower bound on the distance to its points
+    struct Visit
+    {
+        uint32_t node;
+        float distance_squared;
+    };
+
+    Visit stack[MaxStackSize];
+    size_t top = 0;
+    stack[top++] = { 0, 0.0f };
+    while(top > 0) {
+        const Visit visit = stack[--top];
+        if(visit.distance_squared > nearest.bound()) {
+            continue;
+        }
+
+        const Node& node = _nodes[visit.node];
+        if(Leaf != node.axis) {
+            // the near side goes on top so it's searched first
+            const float d = c[node.axis] - node.split;
+            const uint32_t left = visit.node + 1, right = node.index;
+            stack[top++] = { d <= 0.0f ? right : left, MAX(visit.distance_squared, d * d) };
+            stack[top++] = { d <= 0.0f ? left : right, visit.distance_squared };
+            continue;
+        }
+
+#if defined USE_SSE
+        const __m128 CX = _mm_set1_ps(c[0]), CY = _mm_set1_ps(c[1]), CZ = _mm_set1_ps(c[2]);
+        for(uint32_t i = node.index, end = node.index + node.count; i < end; i += 4) {
+            const __m128 DX = _mm_sub_ps(_mm_loadu_ps(_x.data() + i), CX);
+            const __m128 DY = _mm_sub_ps(_mm_loadu_ps(_y.data() + i), CY);
+            const __m128 DZ = _mm_sub_ps(_mm_loadu_ps(_z.data() + i), CZ);
+            const __m128 D = _mm_add_ps(_mm_add_ps(_mm_mul_ps(DX, DX), _mm_mul_ps(DZ, DZ)), _mm_mul_ps(DY, DY));
+
+            // most points can't beat the current bound, skip them together
+            int mask = _mm_movemask_ps(_mm_cmple_ps(D, _mm_set1_ps(nearest.bound())));
+            if(end - i < 4) {
+                mask &= (1 << (end - i)) - 1;
+            }
+            if(0 == mask) {
+                continue;
+            }
+
+            ALIGN(16) float d[4];
+            _mm_store_ps(d, D);
+            for(uint32_t j = 0; 0 != mask; ++j, mask >>= 1) {
+                if(0 != (mask & 1)) {
+                    nearest.add(d[j], _indices[i + j]);
+                }
+            }
+        }
+#else
+        for(uint32_t i = node.index, end = node.index + node.count; i < end; ++i) {
+            const float dx = _x[i] - c[0], dy = _y[i] - c[1], dz = _z[i] - c[2];
+            nearest.add(dx * dx + dy * dy + dz * dz, _indices[i]);
+        }
+#endif
+    }
+
+    return nearest.finish(out);
+}
+
+void KdTree::query_radius(const Point3* const centers, size_t count, float radius, QueryResults& results) const
+{
+    results.clear();
+    results.offsets.reserve(count + 1);
+    results.offsets.push_back(0);
+    for(size_t i = 0; i < count; ++i) {
+        query_radius(centers[i], radius, results.ids);
+        results.offsets.push_back(results.ids.size());
+    }
+}
+
+void KdTree::query_nearest(const Point3* const centers, size_t count, size_t k, QueryResults& results, float max_distance) const
+{
+    results.clear();
+    results.offsets.reserve(count + 1);
+    results.ids.reserve(count * MIN(k, size()));
+    results.offsets.push_back(0);
+    for(size_t i = 0; i < count; ++i) {
+        query_nearest(centers[i], k, results.ids, max_distance);
+        results.offsets.push_back(results.ids.size());
+    }
+}
+
+} }
@@ -0,0 +1,137 @@
+#if !defined __KDTREE_H__
+#define __KDTREE_H__
+
+#include <limits>
+#include <vector>
+#include "Core/Math/Vector.h"
+#include "QueryResults.h"
+
+namespace energonsoftware {
+namespace spatial {
+
+using math::Point3;
+using math::Vector;
+
+/*
+Static k-d tree over a set of Point3s, built once and then only queried.
+
+The nodes are a single flat array in depth-first order (the left child
+of a node directly follows it) and the points are copied into
+structure-of-arrays order by leaf, so a query walks contiguous memory and
+scans each leaf 4 points at a time with SSE.
+
+Each node splits its points at the median along the widest axis
+of their bounds. The subtrees are independent so large builds
+split them across threads, the result doesn't depend on the thread count.
+
+For points that don't move this is faster to query than SpatialHashGrid
+and doesn't need a cell size tuned to the query radius, rebuild it
+(or use the grid) for points that do.
+
+Results are indices into the array the tree was built from.
+Only x, y and z are used, w is ignored.
+
+Queries are const and safe to run from multiple threads at once.
+*/
+class DllExport KdTree
+{
+public:
+    typedef uint32_t Index;
+
+    static const Index InvalidIndex = 0xffffffff;
+
+    // the most points in a leaf
+    static const size_t LeafSize = 8;
+
+public:
+    KdTree() = default;
+
+    // see build()
+    KdTree(const Point3* const points, size_t count, size_t max_threads = 0);
+
+    DEFAULT_COPY_AND_ASSIGN(KdTree);
+
+    KdTree(KdTree&& tree) = default;
+
+    ~KdTree() = default;
+
+public:
+    // replaces the tree with one over count points
+    // max_threads limits the build threads, 0 uses every hardware thread
+    void build(const Point3* const points, size_t count, size_t max_threads = 0);
+
+    void clear();
+
+    // the number of points
+    size_t size() const { return _indices.size(); }
+    bool empty() const { return _indices.empty(); }
+
+    size_t node_count() const { return _nodes.size(); }
+
+    // NOTE: index is into the original array
+    Point3 point(Index index) const;
+
+public:
+    // the index of the point nearest center, InvalidIndex if the tree is empty
+    Index nearest(const Point3& center) const;
+
+    // appends the indices of every point within radius (inclusive) of center to out
+    // in no particular order, returns the number found
+    size_t query_radius(const Point3& center, float radius, std::vector<Index>& out) const;
+
+    // appends the indices of the (up to) k points nearest center
+    // and no further than max_distance to out, nearest first,
+    // returns the number found
+    size_t query_nearest(const Point3& center, size_t k, std::vector<Index>& out,
+        float max_distance = std::numeric_limits<float>::infinity()) const;
+
+    // batched versions of the above, one query per center
+    // results replace whatever was in the buffers
+    void query_radius(const Point3* const centers, size_t count, float radius, QueryResults& results) const;
+    void query_nearest(const Point3* const centers, size_t count, size_t k, QueryResults& results,
+        float max_distance = std::numeric_limits<float>::infinity()) const;
+
+private:
+    struct Node
+    {
+        // inner nodes only, points left of the split are <= split
+        // and points right of it are >= split
+        float split;
+
+        // 0, 1 or 2 for inner nodes, Leaf for leaves
+        uint32_t axis;
+
+        // inner nodes: the right child
+        // leaves: the first point (in the tree order)
+        uint32_t index;
+
+        // leaves only
+        uint32_t count;
+    };
+
+    static const uint32_t Leaf = 3;
+
+    struct Range
+    {
+        uint32_t begin;
+        uint32_t count;
+    };
+
+    class Builder;
+
+private:
+    // tree order
+    std::vector<float> _x;
+    std::vector<float> _y;
+    std::vector<float> _z;
+    std::vector<Index> _indices;
+
+    // original index to tree order
+    std::vector<uint32_t> _positions;
+
+    std::vector<Node> _nodes;
+};
+
+} }
+
+#endif
@@ -0,0 +1,67 @@
+#if !defined __NEARESTHEAP_H__
+#define __NEARESTHEAP_H__
+
+#include <algorithm>
+#include <vector>
+
+namespace energonsoftware {
+namespace spatial {
+
+// the k best candidates of a nearest-neighbor query as a max-heap on distance
+// shared by the spatial indices, which keeps their results identical
+class NearestHeap
+{
+public:
+    NearestHeap(size_t k, float max_distance_squared)
+        : _k(k), _max_distance_squared(max_distance_squared)
+    {
+        _heap.reserve(k);
+    }
+
+public:
+    bool full() const { return _heap.size() == _k; }
+
+    // the distance a point has to beat to get in
+    float bound() const { return full() ? _heap.front().first : _max_distance_squared; }
+
+    void add(float distance_squared, uint32_t id)
+    {
+        if(distance_squared > _max_distance_squared) {
+            return;
+        }
+
+        const Candidate candidate(distance_squared, id);
+        if(!full()) {
+            _heap.push_back(candidate);
+            std::push_heap(_heap.begin(), _heap.end());
+        } else if(candidate < _heap.front()) {
+            std::pop_heap(_heap.begin(), _heap.end());
+            _heap.back() = candidate;
+            std::push_heap(_heap.begin(), _heap.end());
+        }
+    }
+
+    void clear() { _heap.clear(); }
+
+    // appends the ids to out nearest first, returns the number appended
+    size_t finish(std::vector<uint32_t>& out)
+    {
+        std::sort_heap(_heap.begin(), _heap.end());
+        for(const Candidate& candidate : _heap) {
+            out.push_back(candidate.second);
+        }
+        return _heap.size();
+    }
+
+private:
+    // ties are broken by id so the results don't depend on the search order
+    typedef std::pair<float, uint32_t> Candidate;
+
+    size_t _k;
+    float _max_distance_squared;
+    std::vector<Candidate> _heap;
+};
+
+} }
+
+#endif
@@ -0,0 +1,37 @@
+#if !defined __QUERYRESULTS_H__
+#define __QUERYRESULTS_H__
+
+#include <vector>
+
+namespace energonsoftware {
+namespace spatial {
+
+/*
+Results of a batched query in a single contiguous buffer.
+
+The results of query i are ids[offsets[i]] up to ids[offsets[i + 1]],
+so the buffers can be reused from one query to the next without reallocating.
+*/
+struct DllExport QueryResults
+{
+    std::vector<size_t> offsets;
+    std::vector<uint32_t> ids;
+
+    // the number of queries
+    size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+    size_t count(size_t query) const { return offsets[query + 1] - offsets[query]; }
+
+    const uint32_t* begin(size_t query) const { return ids.data() + offsets[query]; }
+    const uint32_t* end(size_t query) const { return ids.data() + offsets[query + 1]; }
+
+    void clear()
+    {
+        offsets.clear();
+        ids.clear();
+    }
+};
+
+} }
+
+#endif
@@ -0,0 +1,412 @@
+#include "pch.h"
+#include <algorithm>
+#include <cmath>
+#include "NearestHeap.h"
+#include "SpatialHashGrid.h"
+
+namespace energonsoftware {
+namespace spatial {
+
+const SpatialHashGrid::Id SpatialHashGrid::InvalidId;
+const uint64_t SpatialHashGrid::EmptyKey;
+
+namespace {
+
+// each coordinate gets 21 bits of the key, coordinates outside of
+// that range wrap around and share cells with others, which costs
+// extra distance checks but never changes the results
+const int CoordinateBits = 21;
+const uint64_t CoordinateMask = (static_cast<uint64_t>(1) << CoordinateBits) - 1;
+
+// ranges of cells at least this wide would wrap and visit cells twice
+const int64_t MaxCellSpan = static_cast<int64_t>(1) << CoordinateBits;
+
+// the cell table starts this big and stays at most half full
+const size_t MinTableSize = 64;
+
+uint64_t cell_key(int32_t x, int32_t y, int32_t z)
+{
+    return (static_cast<uint64_t>(x) & CoordinateMask)
+        | ((static_cast<uint64_t>(y) & CoordinateMask) << CoordinateBits)
+        | ((static_cast<uint64_t>(z) & CoordinateMask) << (CoordinateBits * 2));
+}
+
+// the keys are packed cell coordinates so this only needs to mix the bits
+size_t key_hash(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return static_cast<size_t>(key);
+}
+
+}
+
+SpatialHashGrid::SpatialHashGrid(float cell_size)
+    : _cell_size(cell_size), _inv_cell_size(1.0f / cell_size)
+{
+    assert(cell_size > 0.0f);
+}
+
+void SpatialHashGrid::clear()
+{
+    _cells.clear();
+    _table_keys.clear();
+    _table_cells.clear();
+    _entries.clear();
+    _free.clear();
+    _size = 0;
+}
+
+SpatialHashGrid::Id SpatialHashGrid::insert(const Point3& position)
+{
+    Id id;
+    if(_free.empty()) {
+        assert(_entries.size() < InvalidId);
+        id = static_cast<Id>(_entries.size());
+        _entries.push_back({ EmptyKey, 0 });
+    } else {
+        id = _free.back();
+        _free.pop_back();
+    }
+
+    const Vector p = position.xyz();
+    const CellCoordinates c = cell_coordinates(p);
+    add_to_cell(id, cell_key(c.x, c.y, c.z), p);
+    ++_size;
+    return id;
+}
+
+void SpatialHashGrid::move(Id id, const Point3& position)
+{
+    assert(contains(id));
+
+    const Vector p = position.xyz();
+    const CellCoordinates c = cell_coordinates(p);
+    const uint64_t key = cell_key(c.x, c.y, c.z);
+
+    Entry& entry = _entries[id];
+    if(key == entry.key) {
+        const_cast<Cell*>(find_cell(key))->positions[entry.slot] = p;
+        return;
+    }
+
+    remove_from_cell(id);
+    add_to_cell(id, key, p);
+}
+
+void SpatialHashGrid::remove(Id id)
+{
+    assert(contains(id));
+
+    remove_from_cell(id);
+    _entries[id].key = EmptyKey;
+    _free.push_back(id);
+    --_size;
+}
+
+const Point3& SpatialHashGrid::position(Id id) const
+{
+    assert(contains(id));
+
+    const Entry& entry = _entries[id];
+    return find_cell(entry.key)->positions[entry.slot];
+}
+
+size_t SpatialHashGrid::query_radius(const Point3& center, float radius, std::vector<Id>& out) const
+{
+    const size_t start = out.size();
+    if(empty() || radius < 0.0f) {
+        return 0;
+    }
+
+    const Vector c = center.xyz();
+    const float radius_squared = radius * radius;
+
+    const auto scan = [&c, radius_squared, &out](const Cell& cell) {
+        for(size_t i = 0; i < cell.positions.size(); ++i) {
+            if(c.distance_squared(cell.positions[i]) <= radius_squared) {
+                out.push_back(cell.ids[i]);
+            }
+        }
+    };
+
+    const Vector extent(radius, radius, radius);
+    const CellCoordinates lo = cell_coordinates(c - extent);
+    const CellCoordinates hi = cell_coordinates(c + extent);
+
+    const int64_t nx = static_cast<int64_t>(hi.x) - lo.x + 1;
+    const int64_t ny = static_cast<int64_t>(hi.y) - lo.y + 1;
+    const int64_t nz = static_cast<int64_t>(hi.z) - lo.z + 1;
+
+    // large radii cover more (empty) cells than there are occupied ones
+    if(nx >= MaxCellSpan || ny >= MaxCellSpan || nz >= MaxCellSpan
+        || static_cast<double>(nx) * ny * nz > static_cast<double>(_cells.size())) {
+        for(const Cell& cell : _cells) {
+            scan(cell);
+        }
+        return out.size() - start;
+    }
+
+    // the distance along one axis from center to cell i, with a little slack for rounding
+    const float slack = _cell_size * 1.0e-5f;
+    const auto gap = [this, slack](int32_t i, float v) {
+        const float g = MAX(static_cast<float>(i) * _cell_size - v, v - static_cast<float>(i + 1) * _cell_size);
+        return MAX(0.0f, g - slack);
+    };
+
+    for(int32_t z = lo.z; z <= hi.z; ++z) {
+        const float gz = gap(z, c.z());
+        for(int32_t y = lo.y; y <= hi.y; ++y) {
+            const float gy = gap(y, c.y());
+            for(int32_t x = lo.x; x <= hi.x; ++x) {
+                // skip (without looking up) the corners of the box outside of the sphere
+                const float gx = gap(x, c.x());
+                if(gx * gx + gy * gy + gz * gz > radius_squared) {
+                    continue;
+                }
+
+                const Cell* const cell = find_cell(x, y, z);
+                if(nullptr != cell) {
+                    scan(*cell);
+                }
+            }
+        }
+    }
+    return out.size() - start;
+}
+
+size_t SpatialHashGrid::query_nearest(const Point3& center, size_t k, std::vector<Id>& out, float max_distance) const
+{
+    if(empty() || 0 == k || max_distance < 0.0f) {
+        return 0;
+    }
+
+    const Vector c = center.xyz();
+    NearestHeap nearest(k, max_distance * max_distance);
+
+    const auto scan = [&c, &nearest](const Cell& cell) {
+        for(size_t i = 0; i < cell.positions.size(); ++i) {
+            nearest.add(c.distance_squared(cell.positions[i]), cell.ids[i]);
+        }
+        return cell.positions.size();
+    };
+
+    // search outwards one shell of cells at a time
+    // until nothing outside of the searched cube can be closer
+    const CellCoordinates origin = cell_coordinates(c);
+
+    // center relative to its cell, and the distance along one axis
+    // from there to the cell d cells over (with a little slack for rounding)
+    const Vector offset = c - Vector(static_cast<float>(origin.x), static_cast<float>(origin.y), static_cast<float>(origin.z)) * _cell_size;
+    const float slack = _cell_size * 1.0e-5f;
+    const auto gap = [this, slack](int32_t d, float o) {
+        const float g = d > 0 ? static_cast<float>(d) * _cell_size - o
+            : d < 0 ? o - static_cast<float>(d + 1) * _cell_size
+            : 0.0f;
+        return MAX(0.0f, g - slack);
+    };
+
+    size_t visited = 0;
+    for(int64_t r = 0; ; ++r) {
+        const int64_t side = 2 * r + 1;
+        const double shell_cells = static_cast<double>(side) * side * side - static_cast<double>(side - 2) * (side - 2) * (side - 2);
+
+        // far enough out that checking everything is cheaper
+        if(r > 0 && (side >= MaxCellSpan || shell_cells > static_cast<double>(_cells.size()))) {
+            nearest.clear();
+            for(const Cell& cell : _cells) {
+                scan(cell);
+            }
+            break;
+        }
+
+        const int32_t r32 = static_cast<int32_t>(r);
+        for(int32_t dz = -r32; dz <= r32; ++dz) {
+            const float gz = gap(dz, offset.z());
+            for(int32_t dy = -r32; dy <= r32; ++dy) {
+                const float gy = gap(dy, offset.y());
+
+                // the inner cells of this slice were covered by earlier shells
+                const bool face = dz == -r32 || dz == r32 || dy == -r32 || dy == r32;
+                const int32_t step = face ? 1 : 2 * r32;
+                for(int32_t dx = -r32; dx <= r32; dx += step) {
+                    // skip (without looking up) cells that are too far away to matter
+                    const float gx = gap(dx, offset.x());
+                    if(gx * gx + gy * gy + gz * gz > nearest.bound()) {
+                        continue;
+                    }
+
+                    const Cell* const cell = find_cell(origin.x + dx, origin.y + dy, origin.z + dz);
+                    if(nullptr != cell) {
+                        visited += scan(*cell);
+                    }
+                }
+            }
+        }
+
+        if(visited == _size) {
+            break;
+        }
+
+        // the distance from center to the closest cell outside of the searched cube
+        const float reach = MIN(MIN(gap(r32 + 1, offset.x()), gap(-r32 - 1, offset.x())),
+            MIN(MIN(gap(r32 + 1, offset.y()), gap(-r32 - 1, offset.y())), MIN(gap(r32 + 1, offset.z()), gap(-r32 - 1, offset.z()))));
+        if(reach * reach > nearest.bound()) {
+            break;
+        }
+    }
+
+    return nearest.finish(out);
+}
+
+void SpatialHashGrid::query_radius(const Point3* const centers, size_t count, float radius, QueryResults& results) const
+{
+    results.clear();
+    results.offsets.reserve(count + 1);
+    results.offsets.push_back(0);
+    for(size_t i = 0; i < count; ++i) {
+        query_radius(centers[i], radius, results.ids);
+        results.offsets.push_back(results.ids.size());
+    }
+}
+
+void SpatialHashGrid::query_nearest(const Point3* const centers, size_t count, size_t k, QueryResults& results, float max_distance) const
+{
+    results.clear();
+    results.offsets.reserve(count + 1);
+    results.ids.reserve(count * MIN(k, _size));
+    results.offsets.push_back(0);
+    for(size_t i = 0; i < count; ++i) {
+        query_nearest(centers[i], k, results.ids, max_distance);
+        results.offsets.push_back(results.ids.size());
+    }
+}
+
+SpatialHashGrid::CellCoordinates SpatialHashGrid::cell_coordinates(const Vector& position) const
+{
+    // clamped so that far away (or infinite) positions still convert safely
+    const auto coordinate = [this](float v) {
+        const float c = std::floor(v * _inv_cell_size);
+        return static_cast<int32_t>(MAX(-1073741824.0f, MIN(c, 1073741824.0f)));
+    };
+    return { coordinate(position.x()), coordinate(position.y()), coordinate(position.z()) };
+}
+
+size_t SpatialHashGrid::find_slot(uint64_t key) const
+{
+    const size_t mask = _table_keys.size() - 1;
+    size_t slot = key_hash(key) & mask;
+    while(EmptyKey != _table_keys[slot] && key != _table_keys[slot]) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+const SpatialHashGrid::Cell* SpatialHashGrid::find_cell(uint64_t key) const
+{
+    if(_table_keys.empty()) {
+        return nullptr;
+    }
+
+    const size_t slot = find_slot(key);
+    return EmptyKey == _table_keys[slot] ? nullptr : &_cells[_table_cells[slot]];
+}
+
+const SpatialHashGrid::Cell* SpatialHashGrid::find_cell(int32_t x, int32_t y, int32_t z) const
+{
+    return find_cell(cell_key(x, y, z));
+}
+
+SpatialHashGrid::Cell& SpatialHashGrid::find_or_add_cell(uint64_t key)
+{
+    if((_cells.size() + 1) * 2 > _table_keys.size()) {
+        rehash(MAX(MinTableSize, _table_keys.size() * 2));
+    }
+
+    const size_t slot = find_slot(key);
+    if(EmptyKey != _table_keys[slot]) {
+        return _cells[_table_cells[slot]];
+    }
+
+    _table_keys[slot] = key;
+    _table_cells[slot] = static_cast<uint32_t>(_cells.size());
+
+    _cells.emplace_back();
+    _cells.back().key = key;
+    return _cells.back();
+}
+
+void SpatialHashGrid::remove_cell(size_t slot)
+{
+    // keep the cells packed by moving the last one into the hole
+    const uint32_t index = _table_cells[slot];
+    if(index != _cells.size() - 1) {
+        _cells[index] = std::move(_cells.back());
+        _table_cells[find_slot(_cells[index].key)] = index;
+    }
+    _cells.pop_back();
+
+    // shift later entries of the probe sequence back so that lookups
+    // don't need tombstones (Knuth's algorithm R)
+    const size_t mask = _table_keys.size() - 1;
+    size_t hole = slot;
+    for(size_t next = (slot + 1) & mask; EmptyKey != _table_keys[next]; next = (next + 1) & mask) {
+        const size_t home = key_hash(_table_keys[next]) & mask;
+
+        // entries whose home is cyclically in (hole, next] have to stay
+        const bool stays = hole <= next ? (hole < home && home <= next) : (hole < home || home <= next);
+        if(!stays) {
+            _table_keys[hole] = _table_keys[next];
+            _table_cells[hole] = _table_cells[next];
+            hole = next;
+        }
+    }
+    _table_keys[hole] = EmptyKey;
+}
+
+void SpatialHashGrid::rehash(size_t capacity)
+{
+    _table_keys.assign(capacity, EmptyKey);
+    _table_cells.assign(capacity, 0);
+    for(size_t i = 0; i < _cells.size(); ++i) {
+        const size_t slot = find_slot(_cells[i].key);
+        _table_keys[slot] = _cells[i].key;
+        _table_cells[slot] = static_cast<uint32_t>(i);
+    }
+}
+
+void SpatialHashGrid::add_to_cell(Id id, uint64_t key, const Vector& position)
+{
+    Cell& cell = find_or_add_cell(key);
+
+    Entry& entry = _entries[id];
+    entry.key = key;
+    entry.slot = static_cast<uint32_t>(cell.ids.size());
+
+    cell.positions.push_back(position);
+    cell.ids.push_back(id);
+}
+
+void SpatialHashGrid::remove_from_cell(Id id)
+{
+    const Entry& entry = _entries[id];
+    const size_t slot = find_slot(entry.key);
+    Cell& cell = _cells[_table_cells[slot]];
+
+    // swap with the last point in the cell
+    const uint32_t last = static_cast<uint32_t>(cell.ids.size() - 1);
+    if(entry.slot != last) {
+        cell.positions[entry.slot] = cell.positions[last];
+        cell.ids[entry.slot] = cell.ids[last];
+        _entries[cell.ids[entry.slot]].slot = entry.slot;
+    }
+    cell.positions.pop_back();
+    cell.ids.pop_back();
+
+    if(cell.ids.empty()) {
+        remove_cell(slot);
+    }
+}
+
+} }
@@ -0,0 +1,150 @@
+#if !defined __SPATIALHASHGRID_H__
+#define __SPATIALHASHGRID_H__
+
+#include <limits>
+#include <vector>
+#include "Core/Math/Vector.h"
+#include "QueryResults.h"
+
+namespace energonsoftware {
+namespace spatial {
+
+using math::Point3;
+using math::Vector;
+
+/*
+Uniform grid of cubic cells over Point3s, hashed so that only
+occupied cells take up memory and the world doesn't need bounds.
+
+Each cell keeps its points packed together (position and id)
+so a query only touches the cells that overlap it. Points can be
+inserted, moved and removed incrementally, which makes this suited
+to large sets of moving entities that are queried every tick.
+
+The cell size should be about the most common query radius,
+radius queries then visit 27 cells or fewer.
+
+Only x, y and z are used, w is ignored.
+
+Queries are const and safe to run from multiple threads at once,
+as long as nothing modifies the grid at the same time.
+*/
+class DllExport SpatialHashGrid
+{
+public:
+    // handle returned by insert()
+    // the ids of removed points are reused by later inserts
+    typedef uint32_t Id;
+
+    static const Id InvalidId = 0xffffffff;
+
+public:
+    explicit SpatialHashGrid(float cell_size);
+
+    DEFAULT_COPY_AND_ASSIGN(SpatialHashGrid);
+
+    SpatialHashGrid(SpatialHashGrid&& grid) = default;
+
+    ~SpatialHashGrid() = default;
+
+public:
+    float cell_size() const { return _cell_size; }
+
+    // the number of points
+    size_t size() const { return _size; }
+    bool empty() const { return 0 == _size; }
+
+    // the number of occupied cells
+    size_t cell_count() const { return _cells.size(); }
+
+    void clear();
+
+    // makes room for count ids without reallocating
+    void reserve(size_t count) { _entries.reserve(count); }
+
+    Id insert(const Point3& position);
+
+    void move(Id id, const Point3& position);
+
+    void remove(Id id);
+
+    bool contains(Id id) const { return id < _entries.size() && EmptyKey != _entries[id].key; }
+
+    // NOTE: id must be valid
+    const Point3& position(Id id) const;
+
+public:
+    // appends the ids of every point within radius (inclusive) of center to out
+    // in no particular order, returns the number found
+    size_t query_radius(const Point3& center, float radius, std::vector<Id>& out) const;
+
+    // appends the ids of the (up to) k points nearest center
+    // and no further than max_distance to out, nearest first,
+    // returns the number found
+    size_t query_nearest(const Point3& center, size_t k, std::vector<Id>& out,
+        float max_distance = std::numeric_limits<float>::infinity()) const;
+
+    // batched versions of the above, one query per center
+    // results replace whatever was in the buffers
+    void query_radius(const Point3* const centers, size_t count, float radius, QueryResults& results) const;
+    void query_nearest(const Point3* const centers, size_t count, size_t k, QueryResults& results,
+        float max_distance = std::numeric_limits<float>::infinity()) const;
+
+private:
+    // the points in a cell, positions[i] belongs to ids[i]
+    struct Cell
+    {
+        uint64_t key;
+        std::vector<Vector> positions;
+        std::vector<Id> ids;
+    };
+
+    struct Entry
+    {
+        uint64_t key;
+        uint32_t slot;
+    };
+
+    struct CellCoordinates
+    {
+        int32_t x, y, z;
+    };
+
+    // not a valid cell key, marks removed entries and empty table slots
+    static const uint64_t EmptyKey = 0xffffffffffffffffULL;
+
+private:
+    CellCoordinates cell_coordinates(const Vector& position) const;
+
+    // the slot of key in the cell table, or the empty slot where it would go
+    size_t find_slot(uint64_t key) const;
+
+    const Cell* find_cell(uint64_t key) const;
+    const Cell* find_cell(int32_t x, int32_t y, int32_t z) const;
+    Cell& find_or_add_cell(uint64_t key);
+    void remove_cell(size_t slot);
+    void rehash(size_t capacity);
+
+    void add_to_cell(Id id, uint64_t key, const Vector& position);
+    void remove_from_cell(Id id);
+
+private:
+    float _cell_size;
+    float _inv_cell_size;
+
+    // occupied cells, packed
+    std::vector<Cell> _cells;
+
+    // open addressing (linear probing) table from cell key
+    // to the index of the cell in _cells, the size is a power of 2
+    std::vector<uint64_t> _table_keys;
+    std::vector<uint32_t> _table_cells;
+
+    std::vector<Entry> _entries;
+    std::vector<Id> _free;
+    size_t _size = 0;
+};
+
+} }
+
+#endif
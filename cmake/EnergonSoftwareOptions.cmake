@@ -0,0 +1,100 @@
+# compile and link options shared by every target
+# see the ENERGONSOFTWARE_* options in the top-level CMakeLists.txt
+#
+# energonsoftware_options is what targets link against,
+# energonsoftware_common is everything except the baseline instruction set
+# so the unit tests can also build a scalar (no USE_SSE) copy of Core
+
+add_library(energonsoftware_common INTERFACE)
+add_library(energonsoftware_options INTERFACE)
+target_link_libraries(energonsoftware_options INTERFACE energonsoftware_common)
+
+target_include_directories(energonsoftware_common INTERFACE ${PROJECT_SOURCE_DIR})
+
+if(CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
+    target_compile_options(energonsoftware_common INTERFACE -Wall -Wextra)
+
+    # GCC fuses a * b + c into FMAs by default (with -mfma), which would make
+    # the rounding depend on the optimizer, the SIMD and scalar paths (and the
+    # spatial indices and their references) have to round identically
+    # NOTE: explicit FMA intrinsics (Core/Math/SIMD) aren't affected
+    target_compile_options(energonsoftware_common INTERFACE -ffp-contract=off)
+endif()
+
+# baseline instruction set
+# the runtime-dispatched kernels (Core/Math/SIMD) pick their own
+# instruction sets regardless, this controls everything else
+# (USE_SSE enables the SSE paths in Vector, Matrix4 and Quaternion)
+string(TOLOWER "${ENERGONSOFTWARE_ARCH}" _arch)
+set(ENERGONSOFTWARE_USE_SSE OFF)
+if(_arch STREQUAL "none")
+    set(_arch_flags "")
+elseif(_arch STREQUAL "sse2")
+    set(_arch_flags -msse2)
+elseif(_arch STREQUAL "avx2")
+    set(_arch_flags -mavx2 -mfma)
+elseif(_arch STREQUAL "avx512")
+    set(_arch_flags -mavx512f -mavx512dq -mavx512bw -mavx512vl -mavx2 -mfma)
+elseif(_arch STREQUAL "native")
+    set(_arch_flags -march=native)
+else()
+    message(FATAL_ERROR "Unknown ENERGONSOFTWARE_ARCH '${ENERGONSOFTWARE_ARCH}'")
+endif()
+
+if(NOT _arch STREQUAL "none")
+    set(ENERGONSOFTWARE_USE_SSE ON)
+    target_compile_definitions(energonsoftware_options INTERFACE USE_SSE)
+    if(CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
+        target_compile_options(energonsoftware_options INTERFACE ${_arch_flags})
+    endif()
+endif()
+
+# log4cpp is optional outside of Windows
+find_path(LOG4CPP_INCLUDE_DIR log4cpp/Category.hh)
+find_library(LOG4CPP_LIBRARY log4cpp)
+if(LOG4CPP_INCLUDE_DIR AND LOG4CPP_LIBRARY)
+    target_include_directories(energonsoftware_common INTERFACE ${LOG4CPP_INCLUDE_DIR})
+    target_link_libraries(energonsoftware_common INTERFACE ${LOG4CPP_LIBRARY})
+else()
+    message(STATUS "log4cpp not found, building without it")
+    target_compile_definitions(energonsoftware_common INTERFACE NO_LOG4CPP)
+endif()
+
+find_package(Threads REQUIRED)
+target_link_libraries(energonsoftware_common INTERFACE Threads::Threads)
+
+# link-time optimization
+if(ENERGONSOFTWARE_LTO)
+    include(CheckIPOSupported)
+    check_ipo_supported(RESULT _lto_supported OUTPUT _lto_error LANGUAGES CXX)
+    if(NOT _lto_supported)
+        message(FATAL_ERROR "LTO is not supported: ${_lto_error}")
+    endif()
+    set(CMAKE_INTERPROCEDURAL_OPTIMIZATION ON)
+endif()
+
+# profile-guided optimization
+# build with GENERATE, run the benchmarks (or a real workload) to write the
+# profiles to ENERGONSOFTWARE_PGO_DIR, then rebuild the same tree with USE
+string(TOUPPER "${ENERGONSOFTWARE_PGO}" _pgo)
+if(_pgo STREQUAL "GENERATE")
+    if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+        set(_pgo_flags -fprofile-generate -fprofile-dir=${ENERGONSOFTWARE_PGO_DIR} -fprofile-update=atomic)
+    else()
+        set(_pgo_flags -fprofile-instr-generate=${ENERGONSOFTWARE_PGO_DIR}/%p.profraw)
+    endif()
+    target_compile_options(energonsoftware_common INTERFACE ${_pgo_flags})
+    target_link_options(energonsoftware_common INTERFACE ${_pgo_flags})
+elseif(_pgo STREQUAL "USE")
+    if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+        set(_pgo_flags -fprofile-use -fprofile-dir=${ENERGONSOFTWARE_PGO_DIR} -fprofile-correction -Wno-missing-profile)
+    else()
+        # merge the raw profiles first:
+        # llvm-profdata merge -o ${ENERGONSOFTWARE_PGO_DIR}/default.profdata ${ENERGONSOFTWARE_PGO_DIR}/*.profraw
+        set(_pgo_flags -fprofile-instr-use=${ENERGONSOFTWARE_PGO_DIR}/default.profdata)
+    endif()
+    target_compile_options(energonsoftware_common INTERFACE ${_pgo_flags})
+    target_link_options(energonsoftware_common INTERFACE ${_pgo_flags})
+elseif(NOT _pgo STREQUAL "OFF")
+    message(FATAL_ERROR "Unknown ENERGONSOFTWARE_PGO '${ENERGONSOFTWARE_PGO}'")
+endif()
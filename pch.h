@@ -24,9 +24,12 @@
 #include <random>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 
-#include <log4cpp/Category.hh>
+#if !defined NO_LOG4CPP
+    #include <log4cpp/Category.hh>
+#endif
 
 #define DISALLOW_COPY_AND_ASSIGN(TypeName) \
 TypeName(const TypeName&) = delete; \